@@ -319,6 +319,18 @@ namespace quda {
     */
     inline double xmyNorm(const ColorSpinorField &x, ColorSpinorField &y) { return axpbyzNorm(1.0, x, -1.0, y, y); }
 
+    /**
+       @brief Compute y = x - y, copy the result to z and return
+       ||y||^2 in a single pass.  This is used to recompute the
+       residual at a reliable update, where z is the sloppy residual.
+       The norm is computed before the result is rounded to the
+       precision of z, and when z aliases y this reduces to xmyNorm.
+       @param[in] x input vector
+       @param[in,out] y update vector
+       @param[out] z copy of the updated y, of at most the precision of y
+    */
+    double xmyNormCopy(const ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
+
     /**
        @brief Compute the complex-valued inner product (x, y)
        @param[in] x input vector
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <color_spinor_field.h>
+#include <dirac_quda.h>
+
+namespace quda
+{
+
+  /**
+     @brief Chronology holds the history of previous solutions that
+     is used to forecast the initial guess of subsequent solves using
+     the minimum residual extrapolation (as does MinResExt).  In
+     contrast to MinResExt, which re-orthogonalizes the basis on
+     every call, the Gram matrix of the basis is updated
+     incrementally as each new solution is added, so that only N new
+     inner products are computed per solve.  The projected problem
+     is then solved in the orthonormal frame defined by the Gram
+     matrix, dropping any numerically dependent directions.
+
+     The basis can be stored in any precision, including half and
+     quarter, with all inner products accumulated in double
+     precision, and its dimension can be capped by a memory budget.
+     Statistics on the iteration counts with and without forecasting
+     are gathered to quantify the savings.
+   */
+  class Chronology
+  {
+    std::vector<ColorSpinorField> basis; /** Previous solutions, most recent first */
+    std::vector<Complex> gram;           /** Gram matrix (p_i, p_j) of the basis, row major */
+
+    int n_forecast = 0;   /** Number of solves that used a forecast */
+    int n_cold = 0;       /** Number of solves that did not use a forecast */
+    long iter_forecast = 0; /** Total iterations of the solves that used a forecast */
+    long iter_cold = 0;   /** Total iterations of the solves that did not use a forecast */
+    int max_dim_used = 0; /** Largest basis size used in a forecast */
+
+  public:
+    Chronology() = default;
+
+    /**
+       @return The number of vectors in the basis
+    */
+    size_t size() const { return basis.size(); }
+
+    /**
+       @return The storage precision of the basis
+    */
+    QudaPrecision Precision() const { return basis.size() ? basis[0].Precision() : QUDA_INVALID_PRECISION; }
+
+    /**
+       @return The device memory in bytes presently used by the basis
+    */
+    size_t Bytes() const;
+
+    /**
+       @brief Return the maximum basis dimension consistent with both
+       the requested dimension and the memory budget
+       @param[in] max_dim The requested maximum dimension
+       @param[in] budget The memory budget in GiB (zero is no budget)
+       @param[in] x A field with the geometry of the basis vectors
+       @param[in] prec The storage precision of the basis
+    */
+    static int max_dim(int max_dim, double budget, const ColorSpinorField &x, QudaPrecision prec);
+
+    /**
+       @brief Add a solution to the basis, updating the Gram matrix
+       with the N inner products between the new vector and the
+       existing basis.  The new vector is placed at the front of the
+       basis, and if the basis is at full capacity the oldest vector
+       is discarded.
+       @param[in] x The solution vector to add
+       @param[in] max_dim The maximum dimension of the basis
+       @param[in] prec The precision in which to store the vector
+       @param[in] replace_last Whether to replace the most recent
+       vector rather than augment the basis
+    */
+    void add(const ColorSpinorField &x, int max_dim, QudaPrecision prec, bool replace_last);
+
+    /**
+       @brief Compute the minimum residual extrapolation of the
+       solution of A x = b over the basis.  For Hermitian A we
+       minimize the A-norm of the error, and stream the basis through
+       the operator one vector at a time, else we minimize the
+       residual norm using the normal equations.
+       @param[out] x The forecast solution
+       @param[in] b The source vector
+       @param[in] mat The operator to apply to the basis
+       @param[in] prec The precision of the operator mat
+       @param[in] hermitian Whether mat is Hermitian
+    */
+    void forecast(ColorSpinorField &x, const ColorSpinorField &b, const DiracMatrix &mat, QudaPrecision prec,
+                  bool hermitian);
+
+    /**
+       @brief Record the iteration count of a solve for the statistics
+       @param[in] iter The number of solver iterations
+       @param[in] forecast Whether the solve used a forecast
+    */
+    void record(int iter, bool forecast);
+
+    /**
+       @brief Print the statistics gathered on this chronology
+       @param[in] index The chrono index of this chronology
+    */
+    void print_stats(int index) const;
+
+    /**
+       @brief Free the basis and reset the statistics
+    */
+    void clear();
+  };
+
+} // namespace quda
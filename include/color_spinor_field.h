@@ -1011,14 +1011,33 @@ namespace quda
   void spinorNoise(ColorSpinorField &src, unsigned long long seed, QudaNoiseType type);
 
   /**
-     @brief Generate a set of diluted color spinors from a single source.
-     @param[out] v Diluted vector set
+     @brief Return the size of the complete dilution set for a given
+     source and dilution type.
      @param[in] src The input source
      @param[in] type The type of dilution to apply (QUDA_DILUTION_SPIN_COLOR, etc.)
-     @param[in] local_block The local block size to use when using QUDA_DILUTION_BLOCK dilution
+     @param[in] local_block The local block size (see spinorDilute)
+     @return The number of diluted fields
   */
-  void spinorDilute(std::vector<ColorSpinorField> &v, const ColorSpinorField &src, QudaDilutionType type,
-                    const lat_dim_t &local_block = {});
+  size_t spinorDiluteSize(const ColorSpinorField &src, QudaDilutionType type, const lat_dim_t &local_block = {});
+
+  /**
+     @brief Generate a set of diluted color spinors from a single
+     source.  The set may be generated in batches: v is filled with
+     elements [offset, offset + v.size()) of the complete set, whose
+     size is given by spinorDiluteSize.  For the non-block dilution
+     types, if all elements of local_block are set the dilution is
+     additionally composed with block dilution (e.g., time dilution
+     with a block of the spatial volume by one time slice), with the
+     spin/color/parity pattern running fastest in the set.
+     @param[out] v Diluted vector set (or batch thereof)
+     @param[in] src The input source
+     @param[in] type The type of dilution to apply (QUDA_DILUTION_SPIN_COLOR, etc.)
+     @param[in] local_block The local block size to use when using
+     QUDA_DILUTION_BLOCK dilution, or to compose with the other types
+     @param[in] offset The index in the complete set of v[0]
+  */
+  void spinorDilute(cvector_ref<ColorSpinorField> &v, const ColorSpinorField &src, QudaDilutionType type,
+                    const lat_dim_t &local_block = {}, int offset = 0);
 
   /**
      @brief Helper function for determining if the preconditioning
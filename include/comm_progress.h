@@ -0,0 +1,80 @@
+#pragma once
+
+#include <comm_quda.h>
+
+/**
+   @file comm_progress.h
+
+   @brief Optional communication progress engine, enabled by setting
+   QUDA_ENABLE_PROGRESS_THREAD=1.
+
+   When enabled, comm_start() hands the message handle to a dedicated
+   host thread rather than starting it from the calling thread.  The
+   progress thread starts each message and then continuously polls all
+   messages in flight, publishing completion through a per-handle
+   atomic flag.  comm_query() and comm_wait() then only read this
+   flag, so halo messages continue to progress while the calling
+   thread is busy launching or waiting on kernels, even with MPI
+   implementations that only progress messages from within MPI calls.
+   The progress thread is bound to the PROGRESS cores when thread
+   binding is enabled (see numa_affinity.h).
+
+   Since MPI is then called concurrently from the progress thread and
+   the calling thread, this requires MPI to have been initialized with
+   MPI_THREAD_MULTIPLE, otherwise the engine is disabled with a
+   warning.  The engine is not used in single-process builds.
+ */
+
+namespace quda
+{
+
+  struct Communicator;
+
+  namespace comm_progress
+  {
+
+    /**
+       @return Whether the progress engine is enabled.  The
+       environment and MPI thread level are inspected on the first
+       call.
+     */
+    bool enabled();
+
+    /**
+       @brief Hand a message to the progress thread, which starts it
+       and polls it to completion.  The thread is launched on the
+       first call.
+       @param[in] comm The communicator the message was declared with
+       @param[in] mh Message handle
+     */
+    void start(Communicator &comm, MsgHandle *mh);
+
+    /**
+       @brief Wait until the progress thread has completed a message.
+       Returns immediately if the message has not been started.
+       @param[in] mh Message handle
+     */
+    void wait(MsgHandle *mh);
+
+    /**
+       @param[in] mh Message handle
+       @return Whether the progress thread has completed the message
+     */
+    int query(MsgHandle *mh);
+
+    /**
+       @brief Release the progress-engine state of a message, waiting
+       for any message in flight to complete.  Must be called before
+       the message handle is freed.
+       @param[in] mh Message handle
+     */
+    void release(MsgHandle *mh);
+
+    /**
+       @brief Stop and join the progress thread, if running
+     */
+    void finalize();
+
+  } // namespace comm_progress
+
+} // namespace quda
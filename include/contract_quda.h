@@ -2,8 +2,46 @@
 
 #include <quda_internal.h>
 #include <quda.h>
+#include <array.h>
 
 namespace quda
 {
   void contractQuda(const ColorSpinorField &x, const ColorSpinorField &y, void *result, QudaContractType cType);
+
+  /**
+     @brief Contract the spinors x and y site by site, multiply by the
+     momentum phase exp(-i p.x) and sum over each time slice, so that
+     only the time-slice correlators are returned rather than the
+     per-site result
+     @param[in] x The bra spinor field
+     @param[in] y The ket spinor field
+     @param[out] result The 16 spin components for each momentum and
+     global time slice, ordered as ((mom * T + t) * 16 + spin)
+     @param[in] cType Which type of contraction (open or degrand-rossi)
+     @param[in] mom The momenta as integer modes (n_x, n_y, n_z) with
+     p_i = 2 pi n_i / L_i
+  */
+  void contractSummedQuda(const ColorSpinorField &x, const ColorSpinorField &y, std::vector<Complex> &result,
+                          QudaContractType cType, const std::vector<array<int, 3>> &mom);
+
+  /**
+     @brief Compute the all-to-all meson field
+     M[t][p][g][i][j] = sum_{x in t} w_i(x)^dagger Gamma_g v_j(x) exp(-i p.x)
+     for two blocks of vectors.  Each block is packed into
+     per-time-slice matrices and the contraction is done with one
+     strided batched GEMM per momentum (batched over the local time
+     slices), rather than N * M separate contractions.  Device fields
+     use the native BLAS when enabled, and host fields (in
+     space-spin-color order) are contracted on the host.
+     @param[in] w The bra vectors (N)
+     @param[in] v The ket vectors (M)
+     @param[out] result The meson field, ordered as
+     [T][mom][16][N][M] with T the global temporal extent
+     @param[in] cType Which type of contraction (open or degrand-rossi)
+     @param[in] mom The momenta as integer modes (n_x, n_y, n_z) with
+     p_i = 2 pi n_i / L_i
+  */
+  void contractMesonFieldQuda(cvector_ref<const ColorSpinorField> &w, cvector_ref<const ColorSpinorField> &v,
+                              std::vector<Complex> &result, QudaContractType cType,
+                              const std::vector<array<int, 3>> &mom);
 } // namespace quda
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <target_device.h>
+
+namespace quda
+{
+
+  /**
+     @brief Parameters that define a counter-based random stream.
+     This is passed by value to the kernel, and together with the
+     global site index of each thread it uniquely determines the
+     random numbers that thread will draw.
+   */
+  struct CounterRNG {
+    bool enabled = false;         /** Whether the counter-based generator is in use */
+    unsigned long long seed = 0;  /** The generator seed (the Philox key) */
+    unsigned int stream = 0;      /** Stream index, advanced on every use of the generator */
+    int X[4] = {};                /** Local lattice dimensions */
+    int commCoord[4] = {};        /** Coordinates of this process in the process grid */
+    int X_global[4] = {};         /** Global lattice dimensions */
+
+    /**
+       @brief Return the global lexicographical site index of a
+       given local checkerboard site.  This is the same index that is
+       used to seed the stateful generators in init_random.
+       @param[in] x_cb Checkerboard site index
+       @param[in] parity Site parity
+     */
+    __device__ __host__ inline uint64_t site(int x_cb, int parity) const
+    {
+      int x[4];
+      int za = x_cb / (X[0] / 2);
+      int zb = za / X[1];
+      x[1] = za - zb * X[1];
+      x[3] = zb / X[2];
+      x[2] = zb - x[3] * X[2];
+      int x1odd = (x[1] + x[2] + x[3] + parity) & 1;
+      x[0] = 2 * x_cb + x1odd - za * X[0];
+      for (int i = 0; i < 4; i++) x[i] += commCoord[i] * X[i];
+      return (((static_cast<uint64_t>(x[3]) * X_global[2] + x[2]) * X_global[1] + x[1]) * X_global[0] + x[0]);
+    }
+  };
+
+} // namespace quda
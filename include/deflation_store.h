@@ -0,0 +1,140 @@
+#pragma once
+
+#include <vector>
+#include <color_spinor_field.h>
+#include <dirac_quda.h>
+
+/**
+   @file deflation_store.h
+
+   @brief Compressed storage of a deflation space, used by the
+   Hermitian deflated solvers when QudaEigParam::deflation_prec is
+   lower than the precision of the eigensolver.
+
+   The vectors are stored as half- or quarter-precision fields, which
+   carry a scale per site, so that 2-4x as many vectors fit in the
+   memory of a single-precision space.  Since the compressed vectors
+   are no longer exact eigenvectors, the deflated guess is formed
+   with the Galerkin projection
+
+     x = V (V^dag A V)^{-1} V^dag b
+
+   rather than with the eigenvalues.  The projected matrix
+   H = V^dag A V and its Cholesky factor are extended by bordering as
+   vectors are added, so adding k vectors to a space of n costs k
+   operator applications, an n x k block of inner products and O(k
+   n^2) host work, rather than a rebuild.  The projections stream the
+   stored vectors through the multi-blas kernels, reading them in
+   their storage precision where the kernels allow mixed precision,
+   and else expanding them tile by tile into working buffers.
+
+   The store is the deflation space: it is preserved across solves,
+   and transferred between solvers, as is, so that the space is only
+   compressed once.  Vectors added to the store are released as they
+   are compressed, so the full- and low-precision copies of the space
+   never coexist.
+ */
+
+namespace quda
+{
+
+  class DeflationStore
+  {
+    const DiracMatrix *mat;     /** Operator whose low modes are deflated */
+    const QudaPrecision prec;   /** Storage precision */
+    QudaPrecision work_prec;    /** Precision in which the operator is applied */
+
+    std::vector<ColorSpinorField> v;               /** The stored vectors */
+    std::vector<std::vector<Complex>> H;           /** Lower triangle of V^dag A V, by rows */
+    std::vector<std::vector<Complex>> L;           /** Cholesky factor of H, by rows */
+    mutable std::vector<ColorSpinorField> work;    /** Working-precision tile buffers */
+
+    /**
+       @brief Whether the multi-blas kernels can read the stored
+       vectors together with a field of the given precision
+       @param[in] y The field the stored vectors are combined with
+     */
+    bool direct(const ColorSpinorField &y) const;
+
+    /**
+       @brief Expand stored vectors into the working buffers
+       @param[in] first First vector to expand
+       @param[in] last One past the last vector to expand
+       @param[in] meta Field whose precision the buffers take
+     */
+    void stage(int first, int last, const ColorSpinorField &meta) const;
+
+    /**
+       @brief Compute s[i * y.size() + j] = (v[first + i], y[j]) for
+       the stored vectors in [first, last)
+     */
+    void dot(std::vector<Complex> &s, int first, int last, cvector_ref<const ColorSpinorField> &y) const;
+
+    /**
+       @brief Compute y[j] += sum_i a[i * y.size() + j] v[i] over all
+       stored vectors
+     */
+    void axpy(const std::vector<Complex> &a, cvector_ref<ColorSpinorField> &y) const;
+
+    /**
+       @brief Compute the rows of H and L of the vectors from first
+       onwards, assuming the rows before first are current
+     */
+    void extend(int first);
+
+  public:
+    /** Number of vectors streamed through each staged kernel, and
+        the number of operator applications batched per projection
+        when extending the space */
+    static constexpr int tile = 16;
+
+    /**
+       @brief Create an empty store
+       @param[in] mat The operator whose low modes are deflated
+       @param[in] prec The storage precision
+     */
+    DeflationStore(const DiracMatrix &mat, QudaPrecision prec);
+
+    /**
+       @brief Compress vectors into the store, and extend the
+       projected matrix with them.  Each vector is released once it
+       has been compressed.
+       @param[in,out] vecs The vectors to add, empty on return
+     */
+    void add(std::vector<ColorSpinorField> &vecs);
+
+    /**
+       @brief Set the operator whose low modes are deflated, e.g.,
+       when the store is transferred to a new solver.  This does not
+       recompute the projected matrix, see rebuild.
+       @param[in] mat The operator
+     */
+    void setOperator(const DiracMatrix &mat) { this->mat = &mat; }
+
+    /**
+       @brief Recompute the projected matrix, e.g., after the
+       operator has changed
+     */
+    void rebuild();
+
+    /**
+       @brief Deflate a set of vectors: sol (+)= V (V^dag A V)^{-1} V^dag src
+       @param[in,out] sol The deflated vectors
+       @param[in] src The vectors to deflate
+       @param[in] accumulate Whether to accumulate into sol, else sol is overwritten
+     */
+    void deflate(cvector_ref<ColorSpinorField> &sol, cvector_ref<const ColorSpinorField> &src,
+                 bool accumulate = false) const;
+
+    /**
+       @return The number of stored vectors
+     */
+    int size() const { return v.size(); }
+
+    /**
+       @return The device memory used by the stored vectors
+     */
+    size_t bytes() const;
+  };
+
+} // namespace quda
@@ -33,6 +33,13 @@ namespace quda
     */
     void get_visible_devices_string(char device_list_string[128]);
 
+    /**
+       @brief Get the PCI bus id of the device used by this process,
+       in the form used by sysfs, e.g., "0000:3b:00.0"
+       @param[out] bus_id The output string
+    */
+    void get_pci_bus_id(char bus_id[16]);
+
     /**
        @brief Query and print to stdout device properties of all GPUs
     */
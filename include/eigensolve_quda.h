@@ -168,8 +168,9 @@ namespace quda
       @param[in] v Vector space
       @param[in] i Ortho block size for Hybrid MGS (1 = modified, j-1 = classical, 1 < i < j-1 = hybrid)
       @param[in] j Use vectors v[0:j-1]
+      @param[in] k Only orthonormalise v[k:j-1], assuming v[0:k-1] are already orthonormal
    */
-    void orthonormalizeHMGS(std::vector<ColorSpinorField> &v, int i, int j);
+    void orthonormalizeHMGS(std::vector<ColorSpinorField> &v, int i, int j, int k = 0);
 
     /**
        @brief Check orthonormality of input vector space v
@@ -467,6 +468,59 @@ namespace quda
     void computeBlockKeptRitz(std::vector<ColorSpinorField> &kSpace);
   };
 
+  /**
+     @brief Chebyshev-Filtered Subspace Iteration.
+  */
+  class CHFSI : public EigenSolver
+  {
+
+  public:
+    /**
+       @brief Constructor for Chebyshev-Filtered Subspace Iteration class
+       @param eig_param The eigensolver parameters
+       @param mat The operator to solve
+       @param profile Time Profile
+    */
+    CHFSI(const DiracMatrix &mat, QudaEigParam *eig_param, TimeProfile &profile);
+
+    /**
+       @return Whether the solver is only for Hermitian systems
+    */
+    virtual bool hermitian() { return true; } /** CHFSI is only for Hermitian systems */
+
+    // Ritz values of the subspace
+    std::vector<double> ritz;
+
+    /**
+       @brief Compute eigenpairs
+       @param[in] kSpace The search subspace
+       @param[in] evals Computed eigenvalues
+    */
+    void operator()(std::vector<ColorSpinorField> &kSpace, std::vector<Complex> &evals);
+
+    /**
+       @brief Apply the Chebyshev filter to the unlocked vectors,
+       block_size vectors at a time
+       @param[in] v The search subspace
+    */
+    void filter(std::vector<ColorSpinorField> &v);
+
+    /**
+       @brief Rayleigh-Ritz projection of the operator onto the
+       unlocked vectors, rotating them into the Ritz vectors
+       @param[in] v The search subspace
+    */
+    void rayleighRitz(std::vector<ColorSpinorField> &v);
+
+    /**
+       @brief Compute the residuals of the leading unlocked Ritz
+       pairs, and lock those that have converged
+       @param[in] v The search subspace
+       @param[in] mat_norm Estimate of the operator norm
+    */
+    void lock(std::vector<ColorSpinorField> &v, double mat_norm);
+  };
+
   /**
      @brief Implicitly Restarted Arnoldi Method.
   */
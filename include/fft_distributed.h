@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <quda_internal.h>
+#include <lattice_field.h>
+#include <FFT_Plans.h>
+
+namespace quda
+{
+
+  /**
+     @brief Complex-to-complex 4-d FFT of a scalar field distributed
+     over a partitioned lattice.  The transform is performed as a
+     sequence of 1-d transforms, one per dimension, using a pencil
+     decomposition: for each partitioned dimension the P ranks that
+     share a line along it exchange chunks (an all-to-all within the
+     line of ranks), such that each rank holds 1/P of the complete
+     lines, which are transformed locally with the target FFT library
+     and then returned.  The input and output are local arrays of the
+     interior volume in lexicographical order (x fastest), and in
+     momentum space the local index x_d corresponds to global
+     momentum p_d = comm_coord(d) * X_d + x_d, i.e., the distribution
+     of momenta is the same as that of the sites.
+
+     The transforms are unnormalized, as with the underlying library.
+   */
+  class FFTDistributed
+  {
+    const LatticeField &meta;   /** Field used for tuning metadata */
+    const QudaPrecision precision;
+    lat_dim_t X;                /** Local interior dimensions */
+    lat_dim_t P;                /** Number of ranks along each dimension */
+    size_t volume;              /** Local interior volume */
+    FFTPlanHandle plan[4];      /** Batched 1-d plans for each dimension */
+    void *buffer[2];            /** Device work buffers */
+    void *send = nullptr;       /** Host buffer for outgoing chunks */
+    void *recv = nullptr;       /** Host buffer for incoming chunks */
+
+    /**
+       @brief Exchange the chunks of the rotated array between the
+       ranks in the line along dimension d
+       @param[in,out] data Device array to exchange in place
+       @param[in] d The dimension
+     */
+    void exchange(void *data, int d);
+
+    template <typename Float> void transform(void *out, const void *in, int direction);
+
+  public:
+    /**
+       @brief Create the plans and work buffers for the distributed FFT
+       @param[in] meta Lattice field whose local interior dimensions
+       define the transform
+       @param[in] precision Precision of the transform (single or double)
+     */
+    FFTDistributed(const LatticeField &meta, QudaPrecision precision);
+
+    ~FFTDistributed();
+
+    FFTDistributed(const FFTDistributed &) = delete;
+    FFTDistributed &operator=(const FFTDistributed &) = delete;
+
+    /**
+       @brief Apply the 4-d transform
+       @param[out] out Output array (may be the same as in)
+       @param[in] in Input array
+       @param[in] direction FFT_FORWARD or FFT_INVERSE
+     */
+    void operator()(void *out, const void *in, int direction);
+
+    /**
+       @return The flops of a single 4-d transform (5 N log2 N)
+     */
+    double flops() const;
+  };
+
+} // namespace quda
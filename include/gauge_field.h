@@ -99,6 +99,10 @@ namespace quda {
       reconstruct(link_type == QUDA_ASQTAD_MOM_LINKS && order != QUDA_TIFR_GAUGE_ORDER
                       && order != QUDA_TIFR_PADDED_GAUGE_ORDER ?
                     QUDA_RECONSTRUCT_10 :
+                    // SU(3) fields in QDP or MILC order may be stored compressed on the host
+                    (link_type == QUDA_SU3_LINKS
+                     && (param.cpu_reconstruct == QUDA_RECONSTRUCT_12 || param.cpu_reconstruct == QUDA_RECONSTRUCT_8)) ?
+                    param.cpu_reconstruct :
                     QUDA_RECONSTRUCT_NO),
       anisotropy(param.anisotropy),
       tadpole(param.tadpole_coeff),
@@ -766,6 +770,40 @@ namespace quda {
   */
   uint64_t Checksum(const GaugeField &u, bool mini=false);
 
+  /**
+     Checksums of a gauge field as used for verifying its integrity
+     on load and save.
+   */
+  struct GaugeChecksum {
+    uint32_t suma = 0;  /** SciDAC / ILDG checksum a */
+    uint32_t sumb = 0;  /** SciDAC / ILDG checksum b */
+    uint64_t quda = 0;  /** QUDA's XOR-based checksum, as returned by Checksum */
+
+    bool operator==(const GaugeChecksum &other) const
+    {
+      return suma == other.suma && sumb == other.sumb && quda == other.quda;
+    }
+    bool operator!=(const GaugeChecksum &other) const { return !(*this == other); }
+  };
+
+  /**
+     @brief Compute the SciDAC / ILDG checksum of a host gauge field,
+     together with QUDA's XOR-based checksum, in a single pass over
+     the field.  The SciDAC checksum is the one QIO and ILDG record
+     alongside a lattice: for each site the CRC32 of its big-endian
+     record of file precision is computed, rotated by the global
+     lexicographical site index modulo 29 and 31, respectively, and
+     these are accumulated with XOR.  Each rank computes the checksum
+     of its local sites in parallel, with the global result formed
+     with an XOR all-reduce, so that, unlike QIO, no single node
+     needs to see the entire lattice.
+     @param[in] u Host gauge field (geometry must be vector)
+     @param[in] file_prec Precision of the record the SciDAC checksum
+     corresponds to (QUDA_DOUBLE_PRECISION or QUDA_SINGLE_PRECISION)
+     @return The global checksums
+  */
+  GaugeChecksum ChecksumSciDAC(const GaugeField &u, QudaPrecision file_prec);
+
   /**
      @brief Helper function for determining if the reconstruct of the fields is the same.
      @param[in] a Input field
@@ -375,6 +375,8 @@ namespace quda {
         scale(static_cast<Float>(1.0)),
         scale_inv(static_cast<Float>(1.0))
       {
+        if (U.Reconstruct() == QUDA_RECONSTRUCT_12 || U.Reconstruct() == QUDA_RECONSTRUCT_8)
+          errorQuda("Element accessor not supported for compressed QDP-ordered fields");
         for (int d = 0; d < U.Geometry(); d++)
           u[d] = gauge_ ? static_cast<complex<storeFloat> **>(gauge_)[d] : U.data<complex<storeFloat> *>(d);
         resetScale(U.Scale());
@@ -494,6 +496,8 @@ namespace quda {
         scale(static_cast<Float>(1.0)),
         scale_inv(static_cast<Float>(1.0))
       {
+        if (U.Reconstruct() == QUDA_RECONSTRUCT_12 || U.Reconstruct() == QUDA_RECONSTRUCT_8)
+          errorQuda("Element accessor not supported for compressed MILC-ordered fields");
         resetScale(U.Scale());
       }
 
@@ -1771,21 +1775,32 @@ namespace quda {
       /**
          @brief The LegacyOrder defines the ghost zone storage and ordering for
          all non-native fields, which use the same ghost zone storage.
+         Orders that support compressed storage of SU(3) links
+         (reconLen = 12 or 8) use the unpack and pack helpers here to
+         convert between the stored and the full matrix.
       */
-      template <typename Float, int length_> struct LegacyOrder {
+      template <typename Float, int length_, int reconLenParam = length_> struct LegacyOrder {
         static constexpr int length = length_;
-        using Accessor = LegacyOrder<Float, length>;
+        static constexpr int reconLen = reconLenParam;
+        static_assert(reconLen == length || (length == 18 && (reconLen == 12 || reconLen == 8)),
+                      "Unsupported reconstruction for legacy gauge order");
+        using Accessor = LegacyOrder<Float, length, reconLen>;
         using store_t = Float;
         using real = typename mapper<Float>::type;
         using complex = complex<real>;
+        // only used when compressed (the trivial 18 variant is a placeholder for any uncompressed length)
+        Reconstruct<reconLen == length ? 18 : reconLen, Float, QUDA_GHOST_EXCHANGE_INVALID> reconstruct;
         Float *ghost[QUDA_MAX_DIM] = {};
         int faceVolumeCB[QUDA_MAX_DIM] = {};
+        int X[QUDA_MAX_DIM] = {};
+        int R[QUDA_MAX_DIM] = {};
         const unsigned int volumeCB;
         const int stride;
         const int geometry;
         const int hasPhase;
 
         LegacyOrder(const GaugeField &u, Float **ghost_) :
+          reconstruct(u),
           volumeCB(u.VolumeCB()),
           stride(u.Stride()),
           geometry(u.Geometry()),
@@ -1793,25 +1808,69 @@ namespace quda {
         {
           if (geometry == QUDA_COARSE_GEOMETRY)
             errorQuda("This accessor does not support coarse-link fields (lacks support for bidirectional ghost zone");
+          if (reconLen != length && u.Reconstruct() != reconLen)
+            errorQuda("Accessor reconstruct %d does not match field reconstruct %d", reconLen, u.Reconstruct());
+          if (reconLen == length && length == 18
+              && (u.Reconstruct() == QUDA_RECONSTRUCT_12 || u.Reconstruct() == QUDA_RECONSTRUCT_8))
+            errorQuda("Uncompressed accessor used for field with reconstruct %d", u.Reconstruct());
 
           for (int i = 0; i < 4; i++) {
             ghost[i] = (ghost_)                            ? ghost_[i] :
               u.GhostExchange() == QUDA_GHOST_EXCHANGE_PAD ? (Float *)(u.Ghost()[i].data()) :
                                                              nullptr;
             faceVolumeCB[i] = u.SurfaceCB(i) * u.Nface(); // face volume equals surface * depth
+            X[i] = u.X()[i];
+            R[i] = u.R()[i];
+          }
+        }
+
+        /**
+           @brief Load a (possibly compressed) link from memory and
+           unpack to the full matrix.  The stored reals are loaded
+           with a single block load prior to the reconstruction.
+           @param[out] v The full link matrix
+           @param[in] in Pointer to the stored link
+           @param[in] x Checkerboard index used to apply the temporal
+           boundary condition when reconstructing
+           @param[in] dir The link direction
+        */
+        __device__ __host__ inline void unpack(complex v[length / 2], const Float *in, int x, int dir) const
+        {
+          if constexpr (reconLen == length) {
+            block_load<complex, length / 2>(v, reinterpret_cast<const complex *>(in));
+          } else {
+            real tmp[reconLen];
+            block_load<complex, reconLen / 2>(reinterpret_cast<complex *>(tmp), reinterpret_cast<const complex *>(in));
+            reconstruct.Unpack(v, tmp, x, dir, static_cast<real>(0.0), X, R);
+          }
+        }
+
+        /**
+           @brief Pack a link to its (possibly compressed) stored form
+           and save to memory
+           @param[out] out Pointer to the stored link
+           @param[in] v The full link matrix
+        */
+        __device__ __host__ inline void pack(Float *out, const complex v[length / 2]) const
+        {
+          if constexpr (reconLen == length) {
+            block_store<complex, length / 2>(reinterpret_cast<complex *>(out), v);
+          } else {
+            real tmp[reconLen];
+            reconstruct.Pack(tmp, v);
+            block_store<complex, reconLen / 2>(reinterpret_cast<complex *>(out), reinterpret_cast<complex *>(tmp));
           }
         }
 
         __device__ __host__ inline void loadGhost(complex v[length / 2], int x, int dir, int parity, real = 1.0) const
         {
-          auto in = &ghost[dir][(parity * faceVolumeCB[dir] + x) * length];
-          block_load<complex, length / 2>(v, reinterpret_cast<complex *>(in));
+          // the ghost zone holds the backwards links from the neighboring time slice
+          unpack(v, &ghost[dir][(parity * faceVolumeCB[dir] + x) * reconLen], volumeCB + x, dir);
         }
 
         __device__ __host__ inline void saveGhost(const complex v[length / 2], int x, int dir, int parity)
         {
-          auto out = &ghost[dir][(parity * faceVolumeCB[dir] + x) * length];
-          block_store<complex, length / 2>(reinterpret_cast<complex *>(out), v);
+          pack(&ghost[dir][(parity * faceVolumeCB[dir] + x) * reconLen], v);
         }
 
         /**
@@ -1833,15 +1892,15 @@ namespace quda {
         __device__ __host__ inline void loadGhostEx(complex v[length / 2], int x, int, int dir, int dim, int g,
                                                     int parity, const int R[]) const
         {
-          auto in = &ghost[dim][(((dir * 2 + parity) * R[dim] * faceVolumeCB[dim] + x) * geometry + g) * length];
-          block_load<complex, length / 2>(v, reinterpret_cast<complex *>(in));
+          auto in = &ghost[dim][(((dir * 2 + parity) * R[dim] * faceVolumeCB[dim] + x) * geometry + g) * reconLen];
+          unpack(v, in, volumeCB + x, g);
         }
 
         __device__ __host__ inline void saveGhostEx(const complex v[length / 2], int x, int, int dir, int dim, int g,
                                                     int parity, const int R[]) const
         {
-          auto out = &ghost[dim][(((dir * 2 + parity) * R[dim] * faceVolumeCB[dim] + x) * geometry + g) * length];
-          block_store<complex, length / 2>(reinterpret_cast<complex *>(out), v);
+          auto out = &ghost[dim][(((dir * 2 + parity) * R[dim] * faceVolumeCB[dim] + x) * geometry + g) * reconLen];
+          pack(out, v);
         }
       };
 
@@ -1849,28 +1908,73 @@ namespace quda {
        struct to define QDP ordered gauge fields:
        [[dim]] [[parity][volumecb][row][col]]
     */
-    template <typename Float, int length> struct QDPOrder : public LegacyOrder<Float,length> {
-      using Accessor = QDPOrder<Float, length>;
+    /**
+       @brief Return the stored length of a legacy-ordered link: only
+       SU(3) links (length 18) may be stored compressed
+       @param[in] recon The reconstruction type
+       @param[in] length The length of the full link matrix
+    */
+    constexpr int legacy_recon_length(QudaReconstructType recon, int length)
+    {
+      return (length == 18 && (recon == QUDA_RECONSTRUCT_12 || recon == QUDA_RECONSTRUCT_8)) ? recon : length;
+    }
+
+    /**
+       @brief Dispatch a legacy gauge order on the reconstruction of
+       the field, calling the functor with the matching accessor.
+       QDP- and MILC-ordered SU(3) fields may be stored with
+       reconstruct-12 or reconstruct-8, in which case the accessor
+       unpacks on load and packs on save.
+       @tparam Order The legacy order (QDPOrder or MILCOrder)
+       @param[in] u The gauge field
+       @param[in] gauge Optional pointer to the field
+       @param[in] ghost Optional pointer to the ghost zones
+       @param[in] f Functor called with the accessor instance
+    */
+    template <template <typename, int, int> class Order, typename Float, int length, typename F>
+    void instantiateLegacyRecon(const GaugeField &u, Float *gauge, Float **ghost, F &&f)
+    {
+      if constexpr (length == 18) {
+        if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+#if QUDA_RECONSTRUCT & 2
+          f(Order<Float, length, 12>(u, gauge, ghost));
+#else
+          errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-12", QUDA_RECONSTRUCT);
+#endif
+          return;
+        } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+#if QUDA_RECONSTRUCT & 1
+          f(Order<Float, length, 8>(u, gauge, ghost));
+#else
+          errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-8", QUDA_RECONSTRUCT);
+#endif
+          return;
+        }
+      }
+      f(Order<Float, length, length>(u, gauge, ghost));
+    }
+
+    template <typename Float, int length, int reconLen = length>
+    struct QDPOrder : public LegacyOrder<Float, length, reconLen> {
+      using Accessor = QDPOrder<Float, length, reconLen>;
       using real = typename mapper<Float>::type;
       using complex = complex<real>;
       Float *gauge[QUDA_MAX_DIM];
       const unsigned int volumeCB;
       QDPOrder(const GaugeField &u, Float *gauge_ = 0, Float **ghost_ = 0) :
-        LegacyOrder<Float, length>(u, ghost_), volumeCB(u.VolumeCB())
+        LegacyOrder<Float, length, reconLen>(u, ghost_), volumeCB(u.VolumeCB())
       {
         for (int i = 0; i < 4; i++) gauge[i] = gauge_ ? ((Float **)gauge_)[i] : u.data<Float *>(i);
       }
 
-        __device__ __host__ inline void load(complex v[length / 2], int x, int dir, int parity, real = 1.0) const
-        {
-          auto in = &gauge[dir][(parity * volumeCB + x) * length];
-          block_load<complex, length / 2>(v, reinterpret_cast<complex *>(in));
+      __device__ __host__ inline void load(complex v[length / 2], int x, int dir, int parity, real = 1.0) const
+      {
+        this->unpack(v, &gauge[dir][(parity * volumeCB + x) * reconLen], x, dir);
       }
 
       __device__ __host__ inline void save(const complex v[length / 2], int x, int dir, int parity) const
       {
-        auto out = &gauge[dir][(parity * volumeCB + x) * length];
-        block_store<complex, length / 2>(reinterpret_cast<complex *>(out), v);
+        this->pack(&gauge[dir][(parity * volumeCB + x) * reconLen], v);
       }
 
       /**
@@ -1945,15 +2049,16 @@ namespace quda {
      struct to define MILC ordered gauge fields:
      [parity][dim][volumecb][row][col]
   */
-  template <typename Float, int length> struct MILCOrder : public LegacyOrder<Float,length> {
-    using Accessor = MILCOrder<Float, length>;
+  template <typename Float, int length, int reconLen = length>
+  struct MILCOrder : public LegacyOrder<Float, length, reconLen> {
+    using Accessor = MILCOrder<Float, length, reconLen>;
     using real = typename mapper<Float>::type;
     using complex = complex<real>;
     Float *gauge;
     const unsigned int volumeCB;
     const int geometry;
     MILCOrder(const GaugeField &u, Float *gauge_ = 0, Float **ghost_ = 0) :
-      LegacyOrder<Float, length>(u, ghost_),
+      LegacyOrder<Float, length, reconLen>(u, ghost_),
       gauge(gauge_ ? gauge_ : u.data<Float *>()),
       volumeCB(u.VolumeCB()),
       geometry(u.Geometry())
@@ -1963,14 +2068,12 @@ namespace quda {
 
     __device__ __host__ inline void load(complex v[length / 2], int x, int dir, int parity, real = 1.0) const
     {
-      auto in = &gauge[((parity * volumeCB + x) * geometry + dir) * length];
-      block_load<complex, length / 2>(v, reinterpret_cast<complex *>(in));
+      this->unpack(v, &gauge[((parity * volumeCB + x) * geometry + dir) * reconLen], x, dir);
     }
 
     __device__ __host__ inline void save(const complex v[length / 2], int x, int dir, int parity) const
     {
-      auto out = &gauge[((parity * volumeCB + x) * geometry + dir) * length];
-      block_store<complex, length / 2>(reinterpret_cast<complex *>(out), v);
+      this->pack(&gauge[((parity * volumeCB + x) * geometry + dir) * reconLen], v);
     }
 
     /**
@@ -2471,13 +2574,13 @@ namespace quda {
   template <typename T, QudaReconstructType recon, int N, QudaStaggeredPhase stag, bool huge_alloc,
             QudaGhostExchange ghostExchange, bool use_inphase>
   struct gauge_mapper<T, recon, N, stag, huge_alloc, ghostExchange, use_inphase, QUDA_MILC_GAUGE_ORDER> {
-    typedef gauge::MILCOrder<T, N> type;
+    typedef gauge::MILCOrder<T, N, gauge::legacy_recon_length(recon, N)> type;
   };
 
   template <typename T, QudaReconstructType recon, int N, QudaStaggeredPhase stag, bool huge_alloc,
             QudaGhostExchange ghostExchange, bool use_inphase>
   struct gauge_mapper<T, recon, N, stag, huge_alloc, ghostExchange, use_inphase, QUDA_QDP_GAUGE_ORDER> {
-    typedef gauge::QDPOrder<T, N> type;
+    typedef gauge::QDPOrder<T, N, gauge::legacy_recon_length(recon, N)> type;
   };
 
   template<typename T, QudaGaugeFieldOrder order, int Nc> struct gauge_order_mapper { };
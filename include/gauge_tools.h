@@ -131,6 +131,23 @@ namespace quda
   */
   void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, double epsilon, QudaGaugeSmearType smear_type);
 
+  /**
+     @brief Apply the Wilson Flow steps W1, W2, Vt as WFlowStep, and
+     additionally form the embedded second-order solution from the
+     first two stages.  The distance between the third- and
+     second-order solutions is the local error estimate used for step
+     size control, which is O(epsilon^3).
+     @param[out] out Output smeared field
+     @param[in] temp Temp space
+     @param[in] in Input gauge field (overwritten with W2)
+     @param[out] emb Embedded second-order solution
+     @param[in] epsilon Step size
+     @param[in] smear_type Wilson (1x1) or Symanzik improved (2x1) staples, else error
+     @return Maximum over links of |out - emb| / nColor
+  */
+  double WFlowStepEmbedded(GaugeField &out, GaugeField &temp, GaugeField &in, GaugeField &emb, double epsilon,
+                           QudaGaugeSmearType smear_type);
+
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
    * @param[in,out] data, quda gauge field
@@ -190,6 +207,23 @@ namespace quda
   */
   void computeQChargeDensity(double energy[3], double &qcharge, void *qdensity, const GaugeField &Fmunu);
 
+  /**
+     @brief Compute the plaquette, field energy and topological charge
+     (and optionally the charge density) in a single pass over the
+     gauge field, without constructing the Fmunu tensor.  The field
+     may be resident on the device in native order, or on the host in
+     QDP order in which case the computation runs on the host.
+     @param[in] u The extended gauge field (at least one site of
+     halo in each partitioned dimension)
+     @param[out] plaq The total, spatial and temporal plaquette
+     @param[out] energy The total, spatial, and temporal field energy
+     @param[out] qcharge The total topological charge
+     @param[out] qdensity The topological charge at each lattice
+     site, in the location of u and precision of u (ignored if nullptr)
+   */
+  void computeFusedGaugeObservables(const GaugeField &u, double plaq[3], double energy[3], double &qcharge,
+                                    void *qdensity = nullptr);
+
   /**
    * @brief Compute the trace of the Polyakov loop in a given dimension
    * @param[out] ploop The real and imaginary parts of the Polyakov loop
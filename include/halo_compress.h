@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <comm_quda.h>
+
+/**
+   @file halo_compress.h
+
+   @brief Lossless compression of host-staged halo messages, enabled
+   by setting QUDA_ENABLE_HALO_COMPRESSION=1.
+
+   Each face is encoded by splitting its words into byte planes (a
+   byte shuffle, with the word size given by the ghost precision), and
+   then storing each plane with the fewest bits per byte needed to
+   index the distinct byte values that occur in the plane.  For
+   floating-point halos the sign and exponent planes take only a
+   handful of values, and so compress well, while planes that do not
+   compress are stored verbatim.  A small header precedes the payload,
+   so the receiver decodes whatever the sender chose.
+
+   Whether a given face is compressed is decided by a bandwidth model:
+   the face is compressed when the measured encode throughput and
+   compression ratio predict that encoding plus sending the smaller
+   message is faster than sending the face as is.  The network
+   bandwidth is fitted from the observed completion times of the
+   sends, unless fixed by QUDA_HALO_COMPRESSION_BANDWIDTH (GB/s).
+   Faces that are not compressed are periodically re-probed to keep
+   the model current.
+
+   With encoded / raw size r, encode rate R and link bandwidth B,
+   compression pays off when R > 2 B / (1 - r).  Generic floating
+   point halos give r of about 0.9, so this requires an encode rate
+   of twenty times the link bandwidth, i.e., only slow links.  Halos
+   with many repeated values, such as diluted sources, compress far
+   better, and can pay off on fast links too.
+
+   Compressed messages are staged through dedicated host buffers.  The
+   receives are persistent and posted for the uncompressed size.  The
+   encoded sends are padded to one of a fixed set of sizes, each with
+   its own persistent handle that is declared on first use.  GPU
+   Direct RDMA and peer-to-peer exchanges are never compressed.
+ */
+
+namespace quda
+{
+
+  namespace halo_compress
+  {
+
+    /**
+       @return Whether halo compression is enabled
+     */
+    bool enabled();
+
+    /**
+       @brief Encode a buffer
+       @param[out] dst Output buffer, of at least max_bytes(bytes) bytes
+       @param[in] src Input buffer
+       @param[in] bytes Size of the input buffer
+       @param[in] word Word size used for the byte shuffle
+       @param[in] compress Whether to compress, else the input is
+       stored verbatim behind the header
+       @return The size of the encoded buffer
+     */
+    size_t encode(void *dst, const void *src, size_t bytes, int word, bool compress);
+
+    /**
+       @brief Decode a buffer produced by encode
+       @param[out] dst Output buffer
+       @param[in] src Encoded buffer
+       @param[in] bytes Size of the output buffer, which must match
+       the size that was encoded
+     */
+    void decode(void *dst, const void *src, size_t bytes);
+
+    /**
+       @return The largest encoded size of a buffer of the given size
+     */
+    size_t max_bytes(size_t bytes);
+
+    /**
+       @brief Post the compressed receive of a face
+       @param[in] b Buffer index
+       @param[in] dim Dimension
+       @param[in] dir Direction we receive from (0 backwards, 1 forwards)
+       @param[in] bytes Uncompressed size of the face
+     */
+    void recv_start(int b, int dim, int dir, size_t bytes);
+
+    /**
+       @brief Encode and send a face, compressing it if the bandwidth
+       model predicts this is faster
+       @param[in] b Buffer index
+       @param[in] dim Dimension
+       @param[in] dir Direction we send to (0 backwards, 1 forwards)
+       @param[in] src Host buffer holding the face
+       @param[in] bytes Size of the face
+       @param[in] word Word size of the face data
+     */
+    void send_start(int b, int dim, int dir, const void *src, size_t bytes, int word);
+
+    /**
+       @return Whether the send of a face has completed
+     */
+    int send_query(int b, int dim, int dir);
+
+    /**
+       @brief Wait for the send of a face to complete
+     */
+    void send_wait(int b, int dim, int dir);
+
+    /**
+       @brief Query the receive of a face, and decode it into dst
+       upon completion
+       @param[out] dst Host buffer for the decoded face
+       @return Whether the receive has completed
+     */
+    int recv_query(int b, int dim, int dir, void *dst);
+
+    /**
+       @brief Wait for the receive of a face and decode it into dst
+       @param[out] dst Host buffer for the decoded face
+     */
+    void recv_wait(int b, int dim, int dir, void *dst);
+
+    /**
+       @brief Free the staging buffers and message handles.  This must
+       be called whenever the communicator changes.
+     */
+    void destroy();
+
+  } // namespace halo_compress
+
+} // namespace quda
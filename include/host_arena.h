@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+   @file host_arena.h
+
+   @brief Arena allocator for host memory, used behind safe_malloc()
+   when the environment variable QUDA_ENABLE_HOST_ARENA=1 is set.
+
+   A single range of virtual address space is reserved at start up,
+   backed by transparent 2 MiB huge pages, and split into one region
+   per NUMA node and per power-of-two size class (64 bytes upwards).
+   Allocations are served from the calling thread's NUMA node, from a
+   lock-free free list of that size class if possible, else by
+   atomically carving a new block from the class region.  Blocks are
+   aligned to their size class (64 bytes minimum, 2 MiB for large
+   blocks), and newly carved large blocks are first touched in
+   parallel by the OpenMP threads with a static schedule, such that
+   the pages are placed on the NUMA nodes of the threads that will
+   subsequently use them.  Freed blocks are returned to their free
+   list and are never released to the operating system, so repeated
+   allocation and release of fields incurs no system calls.  Unlike
+   the regular allocations, arena allocations are not individually
+   tracked.
+ */
+
+namespace quda
+{
+
+  namespace host_arena
+  {
+
+    /** Size of the huge pages backing large host allocations */
+    constexpr size_t huge_page_size = 2ul << 20;
+
+    /**
+       @return Whether the arena is enabled: this is set by
+       QUDA_ENABLE_HOST_ARENA=1 and requires the initial address-space
+       reservation to succeed
+     */
+    bool enabled();
+
+    /**
+       @brief Allocate a block from the arena
+       @param[in] bytes The size of the allocation
+       @return Pointer to the block, or nullptr if the request cannot
+       be served by the arena
+     */
+    void *allocate(size_t bytes);
+
+    /**
+       @brief Return a block to the arena
+       @param[in] ptr Pointer previously returned by allocate
+     */
+    void deallocate(void *ptr);
+
+    /**
+       @param[in] ptr Host pointer
+       @return Whether ptr was allocated by the arena.  This is an
+       address range check and is safe to call on any pointer.
+     */
+    bool owns(const void *ptr);
+
+    /**
+       @return The number of bytes of arena blocks presently in use
+     */
+    size_t allocated();
+
+    /**
+       @return The peak number of bytes of arena blocks in use
+     */
+    size_t allocated_peak();
+
+    /**
+       @brief Advise the kernel to back a host allocation with
+       transparent huge pages.  This is a no-op for allocations
+       smaller than a huge page.
+       @param[in] ptr Pointer to the allocation
+       @param[in] bytes The size of the allocation
+     */
+    void advise_huge_pages(void *ptr, size_t bytes);
+
+  } // namespace host_arena
+
+} // namespace quda
@@ -14,6 +14,12 @@
 
 namespace quda {
 
+  /**
+     @brief Returns if a solver is CA or not
+     @return true if CA, false otherwise
+  */
+  bool is_ca_solver(QudaInverterType type);
+
   /**
      SolverParam is the meta data used to define linear solvers.
    */
@@ -219,6 +225,12 @@ namespace quda {
     /** Maximum eigenvalue for Chebyshev CA basis in a preconditioner */
     double ca_lambda_max_precondition; // -1 -> power iter generate
 
+    /** Whether to estimate the Chebyshev bounds with Arnoldi and adapt the CA basis size */
+    bool ca_adaptive;
+
+    /** Whether to estimate the Chebyshev bounds with Arnoldi in a preconditioner */
+    bool ca_adaptive_precondition;
+
     /** Whether to use additive or multiplicative Schwarz preconditioning */
     QudaSchwarzType schwarz_type;
 
@@ -325,6 +337,8 @@ namespace quda {
       ca_basis_precondition(param.ca_basis_precondition),
       ca_lambda_min_precondition(param.ca_lambda_min_precondition),
       ca_lambda_max_precondition(param.ca_lambda_max_precondition),
+      ca_adaptive(param.ca_adaptive == QUDA_BOOLEAN_TRUE),
+      ca_adaptive_precondition(param.ca_adaptive_precondition == QUDA_BOOLEAN_TRUE),
       schwarz_type(param.schwarz_type),
       accelerator_type_precondition(param.accelerator_type_precondition),
       precision_ritz(param.cuda_prec_ritz),
@@ -412,6 +426,8 @@ namespace quda {
       ca_basis_precondition(param.ca_basis_precondition),
       ca_lambda_min_precondition(param.ca_lambda_min_precondition),
       ca_lambda_max_precondition(param.ca_lambda_max_precondition),
+      ca_adaptive(param.ca_adaptive),
+      ca_adaptive_precondition(param.ca_adaptive_precondition),
       schwarz_type(param.schwarz_type),
       accelerator_type_precondition(param.accelerator_type_precondition),
       precision_ritz(param.precision_ritz),
@@ -476,6 +492,9 @@ namespace quda {
       param.ca_lambda_min_precondition = ca_lambda_min_precondition;
       param.ca_lambda_max_precondition = ca_lambda_max_precondition;
 
+      // the basis size may have been reduced by the adaptive CA solver
+      if (ca_adaptive && is_ca_solver(inv_type)) param.gcrNkrylov = Nkrylov;
+
       if (deflate) *static_cast<QudaEigParam *>(param.eig_param) = eig_param;
     }
 
@@ -486,6 +505,8 @@ namespace quda {
 
   };
 
+  class DeflationStore;
+
   class Solver {
 
   protected:
@@ -503,6 +524,7 @@ namespace quda {
     bool recompute_evals;   /** If true, instruct the solver to recompute evals from an existing deflation space. */
     std::vector<ColorSpinorField> evecs; /** Holds the eigenvectors. */
     std::vector<Complex> evals;          /** Holds the eigenvalues. */
+    std::shared_ptr<DeflationStore> defl_store; /** Compressed deflation space, if eig_param.deflation_prec is set */
 
     bool mixed() { return param.precision != param.precision_sloppy; }
 
@@ -698,6 +720,42 @@ namespace quda {
     */
     void destroyDeflationSpace();
 
+    /**
+       @brief Deflate a set of vectors with the deflation space.  If
+       eig_param.deflation_prec is lower than the precision of the
+       eigenvectors, they are moved into a compressed DeflationStore
+       on first use, and the deflation uses its projected matrix.
+       @param[in,out] sol The resulting deflated vector set
+       @param[in] src The source vector set we are deflating
+       @param[in] accumulate Whether to preserve the sol vector content prior to accumulating
+    */
+    void deflate(cvector_ref<ColorSpinorField> &sol, cvector_ref<const ColorSpinorField> &src, bool accumulate = false);
+
+    /**
+       @brief Recompute the eigenvalues of the deflation space, or
+       the projected matrix of a compressed space, after the operator
+       has changed
+    */
+    void recomputeEvals();
+
+    /**
+       @brief Deflate a set of vectors with the left and right
+       singular vectors of the deflation space.  A compressed
+       DeflationStore only holds a Hermitian eigenspace, so this is an
+       error if the space was restored in compressed form.
+       @param[in,out] sol The resulting deflated vector set
+       @param[in] src The source vector set we are deflating
+       @param[in] accumulate Whether to preserve the sol vector content prior to accumulating
+    */
+    void deflateSVD(cvector_ref<ColorSpinorField> &sol, cvector_ref<const ColorSpinorField> &src, bool accumulate = false);
+
+    /**
+       @brief Recompute the singular values and vectors of the
+       deflation space after the operator has changed.  As with
+       deflateSVD, this is an error for a compressed space.
+    */
+    void recomputeSVD();
+
     /**
        @brief Extends the deflation space to twice its size for SVD deflation
     */
@@ -710,8 +768,10 @@ namespace quda {
        space transferred to the solver.
        @param[in,out] defl_space the deflation space we wish to
        transfer to the solver.
+       @param[in,out] store the compressed deflation space we wish to
+       transfer to the solver, if any
     */
-    void injectDeflationSpace(std::vector<ColorSpinorField> &defl_space);
+    void injectDeflationSpace(std::vector<ColorSpinorField> &defl_space, std::shared_ptr<DeflationStore> &store);
 
     /**
        @brief Extracts the deflation space from the solver to the
@@ -720,13 +780,15 @@ namespace quda {
        responsibility for the space transferred to the argument.
        @param[in,out] defl_space the extracted deflation space.  On
        input, this vector should have zero size.
+       @param[in,out] store the extracted compressed deflation space,
+       which is transferred as is, rather than expanded into defl_space
     */
-    void extractDeflationSpace(std::vector<ColorSpinorField> &defl_space);
+    void extractDeflationSpace(std::vector<ColorSpinorField> &defl_space, std::shared_ptr<DeflationStore> &store);
 
     /**
        @brief Returns the size of deflation space
     */
-    int deflationSpaceSize() const { return (int)evecs.size(); };
+    int deflationSpaceSize() const;
 
     /**
        @brief Sets the deflation compute boolean
@@ -773,6 +835,38 @@ namespace quda {
     static void computeCAKrylovSpace(const DiracMatrix &diracm, std::vector<ColorSpinorField> &Ap,
                                      std::vector<ColorSpinorField> &p, int n_krylov, QudaCABasis basis, double m_map,
                                      double b_map, Args &&...args);
+
+    /**
+       @brief Estimate the extremal eigenvalues of a Dirac matrix using
+       the Arnoldi process with full reorthogonalization, which is
+       equivalent to Lanczos for a Hermitian operator.  Unlike power
+       iterations, this estimates both ends of the spectrum from a
+       single short Krylov space.
+       The number of steps is bounded by the size of the workspace.
+       @param[in] diracm Dirac matrix whose spectrum we are estimating
+       @param[in] start Starting vector for the Krylov space (preserved)
+       @param[in,out] v Workspace holding the Krylov basis, which must not alias start
+       @param[out] lambda_min Lower estimate of the smallest real part of the spectrum
+       @param[out] lambda_max Largest real part of the Ritz values
+       @param[in] args Parameter pack of ColorSpinorFields used as temporary passed to Dirac
+       @return Whether the estimate succeeded (fails for a zero starting vector)
+    */
+    template <typename... Args>
+    static bool estimateSpectrumBounds(const DiracMatrix &diracm, const ColorSpinorField &start,
+                                       cvector_ref<ColorSpinorField> &v, double &lambda_min, double &lambda_max,
+                                       Args &&...args);
+
+    /**
+       @brief Return the largest CA basis size s <= s_max for which
+       the basis is numerically stable, defined as the condition
+       number of the diagonally scaled Gram matrix of the first s
+       basis vectors not exceeding cond_max
+       @param[in] v The basis vectors
+       @param[in] s_max The maximum basis size
+       @param[in] cond_max The maximum acceptable condition number
+       @return The selected basis size
+    */
+    static int selectCABasisSize(const std::vector<ColorSpinorField> &v, int s_max, double cond_max);
   };
 
   /**
@@ -1277,6 +1371,7 @@ namespace quda {
     bool init = false;
 
     bool lambda_init;
+    bool basis_size_init = false; // whether the adaptive basis size has been selected
     QudaCABasis basis;
 
     std::vector<double> Q_AQandg; // Fused inner product matrix
@@ -1417,6 +1512,7 @@ namespace quda {
     bool init = false;
 
     bool lambda_init;  // whether or not lambda_max has been initialized
+    bool basis_size_init = false; // whether the adaptive basis size has been selected
     QudaCABasis basis; // CA basis
 
     std::vector<Complex> alpha; // Solution coefficient vectors
@@ -1601,6 +1697,71 @@ public:
     }
   };
 
+  /**
+   * @brief Multi-Shift Conjugate Gradient Solver for several
+   * independent sources, e.g., the pseudofermions of an RHMC force
+   * calculation, sharing the same set of shifts.  The sources are
+   * advanced in lock step, with the unshifted search directions of
+   * all active sources (and any reliable updates that trigger on the
+   * same iteration) applied with a single multi-RHS operator
+   * application, so that the gauge field is loaded once per
+   * iteration for the whole batch.  Sources leave the batch as they
+   * converge.
+   */
+  class MultiShiftMultiSrcCG : public MultiShiftSolver
+  {
+
+    int num_offset;
+    std::vector<std::vector<double>> true_res;    /** True residual per source and shift */
+    std::vector<std::vector<double>> iter_res;    /** Iterated residual per source and shift */
+    std::vector<std::vector<double>> true_res_hq; /** True heavy-quark residual per source and shift */
+
+  public:
+    MultiShiftMultiSrcCG(const DiracMatrix &mat, const DiracMatrix &matSloppy, SolverParam &param,
+                         TimeProfile &profile);
+
+    /**
+     * @brief Run multi-shift on all sources and return the Krylov space
+     * of each at the end of the solve in p and r2_old_array.  On
+     * return param holds the worst residual over the sources for
+     * each shift, with the per-source values available through
+     * updateInvertParam.
+     *
+     * @param x Solutions for all the shifts of each source.
+     * @param b The sources.
+     * @param p To hold the search directions of each source. Note this will be resized as necessary.
+     * @param r2_old_array The last values of r2_old for each source and shift. Note this will be resized as necessary.
+     */
+    void operator()(std::vector<std::vector<ColorSpinorField>> &x, std::vector<ColorSpinorField> &b,
+                    std::vector<std::vector<ColorSpinorField>> &p, std::vector<std::vector<double>> &r2_old_array);
+
+    /**
+     * @brief Run multi-shift on a single source.
+     *
+     * @param out std::vector of pointer to solutions for all the shifts.
+     * @param in right-hand side.
+     */
+    void operator()(std::vector<ColorSpinorField> &out, ColorSpinorField &in)
+    {
+      std::vector<std::vector<ColorSpinorField>> x(1);
+      for (auto &xi : out) x[0].push_back(xi.create_alias());
+      std::vector<ColorSpinorField> b;
+      b.push_back(in.create_alias());
+      std::vector<std::vector<ColorSpinorField>> p;
+      std::vector<std::vector<double>> r2_old;
+
+      (*this)(x, b, p, r2_old);
+    }
+
+    /**
+     * @brief Copy the per-shift residuals attained by a given source
+     * in the last solve into the invert param
+     * @param[out] inv_param The invert param to update
+     * @param[in] src The source index
+     */
+    void updateInvertParam(QudaInvertParam &inv_param, int src) const;
+  };
+
 
   /**
      @brief This computes the optimum guess for the system Ax=b in the L2
@@ -1764,12 +1925,7 @@ public:
    bool svd;                            /** Whether this space is for an SVD deflaton */
    std::vector<ColorSpinorField> evecs; /** Container for the eigenvectors */
    std::vector<Complex> evals;          /** The eigenvalues */
+   std::shared_ptr<DeflationStore> store; /** The compressed deflation space, used in place of evecs and evals */
  };
 
- /**
-   @brief Returns if a solver is CA or not
-   @return true if CA, false otherwise
- */
- bool is_ca_solver(QudaInverterType type);
-
 } // namespace quda
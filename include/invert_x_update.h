@@ -52,6 +52,33 @@ namespace quda
       blas::axpy<double>({_alphas.begin(), _alphas.begin() + _j + 1}, {_ps.begin(), _ps.begin() + _j + 1}, x);
     }
 
+    /**
+       @brief use the vectors currently stored, together with the
+       partial solution x, to update the solution y in a single pass,
+       y += x + sum_i alpha[i] * p[i], as done at a reliable update.
+       If x does not have the precision of the p-vectors, or if y
+       has a different precision and the fields do not support
+       mixed-precision multi-blas (which requires site unrolling),
+       the vectors are first accumulated into x.
+       @param y the output field to add to
+       @param x the partial solution
+    */
+    void accumulate_x(ColorSpinorField &y, ColorSpinorField &x)
+    {
+      if (x.Precision() != _ps[0].Precision()
+          || (y.Precision() != x.Precision() && (x.Ncolor() != 3 || x.Nspin() == 2))) {
+        accumulate_x(x);
+        blas::xpy(x, y);
+        return;
+      }
+
+      std::vector<double> alphas {_alphas.begin(), _alphas.begin() + _j + 1};
+      vector_ref<const ColorSpinorField> ps {_ps.begin(), _ps.begin() + _j + 1};
+      alphas.push_back(1.0);
+      ps.push_back(x);
+      blas::axpy<double>(alphas, ps, y);
+    }
+
     /**
        @brief Get the current vector
     */
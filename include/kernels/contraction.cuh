@@ -5,6 +5,8 @@
 #include <quda_matrix.h>
 #include <matrix_field.h>
 #include <kernel.h>
+#include <array.h>
+#include <reduction_kernel.h>
 
 namespace quda
 {
@@ -64,6 +66,160 @@ namespace quda
     }
   };
 
+  /**
+     @brief Project the spin elementals <x_mu | y_nu> onto the sixteen
+     Degrand-Rossi gamma matrix insertions
+     @param[out] A The sixteen gamma projections, G_idx = 4*rho + tau
+     @param[in] spin_elem The color-contracted spin elementals
+  */
+  template <typename real>
+  __device__ __host__ inline void degrandRossiProject(complex<real> A[16], const complex<real> spin_elem[4][4])
+  {
+    complex<real> I(0.0, 1.0);
+    complex<real> result_local(0.0, 0.0);
+
+    // Spin contract: <\phi(x)_{\mu} \Gamma_{mu,nu}^{rho,tau} \phi(y)_{\nu}>
+    // The rho index runs slowest.
+    // Layout is defined in enum_quda.h: G_idx = 4*rho + tau
+    // DMH: Hardcoded to Degrand-Rossi. Need a template on Gamma basis.
+
+    int G_idx = 0;
+
+    // SCALAR
+    // G_idx = 0: I
+    result_local = 0.0;
+    result_local += spin_elem[0][0];
+    result_local += spin_elem[1][1];
+    result_local += spin_elem[2][2];
+    result_local += spin_elem[3][3];
+    A[G_idx++] = result_local;
+
+    // VECTORS
+    // G_idx = 1: \gamma_1
+    result_local = 0.0;
+    result_local += I * spin_elem[0][3];
+    result_local += I * spin_elem[1][2];
+    result_local -= I * spin_elem[2][1];
+    result_local -= I * spin_elem[3][0];
+    A[G_idx++] = result_local;
+
+    // G_idx = 2: \gamma_2
+    result_local = 0.0;
+    result_local -= spin_elem[0][3];
+    result_local += spin_elem[1][2];
+    result_local += spin_elem[2][1];
+    result_local -= spin_elem[3][0];
+    A[G_idx++] = result_local;
+
+    // G_idx = 3: \gamma_3
+    result_local = 0.0;
+    result_local += I * spin_elem[0][2];
+    result_local -= I * spin_elem[1][3];
+    result_local -= I * spin_elem[2][0];
+    result_local += I * spin_elem[3][1];
+    A[G_idx++] = result_local;
+
+    // G_idx = 4: \gamma_4
+    result_local = 0.0;
+    result_local += spin_elem[0][2];
+    result_local += spin_elem[1][3];
+    result_local += spin_elem[2][0];
+    result_local += spin_elem[3][1];
+    A[G_idx++] = result_local;
+
+    // PSEUDO-SCALAR
+    // G_idx = 5: \gamma_5
+    result_local = 0.0;
+    result_local += spin_elem[0][0];
+    result_local += spin_elem[1][1];
+    result_local -= spin_elem[2][2];
+    result_local -= spin_elem[3][3];
+    A[G_idx++] = result_local;
+
+    // PSEUDO-VECTORS
+    // DMH: Careful here... we may wish to use  \gamma_1,2,3,4\gamma_5 for pseudovectors
+    // G_idx = 6: \gamma_5\gamma_1
+    result_local = 0.0;
+    result_local += I * spin_elem[0][3];
+    result_local += I * spin_elem[1][2];
+    result_local += I * spin_elem[2][1];
+    result_local += I * spin_elem[3][0];
+    A[G_idx++] = result_local;
+
+    // G_idx = 7: \gamma_5\gamma_2
+    result_local = 0.0;
+    result_local -= spin_elem[0][3];
+    result_local += spin_elem[1][2];
+    result_local -= spin_elem[2][1];
+    result_local += spin_elem[3][0];
+    A[G_idx++] = result_local;
+
+    // G_idx = 8: \gamma_5\gamma_3
+    result_local = 0.0;
+    result_local += I * spin_elem[0][2];
+    result_local -= I * spin_elem[1][3];
+    result_local += I * spin_elem[2][0];
+    result_local -= I * spin_elem[3][1];
+    A[G_idx++] = result_local;
+
+    // G_idx = 9: \gamma_5\gamma_4
+    result_local = 0.0;
+    result_local += spin_elem[0][2];
+    result_local += spin_elem[1][3];
+    result_local -= spin_elem[2][0];
+    result_local -= spin_elem[3][1];
+    A[G_idx++] = result_local;
+
+    // TENSORS
+    // G_idx = 10: (i/2) * [\gamma_1, \gamma_2]
+    result_local = 0.0;
+    result_local += spin_elem[0][0];
+    result_local -= spin_elem[1][1];
+    result_local += spin_elem[2][2];
+    result_local -= spin_elem[3][3];
+    A[G_idx++] = result_local;
+
+    // G_idx = 11: (i/2) * [\gamma_1, \gamma_3]
+    result_local = 0.0;
+    result_local -= I * spin_elem[0][2];
+    result_local -= I * spin_elem[1][3];
+    result_local += I * spin_elem[2][0];
+    result_local += I * spin_elem[3][1];
+    A[G_idx++] = result_local;
+
+    // G_idx = 12: (i/2) * [\gamma_1, \gamma_4]
+    result_local = 0.0;
+    result_local -= spin_elem[0][1];
+    result_local -= spin_elem[1][0];
+    result_local += spin_elem[2][3];
+    result_local += spin_elem[3][2];
+    A[G_idx++] = result_local;
+
+    // G_idx = 13: (i/2) * [\gamma_2, \gamma_3]
+    result_local = 0.0;
+    result_local += spin_elem[0][1];
+    result_local += spin_elem[1][0];
+    result_local += spin_elem[2][3];
+    result_local += spin_elem[3][2];
+    A[G_idx++] = result_local;
+
+    // G_idx = 14: (i/2) * [\gamma_2, \gamma_4]
+    result_local = 0.0;
+    result_local -= I * spin_elem[0][1];
+    result_local += I * spin_elem[1][0];
+    result_local += I * spin_elem[2][3];
+    result_local -= I * spin_elem[3][2];
+    A[G_idx++] = result_local;
+
+    // G_idx = 15: (i/2) * [\gamma_3, \gamma_4]
+    result_local = 0.0;
+    result_local -= spin_elem[0][0];
+    result_local -= spin_elem[1][1];
+    result_local += spin_elem[2][2];
+    result_local += spin_elem[3][3];
+    A[G_idx++] = result_local;
+  }
+
   template <typename Arg> struct DegrandRossiContract {
     const Arg &arg;
     constexpr DegrandRossiContract(const Arg &arg) : arg(arg) {}
@@ -79,9 +235,7 @@ namespace quda
       Vector x = arg.x(x_cb, parity);
       Vector y = arg.y(x_cb, parity);
 
-      complex<real> I(0.0, 1.0);
       complex<real> spin_elem[nSpin][nSpin];
-      complex<real> result_local(0.0, 0.0);
 
       // Color contract: <\phi(x)_{\mu} | \phi(y)_{\nu}>
       // The Bra is conjugated
@@ -89,151 +243,132 @@ namespace quda
         for (int nu = 0; nu < nSpin; nu++) { spin_elem[mu][nu] = innerProduct(x, y, mu, nu); }
       }
 
-      Matrix<complex<real>, nSpin> A_;
-      auto A = A_.data;
-
-      // Spin contract: <\phi(x)_{\mu} \Gamma_{mu,nu}^{rho,tau} \phi(y)_{\nu}>
-      // The rho index runs slowest.
-      // Layout is defined in enum_quda.h: G_idx = 4*rho + tau
-      // DMH: Hardcoded to Degrand-Rossi. Need a template on Gamma basis.
-
-      int G_idx = 0;
-
-      // SCALAR
-      // G_idx = 0: I
-      result_local = 0.0;
-      result_local += spin_elem[0][0];
-      result_local += spin_elem[1][1];
-      result_local += spin_elem[2][2];
-      result_local += spin_elem[3][3];
-      A[G_idx++] = result_local;
-
-      // VECTORS
-      // G_idx = 1: \gamma_1
-      result_local = 0.0;
-      result_local += I * spin_elem[0][3];
-      result_local += I * spin_elem[1][2];
-      result_local -= I * spin_elem[2][1];
-      result_local -= I * spin_elem[3][0];
-      A[G_idx++] = result_local;
-
-      // G_idx = 2: \gamma_2
-      result_local = 0.0;
-      result_local -= spin_elem[0][3];
-      result_local += spin_elem[1][2];
-      result_local += spin_elem[2][1];
-      result_local -= spin_elem[3][0];
-      A[G_idx++] = result_local;
-
-      // G_idx = 3: \gamma_3
-      result_local = 0.0;
-      result_local += I * spin_elem[0][2];
-      result_local -= I * spin_elem[1][3];
-      result_local -= I * spin_elem[2][0];
-      result_local += I * spin_elem[3][1];
-      A[G_idx++] = result_local;
-
-      // G_idx = 4: \gamma_4
-      result_local = 0.0;
-      result_local += spin_elem[0][2];
-      result_local += spin_elem[1][3];
-      result_local += spin_elem[2][0];
-      result_local += spin_elem[3][1];
-      A[G_idx++] = result_local;
-
-      // PSEUDO-SCALAR
-      // G_idx = 5: \gamma_5
-      result_local = 0.0;
-      result_local += spin_elem[0][0];
-      result_local += spin_elem[1][1];
-      result_local -= spin_elem[2][2];
-      result_local -= spin_elem[3][3];
-      A[G_idx++] = result_local;
-
-      // PSEUDO-VECTORS
-      // DMH: Careful here... we may wish to use  \gamma_1,2,3,4\gamma_5 for pseudovectors
-      // G_idx = 6: \gamma_5\gamma_1
-      result_local = 0.0;
-      result_local += I * spin_elem[0][3];
-      result_local += I * spin_elem[1][2];
-      result_local += I * spin_elem[2][1];
-      result_local += I * spin_elem[3][0];
-      A[G_idx++] = result_local;
-
-      // G_idx = 7: \gamma_5\gamma_2
-      result_local = 0.0;
-      result_local -= spin_elem[0][3];
-      result_local += spin_elem[1][2];
-      result_local -= spin_elem[2][1];
-      result_local += spin_elem[3][0];
-      A[G_idx++] = result_local;
-
-      // G_idx = 8: \gamma_5\gamma_3
-      result_local = 0.0;
-      result_local += I * spin_elem[0][2];
-      result_local -= I * spin_elem[1][3];
-      result_local += I * spin_elem[2][0];
-      result_local -= I * spin_elem[3][1];
-      A[G_idx++] = result_local;
-
-      // G_idx = 9: \gamma_5\gamma_4
-      result_local = 0.0;
-      result_local += spin_elem[0][2];
-      result_local += spin_elem[1][3];
-      result_local -= spin_elem[2][0];
-      result_local -= spin_elem[3][1];
-      A[G_idx++] = result_local;
-
-      // TENSORS
-      // G_idx = 10: (i/2) * [\gamma_1, \gamma_2]
-      result_local = 0.0;
-      result_local += spin_elem[0][0];
-      result_local -= spin_elem[1][1];
-      result_local += spin_elem[2][2];
-      result_local -= spin_elem[3][3];
-      A[G_idx++] = result_local;
-
-      // G_idx = 11: (i/2) * [\gamma_1, \gamma_3]
-      result_local = 0.0;
-      result_local -= I * spin_elem[0][2];
-      result_local -= I * spin_elem[1][3];
-      result_local += I * spin_elem[2][0];
-      result_local += I * spin_elem[3][1];
-      A[G_idx++] = result_local;
-
-      // G_idx = 12: (i/2) * [\gamma_1, \gamma_4]
-      result_local = 0.0;
-      result_local -= spin_elem[0][1];
-      result_local -= spin_elem[1][0];
-      result_local += spin_elem[2][3];
-      result_local += spin_elem[3][2];
-      A[G_idx++] = result_local;
-
-      // G_idx = 13: (i/2) * [\gamma_2, \gamma_3]
-      result_local = 0.0;
-      result_local += spin_elem[0][1];
-      result_local += spin_elem[1][0];
-      result_local += spin_elem[2][3];
-      result_local += spin_elem[3][2];
-      A[G_idx++] = result_local;
-
-      // G_idx = 14: (i/2) * [\gamma_2, \gamma_4]
-      result_local = 0.0;
-      result_local -= I * spin_elem[0][1];
-      result_local += I * spin_elem[1][0];
-      result_local += I * spin_elem[2][3];
-      result_local -= I * spin_elem[3][2];
-      A[G_idx++] = result_local;
-
-      // G_idx = 15: (i/2) * [\gamma_3, \gamma_4]
-      result_local = 0.0;
-      result_local -= spin_elem[0][0];
-      result_local -= spin_elem[1][1];
-      result_local += spin_elem[2][2];
-      result_local += spin_elem[3][3];
-      A[G_idx++] = result_local;
-
-      arg.s.save(A_, x_cb, parity);
+      Matrix<complex<real>, nSpin> A;
+      degrandRossiProject(A.data, spin_elem);
+
+      arg.s.save(A, x_cb, parity);
     }
   };
+
+  /**
+     @brief Return the batch block size used for the momentum-projected
+     contraction multi-reduction
+  */
+  constexpr unsigned int max_n_batch_block_contract() { return 2; }
+
+  /**
+     @brief Maximum number of momenta that can be projected in a single
+     momentum-projected contraction
+  */
+  constexpr int max_contract_mom() { return 64; }
+
+  template <typename Float, int nColor_, QudaContractType cType_>
+  struct ContractionSummedArg : public ReduceArg<array<double, 32>> {
+    using reduce_t = array<double, 32>; // 16 complex spin components
+    using real = typename mapper<Float>::type;
+    static constexpr unsigned int max_n_batch_block = max_n_batch_block_contract();
+
+    static constexpr int nSpin = 4;
+    static constexpr int nColor = nColor_;
+    static constexpr QudaContractType cType = cType_;
+    static constexpr bool spin_project = true;
+    static constexpr bool spinor_direct_load = false; // false means texture load
+
+    using F = typename colorspinor_mapper<Float, nSpin, nColor, spin_project, spinor_direct_load>::type;
+
+    F x;
+    F y;
+
+    int X[4];      // local grid dimensions
+    int offset[3]; // global coordinates of the local origin
+    int L[3];      // global spatial dimensions
+    int Vs_cb;     // checkerboarded local spatial volume
+    int Lt;        // local temporal extent
+    int n_mom;
+    array<array<int, 3>, max_contract_mom()> mom;
+
+    ContractionSummedArg(const ColorSpinorField &x, const ColorSpinorField &y,
+                         const std::vector<array<int, 3>> &mom) :
+      ReduceArg<reduce_t>(dim3(x.VolumeCB() / x.X()[3], 2, mom.size() * x.X()[3]), mom.size() * x.X()[3]),
+      x(x),
+      y(y),
+      Vs_cb(x.VolumeCB() / x.X()[3]),
+      Lt(x.X()[3]),
+      n_mom(mom.size())
+    {
+      for (int dir = 0; dir < 4; dir++) X[dir] = x.X()[dir];
+      for (int dir = 0; dir < 3; dir++) {
+        offset[dir] = comm_coord(dir) * X[dir];
+        L[dir] = comm_dim(dir) * X[dir];
+      }
+      for (int i = 0; i < n_mom; i++) this->mom[i] = mom[i];
+    }
+  };
+
+  /**
+     Site-local contraction fused with the momentum phase and the
+     time-slice sum.  The batch index runs over (momentum, local time
+     slice) and the x thread index over the checkerboarded sites of a
+     single time slice, which are contiguous in x_cb.
+  */
+  template <typename Arg> struct ContractionSummed : plus<typename Arg::reduce_t> {
+    using reduce_t = typename Arg::reduce_t;
+    using plus<reduce_t>::operator();
+    static constexpr int reduce_block_dim = 2; // x_cb and parity are mapped to x
+    const Arg &arg;
+    constexpr ContractionSummed(const Arg &arg) : arg(arg) { }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline reduce_t operator()(reduce_t &value, int s_cb, int parity, int batch)
+    {
+      constexpr int nSpin = Arg::nSpin;
+      using real = typename Arg::real;
+      using Vector = ColorSpinor<real, Arg::nColor, nSpin>;
+
+      const int m = batch / arg.Lt;
+      const int t = batch % arg.Lt;
+      const int x_cb = t * arg.Vs_cb + s_cb;
+
+      int x[4];
+      getCoords(x, x_cb, arg.X, parity);
+
+      Vector xs = arg.x(x_cb, parity);
+      Vector ys = arg.y(x_cb, parity);
+
+      complex<real> spin_elem[nSpin][nSpin];
+#pragma unroll
+      for (int mu = 0; mu < nSpin; mu++) {
+#pragma unroll
+        for (int nu = 0; nu < nSpin; nu++) { spin_elem[mu][nu] = innerProduct(xs, ys, mu, nu); }
+      }
+
+      complex<real> A[nSpin * nSpin];
+      if constexpr (Arg::cType == QUDA_CONTRACT_TYPE_DR) {
+        degrandRossiProject(A, spin_elem);
+      } else {
+#pragma unroll
+        for (int mu = 0; mu < nSpin; mu++)
+#pragma unroll
+          for (int nu = 0; nu < nSpin; nu++) A[mu * nSpin + nu] = spin_elem[mu][nu];
+      }
+
+      // phase exp(-i p.x) with p_i = 2 pi n_i / L_i
+      double arg_pi = 0.0;
+#pragma unroll
+      for (int d = 0; d < 3; d++)
+        arg_pi -= 2.0 * arg.mom[m][d] * static_cast<double>(x[d] + arg.offset[d]) / arg.L[d];
+      double s, c;
+      quda::sincospi(arg_pi, &s, &c);
+
+      reduce_t sum;
+#pragma unroll
+      for (int i = 0; i < nSpin * nSpin; i++) {
+        sum[2 * i + 0] = c * A[i].real() - s * A[i].imag();
+        sum[2 * i + 1] = c * A[i].imag() + s * A[i].real();
+      }
+
+      return operator()(sum, value);
+    }
+  };
+
 } // namespace quda
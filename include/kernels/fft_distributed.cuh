@@ -0,0 +1,90 @@
+#pragma once
+
+#include <complex_quda.h>
+#include <fast_intdiv.h>
+#include <kernel.h>
+
+namespace quda
+{
+
+  /**
+     The transposes used by the distributed FFT.  For a transform along
+     dimension d, the local lexicographic (x fastest) array is first
+     packed such that d runs fastest, with the remaining three local
+     coordinates flattened into a single index r:
+
+       PACK:    local[x] -> rotated[r * X_d + x_d]
+
+     Chunk j of the rotated array, holding r in [j * R_p, (j + 1) * R_p)
+     where R_p = R / P_d, is sent to the rank with coordinate j along d.
+     On receipt, the chunks from the P_d ranks are gathered into full
+     lines of global length L_d = P_d * X_d:
+
+       GATHER:  recv[(k * R_p + r') * X_d + x] -> line[r' * L_d + k * X_d + x]
+
+     SCATTER and UNPACK are the respective inverses.
+   */
+  enum FFTTransposeType { FFT_PACK, FFT_UNPACK, FFT_GATHER, FFT_SCATTER };
+
+  template <typename Float, FFTTransposeType type_> struct FFTTransposeArg : kernel_param<> {
+    static constexpr FFTTransposeType type = type_;
+    int_fastdiv X[4]; // local dimensions
+    int d;            // dimension we are transforming
+    int_fastdiv Xd;   // local length of dimension d
+    int_fastdiv Rp;   // number of lines per rank
+    int L;            // global length of dimension d
+    complex<Float> *out;
+    const complex<Float> *in;
+
+    FFTTransposeArg(const lat_dim_t &X, int d, int P, complex<Float> *out, const complex<Float> *in) :
+      kernel_param(dim3(X[0] * X[1] * X[2] * X[3], 1, 1)), d(d), Xd(X[d]), L(P * X[d]), out(out), in(in)
+    {
+      for (int i = 0; i < 4; i++) this->X[i] = X[i];
+      Rp = X[0] * X[1] * X[2] * X[3] / (X[d] * P);
+    }
+  };
+
+  template <typename Arg> struct FFTTranspose {
+    const Arg &arg;
+    constexpr FFTTranspose(const Arg &arg) : arg(arg) { }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline void operator()(int id)
+    {
+      if constexpr (Arg::type == FFT_PACK || Arg::type == FFT_UNPACK) {
+        // local lexicographic index -> (r, x_d)
+        int x[4];
+        int rem = id;
+#pragma unroll
+        for (int i = 0; i < 4; i++) {
+          int q = rem / arg.X[i];
+          x[i] = rem - q * arg.X[i];
+          rem = q;
+        }
+        int r = 0;
+#pragma unroll
+        for (int i = 3; i >= 0; i--)
+          if (i != arg.d) r = r * arg.X[i] + x[i];
+        int rotated = r * arg.Xd + x[arg.d];
+
+        if constexpr (Arg::type == FFT_PACK)
+          arg.out[rotated] = arg.in[id];
+        else
+          arg.out[id] = arg.in[rotated];
+      } else {
+        // recv index = (k * R_p + r') * X_d + x
+        int x = id % arg.Xd;
+        int kr = id / arg.Xd;
+        int r = kr % arg.Rp;
+        int k = kr / arg.Rp;
+        int line = r * arg.L + k * arg.Xd + x;
+
+        if constexpr (Arg::type == FFT_GATHER)
+          arg.out[line] = arg.in[id];
+        else
+          arg.out[id] = arg.in[line];
+      }
+    }
+  };
+
+} // namespace quda
@@ -35,20 +35,28 @@ namespace quda
     }
   };
 
+  /**
+     @brief Compute the sum of the four plaquette leaves in the mu-nu
+     plane that meet at site x (the clover).  The first leaf is the
+     plaquette with corner x, so its real trace can also be returned
+     for use by fused observables.
+     @param[in] arg Kernel argument holding the gauge field accessor u
+     @param[in] x Extended-lattice coordinates of the site
+     @param[in] X Extended-lattice dimensions
+     @param[in] parity Parity of the site
+     @param[in] mu First direction of the plane
+     @param[in] nu Second direction of the plane
+     @param[out] plaq Real trace of the plaquette with corner x (not
+     computed if nullptr)
+     @return The sum of the four leaves
+   */
   template <typename Arg>
-  __device__ __host__ inline void computeFmunuCore(const Arg &arg, int idx, int parity, int mu, int nu)
+  __device__ __host__ inline Matrix<complex<typename Arg::Float>, 3>
+  cloverLeaves(const Arg &arg, const int x[4], const int X[4], int parity, int mu, int nu,
+               typename Arg::Float *plaq = nullptr)
   {
     using Link = Matrix<complex<typename Arg::Float>, 3>;
 
-    int x[4];
-    int X[4];
-
-    getCoords(x, idx, arg.X, parity);
-    for (int dir = 0; dir < 4; ++dir) {
-      x[dir] += arg.border[dir];
-      X[dir] = arg.X[dir] + 2 * arg.border[dir];
-    }
-
     Link F;
     { // U(x,mu) U(x+mu,nu) U[dagger](x+nu,mu) U[dagger](x,nu)
 
@@ -71,6 +79,7 @@ namespace quda
 
       // compute plaquette
       F = U1 * U2 * conj(U3) * conj(U4);
+      if (plaq) *plaq = getTrace(F).real();
     }
 
     { // U(x,nu) U[dagger](x+nu-mu,mu) U[dagger](x-mu,nu) U(x-mu, mu)
@@ -157,6 +166,24 @@ namespace quda
       // sum this contribution to Fmunu
       F += conj(U1) * conj(U2) * U3 * U4;
     }
+
+    return F;
+  }
+
+  template <typename Arg>
+  __device__ __host__ inline void computeFmunuCore(const Arg &arg, int idx, int parity, int mu, int nu)
+  {
+    int x[4];
+    int X[4];
+
+    getCoords(x, idx, arg.X, parity);
+    for (int dir = 0; dir < 4; ++dir) {
+      x[dir] += arg.border[dir];
+      X[dir] = arg.X[dir] + 2 * arg.border[dir];
+    }
+
+    auto F = cloverLeaves(arg, x, X, parity, mu, nu);
+
     // 3 matrix additions, 12 matrix-matrix multiplications, 8 matrix conjugations
     // Each matrix conjugation involves 9 unary minus operations but these ar not included in the operation count
     // Each matrix addition involves 18 real additions
@@ -6,6 +6,7 @@
 #include <kernel.h>
 #include <reduction_kernel.h>
 #include <fast_intdiv.h>
+#include <comm_quda.h>
 
 namespace quda {
 
@@ -77,19 +78,27 @@ namespace quda {
     static constexpr int elems = recon / 2;
     Gauge data;
     int_fastdiv X[4];     // grid dimensions
+    int offset[4];        // global coordinates of the local origin
+    int L[4];             // global grid dimensions
     Float *invpsq;
     complex<Float> *delta;
     complex<Float> *gx;
     Float alpha;
     int volume;
+    double global_volume;
 
     GaugeFixArg(GaugeField &data, double alpha) :
-      kernel_param(dim3(data.VolumeCB(), 2, 1)),
+      kernel_param(dim3(data.LocalVolumeCB(), 2, 1)),
       data(data),
       alpha(static_cast<Float>(alpha)),
-      volume(data.Volume())
+      volume(data.LocalVolume()),
+      global_volume(volume * static_cast<double>(comm_size()))
     {
-      for (int dir = 0; dir < 4; ++dir ) X[dir] = data.X()[dir];
+      for (int dir = 0; dir < 4; ++dir) {
+        X[dir] = data.LocalX()[dir];
+        offset[dir] = comm_coord(dir) * data.LocalX()[dir];
+        L[dir] = comm_dim(dir) * data.LocalX()[dir];
+      }
       invpsq = (Float*)device_malloc(sizeof(Float) * volume);
       delta = (complex<Float>*)device_malloc(sizeof(complex<Float>) * volume * 6);
 #ifdef GAUGEFIXING_DONT_USE_GX
@@ -134,6 +143,40 @@ namespace quda {
     }
   };
 
+  /**
+     @brief Compute the Fourier acceleration factor for the
+     distributed FFT, where the momenta are in local lexicographical
+     order with the global momentum offset of this rank
+  */
+  template <typename Arg> struct set_invpsq_lex
+  {
+    const Arg &arg;
+    constexpr set_invpsq_lex(const Arg &arg) : arg(arg) {}
+    static constexpr const char* filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline void operator()(int x_cb, int parity)
+    {
+      using Float = typename Arg::Float;
+      int id = parity * arg.threads.x + x_cb;
+      int p[4];
+      int rem = id;
+      for (int d = 0; d < 4; d++) {
+        int q = rem / arg.X[d];
+        p[d] = rem - q * arg.X[d] + arg.offset[d];
+        rem = q;
+      }
+      Float sinsq = 0.0;
+      for (int d = 0; d < 4; d++) {
+        Float s = quda::sinpi((Float)p[d] / (Float)arg.L[d]);
+        sinsq += s * s;
+      }
+      Float prcfact = 0.0;
+      //The FFT normalization is done here
+      if (sinsq > 0.00001) prcfact = 4.0 / (sinsq * (Float)(arg.global_volume));
+      arg.invpsq[id] = prcfact;
+    }
+  };
+
   template <typename Arg> struct mult_norm_2d
   {
     const Arg &arg;
@@ -157,19 +200,25 @@ namespace quda {
     static constexpr int gauge_dir = gauge_dir_;
 
     int_fastdiv X[4];     // grid dimensions
+    int E[4];             // extended grid dimensions
+    int border[4];
     Gauge data;
     complex<real> *delta;
     reduce_t result;
     int volume;
 
     GaugeFixQualityFFTArg(const GaugeField &data, complex<real> *delta) :
-      ReduceArg<reduce_t>(dim3(data.VolumeCB(), 2, 1), 1, true), // reset = true
+      ReduceArg<reduce_t>(dim3(data.LocalVolumeCB(), 2, 1), 1, true), // reset = true
       data(data),
       delta(delta),
       result{0, 0},
-      volume(data.Volume())
+      volume(data.LocalVolume())
     {
-      for (int dir = 0; dir < 4; dir++) X[dir] = data.X()[dir];
+      for (int dir = 0; dir < 4; dir++) {
+        border[dir] = data.R()[dir];
+        E[dir] = data.X()[dir];
+        X[dir] = data.X()[dir] - border[dir] * 2;
+      }
     }
 
     double getAction() { return result[0]; }
@@ -193,18 +242,22 @@ namespace quda {
       using matrix = Matrix<complex<typename Arg::real>, 3>;
       int x[4];
       getCoords(x, x_cb, arg.X, parity);
+      int idx = getIndexFull(x_cb, arg.X, parity);
+      for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+      int e_cb = linkIndex(x, arg.E);
+
       matrix delta;
       setZero(&delta);
 
       for (int mu = 0; mu < Arg::gauge_dir; mu++) {
-        matrix U = arg.data(mu, x_cb, parity);
+        matrix U = arg.data(mu, e_cb, parity);
         delta -= U;
       }
       //18*gauge_dir
       data[0] = -delta(0, 0).real() - delta(1, 1).real() - delta(2, 2).real();
       //2
       for (int mu = 0; mu < Arg::gauge_dir; mu++) {
-        matrix U = arg.data(mu, linkIndexM1(x, arg.X, mu), 1 - parity);
+        matrix U = arg.data(mu, linkIndexM1(x, arg.E, mu), 1 - parity);
         delta += U;
       }
       //18*gauge_dir
@@ -212,7 +265,6 @@ namespace quda {
       //18
       //SAVE DELTA!!!!!
       SubTraceUnit(delta);
-      int idx = getIndexFull(x_cb, arg.X, parity);
 
       //Saving Delta
       arg.delta[idx + 0 * arg.volume] = delta(0,0);
@@ -427,4 +479,108 @@ namespace quda {
     }
   };
 
+  /**
+     @brief Parameters for applying the gauge transformation on a
+     partitioned lattice.  Here g(x) is stored in an extended field
+     so that its halo can be exchanged, since the update of U_mu(x)
+     requires g(x + mu).
+  */
+  template <typename store_t, QudaReconstructType recon>
+  struct GaugeFixTransformArg : kernel_param<> {
+    using Float = typename mapper<store_t>::type;
+    using Gauge = typename gauge_mapper<store_t, recon>::type;
+    using GaugeG = typename gauge_mapper<Float, QUDA_RECONSTRUCT_NO>::type;
+    Gauge data;
+    GaugeG g;
+    int_fastdiv X[4]; // grid dimensions
+    int E[4];         // extended grid dimensions
+    int border[4];
+    const complex<Float> *delta;
+    Float alpha;
+    int volume;
+
+    GaugeFixTransformArg(GaugeField &data, GaugeField &g, const complex<Float> *delta, Float alpha) :
+      kernel_param(dim3(data.LocalVolumeCB(), 2, 1)),
+      data(data),
+      g(g),
+      delta(delta),
+      alpha(alpha),
+      volume(data.LocalVolume())
+    {
+      for (int dir = 0; dir < 4; dir++) {
+        border[dir] = data.R()[dir];
+        E[dir] = data.X()[dir];
+        X[dir] = data.X()[dir] - border[dir] * 2;
+      }
+    }
+  };
+
+  /**
+     @brief Compute g(x) from the accelerated Delta(x) and store it in
+     the extended field
+  */
+  template <typename Arg> struct GXField {
+    const Arg &arg;
+    constexpr GXField(const Arg &arg) : arg(arg) {}
+    static constexpr const char* filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline void operator()(int x_cb, int parity)
+    {
+      using Float = typename Arg::Float;
+      using complex = complex<Float>;
+      using matrix = Matrix<complex, 3>;
+
+      int x[4];
+      getCoords(x, x_cb, arg.X, parity);
+      int idx = ((x[3] * arg.X[2] + x[2]) * arg.X[1] + x[1]) * arg.X[0] + x[0];
+      for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr];
+
+      matrix de;
+      de(0,0) = arg.delta[idx + 0 * arg.volume];
+      de(0,1) = arg.delta[idx + 1 * arg.volume];
+      de(0,2) = arg.delta[idx + 2 * arg.volume];
+      de(1,1) = arg.delta[idx + 3 * arg.volume];
+      de(1,2) = arg.delta[idx + 4 * arg.volume];
+      de(2,2) = arg.delta[idx + 5 * arg.volume];
+
+      de(1,0) = complex(-de(0,1).real(), de(0,1).imag());
+      de(2,0) = complex(-de(0,2).real(), de(0,2).imag());
+      de(2,1) = complex(-de(1,2).real(), de(1,2).imag());
+
+      matrix g;
+      setIdentity(&g);
+      g += de * (arg.alpha * static_cast<Float>(0.5));
+      reunit_link<Float>(g);
+      arg.g(0, linkIndex(x, arg.E), parity) = g;
+    }
+  };
+
+  /**
+     @brief Apply U_mu(x) -> g(x) U_mu(x) g(x + mu)^dagger, reading g
+     from the extended field
+  */
+  template <typename Arg> struct U_EO_Field {
+    const Arg &arg;
+    constexpr U_EO_Field(const Arg &arg) : arg(arg) {}
+    static constexpr const char* filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline void operator()(int x_cb, int parity)
+    {
+      using matrix = Matrix<complex<typename Arg::Float>, 3>;
+
+      int x[4];
+      getCoords(x, x_cb, arg.X, parity);
+      for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr];
+      int e_cb = linkIndex(x, arg.E);
+
+      matrix g = arg.g(0, e_cb, parity);
+      for (int mu = 0; mu < 4; mu++) {
+        matrix U = arg.data(mu, e_cb, parity);
+        matrix g0 = arg.g(0, linkIndexP1(x, arg.E, mu), 1 - parity);
+        U = g * U * conj(g0);
+        arg.data(mu, e_cb, parity) = U;
+      }
+    }
+  };
+
 }
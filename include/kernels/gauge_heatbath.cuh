@@ -74,8 +74,8 @@ namespace quda {
     @param al weight
     @param localstate CURAND rng state
  */
-  template <class T>
-  __device__ inline Matrix<T,2> generate_su2_matrix_milc(T al, RNGState& localState)
+  template <class T, class State>
+  __device__ __host__ inline Matrix<T,2> generate_su2_matrix_milc(T al, State& localState)
   {
     T xr1 = uniform<T>::rand(localState);
     xr1 = (log((xr1 + static_cast<T>(1.e-10))));
@@ -294,9 +294,9 @@ namespace quda {
     @param F staple
     @param localstate CURAND rng state
   */
-  template <class Float, int nColor>
-  __device__ inline void heatBathSUN( Matrix<complex<Float>,nColor>& U, Matrix<complex<Float>,nColor> F,
-                                      RNGState& localState, Float BetaOverNc )
+  template <class Float, int nColor, class State>
+  __device__ __host__ inline void heatBathSUN( Matrix<complex<Float>,nColor>& U, Matrix<complex<Float>,nColor> F,
+                                      State& localState, Float BetaOverNc )
   {
     if (nColor == 3) {
       //////////////////////////////////////////////////////////////////
@@ -432,7 +432,7 @@ namespace quda {
      @param F staple
    */
   template <class Float, int nColor>
-  __device__ inline void overrelaxationSUN( Matrix<complex<Float>,nColor>& U, Matrix<complex<Float>,nColor> F )
+  __device__ __host__ inline void overrelaxationSUN( Matrix<complex<Float>,nColor>& U, Matrix<complex<Float>,nColor> F )
   {
     if (nColor == 3) {
       //////////////////////////////////////////////////////////////////
@@ -572,31 +572,53 @@ namespace quda {
     }
   }
 
-  template <typename Float_, int nColor_, QudaReconstructType recon, bool heatbath_>
+  /**
+     @brief Which sites of a given link and parity a heatbath kernel
+     updates: all of them, only those whose staples lie entirely in
+     the local volume, or only those whose staples reach into the
+     halo of a partitioned dimension.
+   */
+  enum MonteRegion { MONTE_ALL, MONTE_INTERIOR, MONTE_BOUNDARY };
+
+  template <typename Float_, int nColor_, QudaReconstructType recon, bool heatbath_, bool host_ = false>
   struct MonteArg : kernel_param<> {
     using Float = Float_;
     static constexpr int nColor = nColor_;
-    using Gauge = typename gauge_mapper<Float, recon>::type;
     static constexpr bool heatbath = heatbath_;
+    static constexpr bool host = host_;
+    // host fields are in QDP order, device fields in native order
+    using Gauge = typename std::conditional_t<host, gauge_order_mapper<Float, QUDA_QDP_GAUGE_ORDER, nColor>,
+                                              gauge_mapper<Float, recon>>::type;
 
     int X[4];       // grid dimensions
     int border[4];
+    int commDim[4]; // whether a dimension is partitioned
     Gauge dataOr;
     Float BetaOverNc;
     RNGState *rng;
+    CounterRNG counter;
     int mu;
     int parity;
-    MonteArg(GaugeField &data, Float Beta, RNGState *rng, int mu, int parity) :
+    int n_hb; // number of heatbath hits per link
+    bool ovr; // whether to apply an overrelaxation hit (following the heatbath hits)
+    MonteRegion region;
+    MonteArg(GaugeField &data, Float Beta, RNGState *rng, const CounterRNG &counter, int mu, int parity, int n_hb,
+             bool ovr, MonteRegion region = MONTE_ALL) :
       kernel_param(dim3(data.LocalVolumeCB(), 1, 1)),
       dataOr(data),
       rng(rng),
+      counter(counter),
       mu(mu),
-      parity(parity)
+      parity(parity),
+      n_hb(n_hb),
+      ovr(ovr),
+      region(region)
     {
       BetaOverNc = Beta / (Float)nColor;
       for (int dir = 0; dir < 4; dir++) {
         border[dir] = data.R()[dir];
         X[dir] = data.X()[dir] - border[dir] * 2;
+        commDim[dir] = comm_dim_partitioned(dir);
       } 
     }
   };
@@ -619,6 +641,15 @@ namespace quda {
 
       int x[4];
       getCoords(x, x_cb, X, parity);
+
+      if (arg.region != MONTE_ALL) {
+        bool boundary = false;
+#pragma unroll
+        for (int dr = 0; dr < 4; ++dr)
+          if (arg.commDim[dr] && (x[dr] == 0 || x[dr] == X[dr] - 1)) boundary = true;
+        if (boundary != (arg.region == MONTE_BOUNDARY)) return;
+      }
+
 #pragma unroll
       for (int dr = 0; dr < 4; ++dr) {
         x[dr] += arg.border[dr];
@@ -653,13 +684,21 @@ namespace quda {
           staple += link;
         }
       U = arg.dataOr(mu, e_cb, parity);
-      if (Arg::heatbath) {
+      staple = conj(staple);
+
+      // the staple is independent of the link being updated, so
+      // multiple hits reuse it without reloading the neighbors
+      if (Arg::heatbath && (Arg::host || arg.counter.enabled)) {
+        PhiloxState localState(arg.counter, x_cb, parity);
+        for (int hit = 0; hit < arg.n_hb; hit++) heatBathSUN(U, staple, localState, arg.BetaOverNc);
+      } else if constexpr (Arg::heatbath && !Arg::host) {
         RNGState localState = arg.rng[x_cb];
-        heatBathSUN( U, conj(staple), localState, arg.BetaOverNc );
+        for (int hit = 0; hit < arg.n_hb; hit++) heatBathSUN(U, staple, localState, arg.BetaOverNc);
         arg.rng[x_cb] = localState;
-      } else {
-        overrelaxationSUN( U, conj(staple) );
       }
+      // overrelaxation at fixed staple is close to an involution, so
+      // there is no point in applying more than one hit
+      if (arg.ovr) overrelaxationSUN(U, staple);
       arg.dataOr(mu, e_cb, parity) = U;
     }
   };
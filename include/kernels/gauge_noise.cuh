@@ -20,13 +20,15 @@ namespace quda {
     int border[4];
     Gauge U;
     RNGState *rng;
+    CounterRNG counter;
     real sigma; // where U = exp(sigma * H)
 
-    GaugeNoiseArg(const GaugeField &U, RNGState *rng) :
+    GaugeNoiseArg(const GaugeField &U, RNGState *rng, const CounterRNG &counter) :
       kernel_param(dim3(U.LocalVolumeCB(), 2, 1)),
       geometry(U.Geometry()),
       U(U),
-      rng(rng)
+      rng(rng),
+      counter(counter)
     {
       for (int dir = 0; dir < 4; ++dir) {
         border[dir] = U.R()[dir];
@@ -36,8 +38,8 @@ namespace quda {
     }
   };
 
-  template<typename real, typename Arg> // Gauss
-  __device__ __host__ inline void genGauss(Arg &arg, RNGState& localState, int parity, int x_cb, int g, int r, int c)
+  template<typename real, typename Arg, typename State> // Gauss
+  __device__ __host__ inline void genGauss(Arg &arg, State& localState, int parity, int x_cb, int g, int r, int c)
   {
     real phi = 2.0 * uniform<real>::rand(localState);
     real radius = uniform<real>::rand(localState);
@@ -47,8 +49,8 @@ namespace quda {
     arg.U(g, parity, x_cb, r, c) = radius * complex<real>(phi_cos, phi_sin);
   }
 
-  template<typename real, typename Arg> // Uniform
-  __device__ __host__ inline void genUniform(Arg &arg, RNGState& localState, int parity, int x_cb, int g, int r, int c)
+  template<typename real, typename Arg, typename State> // Uniform
+  __device__ __host__ inline void genUniform(Arg &arg, State& localState, int parity, int x_cb, int g, int r, int c)
   {
     real x = uniform<real>::rand(localState);
     real y = uniform<real>::rand(localState);
@@ -60,14 +62,8 @@ namespace quda {
     constexpr NoiseGauge(const Arg &arg) : arg(arg) {}
     static constexpr const char* filename() { return KERNEL_FILE; }
 
-    __device__ __host__ void operator()(int x_cb, int parity)
+    template <typename State> __device__ __host__ void noise(State &localState, int e_cb, int parity)
     {
-      int x[4];
-      getCoords(x, x_cb, arg.X, parity);
-      for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
-      int e_cb = linkIndex(x, arg.E);
-
-      RNGState localState = arg.rng[parity * arg.threads.x + x_cb];
       for (int g = 0; g < arg.geometry; g++) {
         for (int r = 0; r < Arg::nColor; r++) {
           for (int c = 0; c < Arg::nColor; c++) {
@@ -78,7 +74,23 @@ namespace quda {
           }
         }
       }
-      arg.rng[parity * arg.threads.x + x_cb] = localState;
+    }
+
+    __device__ __host__ void operator()(int x_cb, int parity)
+    {
+      int x[4];
+      getCoords(x, x_cb, arg.X, parity);
+      for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+      int e_cb = linkIndex(x, arg.E);
+
+      if (arg.counter.enabled) {
+        PhiloxState localState(arg.counter, x_cb, parity);
+        noise(localState, e_cb, parity);
+      } else {
+        RNGState localState = arg.rng[parity * arg.threads.x + x_cb];
+        noise(localState, e_cb, parity);
+        arg.rng[parity * arg.threads.x + x_cb] = localState;
+      }
     }
   };
 
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <gauge_field_order.h>
+#include <index_helper.cuh>
+#include <quda_matrix.h>
+#include <array.h>
+#include <reduction_kernel.h>
+#include <kernels/field_strength_tensor.cuh>
+
+namespace quda
+{
+
+  template <typename Float_, int nColor_, QudaReconstructType recon_, bool density_, bool host_ = false>
+  struct FusedObservablesArg : public ReduceArg<array<double, 5>> {
+    using Float = Float_;
+    static constexpr int nColor = nColor_;
+    static_assert(nColor == 3, "Only nColor=3 enabled at this time");
+    static constexpr QudaReconstructType recon = recon_;
+    static constexpr bool density = density_;
+    static constexpr bool host = host_;
+    // host fields are in QDP order, device fields in native order
+    using G = typename std::conditional_t<host, gauge_order_mapper<Float, QUDA_QDP_GAUGE_ORDER, nColor>,
+                                          gauge_mapper<Float, recon>>::type;
+
+    G u;
+    Float *qDensity;
+
+    int X[4]; // true grid dimensions
+    int border[4];
+
+    FusedObservablesArg(const GaugeField &u, Float *qDensity = nullptr) :
+      ReduceArg<reduce_t>(dim3(u.LocalVolumeCB(), 2, 1)), u(u), qDensity(qDensity)
+    {
+      for (int dir = 0; dir < 4; ++dir) {
+        border[dir] = u.R()[dir];
+        X[dir] = u.X()[dir] - border[dir] * 2;
+      }
+    }
+  };
+
+  /**
+     Compute the plaquette, field energy and topological charge at a
+     site in a single pass over the gauge field.  The clover leaves of
+     each plane are formed once, with the first leaf giving the
+     plaquette and the clover sum giving F_munu, so the field strength
+     is never written to memory.  The reduction is ordered as the
+     spatial and temporal plaquette, the spatial and temporal energy,
+     and the topological charge.
+   */
+  template <typename Arg> struct FusedObservables : plus<typename Arg::reduce_t> {
+    using reduce_t = typename Arg::reduce_t;
+    using plus<reduce_t>::operator();
+    static constexpr int reduce_block_dim = 2; // x_cb in x, parity in y
+    const Arg &arg;
+    constexpr FusedObservables(const Arg &arg) : arg(arg) { }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline reduce_t operator()(reduce_t &value, int x_cb, int parity)
+    {
+      using real = typename Arg::Float;
+      using Link = Matrix<complex<real>, Arg::nColor>;
+      constexpr real q_norm = static_cast<real>(-1.0 / (4 * M_PI * M_PI));
+      constexpr real n_inv = static_cast<real>(1.0 / Arg::nColor);
+
+      reduce_t obs {0, 0, 0, 0, 0};
+
+      int x[4];
+      int X[4];
+      getCoords(x, x_cb, arg.X, parity);
+#pragma unroll
+      for (int dir = 0; dir < 4; ++dir) {
+        x[dir] += arg.border[dir]; // extended grid coordinates
+        X[dir] = arg.X[dir] + 2 * arg.border[dir];
+      }
+
+      // F0 = F[Y,X], F1 = F[Z,X], F2 = F[Z,Y],
+      // F3 = F[T,X], F4 = F[T,Y], F5 = F[T,Z]
+      Link F[6];
+#pragma unroll
+      for (int mu = 1; mu < 4; mu++) {
+#pragma unroll
+        for (int nu = 0; nu < mu; nu++) {
+          real plaq;
+          Link C = cloverLeaves(arg, x, X, parity, mu, nu, &plaq);
+          obs[mu < 3 ? 0 : 1] += plaq;
+
+          int munu_idx = (mu * (mu - 1)) / 2 + nu; // lower-triangular indexing
+          F[munu_idx] = C;
+          F[munu_idx] -= conj(C);
+          F[munu_idx] *= static_cast<real>(0.125);
+        }
+      }
+
+      // field energy
+      Link iden;
+      setIdentity(&iden);
+#pragma unroll
+      for (int i = 0; i < 6; i++) {
+        auto tmp = F[i] - n_inv * getTrace(F[i]) * iden;
+        obs[i < 3 ? 2 : 3] -= getTrace(tmp * tmp).real();
+      }
+
+      // topological charge, with the levi-civita signs applied
+      double Q = 0.0;
+#pragma unroll
+      for (int i = 0; i < 3; i++) {
+        double Qi = getTrace(F[i] * F[5 - i]).real();
+        Q += (i % 2 == 0) ? Qi : -Qi;
+      }
+      obs[4] = Q * q_norm;
+      if (Arg::density) arg.qDensity[x_cb + parity * arg.threads.x] = obs[4];
+
+      return operator()(obs, value);
+    }
+  };
+
+} // namespace quda
@@ -21,12 +21,14 @@ namespace quda {
     int border[4];
     Gauge U;
     RNGState *rng;
+    CounterRNG counter;
     real sigma; // where U = exp(sigma * H)
 
-    GaugeGaussArg(const GaugeField &U, RNGState *rng, double sigma) :
+    GaugeGaussArg(const GaugeField &U, RNGState *rng, const CounterRNG &counter, double sigma) :
       kernel_param(dim3(U.LocalVolumeCB(), 2, 1)),
       U(U),
       rng(rng),
+      counter(counter),
       sigma(sigma)
     {
       for (int dir = 0; dir < 4; ++dir) {
@@ -37,7 +39,7 @@ namespace quda {
     }
   };
 
-  template <typename real, typename Link> __device__ __host__ Link gauss_su3(RNGState &localState)
+  template <typename real, typename Link, typename State> __device__ __host__ Link gauss_su3(State &localState)
   {
     Link ret;
     real rand1[4], rand2[4], phi[4], radius[4], temp1[4], temp2[4];
@@ -73,6 +75,17 @@ namespace quda {
     constexpr GaussGauge(const Arg &arg) : arg(arg) {}
     static constexpr const char* filename() { return KERNEL_FILE; }
 
+    /**
+       @brief Generate Gaussian distributed su(n) field, and
+       exponentiate if we want a group field
+    */
+    template <typename real, typename Link, typename State> __device__ __host__ Link gauss(State &localState)
+    {
+      Link u = arg.sigma * gauss_su3<real, Link>(localState);
+      if constexpr (Arg::group) { expsu3<real>(u); }
+      return u;
+    }
+
     __device__ __host__ void operator()(int x_cb, int parity)
     {
       using real = typename mapper<typename Arg::Float>::type;
@@ -92,17 +105,13 @@ namespace quda {
         Link O;
         setZero(&O);
         for (int mu = 0; mu < 4; mu++) arg.U(mu, linkIndex(x, arg.E), parity) = O;
+      } else if (arg.counter.enabled) {
+        PhiloxState localState(arg.counter, x_cb, parity);
+        for (int mu = 0; mu < 4; mu++) arg.U(mu, linkIndex(x, arg.E), parity) = gauss<real, Link>(localState);
       } else {
         for (int mu = 0; mu < 4; mu++) {
           RNGState localState = arg.rng[parity * arg.threads.x + x_cb];
-
-          // generate Gaussian distributed su(n) field
-          Link u = arg.sigma * gauss_su3<real, Link>(localState);
-          if constexpr (Arg::group) {
-            expsu3<real>(u);
-          }
-          arg.U(mu, linkIndex(x, arg.E), parity) = u;
-
+          arg.U(mu, linkIndex(x, arg.E), parity) = gauss<real, Link>(localState);
           arg.rng[parity * arg.threads.x + x_cb] = localState;
         }
       }
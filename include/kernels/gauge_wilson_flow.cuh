@@ -4,6 +4,7 @@
 #include <kernels/gauge_utils.cuh>
 #include <su3_project.cuh>
 #include <kernel.h>
+#include <reduction_kernel.h>
 
 namespace quda
 {
@@ -11,6 +12,7 @@ namespace quda
   enum WFlowStepType {
     WFLOW_STEP_W1,
     WFLOW_STEP_W2,
+    WFLOW_STEP_W2_EMBEDDED, // W2 step that also forms the embedded second-order step
     WFLOW_STEP_VT,
   };
 
@@ -30,6 +32,7 @@ namespace quda
     Gauge out;
     Matrix temp;
     const Gauge in;
+    Gauge emb; // embedded second-order solution (only used by WFLOW_STEP_W2_EMBEDDED)
 
     int_fastdiv X[4];    // grid dimensions
     int border[4];
@@ -38,11 +41,13 @@ namespace quda
     const real coeff1x1;
     const real coeff2x1;
 
-    GaugeWFlowArg(GaugeField &out, GaugeField &temp, const GaugeField &in, const real epsilon) :
+    GaugeWFlowArg(GaugeField &out, GaugeField &temp, const GaugeField &in, const real epsilon,
+                  GaugeField *emb = nullptr) :
       kernel_param(dim3(in.LocalVolumeCB(), 2, wflow_dim)),
       out(out),
       temp(temp),
       in(in),
+      emb(emb ? *emb : out),
       epsilon(epsilon),
       coeff1x1(5.0/3.0),
       coeff2x1(-1.0/12.0)
@@ -95,13 +100,28 @@ namespace quda
   template <typename Link, typename Arg>
   __host__ __device__ inline auto computeW2Step(const Arg &arg, Link &U, const int *x, const int parity, const int x_cb, const int dir)
   {
+    using real = typename Arg::real;
+
     // Compute staples and Z1
-    Link Z1 = static_cast<typename Arg::real>(8.0 / 9.0) * computeStaple(arg, x, parity, dir);
+    Link Z1 = computeStaple(arg, x, parity, dir);
     U = arg.in(dir, linkIndex(x, arg.E), parity);
     Z1 *= conj(U);
 
     // Retrieve Z0, (8/9 Z1 - 17/36 Z0) stored in temp
     Link Z0 = arg.temp(dir, x_cb, parity);
+
+    if constexpr (Arg::step_type == WFLOW_STEP_W2_EMBEDDED) {
+      // The second-order scheme exp(2 Z1 - Z0) W0 sharing the first
+      // two stages, written relative to W1 = exp(Z0 / 4) W0 (exact to
+      // second order since [Z0, Z1] = O(epsilon^3))
+      Link Z = static_cast<real>(2.0) * Z1 - static_cast<real>(5.0 / 4.0) * Z0;
+      Z *= arg.epsilon;
+      makeAntiHerm(Z);
+      Z = complex<real>(0.0, -1.0) * Z;
+      arg.emb(dir, linkIndex(x, arg.E), parity) = exponentiate_iQ(Z) * U;
+    }
+
+    Z1 *= static_cast<real>(8.0 / 9.0);
     Z0 *= static_cast<typename Arg::real>(17.0 / 36.0);
     Z1 = Z1 - Z0;
     arg.temp(dir, x_cb, parity) = Z1;
@@ -145,7 +165,8 @@ namespace quda
       Link U, Z;
       switch (arg.step_type) {
       case WFLOW_STEP_W1: Z = computeW1Step(arg, U, x, parity, x_cb, dir); break;
-      case WFLOW_STEP_W2: Z = computeW2Step(arg, U, x, parity, x_cb, dir); break;
+      case WFLOW_STEP_W2:
+      case WFLOW_STEP_W2_EMBEDDED: Z = computeW2Step(arg, U, x, parity, x_cb, dir); break;
       case WFLOW_STEP_VT: Z = computeVtStep(arg, U, x, parity, x_cb, dir); break;
       }
 
@@ -157,4 +178,58 @@ namespace quda
     }
   };
 
+  template <typename Float, int nColor_, QudaReconstructType recon_> struct LinkDistanceArg : ReduceArg<double> {
+    using real = typename mapper<Float>::type;
+    static constexpr int nColor = nColor_;
+    static constexpr QudaReconstructType recon = recon_;
+    typedef typename gauge_mapper<Float, recon>::type Gauge;
+
+    const Gauge u;
+    const Gauge v;
+    int X[4]; // grid dimensions
+    int E[4]; // extended grid dimensions
+    int border[4];
+
+    LinkDistanceArg(const GaugeField &u, const GaugeField &v) :
+      ReduceArg<reduce_t>(dim3(u.LocalVolumeCB(), 2, 1)), u(u), v(v)
+    {
+      for (int dir = 0; dir < 4; ++dir) {
+        border[dir] = u.R()[dir];
+        X[dir] = u.X()[dir] - border[dir] * 2;
+        E[dir] = u.X()[dir];
+      }
+    }
+  };
+
+  // Maximum over the links of the Frobenius distance |U - V| / nColor,
+  // used as the local error estimate of the adaptive flow
+  template <typename Arg> struct LinkDistance : maximum<typename Arg::reduce_t> {
+    using reduce_t = typename Arg::reduce_t;
+    using maximum<reduce_t>::operator();
+    static constexpr int reduce_block_dim = 2; // x_cb in x, parity in y
+    const Arg &arg;
+    constexpr LinkDistance(const Arg &arg) : arg(arg) { }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline reduce_t operator()(reduce_t &value, int x_cb, int parity)
+    {
+      using Link = Matrix<complex<typename Arg::real>, Arg::nColor>;
+
+      int x[4];
+      getCoords(x, x_cb, arg.X, parity);
+      for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr];
+      int e_cb = linkIndex(x, arg.E);
+
+      reduce_t distance = 0.0;
+#pragma unroll
+      for (int d = 0; d < 4; d++) {
+        Link U = arg.u(d, e_cb, parity);
+        Link V = arg.v(d, e_cb, parity);
+        Link D = U - V;
+        distance = operator()(static_cast<reduce_t>(D.L2() / Arg::nColor), distance);
+      }
+      return operator()(distance, value);
+    }
+  };
+
 } // namespace quda
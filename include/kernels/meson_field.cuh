@@ -0,0 +1,156 @@
+#pragma once
+
+#include <color_spinor_field_order.h>
+#include <index_helper.cuh>
+#include <kernel.h>
+#include <array.h>
+
+namespace quda
+{
+
+  /**
+     The meson field M_ij = sum_x w_i(x)^dagger Gamma v_j(x) exp(-i p.x)
+     summed over each time slice is computed as a batched GEMM over
+     the local time slices, for which the fields are packed into
+     column-major matrices per time slice: the rows K = (spatial
+     site, color) are contracted, and the columns are (vector, spin).
+     The spin structure is kept open through the GEMM, with the gamma
+     insertion applied to the (small) result.  The left operand is
+     packed conjugate transposed (dagger), with the rows (vector, spin)
+     and the columns (spatial site, color), so that the GEMM needs no
+     transpose.
+  */
+  template <typename Float, int nColor_, bool host_> struct MesonFieldPackArg : kernel_param<> {
+    using real = typename mapper<Float>::type;
+    static constexpr int nSpin = 4;
+    static constexpr int nColor = nColor_;
+    static constexpr bool host = host_;
+    static constexpr bool spin_project = true;
+    static constexpr bool spinor_direct_load = false; // false means texture load
+
+    // host fields are in space-spin-color order, device fields in native order
+    using F = std::conditional_t<host, colorspinor::SpaceSpinorColorOrder<Float, nSpin, nColor>,
+                                 typename colorspinor_mapper<Float, nSpin, nColor, spin_project, spinor_direct_load>::type>;
+
+    const F x;
+    complex<real> *buffer; // packed matrices
+    const int col;         // which vector we are packing
+    const int n_col;       // number of vectors in the block
+    const int Vs_cb;       // checkerboarded local spatial volume
+    const size_t K;        // contracted dimension of the packed matrix
+    const bool dagger;     // whether we pack the conjugate transpose
+
+    MesonFieldPackArg(const ColorSpinorField &x, void *buffer, int col, int n_col, bool dagger) :
+      kernel_param(dim3(x.VolumeCB(), 2, 1)),
+      x(x),
+      buffer(static_cast<complex<real> *>(buffer)),
+      col(col),
+      n_col(n_col),
+      Vs_cb(x.VolumeCB() / x.X()[3]),
+      K(2 * Vs_cb * nColor),
+      dagger(dagger)
+    {
+    }
+  };
+
+  template <typename Arg> struct MesonFieldPack {
+    const Arg &arg;
+    constexpr MesonFieldPack(const Arg &arg) : arg(arg) { }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline void operator()(int x_cb, int parity)
+    {
+      using Vector = ColorSpinor<typename Arg::real, Arg::nColor, Arg::nSpin>;
+      Vector v = arg.x(x_cb, parity);
+
+      // sites of a time slice are contiguous in x_cb
+      const int t = x_cb / arg.Vs_cb;
+      const int s = parity * arg.Vs_cb + x_cb % arg.Vs_cb;
+
+      auto out = arg.buffer + t * arg.K * Arg::nSpin * arg.n_col;
+      const int ld = Arg::nSpin * arg.n_col;
+#pragma unroll
+      for (int spin = 0; spin < Arg::nSpin; spin++) {
+#pragma unroll
+        for (int color = 0; color < Arg::nColor; color++) {
+          const int row = s * Arg::nColor + color;
+          const int col = arg.col * Arg::nSpin + spin;
+          if (arg.dagger)
+            out[row * ld + col] = conj(v(spin, color));
+          else
+            out[col * arg.K + row] = v(spin, color);
+        }
+      }
+    }
+  };
+
+  template <typename real_, int nColor_> struct MesonFieldPhaseArg : kernel_param<> {
+    using real = real_;
+    static constexpr int nSpin = 4;
+    static constexpr int nColor = nColor_;
+
+    const complex<real> *in;
+    complex<real> *out;
+    const int n_col;
+    int X[4];      // local grid dimensions
+    int offset[3]; // global coordinates of the local origin
+    int L[3];      // global spatial dimensions
+    const int Vs_cb;
+    const size_t K;
+    const array<int, 3> mom;
+
+    MesonFieldPhaseArg(const ColorSpinorField &x, const void *in, void *out, int n_col, const array<int, 3> &mom) :
+      kernel_param(dim3(x.VolumeCB(), 2, 1)),
+      in(static_cast<const complex<real> *>(in)),
+      out(static_cast<complex<real> *>(out)),
+      n_col(n_col),
+      Vs_cb(x.VolumeCB() / x.X()[3]),
+      K(2 * Vs_cb * nColor),
+      mom(mom)
+    {
+      for (int dir = 0; dir < 4; dir++) X[dir] = x.X()[dir];
+      for (int dir = 0; dir < 3; dir++) {
+        offset[dir] = comm_coord(dir) * X[dir];
+        L[dir] = comm_dim(dir) * X[dir];
+      }
+    }
+  };
+
+  /**
+     Multiply the packed block by the momentum phase exp(-i p.x)
+  */
+  template <typename Arg> struct MesonFieldPhase {
+    const Arg &arg;
+    constexpr MesonFieldPhase(const Arg &arg) : arg(arg) { }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline void operator()(int x_cb, int parity)
+    {
+      using real = typename Arg::real;
+
+      int x[4];
+      getCoords(x, x_cb, arg.X, parity);
+
+      double arg_pi = 0.0;
+#pragma unroll
+      for (int d = 0; d < 3; d++)
+        arg_pi -= 2.0 * arg.mom[d] * static_cast<double>(x[d] + arg.offset[d]) / arg.L[d];
+      double s, c;
+      quda::sincospi(arg_pi, &s, &c);
+      complex<real> phase(c, s);
+
+      const int t = x_cb / arg.Vs_cb;
+      const int site = parity * arg.Vs_cb + x_cb % arg.Vs_cb;
+      const size_t base = t * arg.K * Arg::nSpin * arg.n_col + site * Arg::nColor;
+
+      for (int col = 0; col < Arg::nSpin * arg.n_col; col++) {
+#pragma unroll
+        for (int color = 0; color < Arg::nColor; color++) {
+          auto idx = base + col * arg.K + color;
+          arg.out[idx] = phase * arg.in[idx];
+        }
+      }
+    }
+  };
+
+} // namespace quda
@@ -51,13 +51,15 @@ namespace quda {
     int X[4]; // grid dimensions
     Gauge U;
     RNGState *rng;
+    CounterRNG counter;
     int border[4];
-    InitGaugeHotArg(const GaugeField &U, RNGState *rng) :
+    InitGaugeHotArg(const GaugeField &U, RNGState *rng, const CounterRNG &counter) :
       //the optimal number of RNG states in rngstate array must be equal to half the lattice volume
       //this number is the same used in heatbath...
       kernel_param(dim3(U.LocalVolumeCB(), 1, 1)),
       U(U),
-      rng(rng)
+      rng(rng),
+      counter(counter)
     {
       for (int dir = 0; dir < 4; dir++) {
         border[dir] = U.R()[dir];
@@ -111,8 +113,8 @@ namespace quda {
      @param localstate CURAND rng state
      @return four real numbers of the SU(2) matrix
   */
-  template <class T>
-  __device__ static inline Matrix<T,2> randomSU2(RNGState& localState){
+  template <class T, class State>
+  __device__ static inline Matrix<T,2> randomSU2(State& localState){
     Matrix<T,2> a;
     T aabs, ctheta, stheta, phi;
     a(0,0) = uniform<T>::rand(localState, (T)-1.0, (T)1.0);
@@ -177,8 +179,8 @@ namespace quda {
      @param localstate CURAND rng state
      @return SU(Nc) matrix
   */
-  template <class Float, int nColor>
-  __device__ inline Matrix<complex<Float>,nColor> randomize( RNGState& localState )
+  template <class Float, int nColor, class State>
+  __device__ inline Matrix<complex<Float>,nColor> randomize( State& localState )
   {
     Matrix<complex<Float>,nColor> U;
 
@@ -203,23 +205,34 @@ namespace quda {
     constexpr HotStart(const Arg &arg) : arg(arg) {}
     static constexpr const char *filename() { return KERNEL_FILE; }
 
-    __device__ __host__ void operator()(int x_cb)
+    template <typename State> __device__ __host__ void hot(State &localState, int x_cb, int parity)
     {
       int X[4], x[4];
       for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
       for ( int dr = 0; dr < 4; ++dr ) X[dr] += 2 * arg.border[dr];
-      RNGState localState = arg.rng[x_cb];
-      for (int parity = 0; parity < 2; parity++) {
-        getCoords(x, x_cb, arg.X, parity);
-        for (int dr = 0; dr < 4; dr++) x[dr] += arg.border[dr];
-        int e_cb = linkIndex(x, X);
-        for (int d = 0; d < 4; d++) {
-          Matrix<complex<typename Arg::real>, Arg::nColor> U;
-          U = randomize<typename Arg::real, Arg::nColor>(localState);
-          arg.U(d, e_cb, parity) = U;
+      getCoords(x, x_cb, arg.X, parity);
+      for (int dr = 0; dr < 4; dr++) x[dr] += arg.border[dr];
+      int e_cb = linkIndex(x, X);
+      for (int d = 0; d < 4; d++) {
+        Matrix<complex<typename Arg::real>, Arg::nColor> U;
+        U = randomize<typename Arg::real, Arg::nColor>(localState);
+        arg.U(d, e_cb, parity) = U;
+      }
+    }
+
+    __device__ __host__ void operator()(int x_cb)
+    {
+      if (arg.counter.enabled) {
+        // each site has its own stream so the result is independent of the partitioning
+        for (int parity = 0; parity < 2; parity++) {
+          PhiloxState localState(arg.counter, x_cb, parity);
+          hot(localState, x_cb, parity);
         }
+      } else {
+        RNGState localState = arg.rng[x_cb];
+        for (int parity = 0; parity < 2; parity++) hot(localState, x_cb, parity);
+        arg.rng[x_cb] = localState;
       }
-      arg.rng[x_cb] = localState;
     }
   };
 
@@ -20,7 +20,9 @@ namespace quda
        @tparam N Default field vector i/o length
        @tparam y_store_t Store type for the y fields
        @tparam Ny Y-field vector i/o length
-       @tparam Reducer_ Functor used to operate on data
+       @tparam Reducer_ Functor used to operate on data.  If
+       Reducer_::v_mixed is set, the v field has the y-field store
+       type rather than the default
     */
     template <typename real_, int n_, typename store_t, int N, typename y_store_t, int Ny, typename Reducer_>
     struct ReductionArg : public ReduceArg<typename Reducer_::reduce_t, Reducer_::use_kernel_arg> {
@@ -28,11 +30,13 @@ namespace quda
       static constexpr int n = n_;
       using Reducer = Reducer_;
       using reduce_t = typename Reducer_::reduce_t;
+      using v_store_t = std::conditional_t<Reducer_::v_mixed, y_store_t, store_t>;
+      static constexpr int Nv = Reducer_::v_mixed ? Ny : N;
       Spinor<store_t, N> X;
       Spinor<y_store_t, Ny> Y;
       Spinor<store_t, N> Z;
       Spinor<store_t, N> W;
-      Spinor<store_t, N> V;
+      Spinor<v_store_t, Nv> V;
       Reducer r;
 
       const int length_cb;
@@ -99,13 +103,15 @@ namespace quda
 
        @tparam reduce_t The fundamental reduction type
        @tparam site_unroll Whether each thread must update the entire site
+       @tparam v_mixed Whether the v field has the precision of the y field
     */
-    template <typename reduce_t_, bool site_unroll_ = false>
+    template <typename reduce_t_, bool site_unroll_ = false, bool v_mixed_ = false>
     struct ReduceFunctor {
       static constexpr use_kernel_arg_p use_kernel_arg = use_kernel_arg_p::TRUE;
       using reduce_t = reduce_t_;
       using reducer = plus<reduce_t>;
       static constexpr bool site_unroll = site_unroll_;
+      static constexpr bool v_mixed = v_mixed_;
 
       //! pre-computation routine called before the "M-loop"
       __device__ __host__ void pre() const { ; }
@@ -244,6 +250,29 @@ namespace quda
       constexpr int flops() const { return 4; }   //! flops per element
     };
 
+    /**
+       First performs the operation y[i] = v[i] - y[i], with v and y
+       of the same precision, and saves the result to the (lower
+       precision) x[i].  Returns the norm of y, computed before the
+       result is rounded to the precision of x.
+    */
+    template <typename reduce_t, typename real>
+    struct xmyNormCopy_ : public ReduceFunctor<reduce_t, false, true> {
+      static constexpr memory_access<0, 1, 0, 0, 1> read{ };
+      static constexpr memory_access<1, 1> write{ };
+      xmyNormCopy_(const real &, const real &) { ; }
+      template <typename T> __device__ __host__ void operator()(reduce_t &sum, T &x, T &y, T &, T &, T &v) const
+      {
+#pragma unroll
+        for (int i = 0; i < x.size(); i++) {
+          y[i] = v[i] - y[i];
+          norm2_<reduce_t, real>(sum, y[i]);
+          x[i] = y[i];
+        }
+      }
+      constexpr int flops() const { return 3; }   //! flops per element
+    };
+
     /**
        First performs the operation y[i] += a*x[i]
        Return real dot product (x,y)
@@ -467,6 +496,7 @@ namespace quda
       using reduce_t = array<real_reduce_t, 3>;
       using reducer = plus<reduce_t>;
       static constexpr bool site_unroll = true;
+      static constexpr bool v_mixed = false;
 
       static constexpr memory_access<1, 1> read{ };
       static constexpr memory_access<> write{ };
@@ -514,6 +544,7 @@ namespace quda
       using reduce_t = array<real_reduce_t, 3>;
       using reducer = plus<reduce_t>;
       static constexpr bool site_unroll = true;
+      static constexpr bool v_mixed = false;
 
       static constexpr memory_access<1, 1, 1> read{ };
       static constexpr memory_access<> write{ };
@@ -30,7 +30,9 @@ namespace quda {
     static constexpr QudaDilutionType type = type_;
     static constexpr int max_dilution_size = get_size<nSpin, nColor>(type);
     using V = typename colorspinor_mapper<store_t, nSpin, nColor>::type;
-    int dilution_size;
+    int dilution_size; // number of fields in this batch
+    int offset;        // index of the first field of this batch in the complete dilution set
+    bool blocked;      // whether a non-block dilution is additionally block diluted
     V v[max_dilution_size];
     V src;
     int nParity;
@@ -40,14 +42,19 @@ namespace quda {
 
     /**
        @brief Constructor for the dilution arg
-       @param v The output diluted set
+       @param v The output diluted set (or a batch thereof)
        @param src The source vector we are diluting
+       @param dilution_block_dims The local block size used for block dilution
+       @param offset The index of v[0] in the complete dilution set
+       @param blocked Whether to compose a non-block dilution with block dilution
      */
     template <std::size_t... S>
-    SpinorDiluteArg(std::vector<ColorSpinorField> &v, const ColorSpinorField &src, const lat_dim_t &dilution_block_dims,
-                    std::index_sequence<S...>) :
+    SpinorDiluteArg(cvector_ref<ColorSpinorField> &v, const ColorSpinorField &src,
+                    const lat_dim_t &dilution_block_dims, int offset, bool blocked, std::index_sequence<S...>) :
       kernel_param(dim3(src.VolumeCB(), src.SiteSubset(), 1)),
       dilution_size(v.size()),
+      offset(offset),
+      blocked(blocked),
       src(src),
       nParity(src.SiteSubset()),
       dims(static_cast<const LatticeField &>(src).X()),
@@ -58,7 +65,7 @@ namespace quda {
         this->dims[0] *= 2;
         this->dilution_block_dims[0] *= 2;
       }
-      for (auto i = 0; i < src.Ndim() && type == QUDA_DILUTION_BLOCK; i++)
+      for (auto i = 0; i < src.Ndim() && (type == QUDA_DILUTION_BLOCK || blocked); i++)
         dilution_block_grid[i] = (dims[i] * comms_dim[i]) / this->dilution_block_dims[i];
     }
   };
@@ -105,25 +112,35 @@ namespace quda {
       using vector = ColorSpinor<typename Arg::real, Arg::nColor, Arg::nSpin>;
       vector src = arg.src(x_cb, parity);
 
-      if (Arg::type == QUDA_DILUTION_BLOCK) {
+      int block_idx = 0;
+      if (Arg::type == QUDA_DILUTION_BLOCK || arg.blocked) {
         lat_dim_t coords;
         getCoordsGlobal(coords, x_cb, parity, arg);
 
         lat_dim_t block_coords;
         for (int i = 0; i < coords.size(); i++) block_coords[i] = coords[i] / arg.dilution_block_dims[i];
-        int block_idx = ((block_coords[3] * arg.dilution_block_grid[2] + block_coords[2]) * arg.dilution_block_grid[1]
-                         + block_coords[1])
+        block_idx = ((block_coords[3] * arg.dilution_block_grid[2] + block_coords[2]) * arg.dilution_block_grid[1]
+                     + block_coords[1])
             * arg.dilution_block_grid[0]
           + block_coords[0];
+      }
 
-        for (int i = 0; i < arg.dilution_size; i++) { arg.v[i](x_cb, parity) = i == block_idx ? src : vector(); }
+      if (Arg::type == QUDA_DILUTION_BLOCK) {
+        for (int i = 0; i < arg.dilution_size; i++) {
+          arg.v[i](x_cb, parity) = arg.offset + i == block_idx ? src : vector();
+        }
       } else {
-        for (int i = 0; i < Arg::max_dilution_size; i++) { // for these types max = actual size
+        for (int i = 0; i < arg.dilution_size; i++) {
+          // the complete set is ordered with the spin/color/parity pattern running fastest
+          int k = arg.offset + i;
+          int pattern = k % Arg::max_dilution_size; // for these types max = pattern size
+          bool in_block = !arg.blocked || k / Arg::max_dilution_size == block_idx;
           vector v;
 
           for (int s = 0; s < Arg::nSpin; s++) {
             for (int c = 0; c < Arg::nColor; c++) {
-              v(s, c) = write_source(i, s, c, parity) ? src(s, c) : complex<typename Arg::real>(0.0, 0.0);
+              v(s, c) = in_block && write_source(pattern, s, c, parity) ? src(s, c) :
+                                                                          complex<typename Arg::real>(0.0, 0.0);
             }
           }
 
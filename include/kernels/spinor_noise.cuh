@@ -7,24 +7,28 @@ namespace quda {
 
   using namespace colorspinor;
 
-  template <typename real_, int nSpin_, int nColor_, QudaNoiseType noise_>
+  template <typename real_, int nSpin_, int nColor_, QudaNoiseType noise_, bool host_ = false>
   struct SpinorNoiseArg : kernel_param<> {
     using real = real_;
     static constexpr int nSpin = nSpin_;
     static constexpr int nColor = nColor_;
-    static constexpr QudaFieldOrder order = colorspinor::getNative<real>(nSpin);
+    static constexpr bool host = host_; // host generation is only supported with the counter-based generator
+    static constexpr QudaFieldOrder order
+      = host ? QUDA_SPACE_SPIN_COLOR_FIELD_ORDER : colorspinor::getNative<real>(nSpin);
     static constexpr QudaNoiseType noise = noise_;
     using V = typename colorspinor::FieldOrderCB<real, nSpin, nColor, 1, order>;
     V v;
     RNGState *rng;
-    SpinorNoiseArg(ColorSpinorField &v, RNGState *rng) :
+    CounterRNG counter;
+    SpinorNoiseArg(ColorSpinorField &v, RNGState *rng, const CounterRNG &counter) :
       kernel_param(dim3(v.VolumeCB(), v.SiteSubset(), 1)),
       v(v),
-      rng(rng) { }
+      rng(rng),
+      counter(counter) { }
   };
 
-  template<typename real, typename Arg> // Gauss
-  __device__ __host__ inline void genGauss(Arg &arg, RNGState& localState, int parity, int x_cb, int s, int c) {
+  template<typename real, typename Arg, typename State> // Gauss
+  __device__ __host__ inline void genGauss(Arg &arg, State& localState, int parity, int x_cb, int s, int c) {
     real phi = 2.0 * uniform<real>::rand(localState);
     real radius = uniform<real>::rand(localState);
     radius = sqrt(-log(radius));
@@ -33,8 +37,8 @@ namespace quda {
     arg.v(parity, x_cb, s, c) = radius * complex<real>(phi_cos, phi_sin);
   }
 
-  template<typename real, typename Arg> // Uniform
-  __device__ __host__ inline void genUniform(Arg &arg, RNGState& localState, int parity, int x_cb, int s, int c) {
+  template<typename real, typename Arg, typename State> // Uniform
+  __device__ __host__ inline void genUniform(Arg &arg, State& localState, int parity, int x_cb, int s, int c) {
     real x = uniform<real>::rand(localState);
     real y = uniform<real>::rand(localState);
     arg.v(parity, x_cb, s, c) = complex<real>(x, y);
@@ -45,16 +49,26 @@ namespace quda {
     constexpr NoiseSpinor(const Arg &arg) : arg(arg) {}
     static constexpr const char* filename() { return KERNEL_FILE; }
 
-    __device__ __host__ void operator()(int x_cb, int parity)
+    template <typename State> __device__ __host__ void noise(State &localState, int x_cb, int parity)
     {
-      RNGState localState = arg.rng[parity * arg.threads.x + x_cb];
       for (int s=0; s<Arg::nSpin; s++) {
         for (int c=0; c<Arg::nColor; c++) {
           if (Arg::noise == QUDA_NOISE_GAUSS) genGauss<typename Arg::real>(arg, localState, parity, x_cb, s, c);
           else if (Arg::noise == QUDA_NOISE_UNIFORM) genUniform<typename Arg::real>(arg, localState, parity, x_cb, s, c);
         }
       }
-      arg.rng[parity * arg.threads.x + x_cb] = localState;
+    }
+
+    __device__ __host__ void operator()(int x_cb, int parity)
+    {
+      if (Arg::host || arg.counter.enabled) {
+        PhiloxState localState(arg.counter, x_cb, parity);
+        noise(localState, x_cb, parity);
+      } else if constexpr (!Arg::host) {
+        RNGState localState = arg.rng[parity * arg.threads.x + x_cb];
+        noise(localState, x_cb, parity);
+        arg.rng[parity * arg.threads.x + x_cb] = localState;
+      }
     }
   };
 
@@ -375,22 +375,22 @@ namespace quda {
     array_3d<void *, 2, QUDA_MAX_DIM, 2> from_face_dim_dir_d = {};
 
     /**
-       Message handles for receiving
+       Message handles for receiving (owned by the comms plan cache)
     */
     array_3d<MsgHandle *, 2, QUDA_MAX_DIM, 2> mh_recv = {};
 
     /**
-       Message handles for sending
+       Message handles for sending (owned by the comms plan cache)
     */
     array_3d<MsgHandle *, 2, QUDA_MAX_DIM, 2> mh_send = {};
 
     /**
-       Message handles for receiving
+       Message handles for receiving with GDR (owned by the comms plan cache)
     */
     array_3d<MsgHandle *, 2, QUDA_MAX_DIM, 2> mh_recv_rdma = {};
 
     /**
-       Message handles for sending
+       Message handles for sending with GDR (owned by the comms plan cache)
     */
     array_3d<MsgHandle *, 2, QUDA_MAX_DIM, 2> mh_send_rdma = {};
 
@@ -429,6 +429,16 @@ namespace quda {
     */
     bool initComms = false;
 
+    /**
+       Incremented whenever the cached comms plans are destroyed
+    */
+    inline static uint64_t comms_plan_epoch = 0;
+
+    /**
+       The comms plan epoch when this field's message handles were set
+    */
+    uint64_t comms_epoch = 0;
+
     /**
        Whether we have initialized peer-to-peer communication
     */
@@ -539,14 +549,29 @@ namespace quda {
     static void freeGhostBuffer(void);
 
     /**
-       Create the communication handlers (both host and device)
+       @brief Free the cached comms plans.  Each plan holds the
+       persistent message handles for one halo layout on the static
+       ghost buffers, and so must be freed whenever these buffers are
+       reallocated.  This also frees the halo compression staging
+       buffers and handles (see halo_compress.h).
+    */
+    static void destroyCommsPlans();
+
+    /**
+       Create the communication handlers (both host and device).  The
+       persistent message handles are taken from a cache of comms
+       plans keyed by the halo layout (the per-dimension face sizes
+       and offsets, which follow from the geometry, precision, number
+       of faces and site subset), so they are only declared the first
+       time a given layout is used.
        @param[in] no_comms_fill Whether to allocate halo buffers for
        dimensions that are not partitioned
     */
     void createComms(bool no_comms_fill = false);
 
     /**
-       Destroy the communication handlers
+       Destroy the communication handlers.  The message handles
+       themselves remain in the comms plan cache.
     */
     void destroyComms();
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 
 /**
  * sets the cpu affinity of the calling process to the affinity mask reported by nvidia-smi topo
@@ -8,3 +9,62 @@
  * @return          0 if numa affinity was set
  */
 int setNumaAffinityNVML(int deviceid);
+
+namespace quda
+{
+
+  namespace topology
+  {
+
+    /**
+       The roles of QUDA's host threads, each of which is given its
+       own set of cores
+     */
+    enum class ThreadRole { WORKER, PROGRESS };
+
+    /**
+       @brief Discover the host topology and assign cores to the
+       thread roles of this rank.  The topology is read from /sys and
+       /proc, and the cores considered are those allowed by both the
+       process affinity mask and the cgroup cpuset.  If the launcher
+       has not already bound the ranks sharing a node to distinct
+       cores, the allowed cores are split between these ranks.  Of
+       the rank's cores, the last is reserved for the communication
+       progress thread (if there are enough), with the remainder for
+       the worker threads.  Each OpenMP thread is bound to the worker
+       cores, while the calling thread keeps its mask unless
+       QUDA_AFFINITY_BIND_CALLER=1 is set.  This is enabled by setting
+       QUDA_ENABLE_AFFINITY=1, and is otherwise a no-op.  Called by
+       initQuda once communications have been initialized, and
+       collective over all ranks.
+     */
+    void init();
+
+    /**
+       @return Whether thread binding has been enabled
+     */
+    bool enabled();
+
+    /**
+       @brief Bind the calling thread to the cores of the given role.
+       This is a no-op if binding has not been enabled.
+       @param[in] role The role of the calling thread
+     */
+    void bind(ThreadRole role);
+
+    /**
+       @param[in] role Thread role
+       @return The logical cpus assigned to the role on this rank
+     */
+    const std::vector<int> &cpus(ThreadRole role);
+
+    /**
+       @brief Print the core assignment of every rank from the print
+       rank at QUDA_SUMMARIZE verbosity.  This is collective over all
+       ranks.
+     */
+    void print();
+
+  } // namespace topology
+
+} // namespace quda
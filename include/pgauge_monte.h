@@ -7,6 +7,8 @@ namespace quda {
 
   /**
    * @brief Perform heatbath and overrelaxation. Performs nhb heatbath steps followed by nover overrelaxation steps.
+   * On a partitioned lattice, the halo exchange of each updated link is overlapped with the interior update of the
+   * next one.
    *
    * @param[in,out] data Gauge field
    * @param[in,out] rngstate state of the CURAND random number generator
@@ -16,6 +18,26 @@ namespace quda {
    */
   void Monte(GaugeField &data, RNG &rngstate, double Beta, int nhb, int nover);
 
+  /**
+   * @brief Perform a single multi-hit sweep.  In contrast to Monte,
+   * which performs each heatbath and overrelaxation sweep separately,
+   * each link is updated by n_hb heatbath hits followed by an optional
+   * overrelaxation hit in a single kernel, with the staple computed
+   * once.  Since overrelaxation at fixed staple is close to an
+   * involution, at most one overrelaxation hit is applied per link.
+   * This reduces the number of kernel launches, staple computations
+   * and halo exchanges per sweep by a factor n_hb + ovr.  As for
+   * Monte, host fields (QDP order) are updated with a threaded host
+   * implementation, which requires the counter-based generator.
+   *
+   * @param[in,out] data Gauge field
+   * @param[in,out] rngstate state of the random number generator
+   * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
+   * @param[in] n_hb number of heatbath hits per link
+   * @param[in] ovr whether to apply an overrelaxation hit per link
+   */
+  void MonteMultiHit(GaugeField &data, RNG &rngstate, double Beta, int n_hb, bool ovr);
+
   /**
    * @brief Perform a cold start to the gauge field, identity SU(3)
    * matrix, also fills the ghost links in multi-GPU case (no need to
@@ -44,8 +66,11 @@ namespace quda {
    * @param[in,out] data Gauge field
    * @param[in] n_dim Number of dimensions to exchange
    * @param[in] parity Field parity
+   * @param[in] sync_device Whether to synchronize the whole device
+   * before and after the exchange, or only the default stream
+   * before it, so that work on other streams may overlap with it
    */
-  void PGaugeExchange(GaugeField &data, const int n_dim, const int parity);
+  void PGaugeExchange(GaugeField &data, const int n_dim, const int parity, bool sync_device = true);
 
   /**
    * @brief Release all allocated memory used to exchange data between nodes
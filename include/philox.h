@@ -0,0 +1,163 @@
+/*
+   A counter-based random number generator, Philox4x32-10, from
+      John K. Salmon, Mark A. Moraes, Ron O. Dror, David E. Shaw
+      Parallel Random Numbers: As Easy as 1, 2, 3
+      SC '11, doi:10.1145/2063384.2063405
+
+   In contrast to the stateful generators (MRG32k3a / XORWOW), the
+   random numbers are a pure function of (seed, counter), so no
+   per-site state needs to be stored, and the stream that a given
+   lattice site sees depends only on its global coordinate and not
+   on how the lattice is partitioned, nor whether we are running on
+   the host or the device.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <math_helper.cuh>
+#include <counter_rng.h>
+
+namespace quda
+{
+
+  /**
+     @brief Per-thread generator state for the Philox4x32-10
+     generator.  This is constructed on the fly from the CounterRNG
+     parameters and the site index, and is never written back to
+     memory.  The 128-bit counter is composed from (block, site_lo,
+     site_hi, stream), where block is incremented every four 32-bit
+     draws.
+   */
+  class PhiloxState
+  {
+    uint32_t key[2];
+    uint32_t ctr[4];
+    uint32_t out[4];
+    int idx = 4;
+
+    bool has_extf = false;
+    bool has_extd = false;
+    float extf = 0.0f;
+    double extd = 0.0;
+
+    static constexpr uint32_t M0 = 0xD2511F53;
+    static constexpr uint32_t M1 = 0xCD9E8D57;
+    static constexpr uint32_t W0 = 0x9E3779B9;
+    static constexpr uint32_t W1 = 0xBB67AE85;
+
+    __device__ __host__ inline static void mulhilo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo)
+    {
+      uint64_t p = static_cast<uint64_t>(a) * b;
+      hi = static_cast<uint32_t>(p >> 32);
+      lo = static_cast<uint32_t>(p);
+    }
+
+    __device__ __host__ inline void generate()
+    {
+      uint32_t c[4] = {ctr[0], ctr[1], ctr[2], ctr[3]};
+      uint32_t k[2] = {key[0], key[1]};
+#pragma unroll
+      for (int r = 0; r < 10; r++) {
+        uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(M0, c[0], hi0, lo0);
+        mulhilo(M1, c[2], hi1, lo1);
+        c[0] = hi1 ^ c[1] ^ k[0];
+        c[1] = lo1;
+        c[2] = hi0 ^ c[3] ^ k[1];
+        c[3] = lo0;
+        k[0] += W0;
+        k[1] += W1;
+      }
+      for (int i = 0; i < 4; i++) out[i] = c[i];
+      ctr[0]++;
+      idx = 0;
+    }
+
+  public:
+    /**
+       @brief Construct the generator state for a given site
+       @param[in] rng The counter-based stream parameters
+       @param[in] x_cb Checkerboard site index
+       @param[in] parity Site parity
+     */
+    __device__ __host__ inline PhiloxState(const CounterRNG &rng, int x_cb, int parity)
+    {
+      uint64_t site = rng.site(x_cb, parity);
+      key[0] = static_cast<uint32_t>(rng.seed);
+      key[1] = static_cast<uint32_t>(rng.seed >> 32);
+      ctr[0] = 0;
+      ctr[1] = static_cast<uint32_t>(site);
+      ctr[2] = static_cast<uint32_t>(site >> 32);
+      ctr[3] = rng.stream;
+    }
+
+    /**
+       @return The next 32-bit random integer
+     */
+    __device__ __host__ inline uint32_t next()
+    {
+      if (idx == 4) generate();
+      return out[idx++];
+    }
+
+    /**
+       @return A uniform deviate in the open interval (0,1) with 24
+       bits of randomness
+     */
+    __device__ __host__ inline float uniform_float()
+    {
+      return static_cast<float>(next() >> 8) * 0x1.0p-24f + 0x1.0p-25f;
+    }
+
+    /**
+       @return A uniform deviate in the open interval (0,1) with 53
+       bits of randomness
+     */
+    __device__ __host__ inline double uniform_double()
+    {
+      uint64_t a = next() >> 5;
+      uint64_t b = next() >> 6;
+      return static_cast<double>((a << 26) + b) * 0x1.0p-53 + 0x1.0p-54;
+    }
+
+    /**
+       @return A normal deviate with zero mean and unit variance,
+       generated in pairs using the Box-Muller transform
+     */
+    __device__ __host__ inline float normal_float()
+    {
+      if (has_extf) {
+        has_extf = false;
+        return extf;
+      }
+      float radius = sqrtf(-2.0f * logf(uniform_float()));
+      float phi = 2.0f * uniform_float();
+      float s, c;
+      quda::sincospi(phi, &s, &c);
+      has_extf = true;
+      extf = radius * s;
+      return radius * c;
+    }
+
+    /**
+       @return A normal deviate with zero mean and unit variance,
+       generated in pairs using the Box-Muller transform
+     */
+    __device__ __host__ inline double normal_double()
+    {
+      if (has_extd) {
+        has_extd = false;
+        return extd;
+      }
+      double radius = sqrt(-2.0 * log(uniform_double()));
+      double phi = 2.0 * uniform_double();
+      double s, c;
+      quda::sincospi(phi, &s, &c);
+      has_extd = true;
+      extd = radius * s;
+      return radius * c;
+    }
+  };
+
+} // namespace quda
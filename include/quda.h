@@ -44,6 +44,8 @@ extern "C" {
     QudaTboundary t_boundary;  /**< The temporal boundary condition that will be used for fermion fields */
 
     QudaPrecision cpu_prec; /**< The precision used by the caller */
+    QudaReconstructType cpu_reconstruct; /**< The reconstruction type of the caller's SU(3) gauge field
+                                            (QUDA_RECONSTRUCT_NO, 12 or 8; QDP and MILC orders only) */
 
     QudaPrecision cuda_prec; /**< The precision of the cuda gauge field */
     QudaReconstructType reconstruct; /**< The reconstruction type of the cuda gauge field */
@@ -90,6 +92,14 @@ extern "C" {
     size_t gauge_offset; /**< Offset into MILC site struct to the gauge field (only if gauge_order=MILC_SITE_GAUGE_ORDER) */
     size_t mom_offset; /**< Offset into MILC site struct to the momentum field (only if gauge_order=MILC_SITE_GAUGE_ORDER) */
     size_t site_size; /**< Size of MILC site struct (only if gauge_order=MILC_SITE_GAUGE_ORDER) */
+
+    QudaBoolean compute_checksum; /**< Compute the checksums of the host gauge field in loadGaugeQuda and saveGaugeQuda,
+                                     returning them in checksum_scidac and checksum_quda */
+    QudaBoolean verify_checksum;  /**< Verify the checksums of the host gauge field in loadGaugeQuda against
+                                     checksum_scidac and checksum_quda, erroring on a mismatch */
+    QudaPrecision checksum_prec;  /**< Precision of the file record the SciDAC checksum refers to (defaults to cpu_prec) */
+    unsigned int checksum_scidac[2];  /**< SciDAC / ILDG checksum (suma, sumb) of the host gauge field */
+    unsigned long long checksum_quda; /**< QUDA's XOR-based checksum of the host gauge field */
   } QudaGaugeParam;
 
 
@@ -339,6 +349,16 @@ extern "C" {
     /** Maximum eigenvalue for Chebyshev CA basis in a preconditioner solver */
     double ca_lambda_max_precondition;
 
+    /** Whether to estimate the Chebyshev CA basis bounds with Arnoldi
+        (Lanczos for Hermitian operators) where these are not set, and
+        to reduce the basis size gcrNkrylov to the largest numerically
+        stable value */
+    QudaBoolean ca_adaptive;
+
+    /** Whether to estimate the Chebyshev CA basis bounds with Arnoldi
+        in a preconditioner solver where these are not set */
+    QudaBoolean ca_adaptive_precondition;
+
     /** Number of preconditioner cycles to perform per iteration */
     int precondition_cycle;
 
@@ -438,6 +458,10 @@ extern "C" {
     /** Precision to store the chronological basis in */
     QudaPrecision chrono_precision;
 
+    /** Device memory budget in GiB for the chronological basis of
+        this index, further capping chrono_max_dim (0 = no budget) */
+    double chrono_memory_budget;
+
     /** Which external library to use in the linear solvers (Eigen) */
     QudaExtLibType extlib_type;
 
@@ -524,6 +548,12 @@ extern "C" {
     int n_conv;
     /** Number of requested converged eigenvectors to use in deflation **/
     int n_ev_deflate;
+    /** The precision in which deflated solvers store the deflation
+        space.  If lower than the eigensolver precision, the
+        eigenvectors are compressed once computed, and the guess is
+        deflated with the projected matrix V^dag A V rather than the
+        eigenvalues (see deflation_store.h) **/
+    QudaPrecision deflation_prec;
     /** Tolerance on the least well known eigenvalue's residual **/
     double tol;
     /** Tolerance on the QR iteration **/
@@ -785,6 +815,14 @@ extern "C" {
     /** Whether to store the null-space vectors in singlefile or partfile format */
     QudaBoolean mg_vec_partfile[QUDA_MAX_MG_LEVEL];
 
+    /** The precision with which to save the null-space vectors.  Half
+        or quarter precision selects the compressed per-rank format,
+        with fixed-point storage and a scale factor per site, which
+        does not require QIO but must be loaded on the same process
+        grid.  QUDA_INVALID_PRECISION saves at the field precision.
+        This also selects the format when loading the vectors. */
+    QudaPrecision vec_save_prec[QUDA_MAX_MG_LEVEL];
+
     /** Whether to use and initial guess during coarse grid deflation */
     QudaBoolean coarse_guess;
 
@@ -848,6 +886,11 @@ extern "C" {
     double rho; /**< Serves as one of the coefficients used in Over Improved Stout smearing, or as the single coefficient used in Stout */
     unsigned int meas_interval;    /**< Perform the requested measurements on the gauge field at this interval */
     QudaGaugeSmearType smear_type; /**< The smearing type to perform */
+    double adaptive_tol; /**< If positive, the Wilson/Symanzik flow uses an adaptive step size with this tolerance on
+                            the local error per step, with epsilon the initial step size, and measurements are
+                            interpolated onto the times meas_interval * epsilon up to n_steps * epsilon */
+    int adaptive_steps;    /**< Output: the number of accepted steps taken by the adaptive flow */
+    int adaptive_rejected; /**< Output: the number of rejected steps of the adaptive flow */
   } QudaGaugeSmearParam;
 
   typedef struct QudaBLASParam_s {
@@ -962,6 +1005,74 @@ extern "C" {
 
   void initCommsGridQuda(int nDim, const int *dims, QudaCommsMap func, void *fdata);
 
+  /**
+   * Description of the node topology used by adviseCommsLayoutQuda().
+   * Ranks are assumed to be numbered consecutively within each node,
+   * and within each socket of a node, as is the default of most job
+   * launchers.  Bandwidths that are not positive take default values
+   * of 25 GB/s (network), 50 GB/s (between sockets) and 150 GB/s
+   * (within a socket).
+   */
+  typedef struct QudaCommsTopology_s {
+    int ranks_per_node;            /**< Number of ranks on each node */
+    int ranks_per_socket;          /**< Number of ranks on each socket, which must divide ranks_per_node */
+    double inter_node_bandwidth;   /**< Network bandwidth per node (GB/s), shared by the node's ranks */
+    double inter_socket_bandwidth; /**< Bandwidth between the sockets of a node (GB/s), shared by the node's ranks */
+    double intra_socket_bandwidth; /**< Bandwidth between two ranks on the same socket (GB/s) */
+  } QudaCommsTopology;
+
+  /**
+   * A processor grid together with the assignment of its ranks to
+   * nodes and sockets, as returned by adviseCommsLayoutQuda().
+   */
+  typedef struct QudaCommsLayout_s {
+    int grid[4];        /**< Processor grid */
+    int node_grid[4];   /**< Extent of the block of the processor grid placed on each node */
+    int socket_grid[4]; /**< Extent of the block of the processor grid placed on each socket */
+    double cost;        /**< Modeled halo-exchange time of one face site per link (arbitrary units) */
+  } QudaCommsLayout;
+
+  /**
+   * Choose the processor grid and rank mapping for a given lattice,
+   * rank count and node topology.  Every grid that evenly divides the
+   * lattice into local volumes with even extents is considered, with
+   * every placement of blocks of the grid onto nodes and sockets.  A
+   * communication cost model assigns each halo face to the network,
+   * the inter-socket links or the intra-socket links according to
+   * where the neighbouring ranks live, and takes the time of the most
+   * loaded of these, with ties broken by the local surface-to-volume
+   * ratio.  The resulting layout can be passed to initCommsGridQuda()
+   * as the fdata of rankFromCoordsLayoutQuda().  Since this is
+   * intended to be called before communications are initialized, it
+   * neither prints nor aborts, and failure is reported through the
+   * return value.
+   *
+   * @param layout    On input, positive entries of layout->grid fix
+   *                  the processor grid extent in that dimension,
+   *                  while zero entries are free.  On output, the
+   *                  chosen layout.
+   * @param lattice   Global lattice dimensions
+   * @param n_ranks   Number of ranks
+   * @param topology  Node topology
+   * @return          0 on success, or nonzero if the arguments are
+   *                  invalid or no layout satisfies the constraints
+   *                  (in which case layout is unchanged)
+   */
+  int adviseCommsLayoutQuda(QudaCommsLayout *layout, const int *lattice, int n_ranks,
+                            const QudaCommsTopology *topology);
+
+  /**
+   * Rank mapping of a layout returned by adviseCommsLayoutQuda(), of
+   * QudaCommsMap type.  Nodes and the sockets and ranks within each
+   * node are ordered lexicographically with the fourth ("t") index
+   * varying fastest.
+   *
+   * @param coords  Coordinates in the processor grid
+   * @param fdata   Pointer to the QudaCommsLayout
+   * @return        Rank at these coordinates
+   */
+  int rankFromCoordsLayoutQuda(const int *coords, void *fdata);
+
   /**
    * Initialize the library.  This is a low-level interface that is
    * called by initQuda.  Calling initQudaDevice requires that the
@@ -1199,6 +1310,30 @@ extern "C" {
    */
   void invertMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param, void *h_gauge, QudaGaugeParam *gauge_param);
 
+  /**
+   * @brief Generate a stochastic noise source, dilute it, and solve
+   * for every element of the dilution set using @invertMultiSrcQuda.
+   * The diluted sources are generated directly on the device in
+   * batches of param->num_src (the complete set if num_src <= 0),
+   * and, unless split grid is in use, are passed to the solver
+   * without staging through the host.  If all elements of
+   * dilution_block are set, the spin/color dilution types are
+   * composed with block dilution, e.g., {X, Y, Z, 1} gives
+   * spin-color-time dilution.
+   * @param hp_x        Array of solution spinor fields, one per diluted source
+   * @param hp_noise    Optional source spinor field to hold the undiluted noise (may be nullptr)
+   * @param param       Contains all metadata regarding host and device storage and solver parameters
+   * @param h_gauge     Base pointer to host gauge field (used with split grid)
+   * @param gauge_param Contains all metadata regarding host and device storage for gauge field
+   * @param seed        Seed for the noise generation
+   * @param noise_type  The type of noise to generate
+   * @param dilution_type The type of dilution to apply
+   * @param dilution_block The global block size for block dilution (may be nullptr for the other types)
+   */
+  void invertDilutedNoiseQuda(void **hp_x, void *hp_noise, QudaInvertParam *param, void *h_gauge,
+                              QudaGaugeParam *gauge_param, unsigned long long seed, QudaNoiseType noise_type,
+                              QudaDilutionType dilution_type, const int *dilution_block);
+
   /**
    * @brief Really the same with @invertMultiSrcQuda but for staggered-style fermions, by accepting pointers
    * to fat links and long links.
@@ -1235,6 +1370,22 @@ extern "C" {
    */
   void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param);
 
+  /**
+   * Solve for multiple shifts (e.g., masses) on param->num_src
+   * independent sources (e.g., the pseudofermions of a rational
+   * force calculation) simultaneously, with the operator applied to
+   * all sources at once in each iteration.  The shifts and solver
+   * parameters are common to all sources.  On return the residuals
+   * reported for each shift are the worst over the sources, and the
+   * action (if requested) is summed over the sources.  Resident
+   * solutions are stored source major.
+   * @param _hp_x    Array of solution spinor fields for each source, _hp_x[src][shift]
+   * @param _hp_b    Array of source spinor fields
+   * @param param  Contains all metadata regarding host and device
+   *               storage and solver parameters
+   */
+  void invertMultiShiftMultiSrcQuda(void ***_hp_x, void **_hp_b, QudaInvertParam *param);
+
   /**
    * Setup the multigrid solver, according to the parameters set in param.  It
    * is assumed that the gauge field has already been loaded via
@@ -1670,6 +1821,24 @@ extern "C" {
   void contractQuda(const void *x, const void *y, void *result, const QudaContractType cType, QudaInvertParam *param,
                     const int *X);
 
+  /**
+   * Public function to perform color contractions of the host spinors
+   * x and y, projected onto a set of momenta and summed over each time
+   * slice on the device.  Only the time-slice correlators are
+   * returned, rather than the per-site result of contractQuda.
+   * @param[in] x pointer to host data
+   * @param[in] y pointer to host data
+   * @param[out] result pointer to host array of 2 * n_mom * T * 16 doubles, where T is the
+   * global temporal extent, ordered as ((mom * T + t) * 16 + spin) complex numbers
+   * @param[in] cType Which type of contraction (open, degrand-rossi)
+   * @param[in] mom array of 3 * n_mom integer momentum modes, with p_i = 2 pi mom_i / L_i
+   * @param[in] n_mom number of momenta
+   * @param[in] param meta data for construction of ColorSpinorFields.
+   * @param[in] X spacetime data for construction of ColorSpinorFields.
+   */
+  void contractSummedQuda(const void *x, const void *y, double *result, const QudaContractType cType, const int *mom,
+                          int n_mom, QudaInvertParam *param, const int *X);
+
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
    * @param[in,out] gauge, gauge field to be fixed
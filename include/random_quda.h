@@ -3,6 +3,7 @@
 #include <memory>
 #include <quda_define.h>
 #include <lattice_field.h>
+#include <counter_rng.h>
 
 namespace quda {
 
@@ -19,6 +20,7 @@ namespace quda {
     std::shared_ptr<RNGState> state; /*! array with current curand rng state */
     RNGState *backup_state;          /*! array for backup of current curand rng state */
     unsigned long long seed;         /*! initial rng seed */
+    CounterRNG counter;              /*! counter-based stream parameters */
 
   public:
     /**
@@ -26,18 +28,33 @@ namespace quda {
        takes its metadata from pre-existing field
        @param[in] meta The field whose data we use
        @param[in] seed Seed to initialize the RNG
+       @param[in] counter_based Whether to use the stateless
+       counter-based (Philox) generator.  This is also enabled for all
+       RNG instances by setting QUDA_ENABLE_COUNTER_RNG=1.
     */
-    RNG(const LatticeField &meta, unsigned long long seedin);
+    RNG(const LatticeField &meta, unsigned long long seedin, bool counter_based = false);
 
     unsigned long long Seed() { return seed; };
 
+    /*! @brief Whether this is a counter-based generator */
+    bool isCounterBased() const { return counter.enabled; }
+
+    /**
+       @brief Return the counter-based stream parameters to be used
+       for a kernel launch, and advance the stream so that the next
+       use draws independent random numbers.  This should be called
+       once per logical use (not per tuning launch) so that the
+       result is independent of autotuning.
+    */
+    CounterRNG Counter();
+
     /*! @brief Restore rng array states initialization */
     void restore();
 
     /*! @brief Backup rng array states initialization */
     void backup();
 
-    /*! @brief Get pointer to RNGState */
+    /*! @brief Get pointer to RNGState (nullptr if counter-based) */
     RNGState *State() { return state.get(); };
   };
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <quda.h>
 #include <comm_quda.h>
 #include <communicator_quda.h>
@@ -203,4 +206,215 @@ namespace quda
     for (auto &p : v_mh_send) { comm_free(p); };
   }
 
+  /**
+     @brief Pipelined redistribution of a sequence of batches of fields
+     between the full processor grid and the split-grid
+     sub-partitions.  This performs the same data movement as
+     split_field and join_field for each batch, but with non-blocking
+     messages, so that the split of the next batch of sources and the
+     join of the previous batch of solutions can be in flight while a
+     batch is being solved on the sub-partitions.  The pinned staging
+     buffers and persistent message handles are declared once and are
+     reused by every batch, with a ring of depth two, and since the
+     handles are bound to the full processor grid at declaration they
+     can be started while the split communicator is current.
+
+     The expected schedule on every rank is: split_start(0), and then
+     for each batch n: split_wait(n), split_start(n + 1), solve,
+     join_start(n), join_wait(n - 1); followed by join_wait of the last
+     batch.  The pipeline must be created and destroyed while the
+     default communicator is current.
+   */
+  template <class Field> class SplitGridPipeline
+  {
+    static constexpr int depth = 2;
+
+    /**
+       Staging buffers and message handles of one direction of
+       redistribution (split or join) for one slot of the ring
+     */
+    struct Slot {
+      std::vector<void *> send_h;
+      std::vector<void *> recv_h;
+      std::vector<MsgHandle *> mh_send;
+      std::vector<MsgHandle *> mh_recv;
+      bool send_active = false;
+      bool recv_active = false;
+    };
+
+    const CommKey comm_key;
+    const QudaPCType pc_type;
+    const int n_replicates;
+    std::unique_ptr<Field> buffer_field;
+    CommKey field_dim;
+    Slot split_slot[depth];
+    Slot join_slot[depth];
+
+    void wait_send(Slot &slot)
+    {
+      if (!slot.send_active) return;
+      for (auto &mh : slot.mh_send) comm_wait(mh);
+      slot.send_active = false;
+    }
+
+    void wait_recv(Slot &slot)
+    {
+      if (!slot.recv_active) errorQuda("No receive has been started for this batch");
+      for (auto &mh : slot.mh_recv) comm_wait(mh);
+      slot.recv_active = false;
+    }
+
+    void start(Slot &slot)
+    {
+      for (auto &mh : slot.mh_recv) comm_start(mh);
+      for (auto &mh : slot.mh_send) comm_start(mh);
+      slot.send_active = true;
+      slot.recv_active = true;
+    }
+
+  public:
+    /**
+       @brief Declare the staging buffers and message handles
+       @param[in] meta Field with the dimensions and layout of the
+       fields on the full processor grid
+       @param[in] comm_key The split-grid partitioning
+       @param[in] pc_type The preconditioning type of the fields
+     */
+    SplitGridPipeline(const Field &meta, const CommKey &comm_key, QudaPCType pc_type = QUDA_4D_PC) :
+      comm_key(comm_key), pc_type(pc_type), n_replicates(product(comm_key))
+    {
+      CommKey comm_grid_dim = {comm_dim(0), comm_dim(1), comm_dim(2), comm_dim(3)};
+      CommKey comm_grid_idx = {comm_coord(0), comm_coord(1), comm_coord(2), comm_coord(3)};
+
+      // see split_field for the meaning of these
+      auto processor_dim = comm_grid_dim / comm_key;
+      auto partition_dim = comm_grid_dim / processor_dim;
+
+      typename Field::param_type param(meta);
+      buffer_field.reset(Field::Create(param));
+      field_dim = {meta.full_dim(0), meta.full_dim(1), meta.full_dim(2), meta.full_dim(3)};
+
+      size_t bytes = meta.TotalBytes();
+
+      // A rank exchanges at most one message with a given peer per
+      // direction of redistribution and slot, since distinct
+      // replicates map to distinct peers, so the tag need only
+      // distinguish the direction and slot.  This keeps the tags far
+      // below the smallest MPI_TAG_UB allowed by the standard (32767),
+      // independently of the number of ranks.
+      auto tag = [](int slot, int kind) { return slot * 2 + kind; };
+
+      for (int b = 0; b < depth; b++) {
+        for (auto slot : {&split_slot[b], &join_slot[b]}) {
+          slot->send_h.resize(n_replicates);
+          slot->recv_h.resize(n_replicates);
+          slot->mh_send.resize(n_replicates);
+          slot->mh_recv.resize(n_replicates);
+        }
+
+        for (int i = 0; i < n_replicates; i++) {
+          auto partition_idx = coordinate_from_index(i, comm_key);
+          auto processor_idx = comm_grid_idx / partition_dim;
+          int full_rank = comm_rank_from_coords((partition_idx * processor_dim + processor_idx).data());
+          int sub_rank = comm_rank_from_coords(((comm_grid_idx % processor_dim) * partition_dim + partition_idx).data());
+
+          auto &split = split_slot[b];
+          split.send_h[i] = pinned_malloc(bytes);
+          split.recv_h[i] = pinned_malloc(bytes);
+          split.mh_send[i] = comm_declare_send_rank(split.send_h[i], full_rank, tag(b, 0), bytes);
+          split.mh_recv[i] = comm_declare_recv_rank(split.recv_h[i], sub_rank, tag(b, 0), bytes);
+
+          auto &join = join_slot[b];
+          join.send_h[i] = pinned_malloc(bytes);
+          join.recv_h[i] = pinned_malloc(bytes);
+          join.mh_send[i] = comm_declare_send_rank(join.send_h[i], sub_rank, tag(b, 1), bytes);
+          join.mh_recv[i] = comm_declare_recv_rank(join.recv_h[i], full_rank, tag(b, 1), bytes);
+        }
+      }
+    }
+
+    SplitGridPipeline(const SplitGridPipeline &) = delete;
+    SplitGridPipeline &operator=(const SplitGridPipeline &) = delete;
+
+    /**
+       @brief Wait for any outstanding messages and free the buffers
+       and message handles
+     */
+    ~SplitGridPipeline()
+    {
+      for (int b = 0; b < depth; b++) {
+        for (auto slot : {&split_slot[b], &join_slot[b]}) {
+          wait_send(*slot);
+          if (slot->recv_active) wait_recv(*slot);
+          for (auto &p : slot->send_h) host_free(p);
+          for (auto &p : slot->recv_h) host_free(p);
+          for (auto &mh : slot->mh_send) comm_free(mh);
+          for (auto &mh : slot->mh_recv) comm_free(mh);
+        }
+      }
+    }
+
+    /**
+       @brief Start the split of a batch of fields
+       @param[in] batch Batch index
+       @param[in] v_base_field The n_replicates fields of this batch on
+       the full processor grid
+     */
+    void split_start(int batch, const std::vector<Field *> &v_base_field)
+    {
+      if (static_cast<int>(v_base_field.size()) != n_replicates)
+        errorQuda("Expected %d fields per batch, got %lu", n_replicates, v_base_field.size());
+      auto &slot = split_slot[batch % depth];
+      wait_send(slot); // the send buffers are being reused
+      for (int i = 0; i < n_replicates; i++) v_base_field[i]->copy_to_buffer(slot.send_h[i]);
+      start(slot);
+    }
+
+    /**
+       @brief Complete the split of a batch of fields
+       @param[in] batch Batch index
+       @param[out] collect_field The field on the sub-partition
+     */
+    void split_wait(int batch, Field &collect_field)
+    {
+      auto &slot = split_slot[batch % depth];
+      wait_recv(slot);
+      for (int i = 0; i < n_replicates; i++) {
+        buffer_field->copy_from_buffer(slot.recv_h[i]);
+        quda::copyFieldOffset(collect_field, *buffer_field, coordinate_from_index(i, comm_key) * field_dim, pc_type);
+      }
+    }
+
+    /**
+       @brief Start the join of a batch of fields
+       @param[in] batch Batch index
+       @param[in] collect_field The field on the sub-partition
+     */
+    void join_start(int batch, const Field &collect_field)
+    {
+      auto &slot = join_slot[batch % depth];
+      wait_send(slot); // the send buffers are being reused
+      for (int i = 0; i < n_replicates; i++) {
+        quda::copyFieldOffset(*buffer_field, collect_field, coordinate_from_index(i, comm_key) * field_dim, pc_type);
+        buffer_field->copy_to_buffer(slot.send_h[i]);
+      }
+      start(slot);
+    }
+
+    /**
+       @brief Complete the join of a batch of fields
+       @param[in] batch Batch index
+       @param[out] v_base_field The n_replicates fields of this batch on
+       the full processor grid
+     */
+    void join_wait(int batch, const std::vector<Field *> &v_base_field)
+    {
+      if (static_cast<int>(v_base_field.size()) != n_replicates)
+        errorQuda("Expected %d fields per batch, got %lu", n_replicates, v_base_field.size());
+      auto &slot = join_slot[batch % depth];
+      wait_recv(slot);
+      for (int i = 0; i < n_replicates; i++) v_base_field[i]->copy_from_buffer(slot.recv_h[i]);
+    }
+  };
+
 } // namespace quda
@@ -2,6 +2,7 @@
 
 #include <random_quda.h>
 #include <mrg32k3a.h>
+#include <philox.h>
 
 namespace quda
 {
@@ -52,6 +53,23 @@ namespace quda
     {
       return a + (b - a) * (float)target::rng::uniform(state.state);
     }
+
+    /**
+     * \brief Return a uniform deviate between 0 and 1 from the counter-based generator
+     * @param [in,out] the Philox state
+     */
+    static inline float rand(PhiloxState &state) { return state.uniform_float(); }
+
+    /**
+     * \brief Return a uniform deviate between a and b from the counter-based generator
+     * @param [in,out] the Philox state
+     * @param [in] a (the lower end of the range)
+     * @param [in] b (the upper end of the range)
+     */
+    static inline float rand(PhiloxState &state, float a, float b)
+    {
+      return a + (b - a) * state.uniform_float();
+    }
   };
 
   template <> struct uniform<double> {
@@ -71,6 +89,23 @@ namespace quda
     {
       return a + (b - a) * target::rng::uniform(state.state);
     }
+
+    /**
+     * \brief Return a uniform deviate between 0 and 1 from the counter-based generator
+     * @param [in,out] the Philox state
+     */
+    static inline double rand(PhiloxState &state) { return state.uniform_double(); }
+
+    /**
+     * \brief Return a uniform deviate between a and b from the counter-based generator
+     * @param [in,out] the Philox state
+     * @param [in] a -- the lower end of the range
+     * @param [in] b -- the high end of the range
+     */
+    static inline double rand(PhiloxState &state, double a, double b)
+    {
+      return a + (b - a) * state.uniform_double();
+    }
   };
 
   template <class Real> struct normal {
@@ -94,6 +129,12 @@ namespace quda
         return x;
       }
     }
+
+    /**
+     * \brief return a gaussian normal deviate with mean of 0 from the counter-based generator
+     * @param [in,out] the Philox state
+     */
+    static inline float rand(PhiloxState &state) { return state.normal_float(); }
   };
 
   template <> struct normal<double> {
@@ -114,6 +155,12 @@ namespace quda
         return x;
       }
     }
+
+    /**
+     * \brief return a gaussian normal deviate with mean of 0 from the counter-based generator
+     * @param [in,out] the Philox state
+     */
+    static inline double rand(PhiloxState &state) { return state.normal_double(); }
   };
 
 } // namespace quda
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <hiprand_kernel.h>
+#include <philox.h>
 
 namespace quda
 {
@@ -50,6 +51,23 @@ namespace quda
     {
       return a + (b - a) * hiprand_uniform(&state.state);
     }
+
+    /**
+     * \brief Return a uniform deviate between 0 and 1 from the counter-based generator
+     * @param [in,out] the Philox state
+     */
+    __device__ __host__ static inline float rand(PhiloxState &state) { return state.uniform_float(); }
+
+    /**
+     * \brief Return a uniform deviate between a and b from the counter-based generator
+     * @param [in,out] the Philox state
+     * @param [in] a (the lower end of the range)
+     * @param [in] b (the upper end of the range)
+     */
+    __device__ __host__ static inline float rand(PhiloxState &state, float a, float b)
+    {
+      return a + (b - a) * state.uniform_float();
+    }
   };
 
   template <> struct uniform<double> {
@@ -69,6 +87,23 @@ namespace quda
     {
       return a + (b - a) * hiprand_uniform_double(&state.state);
     }
+
+    /**
+     * \brief Return a uniform deviate between 0 and 1 from the counter-based generator
+     * @param [in,out] the Philox state
+     */
+    __device__ __host__ static inline double rand(PhiloxState &state) { return state.uniform_double(); }
+
+    /**
+     * \brief Return a uniform deviate between a and b from the counter-based generator
+     * @param [in,out] the Philox state
+     * @param [in] a -- the lower end of the range
+     * @param [in] b -- the high end of the range
+     */
+    __device__ __host__ static inline double rand(PhiloxState &state, double a, double b)
+    {
+      return a + (b - a) * state.uniform_double();
+    }
   };
 
   template <class Real> struct normal {
@@ -80,6 +115,12 @@ namespace quda
      * @param [in,out] state
      */
     __device__ static inline float rand(RNGState &state) { return hiprand_normal(&state.state); }
+
+    /**
+     * \brief return a gaussian normal deviate with mean of 0 from the counter-based generator
+     * @param [in,out] the Philox state
+     */
+    __device__ __host__ static inline float rand(PhiloxState &state) { return state.normal_float(); }
   };
 
   template <> struct normal<double> {
@@ -88,6 +129,12 @@ namespace quda
      * @param [in,out] state
      */
     __device__ static inline double rand(RNGState &state) { return hiprand_normal_double(&state.state); }
+
+    /**
+     * \brief return a gaussian normal deviate with mean of 0 from the counter-based generator
+     * @param [in,out] the Philox state
+     */
+    __device__ __host__ static inline double rand(PhiloxState &state) { return state.normal_double(); }
   };
 
 } // namespace quda
@@ -9,7 +9,17 @@ namespace quda
 
   /**
      @brief VectorIO is a simple wrapper class for loading and saving
-     sets of vector fields using QIO.
+     sets of vector fields using QIO.  Alternatively, when saving in
+     half or quarter precision, the vectors are written using a
+     compressed per-rank format: each rank writes its local volume to
+     its own file, with the fields stored in fixed-point with a
+     floating-point scale per site (block), in the same fashion as
+     QUDA's native fixed-point field orders.  This format does not
+     require QIO, and is read back in parallel, but requires the same
+     process grid for loading as was used for saving.  The format is
+     selected by the precision passed to save and load, and as with
+     QIO, single-parity fields are inflated to full fields if
+     requested.
    */
   class VectorIO
   {
@@ -17,6 +27,33 @@ namespace quda
     bool parity_inflate;
     bool partfile;
 
+    /**
+       @brief Return the filename used by this rank for the compressed
+       per-rank format
+    */
+    std::string compressed_filename() const;
+
+    /**
+       @brief Query whether a compressed per-rank file set exists for
+       filename.  This is a collective call, and will error out if
+       the compressed files are only found on some of the ranks.
+    */
+    bool compressed_exists() const;
+
+    /**
+       @brief Load vectors from the compressed per-rank format
+       @param[in] vecs The set of vectors to load
+    */
+    void load_compressed(cvector_ref<ColorSpinorField> &vecs);
+
+    /**
+       @brief Save vectors using the compressed per-rank format
+       @param[in] vecs The set of vectors to save
+       @param[in] prec The fixed-point storage precision (half or quarter)
+       @param[in] Nvec The number of vectors to save
+    */
+    void save_compressed(cvector_ref<const ColorSpinorField> &vecs, QudaPrecision prec, int Nvec);
+
   public:
     /**
        Constructor for VectorIO class
@@ -30,13 +67,17 @@ namespace quda
     /**
        @brief Load vectors from filename
        @param[in] vecs The set of vectors to load
+       @param[in] prec The precision the vectors were saved with.  If
+       half or quarter precision, the compressed per-rank format is
+       loaded, else QIO is used.
     */
-    void load(cvector_ref<ColorSpinorField> &vecs);
+    void load(cvector_ref<ColorSpinorField> &vecs, QudaPrecision prec = QUDA_INVALID_PRECISION);
 
     /**
        @brief Save vectors to filename
        @param[in] vecs The set of vectors to save
-       @param[in] prec Optional change of precision when saving
+       @param[in] prec Optional change of precision when saving.  If
+       half or quarter precision, the compressed per-rank format is used.
        @param[in] size Optional cap to number of vectors saved
     */
     void save(cvector_ref<const ColorSpinorField> &vecs, QudaPrecision prec = QUDA_INVALID_PRECISION, uint32_t size = 0);
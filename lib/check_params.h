@@ -73,6 +73,11 @@ void printQudaGaugeParam(QudaGaugeParam *param) {
   P(gauge_order, QUDA_INVALID_GAUGE_ORDER);
   P(t_boundary, QUDA_INVALID_T_BOUNDARY);
   P(cpu_prec, QUDA_INVALID_PRECISION);
+#if defined INIT_PARAM
+  P(cpu_reconstruct, QUDA_RECONSTRUCT_NO);
+#else
+  P(cpu_reconstruct, QUDA_RECONSTRUCT_INVALID);
+#endif
   P(cuda_prec, QUDA_INVALID_PRECISION);
   P(reconstruct, QUDA_RECONSTRUCT_INVALID);
 
@@ -142,6 +147,23 @@ void printQudaGaugeParam(QudaGaugeParam *param) {
   P(site_size, (size_t)INVALID_INT);
 #endif
 
+#if defined INIT_PARAM
+  P(compute_checksum, QUDA_BOOLEAN_FALSE);
+  P(verify_checksum, QUDA_BOOLEAN_FALSE);
+  P(checksum_scidac[0], 0u);
+  P(checksum_scidac[1], 0u);
+  P(checksum_quda, 0ull);
+#else
+  P(compute_checksum, QUDA_BOOLEAN_INVALID);
+  P(verify_checksum, QUDA_BOOLEAN_INVALID);
+#endif
+
+#ifndef CHECK_PARAM
+  P(checksum_prec, QUDA_INVALID_PRECISION);
+#else
+  if (param->checksum_prec == QUDA_INVALID_PRECISION) param->checksum_prec = param->cpu_prec;
+#endif
+
 #ifdef INIT_PARAM
   return ret;
 #endif
@@ -232,7 +254,7 @@ void printQudaEigParam(QudaEigParam *param) {
 
   // only need to enfore block size checking if doing a block eigen solve
 #ifdef CHECK_PARAM
-  if (param->eig_type == QUDA_EIG_BLK_TR_LANCZOS)
+  if (param->eig_type == QUDA_EIG_BLK_TR_LANCZOS || param->eig_type == QUDA_EIG_CHFSI)
 #endif
     P(block_size, INVALID_INT);
 
@@ -248,6 +270,12 @@ void printQudaEigParam(QudaEigParam *param) {
   P(save_prec, QUDA_INVALID_PRECISION);
 #endif
 
+#if defined INIT_PARAM
+  P(deflation_prec, QUDA_DOUBLE_PRECISION);
+#else
+  P(deflation_prec, QUDA_INVALID_PRECISION);
+#endif
+
 #if defined INIT_PARAM
   P(io_parity_inflate, QUDA_BOOLEAN_FALSE);
 #else
@@ -623,6 +651,12 @@ void printQudaInvertParam(QudaInvertParam *param) {
   }
 #endif
 
+#ifdef INIT_PARAM
+  P(ca_adaptive, QUDA_BOOLEAN_FALSE);
+#else
+  if (quda::is_ca_solver(param->inv_type)) P(ca_adaptive, QUDA_BOOLEAN_INVALID);
+#endif
+
 #ifdef INIT_PARAM
   P(ca_basis_precondition, QUDA_POWER_BASIS);
   P(ca_lambda_min_precondition, 0.0);
@@ -637,6 +671,12 @@ void printQudaInvertParam(QudaInvertParam *param) {
   }
 #endif
 
+#ifdef INIT_PARAM
+  P(ca_adaptive_precondition, QUDA_BOOLEAN_FALSE);
+#else
+  if (quda::is_ca_solver(param->inv_type)) P(ca_adaptive_precondition, QUDA_BOOLEAN_INVALID);
+#endif
+
   P(verbosity, QUDA_INVALID_VERBOSITY);
 
 #ifdef INIT_PARAM
@@ -690,12 +730,14 @@ void printQudaInvertParam(QudaInvertParam *param) {
   P(chrono_replace_last, 0);
   P(chrono_max_dim, 0);
   P(chrono_index, 0);
+  P(chrono_memory_budget, 0.0);
 #else
   P(chrono_use_resident, INVALID_INT);
   P(chrono_make_resident, INVALID_INT);
   P(chrono_replace_last, INVALID_INT);
   P(chrono_max_dim, INVALID_INT);
   P(chrono_index, INVALID_INT);
+  P(chrono_memory_budget, INVALID_DOUBLE);
 #endif
 
 #if !defined CHECK_PARAM
@@ -939,6 +981,10 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
 #else
     P(mg_vec_partfile[i], QUDA_BOOLEAN_INVALID);
 #endif
+
+#ifndef CHECK_PARAM
+    P(vec_save_prec[i], QUDA_INVALID_PRECISION);
+#endif
   }
 
 #ifdef INIT_PARAM
@@ -1108,6 +1154,21 @@ void printQudaGaugeSmearParam(QudaGaugeSmearParam *param)
   P(epsilon, INVALID_DOUBLE);
 #endif
 
+#ifdef INIT_PARAM
+  P(adaptive_tol, 0.0);
+#else
+  if (param->smear_type == QUDA_GAUGE_SMEAR_WILSON_FLOW || param->smear_type == QUDA_GAUGE_SMEAR_SYMANZIK_FLOW)
+    P(adaptive_tol, INVALID_DOUBLE);
+#endif
+
+#ifdef INIT_PARAM
+  P(adaptive_steps, 0);
+  P(adaptive_rejected, 0);
+#elif defined(PRINT_PARAM)
+  P(adaptive_steps, INVALID_INT);
+  P(adaptive_rejected, INVALID_INT);
+#endif
+
 #ifdef INIT_PARAM
   return ret;
 #endif
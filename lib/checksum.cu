@@ -1,4 +1,6 @@
+#include <cstring>
 #include <gauge_field_order.h>
+#include <index_helper.cuh>
 
 namespace quda {
 
@@ -22,6 +24,7 @@ namespace quda {
   uint64_t ChecksumCPU(const Arg &arg)
   {
     uint64_t checksum_ = 0;
+#pragma omp parallel for collapse(2) reduction(^ : checksum_)
     for (int parity=0; parity<2; parity++)
       for (int x_cb=0; x_cb<arg.volumeCB; x_cb++)
 	for (int d=0; d<arg.U.geometry; d++)
@@ -83,4 +86,151 @@ namespace quda {
     return checksum;
   }
 
+  namespace scidac
+  {
+
+    /**
+       Lookup table for the (reflected) CRC32 polynomial used by zlib,
+       and hence by QIO / LIME, when computing the record checksums
+    */
+    struct CRC32Table {
+      uint32_t v[256];
+      constexpr CRC32Table() : v()
+      {
+        for (uint32_t i = 0; i < 256; i++) {
+          uint32_t c = i;
+          for (int k = 0; k < 8; k++) c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+          v[i] = c;
+        }
+      }
+    };
+
+    static constexpr CRC32Table crc32_table;
+
+    /**
+       @brief Accumulate the big-endian representation of a value onto a CRC32
+       @param[in] crc The running CRC
+       @param[in] bits The bit pattern of the value
+       @param[in] bytes The size of the value in bytes
+       @return The updated CRC
+    */
+    inline uint32_t crc32(uint32_t crc, uint64_t bits, int bytes)
+    {
+      for (int b = bytes - 1; b >= 0; b--) crc = crc32_table.v[(crc ^ (bits >> (8 * b))) & 0xff] ^ (crc >> 8);
+      return crc;
+    }
+
+    inline uint32_t rotl(uint32_t x, int n) { return n == 0 ? x : (x << n) | (x >> (32 - n)); }
+
+  } // namespace scidac
+
+  template <typename file_t, typename T, int Nc, typename G>
+  GaugeChecksum ChecksumSciDAC(const GaugeField &u, const G &U)
+  {
+    using real = typename mapper<T>::type;
+    using bits_t = std::conditional_t<sizeof(file_t) == sizeof(uint64_t), uint64_t, uint32_t>;
+
+    const lat_dim_t X = u.X();
+    uint64_t L[4];
+    int offset[4];
+    for (int d = 0; d < 4; d++) {
+      L[d] = static_cast<uint64_t>(comm_dim(d)) * X[d];
+      offset[d] = comm_coord(d) * X[d];
+    }
+
+    const int volumeCB = u.VolumeCB();
+    const int geometry = u.Geometry();
+    uint32_t suma = 0, sumb = 0;
+    uint64_t checksum = 0;
+
+#pragma omp parallel for reduction(^ : suma, sumb, checksum)
+    for (int i = 0; i < 2 * volumeCB; i++) {
+      const int parity = i / volumeCB;
+      const int x_cb = i - parity * volumeCB;
+      int x[4];
+      getCoords(x, x_cb, X, parity);
+
+      // global lexicographical site index, x fastest
+      uint64_t rank = 0;
+      for (int d = 3; d >= 0; d--) rank = rank * L[d] + offset[d] + x[d];
+
+      // the site record is [dir][row][col][re/im] in file precision
+      uint32_t crc = 0xffffffffu;
+      for (int d = 0; d < geometry; d++) {
+        const Matrix<complex<real>, Nc> m = U(d, x_cb, parity);
+        checksum ^= m.checksum();
+        for (int j = 0; j < Nc * Nc; j++) {
+          file_t v[2] = {static_cast<file_t>(m.data[j].real()), static_cast<file_t>(m.data[j].imag())};
+          for (auto &v_i : v) {
+            bits_t bits;
+            memcpy(&bits, &v_i, sizeof(v_i));
+            crc = scidac::crc32(crc, bits, sizeof(v_i));
+          }
+        }
+      }
+      crc = ~crc;
+
+      suma ^= scidac::rotl(crc, rank % 29);
+      sumb ^= scidac::rotl(crc, rank % 31);
+    }
+
+    return {suma, sumb, checksum};
+  }
+
+  template <typename file_t, typename T, int Nc> GaugeChecksum ChecksumSciDAC(const GaugeField &u)
+  {
+    constexpr int length = 2 * Nc * Nc;
+    GaugeChecksum sum;
+    auto compute = [&](const auto &U) { sum = ChecksumSciDAC<file_t, T, Nc>(u, U); };
+
+    switch (u.Order()) {
+    case QUDA_QDP_GAUGE_ORDER: gauge::instantiateLegacyRecon<gauge::QDPOrder, T, length>(u, nullptr, nullptr, compute); break;
+    case QUDA_MILC_GAUGE_ORDER:
+      gauge::instantiateLegacyRecon<gauge::MILCOrder, T, length>(u, nullptr, nullptr, compute);
+      break;
+    case QUDA_QDPJIT_GAUGE_ORDER: compute(typename gauge_order_mapper<T, QUDA_QDPJIT_GAUGE_ORDER, Nc>::type(u)); break;
+    case QUDA_BQCD_GAUGE_ORDER: compute(typename gauge_order_mapper<T, QUDA_BQCD_GAUGE_ORDER, Nc>::type(u)); break;
+    case QUDA_TIFR_GAUGE_ORDER: compute(typename gauge_order_mapper<T, QUDA_TIFR_GAUGE_ORDER, Nc>::type(u)); break;
+    case QUDA_TIFR_PADDED_GAUGE_ORDER:
+      compute(typename gauge_order_mapper<T, QUDA_TIFR_PADDED_GAUGE_ORDER, Nc>::type(u));
+      break;
+    default: errorQuda("SciDAC checksum not implemented for order %d", u.Order());
+    }
+
+    return sum;
+  }
+
+  template <typename file_t> GaugeChecksum ChecksumSciDAC(const GaugeField &u)
+  {
+    if (u.Ncolor() != 3) errorQuda("Unsupported nColor = %d", u.Ncolor());
+    switch (u.Precision()) {
+    case QUDA_DOUBLE_PRECISION: return ChecksumSciDAC<file_t, double, 3>(u);
+    case QUDA_SINGLE_PRECISION: return ChecksumSciDAC<file_t, float, 3>(u);
+    default: errorQuda("Unsupported precision = %d", u.Precision());
+    }
+    return {};
+  }
+
+  GaugeChecksum ChecksumSciDAC(const GaugeField &u, QudaPrecision file_prec)
+  {
+    if (u.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Only host fields are supported");
+    if (u.Geometry() != QUDA_VECTOR_GEOMETRY) errorQuda("Unsupported geometry %d", u.Geometry());
+
+    GaugeChecksum sum;
+    switch (file_prec) {
+    case QUDA_DOUBLE_PRECISION: sum = ChecksumSciDAC<double>(u); break;
+    case QUDA_SINGLE_PRECISION: sum = ChecksumSciDAC<float>(u); break;
+    default: errorQuda("Unsupported file precision = %d", file_prec);
+    }
+
+    uint64_t scidac = (static_cast<uint64_t>(sum.suma) << 32) | sum.sumb;
+    comm_allreduce_xor(scidac);
+    comm_allreduce_xor(sum.quda);
+    sum.suma = static_cast<uint32_t>(scidac >> 32);
+    sum.sumb = static_cast<uint32_t>(scidac);
+
+    logQuda(QUDA_DEBUG_VERBOSE, "SciDAC checksum a = %x, b = %x, QUDA checksum = %lx\n", sum.suma, sum.sumb, sum.quda);
+    return sum;
+  }
+
 }
@@ -0,0 +1,244 @@
+#include <chronology.h>
+#include <blas_quda.h>
+#include <timer.h>
+#include <eigen_helper.h>
+
+namespace quda
+{
+
+  size_t Chronology::Bytes() const
+  {
+    size_t bytes = 0;
+    for (auto &p : basis) bytes += p.Bytes();
+    return bytes;
+  }
+
+  int Chronology::max_dim(int max_dim, double budget, const ColorSpinorField &x, QudaPrecision prec)
+  {
+    if (budget <= 0.0) return max_dim;
+
+    // fixed-point fields carry an additional per-site norm
+    size_t vec_bytes = x.Volume() * x.Nspin() * x.Ncolor() * 2 * prec;
+    if (prec < QUDA_SINGLE_PRECISION) vec_bytes += x.Volume() * sizeof(float);
+
+    auto budget_dim = static_cast<int>(budget * 1024 * 1024 * 1024 / vec_bytes);
+    return std::min(max_dim, budget_dim);
+  }
+
+  void Chronology::add(const ColorSpinorField &x, int max_dim, QudaPrecision prec, bool replace_last)
+  {
+    if (basis.size() > 0 && (basis[0].Precision() != prec || basis[0].Volume() != x.Volume())) {
+      logQuda(QUDA_SUMMARIZE, "Chronology basis changed (precision %d -> %d), discarding %lu vectors\n",
+              basis[0].Precision(), prec, basis.size());
+      basis.clear();
+      gram.clear();
+    }
+
+    if (max_dim < 1) {
+      // budget too small to store even a single vector
+      basis.clear();
+      gram.clear();
+      return;
+    }
+
+    // trim the oldest vectors if the budget has shrunk
+    if (static_cast<int>(basis.size()) > max_dim) {
+      const int N_old = basis.size();
+      std::vector<Complex> gram_old = gram;
+      basis.resize(max_dim);
+      gram.resize(max_dim * max_dim);
+      for (int i = 0; i < max_dim; i++)
+        for (int j = 0; j < max_dim; j++) gram[i * max_dim + j] = gram_old[i * N_old + j];
+    }
+
+    if (replace_last && basis.size() > 0) {
+      basis[0] = x;
+    } else {
+      const int N_old = basis.size();
+      // if we have not filled the space yet just augment
+      if (static_cast<int>(basis.size()) < max_dim) {
+        ColorSpinorParam cs_param(x);
+        cs_param.setPrecision(prec, prec, true);
+        cs_param.create = QUDA_NULL_FIELD_CREATE;
+        basis.emplace_back(cs_param);
+      }
+
+      // shuffle every entry down one and bring the last to the front
+      std::rotate(basis.begin(), basis.end() - 1, basis.end());
+      basis[0] = x;
+
+      // the retained block of the Gram matrix shifts down by one
+      const int N = basis.size();
+      std::vector<Complex> gram_old = gram;
+      gram.resize(N * N);
+      for (int i = 0; i < N - 1; i++)
+        for (int j = 0; j < N - 1; j++) gram[(i + 1) * N + (j + 1)] = gram_old[i * N_old + j];
+    }
+
+    // only the inner products with the new vector need be computed
+    const int N = basis.size();
+    std::vector<Complex> row(N);
+    blas::cDotProduct(row, basis, {basis[0]});
+    for (int i = 0; i < N; i++) {
+      gram[i * N + 0] = row[i];
+      gram[0 * N + i] = conj(row[i]);
+    }
+    gram[0] = row[0].real();
+  }
+
+  /*
+    We want to find the best initial guess of the solution of A x = b,
+    given the N previous solutions p_i, without modifying the basis.
+
+    1. Diagonalize the Gram matrix G_ij = (p_i, p_j) = V L V^dagger
+       and form the orthonormal frame T = V L^{-1/2}, dropping
+       directions with negligible eigenvalue
+    2. Form M_ij = (p_i, A p_j) (Hermitian) or (A p_i, A p_j) (normal)
+       and phi_i = (p_i, b) or (A p_i, b)
+    3. Solve (T^dagger M T) y = T^dagger phi
+    4. x = (T y)_i p_i
+  */
+  void Chronology::forecast(ColorSpinorField &x, const ColorSpinorField &b, const DiracMatrix &mat,
+                            QudaPrecision prec, bool hermitian)
+  {
+    typedef Matrix<Complex, Dynamic, Dynamic> matrix;
+    typedef Matrix<Complex, Dynamic, 1> vector;
+
+    bool running = getProfile().isRunning(QUDA_PROFILE_CHRONO);
+    if (!running) getProfile().TPSTART(QUDA_PROFILE_CHRONO);
+
+    const int N = basis.size();
+    logQuda(QUDA_VERBOSE, "Constructing chronological forecast with basis size %d\n", N);
+
+    if (N == 0) {
+      blas::zero(x);
+      if (!running) getProfile().TPSTOP(QUDA_PROFILE_CHRONO);
+      return;
+    }
+
+    ColorSpinorParam param(basis[0]);
+    param.setPrecision(prec, prec, true);
+    param.create = QUDA_NULL_FIELD_CREATE;
+    ColorSpinorField p(param);
+    ColorSpinorField q(param);
+
+    std::vector<Complex> M_(N * N);
+    std::vector<Complex> phi_(N);
+
+    if (hermitian) {
+      // stream the basis through the operator one vector at a time,
+      // so we only ever need two additional working vectors
+      std::vector<Complex> col(N);
+      for (int j = 0; j < N; j++) {
+        p = basis[j];
+        mat(q, p);
+        blas::cDotProduct(col, basis, {q});
+        for (int i = 0; i < N; i++) M_[i * N + j] = col[i];
+      }
+      blas::cDotProduct(phi_, basis, {b});
+    } else {
+      // the normal equations require all of the A p_j together
+      std::vector<ColorSpinorField> Ap(N, ColorSpinorParam(basis[0]));
+      for (int j = 0; j < N; j++) {
+        p = basis[j];
+        mat(q, p);
+        Ap[j] = q;
+      }
+      blas::cDotProduct(M_, Ap, Ap);
+      blas::cDotProduct(phi_, Ap, {b});
+    }
+
+    getProfile().TPSTOP(QUDA_PROFILE_CHRONO);
+    getProfile().TPSTART(QUDA_PROFILE_EIGEN);
+
+    matrix G(N, N), M(N, N);
+    vector phi(N);
+    for (int i = 0; i < N; i++) {
+      phi(i) = phi_[i];
+      for (int j = 0; j < N; j++) {
+        G(i, j) = gram[i * N + j];
+        M(i, j) = M_[i * N + j];
+      }
+    }
+
+    // drop directions that cannot be resolved in the storage precision
+    SelfAdjointEigenSolver<matrix> eigen(G);
+    const auto &lambda = eigen.eigenvalues();
+    double eps = basis[0].Precision() == QUDA_DOUBLE_PRECISION ? std::numeric_limits<double>::epsilon() :
+      basis[0].Precision() == QUDA_SINGLE_PRECISION            ? std::numeric_limits<float>::epsilon() :
+      basis[0].Precision() == QUDA_HALF_PRECISION              ? 1.0 / 32767 :
+                                                                 1.0 / 127;
+    double tol = std::max(1e-14, eps * eps) * lambda(N - 1);
+
+    int rank = 0;
+    for (int i = 0; i < N; i++)
+      if (lambda(i) > tol) rank++;
+
+    if (rank == 0) { // degenerate basis, e.g., all zero solutions
+      getProfile().TPSTOP(QUDA_PROFILE_EIGEN);
+      blas::zero(x);
+      if (running) getProfile().TPSTART(QUDA_PROFILE_CHRONO);
+      return;
+    }
+
+    matrix T(N, rank);
+    for (int i = N - rank, k = 0; i < N; i++, k++) T.col(k) = eigen.eigenvectors().col(i) / sqrt(lambda(i));
+
+    matrix Mr = T.adjoint() * M * T;
+    vector y = Mr.ldlt().solve(T.adjoint() * phi);
+    vector alpha = T * y;
+
+    getProfile().TPSTOP(QUDA_PROFILE_EIGEN);
+    getProfile().TPSTART(QUDA_PROFILE_CHRONO);
+
+    logQuda(QUDA_VERBOSE, "Chronology: basis size %d, numerical rank %d\n", N, rank);
+    max_dim_used = std::max(max_dim_used, N);
+
+    std::vector<Complex> alpha_(N);
+    for (int i = 0; i < N; i++) alpha_[i] = alpha(i);
+
+    blas::zero(x);
+    blas::caxpy(alpha_, basis, x);
+
+    if (!running) getProfile().TPSTOP(QUDA_PROFILE_CHRONO);
+  }
+
+  void Chronology::record(int iter, bool forecast)
+  {
+    if (forecast) {
+      n_forecast++;
+      iter_forecast += iter;
+    } else {
+      n_cold++;
+      iter_cold += iter;
+    }
+  }
+
+  void Chronology::print_stats(int index) const
+  {
+    if (n_forecast + n_cold == 0) return;
+
+    double mean_forecast = n_forecast ? static_cast<double>(iter_forecast) / n_forecast : 0.0;
+    double mean_cold = n_cold ? static_cast<double>(iter_cold) / n_cold : 0.0;
+
+    printfQuda("Chronology %d: basis size %lu (max used %d) with %d-byte precision, %.3f GiB\n", index, basis.size(),
+               max_dim_used, Precision(), Bytes() / (1024.0 * 1024 * 1024));
+    printfQuda("Chronology %d: %d solves with forecast averaging %.1f iterations, %d without averaging %.1f\n", index,
+               n_forecast, mean_forecast, n_cold, mean_cold);
+    if (n_forecast && n_cold)
+      printfQuda("Chronology %d: forecast saved %.1f%% of iterations per solve\n", index,
+                 100.0 * (1.0 - mean_forecast / mean_cold));
+  }
+
+  void Chronology::clear()
+  {
+    basis.clear();
+    gram.clear();
+    n_forecast = 0;
+    n_cold = 0;
+    iter_forecast = 0;
+    iter_cold = 0;
+    max_dim_used = 0;
+  }
+
+} // namespace quda
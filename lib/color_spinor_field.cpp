@@ -5,6 +5,7 @@
 #include <color_spinor_field.h>
 #include <dslash_quda.h>
 #include <field_cache.h>
+#include <halo_compress.h>
 #include <uint_to_char.h>
 
 static bool zeroCopy = false;
@@ -983,7 +984,8 @@ namespace quda
       || (from_face_h[0] != ghost_pinned_recv_buffer_h[0]) || (from_face_h[1] != ghost_pinned_recv_buffer_h[1])
       || (my_face_d[0] != ghost_send_buffer_d[0]) || (my_face_d[1] != ghost_send_buffer_d[1]) ||  // send buffers
       (from_face_d[0] != ghost_recv_buffer_d[0]) || (from_face_d[1] != ghost_recv_buffer_d[1]) || // receive buffers
-      ghost_precision_reset; // ghost_precision has changed
+      ghost_precision_reset ||         // ghost_precision has changed
+      comms_epoch != comms_plan_epoch; // message handles have been freed
 
     if (!initComms || comms_reset) {
 
@@ -1109,6 +1111,8 @@ namespace quda
       comm_start(mh_recv_p2p[bufferIndex][dim][1 - dir]);
     } else if (gdr) {
       comm_start(mh_recv_rdma[bufferIndex][dim][1 - dir]);
+    } else if (halo_compress::enabled()) {
+      halo_compress::recv_start(bufferIndex, dim, 1 - dir, ghost_face_bytes[dim]);
     } else {
       comm_start(mh_recv[bufferIndex][dim][1 - dir]);
     }
@@ -1128,6 +1132,9 @@ namespace quda
     if (!comm_peer2peer_enabled(dir, dim)) {
       if (gdr)
         comm_start(mh_send_rdma[bufferIndex][dim][dir]);
+      else if (halo_compress::enabled())
+        halo_compress::send_start(bufferIndex, dim, dir, my_face_dim_dir_h[bufferIndex][dim][dir], ghost_face_bytes[dim],
+                                  ghost_precision);
       else
         comm_start(mh_send[bufferIndex][dim][dir]);
     } else { // doing peer-to-peer
@@ -1174,6 +1181,8 @@ namespace quda
       if (!complete_send[dim][dir]) complete_send[dim][dir] = comm_query(mh_send_p2p[bufferIndex][dim][dir]);
     } else if (gdr_send) {
       if (!complete_send[dim][dir]) complete_send[dim][dir] = comm_query(mh_send_rdma[bufferIndex][dim][dir]);
+    } else if (halo_compress::enabled()) {
+      if (!complete_send[dim][dir]) complete_send[dim][dir] = halo_compress::send_query(bufferIndex, dim, dir);
     } else {
       if (!complete_send[dim][dir]) complete_send[dim][dir] = comm_query(mh_send[bufferIndex][dim][dir]);
     }
@@ -1185,6 +1194,10 @@ namespace quda
     } else if (gdr_recv) {
       if (!complete_recv[dim][1 - dir])
         complete_recv[dim][1 - dir] = comm_query(mh_recv_rdma[bufferIndex][dim][1 - dir]);
+    } else if (halo_compress::enabled()) {
+      if (!complete_recv[dim][1 - dir])
+        complete_recv[dim][1 - dir]
+          = halo_compress::recv_query(bufferIndex, dim, 1 - dir, from_face_dim_dir_h[bufferIndex][dim][1 - dir]);
     } else {
       if (!complete_recv[dim][1 - dir]) complete_recv[dim][1 - dir] = comm_query(mh_recv[bufferIndex][dim][1 - dir]);
     }
@@ -1216,6 +1229,8 @@ namespace quda
       qudaEventSynchronize(ipcCopyEvent[bufferIndex][dim][dir]);
     } else if (gdr_send) {
       comm_wait(mh_send_rdma[bufferIndex][dim][dir]);
+    } else if (halo_compress::enabled()) {
+      halo_compress::send_wait(bufferIndex, dim, dir);
     } else {
       comm_wait(mh_send[bufferIndex][dim][dir]);
     }
@@ -1226,6 +1241,8 @@ namespace quda
       qudaEventSynchronize(ipcRemoteCopyEvent[bufferIndex][dim][1 - dir]);
     } else if (gdr_recv) {
       comm_wait(mh_recv_rdma[bufferIndex][dim][1 - dir]);
+    } else if (halo_compress::enabled()) {
+      halo_compress::recv_wait(bufferIndex, dim, 1 - dir, from_face_dim_dir_h[bufferIndex][dim][1 - dir]);
     } else {
       comm_wait(mh_recv[bufferIndex][dim][1 - dir]);
     }
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <quda.h>
+
+/**
+   @file comm_advisor.cpp
+
+   @brief Processor grid and rank placement advisor, see
+   adviseCommsLayoutQuda in quda.h
+ */
+
+namespace quda
+{
+
+  namespace comm_advisor
+  {
+
+    constexpr int n_dim = 4;
+    using dims_t = std::array<int, n_dim>;
+
+    /**
+       @brief Enumerate all factorizations of n into n_dim factors,
+       with each factor dividing the corresponding bound
+       @param[out] out The factorizations
+       @param[in] n The number to factorize
+       @param[in] bound The bounds that each factor must divide
+     */
+    static void factorize(std::vector<dims_t> &out, int n, const dims_t &bound, dims_t &f, int d = 0)
+    {
+      if (d == n_dim - 1) {
+        if (bound[d] % n == 0) {
+          f[d] = n;
+          out.push_back(f);
+        }
+        return;
+      }
+      for (int k = 1; k <= n; k++) {
+        if (n % k != 0 || bound[d] % k != 0) continue;
+        f[d] = k;
+        factorize(out, n / k, bound, f, d + 1);
+      }
+    }
+
+    static std::vector<dims_t> factorize(int n, const dims_t &bound)
+    {
+      std::vector<dims_t> out;
+      dims_t f = {};
+      factorize(out, n, bound, f);
+      return out;
+    }
+
+    struct Bandwidth {
+      double node;
+      double socket;
+      double intra;
+    };
+
+    /**
+       @brief Modeled halo-exchange time of a layout.  In each
+       dimension a fraction 1/b of the links leave a block of extent
+       b, unless the block spans the whole dimension.  The network and
+       inter-socket links are shared by all of a node's ranks, and the
+       exchange takes as long as the most loaded class of link.
+     */
+    static double cost(const dims_t &local, const dims_t &grid, const dims_t &node, const dims_t &socket,
+                       int ranks_per_node, const Bandwidth &bw)
+    {
+      double volume = 1.0;
+      for (auto l : local) volume *= l;
+
+      double bytes_node = 0.0, bytes_socket = 0.0, bytes_intra = 0.0;
+      for (int d = 0; d < n_dim; d++) {
+        if (grid[d] == 1) continue;
+        const double face = 2.0 * volume / local[d]; // both directions
+        const double leave_node = node[d] == grid[d] ? 0.0 : 1.0 / node[d];
+        const double leave_socket = socket[d] == grid[d] ? 0.0 : 1.0 / socket[d];
+        bytes_node += face * leave_node;
+        bytes_socket += face * (leave_socket - leave_node);
+        bytes_intra += face * (1.0 - leave_socket);
+      }
+
+      return std::max({ranks_per_node * bytes_node / bw.node, ranks_per_node * bytes_socket / bw.socket,
+                       bytes_intra / bw.intra});
+    }
+
+    static double surface(const dims_t &local, const dims_t &grid)
+    {
+      double volume = 1.0;
+      for (auto l : local) volume *= l;
+      double s = 0.0;
+      for (int d = 0; d < n_dim; d++)
+        if (grid[d] > 1) s += 2.0 * volume / local[d];
+      return s / volume;
+    }
+
+  } // namespace comm_advisor
+
+} // namespace quda
+
+using namespace quda;
+using namespace quda::comm_advisor;
+
+int adviseCommsLayoutQuda(QudaCommsLayout *layout, const int *lattice, int n_ranks, const QudaCommsTopology *topology)
+{
+  // this may be called before communications are initialized, so we
+  // report failure through the return value rather than errorQuda
+  if (!layout || !lattice || !topology) return 1;
+  if (n_ranks < 1) return 1;
+
+  int ranks_per_node = std::min(std::max(topology->ranks_per_node, 1), n_ranks);
+  int ranks_per_socket = std::min(std::max(topology->ranks_per_socket, 1), ranks_per_node);
+  if (n_ranks % ranks_per_node != 0) return 1;
+  if (ranks_per_node % ranks_per_socket != 0) return 1;
+
+  Bandwidth bw = {topology->inter_node_bandwidth > 0.0 ? topology->inter_node_bandwidth : 25.0,
+                  topology->inter_socket_bandwidth > 0.0 ? topology->inter_socket_bandwidth : 50.0,
+                  topology->intra_socket_bandwidth > 0.0 ? topology->intra_socket_bandwidth : 150.0};
+
+  // each local extent must be even, so the grid extent must divide half the lattice extent
+  dims_t bound;
+  for (int d = 0; d < n_dim; d++) {
+    if (lattice[d] <= 0 || lattice[d] % 2 != 0) return 1;
+    bound[d] = layout->grid[d] > 0 ? layout->grid[d] : lattice[d] / 2;
+    if ((lattice[d] / 2) % bound[d] != 0) return 1;
+  }
+
+  bool found = false;
+  QudaCommsLayout best = {};
+  double best_surface = 0.0;
+  int best_partitioned = 0;
+
+  for (auto &grid : factorize(n_ranks, bound)) {
+    bool fixed = true;
+    for (int d = 0; d < n_dim; d++)
+      if (layout->grid[d] > 0 && grid[d] != layout->grid[d]) fixed = false;
+    if (!fixed) continue;
+
+    dims_t local;
+    int partitioned = 0;
+    for (int d = 0; d < n_dim; d++) {
+      local[d] = lattice[d] / grid[d];
+      if (grid[d] > 1) partitioned++;
+    }
+    const double s = surface(local, grid);
+
+    for (auto &node : factorize(ranks_per_node, grid)) {
+      for (auto &socket : factorize(ranks_per_socket, node)) {
+        const double c = cost(local, grid, node, socket, ranks_per_node, bw);
+
+        // prefer lower cost, then lower surface-to-volume, then fewer partitioned dimensions
+        bool better = !found || c < best.cost * (1 - 1e-9)
+          || (c <= best.cost * (1 + 1e-9)
+              && (s < best_surface * (1 - 1e-9) || (s <= best_surface * (1 + 1e-9) && partitioned < best_partitioned)));
+        if (!better) continue;
+
+        found = true;
+        for (int d = 0; d < n_dim; d++) {
+          best.grid[d] = grid[d];
+          best.node_grid[d] = node[d];
+          best.socket_grid[d] = socket[d];
+        }
+        best.cost = c;
+        best_surface = s;
+        best_partitioned = partitioned;
+      }
+    }
+  }
+
+  if (!found) return 1;
+
+  *layout = best;
+  return 0;
+}
+
+int rankFromCoordsLayoutQuda(const int *coords, void *fdata)
+{
+  auto layout = static_cast<const QudaCommsLayout *>(fdata);
+
+  int node = 0, socket = 0, local = 0;
+  int ranks_per_node = 1, ranks_per_socket = 1;
+  for (int d = 0; d < n_dim; d++) { // t varies fastest
+    const int n = layout->node_grid[d];
+    const int s = layout->socket_grid[d];
+    node = node * (layout->grid[d] / n) + coords[d] / n;
+    socket = socket * (n / s) + (coords[d] % n) / s;
+    local = local * s + coords[d] % s;
+    ranks_per_node *= n;
+    ranks_per_socket *= s;
+  }
+
+  return node * ranks_per_node + socket * ranks_per_socket + local;
+}
@@ -0,0 +1,255 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <communicator_quda.h>
+#include <comm_progress.h>
+#include <numa_affinity.h>
+
+#if defined(QMP_COMMS) || defined(MPI_COMMS)
+#include <mpi.h>
+#endif
+
+namespace quda
+{
+
+  namespace comm_progress
+  {
+
+    /**
+       Message states.  A message is PENDING from comm_start until the
+       progress thread has started it, ACTIVE while it is being polled,
+       and COMPLETE once it has finished.
+     */
+    enum State : int { IDLE, PENDING, ACTIVE, COMPLETE };
+
+    /**
+       Progress-engine state of a message handle.  The handle and
+       communicator are set by the calling thread before the request is
+       queued, and after this only the state is shared between threads.
+     */
+    struct Request {
+      MsgHandle *mh = nullptr;
+      Communicator *comm = nullptr;
+      std::atomic<int> state {IDLE};
+    };
+
+    /**
+       Single-producer single-consumer ring of requests to start,
+       filled by the calling thread and drained by the progress thread
+     */
+    class Queue
+    {
+      static constexpr size_t capacity = 1024;
+      Request *ring[capacity];
+      std::atomic<size_t> head {0}; // next slot to pop
+      std::atomic<size_t> tail {0}; // next slot to push
+
+    public:
+      bool push(Request *r)
+      {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == capacity) return false;
+        ring[t % capacity] = r;
+        tail.store(t + 1, std::memory_order_seq_cst);
+        return true;
+      }
+
+      bool pop(Request *&r)
+      {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        r = ring[h % capacity];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+      }
+
+      bool empty() const { return head.load(std::memory_order_seq_cst) == tail.load(std::memory_order_seq_cst); }
+    };
+
+    /** Number of idle polling iterations before the progress thread sleeps */
+    constexpr int idle_spin = 1 << 16;
+
+    /** Number of polls of a message before the calling thread blocks in wait */
+    constexpr int wait_spin = 1 << 10;
+
+    static int engine_enabled = -1;
+
+    // only accessed by the calling thread
+    static std::unordered_map<MsgHandle *, std::unique_ptr<Request>> requests;
+
+    static Queue queue;
+    static std::thread progress_thread;
+    static std::atomic<bool> running {false};
+    static std::atomic<bool> sleeping {false};
+    static std::mutex sleep_mutex;
+    static std::condition_variable wake;
+    static std::atomic<bool> waiting {false};
+    static std::mutex wait_mutex;
+    static std::condition_variable completed;
+
+    bool enabled()
+    {
+      if (engine_enabled < 0) {
+        engine_enabled = 0;
+        char *enable_progress = getenv("QUDA_ENABLE_PROGRESS_THREAD");
+        if (enable_progress && strcmp(enable_progress, "1") == 0) {
+#if defined(QMP_COMMS) || defined(MPI_COMMS)
+          int provided;
+          MPI_Query_thread(&provided);
+          if (provided == MPI_THREAD_MULTIPLE) {
+            engine_enabled = 1;
+            if (comm_rank() == 0) warningQuda("Using communication progress thread");
+          } else {
+            warningQuda("QUDA_ENABLE_PROGRESS_THREAD=1 requires MPI_THREAD_MULTIPLE, disabling progress thread");
+          }
+#else
+          warningQuda("QUDA_ENABLE_PROGRESS_THREAD=1 has no effect in a single-process build");
+#endif
+        }
+      }
+      return engine_enabled;
+    }
+
+    /**
+       @brief Progress thread main loop: start newly queued messages,
+       poll those in flight, and sleep when there is nothing to do
+     */
+    static void progress()
+    {
+      topology::bind(topology::ThreadRole::PROGRESS);
+
+      std::vector<Request *> active;
+      int idle = 0;
+
+      while (running.load(std::memory_order_acquire)) {
+        Request *r;
+        while (queue.pop(r)) {
+          r->comm->comm_start(r->mh);
+          r->state.store(ACTIVE, std::memory_order_relaxed);
+          active.push_back(r);
+        }
+
+        for (size_t i = 0; i < active.size();) {
+          if (active[i]->comm->comm_query(active[i]->mh)) {
+            // the store to the state and the check of waiting pair with
+            // the store to waiting and the check of the state in wait()
+            active[i]->state.store(COMPLETE, std::memory_order_seq_cst);
+            if (waiting.load(std::memory_order_seq_cst)) {
+              std::lock_guard<std::mutex> lock(wait_mutex);
+              completed.notify_one();
+            }
+            active[i] = active.back();
+            active.pop_back();
+          } else {
+            i++;
+          }
+        }
+
+        if (!active.empty()) {
+          idle = 0;
+        } else if (++idle >= idle_spin) {
+          // the store to sleeping and the check of the queue pair with
+          // the push and the check of sleeping in start()
+          std::unique_lock<std::mutex> lock(sleep_mutex);
+          sleeping.store(true, std::memory_order_seq_cst);
+          wake.wait(lock, [] { return !queue.empty() || !running.load(std::memory_order_acquire); });
+          sleeping.store(false, std::memory_order_relaxed);
+          idle = 0;
+        }
+      }
+    }
+
+    /**
+       @return Whether a message is not in flight
+     */
+    static bool done(const Request &r)
+    {
+      const int state = r.state.load(std::memory_order_acquire);
+      return state == IDLE || state == COMPLETE;
+    }
+
+    static Request &request(MsgHandle *mh)
+    {
+      auto &r = requests[mh];
+      if (!r) {
+        r = std::make_unique<Request>();
+        r->mh = mh;
+      }
+      return *r;
+    }
+
+    void start(Communicator &comm, MsgHandle *mh)
+    {
+      if (!running.load(std::memory_order_acquire)) {
+        running.store(true, std::memory_order_release);
+        progress_thread = std::thread(progress);
+      }
+
+      Request &r = request(mh);
+      if (!done(r)) errorQuda("Message handle %p started while still in flight", mh);
+      r.comm = &comm;
+      r.state.store(PENDING, std::memory_order_relaxed);
+      while (!queue.push(&r)) std::this_thread::yield();
+
+      if (sleeping.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        wake.notify_one();
+      }
+    }
+
+    void wait(MsgHandle *mh)
+    {
+      auto it = requests.find(mh);
+      if (it == requests.end()) return;
+      const Request &r = *it->second;
+
+      // poll briefly, since most messages complete soon, then give
+      // up the core until the progress thread signals completion
+      for (int i = 0; i < wait_spin; i++) {
+        if (done(r)) return;
+        std::this_thread::yield();
+      }
+
+      std::unique_lock<std::mutex> lock(wait_mutex);
+      waiting.store(true, std::memory_order_seq_cst);
+      completed.wait(lock, [&r] { return done(r); });
+      waiting.store(false, std::memory_order_relaxed);
+    }
+
+    int query(MsgHandle *mh)
+    {
+      auto it = requests.find(mh);
+      return it == requests.end() || done(*it->second);
+    }
+
+    void release(MsgHandle *mh)
+    {
+      auto it = requests.find(mh);
+      if (it == requests.end()) return;
+      wait(mh);
+      requests.erase(it);
+    }
+
+    void finalize()
+    {
+      if (running.load(std::memory_order_acquire)) {
+        {
+          std::lock_guard<std::mutex> lock(sleep_mutex);
+          running.store(false, std::memory_order_release);
+        }
+        wake.notify_one();
+        progress_thread.join();
+      }
+      requests.clear();
+    }
+
+  } // namespace comm_progress
+
+} // namespace quda
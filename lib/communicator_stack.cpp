@@ -1,4 +1,5 @@
 #include <communicator_quda.h>
+#include <comm_progress.h>
 #include <map>
 #include <array.h>
 #include <lattice_field.h>
@@ -72,7 +73,11 @@ namespace quda
     init_communicator_stack(ndim, dims, rank_from_coords, map_data, user_set_comm_handle, user_comm);
   }
 
-  void comm_finalize() { finalize_communicator_stack(); }
+  void comm_finalize()
+  {
+    comm_progress::finalize();
+    finalize_communicator_stack();
+  }
 
   void comm_dim_partitioned_set(int dim) { get_current_communicator().comm_dim_partitioned_set(dim); }
 
@@ -169,13 +174,39 @@ namespace quda
 
 #define CHECK_MH(mh) { if (mh == nullptr) errorQuda("null message handle"); }
 
-  void comm_free(MsgHandle *&mh) { CHECK_MH(mh); get_current_communicator().comm_free(mh); }
+  // when the progress thread is enabled it owns the starting and
+  // polling of all messages, see comm_progress.h
 
-  void comm_start(MsgHandle *mh) { CHECK_MH(mh); get_current_communicator().comm_start(mh); }
+  void comm_free(MsgHandle *&mh)
+  {
+    CHECK_MH(mh);
+    if (comm_progress::enabled()) comm_progress::release(mh);
+    get_current_communicator().comm_free(mh);
+  }
+
+  void comm_start(MsgHandle *mh)
+  {
+    CHECK_MH(mh);
+    if (comm_progress::enabled())
+      comm_progress::start(get_current_communicator(), mh);
+    else
+      get_current_communicator().comm_start(mh);
+  }
 
-  void comm_wait(MsgHandle *mh) { CHECK_MH(mh); get_current_communicator().comm_wait(mh); }
+  void comm_wait(MsgHandle *mh)
+  {
+    CHECK_MH(mh);
+    if (comm_progress::enabled())
+      comm_progress::wait(mh);
+    else
+      get_current_communicator().comm_wait(mh);
+  }
 
-  int comm_query(MsgHandle *mh) { CHECK_MH(mh); return get_current_communicator().comm_query(mh); }
+  int comm_query(MsgHandle *mh)
+  {
+    CHECK_MH(mh);
+    return comm_progress::enabled() ? comm_progress::query(mh) : get_current_communicator().comm_query(mh);
+  }
 
 #undef CHECK_MH
 
@@ -214,6 +245,11 @@ namespace quda
     comm_allreduce_sum_array(reinterpret_cast<double *>(a.data()), 4 * a.size());
   }
 
+  template <> void comm_allreduce_sum<std::vector<array<double, 32>>>(std::vector<array<double, 32>> &a)
+  {
+    comm_allreduce_sum_array(reinterpret_cast<double *>(a.data()), 32 * a.size());
+  }
+
   template <> void comm_allreduce_sum<double>(double &a) { comm_allreduce_sum_array(&a, 1); }
 
   template <> void comm_allreduce_sum<size_t>(size_t &a) { get_current_communicator().comm_allreduce_sum(a); }
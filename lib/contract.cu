@@ -1,8 +1,11 @@
 #include <color_spinor_field.h>
 #include <contract_quda.h>
 #include <tunable_nd.h>
+#include <tunable_reduction.h>
 #include <instantiate.h>
+#include <blas_lapack.h>
 #include <kernels/contraction.cuh>
+#include <kernels/meson_field.cuh>
 
 namespace quda {
 
@@ -55,6 +58,145 @@ public:
     }
   };
 
+  template <typename Float, int nColor> class ContractionMomentum : TunableMultiReduction
+  {
+    const ColorSpinorField &x;
+    const ColorSpinorField &y;
+    std::vector<array<double, 32>> &result;
+    const QudaContractType cType;
+    const std::vector<array<int, 3>> &mom;
+
+  public:
+    ContractionMomentum(const ColorSpinorField &x, const ColorSpinorField &y, std::vector<array<double, 32>> &result,
+                        const QudaContractType cType, const std::vector<array<int, 3>> &mom) :
+      TunableMultiReduction(x, 2u, mom.size() * x.X()[3], max_n_batch_block_contract()),
+      x(x),
+      y(y),
+      result(result),
+      cType(cType),
+      mom(mom)
+    {
+      switch (cType) {
+      case QUDA_CONTRACT_TYPE_OPEN: strcat(aux, "open,"); break;
+      case QUDA_CONTRACT_TYPE_DR: strcat(aux, "degrand-rossi,"); break;
+      default: errorQuda("Unexpected contraction type %d", cType);
+      }
+      strcat(aux, "n_mom=");
+      u32toa(aux + strlen(aux), mom.size());
+      apply(device::get_default_stream());
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      switch (cType) {
+      case QUDA_CONTRACT_TYPE_OPEN: {
+        ContractionSummedArg<Float, nColor, QUDA_CONTRACT_TYPE_OPEN> arg(x, y, mom);
+        launch<ContractionSummed>(result, tp, stream, arg);
+        break;
+      }
+      case QUDA_CONTRACT_TYPE_DR: {
+        ContractionSummedArg<Float, nColor, QUDA_CONTRACT_TYPE_DR> arg(x, y, mom);
+        launch<ContractionSummed>(result, tp, stream, arg);
+        break;
+      }
+      default: errorQuda("Unexpected contraction type %d", cType);
+      }
+    }
+
+    long long flops() const
+    {
+      // contraction and projection, then the phase multiplication, for every momentum
+      long long site = (16 * 3 * 6ll) + (cType == QUDA_CONTRACT_TYPE_DR ? 16 * (4 + 12) : 0) + 16 * 6;
+      return site * x.Volume() * mom.size();
+    }
+
+    long long bytes() const { return (x.Bytes() + y.Bytes()) * mom.size(); }
+  };
+
+  /**
+     Host launch of the meson-field pack and phase kernels, threaded
+     over sites since each site writes its own entries of the packed
+     block
+  */
+  template <template <typename> class Functor, typename Arg> void MesonFieldHost(const Arg &arg)
+  {
+    Functor<Arg> f(arg);
+#pragma omp parallel for collapse(2)
+    for (int parity = 0; parity < 2; parity++)
+      for (int x_cb = 0; x_cb < static_cast<int>(arg.threads.x); x_cb++) f(x_cb, parity);
+  }
+
+  template <typename Float, int nColor> class MesonFieldPackBlock : TunableKernel2D
+  {
+    const ColorSpinorField &x;
+    void *buffer;
+    const int col;
+    const int n_col;
+    const bool dagger;
+    unsigned int minThreads() const { return x.VolumeCB(); }
+
+  public:
+    MesonFieldPackBlock(const ColorSpinorField &x, void *buffer, int col, int n_col, bool dagger) :
+      TunableKernel2D(x, 2), x(x), buffer(buffer), col(col), n_col(n_col), dagger(dagger)
+    {
+      if (x.Location() == QUDA_CUDA_FIELD_LOCATION && !x.isNative())
+        errorQuda("Device meson field only supported on native ordered fields");
+      if (x.Location() == QUDA_CPU_FIELD_LOCATION && x.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+        errorQuda("Host meson field only supported on space-spin-color ordered fields");
+      if (dagger) strcat(aux, ",dagger");
+      apply(device::get_default_stream());
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      if (x.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        launch_device<MesonFieldPack>(tp, stream, MesonFieldPackArg<Float, nColor, false>(x, buffer, col, n_col, dagger));
+      } else if constexpr (std::is_same_v<Float, double> || std::is_same_v<Float, float>) {
+        MesonFieldHost<MesonFieldPack>(MesonFieldPackArg<Float, nColor, true>(x, buffer, col, n_col, dagger));
+      } else {
+        errorQuda("Host meson field not supported for precision %d", x.Precision());
+      }
+    }
+
+    long long flops() const { return 0; }
+    long long bytes() const { return 2 * x.Bytes(); }
+  };
+
+  template <typename Float, int nColor> class MesonFieldPhaseBlock : TunableKernel2D
+  {
+    using real = typename mapper<Float>::type;
+    const ColorSpinorField &x;
+    const void *in;
+    void *out;
+    const int n_col;
+    const array<int, 3> &mom;
+    unsigned int minThreads() const { return x.VolumeCB(); }
+
+  public:
+    MesonFieldPhaseBlock(const ColorSpinorField &x, const void *in, void *out, int n_col, const array<int, 3> &mom) :
+      TunableKernel2D(x, 2), x(x), in(in), out(out), n_col(n_col), mom(mom)
+    {
+      strcat(aux, ",n_col=");
+      u32toa(aux + strlen(aux), n_col);
+      apply(device::get_default_stream());
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      if (x.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        launch_device<MesonFieldPhase>(tp, stream, MesonFieldPhaseArg<real, nColor>(x, in, out, n_col, mom));
+      } else {
+        MesonFieldHost<MesonFieldPhase>(MesonFieldPhaseArg<real, nColor>(x, in, out, n_col, mom));
+      }
+    }
+
+    long long flops() const { return 6ll * x.Volume() * x.Nspin() * nColor * n_col; }
+    long long bytes() const { return 2ll * x.Volume() * x.Nspin() * nColor * n_col * sizeof(complex<real>); }
+  };
+
 #ifdef GPU_CONTRACT
   void contractQuda(const ColorSpinorField &x, const ColorSpinorField &y, void *result, const QudaContractType cType)
   {
@@ -67,11 +209,215 @@ public:
     instantiate<Contraction>(x, y, result, cType);
     getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
   }
+
+  void contractSummedQuda(const ColorSpinorField &x, const ColorSpinorField &y, std::vector<Complex> &result,
+                          const QudaContractType cType, const std::vector<array<int, 3>> &mom)
+  {
+    getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+    checkPrecision(x, y);
+    if (x.GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS || y.GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS)
+      errorQuda("Unexpected gamma basis x=%d y=%d", x.GammaBasis(), y.GammaBasis());
+    if (x.Nspin() != 4 || y.Nspin() != 4) errorQuda("Unexpected number of spins x=%d y=%d", x.Nspin(), y.Nspin());
+    if (x.SiteSubset() != QUDA_FULL_SITE_SUBSET) errorQuda("Momentum projection requires full fields");
+    if (mom.size() == 0 || mom.size() > static_cast<size_t>(max_contract_mom()))
+      errorQuda("Number of momenta %lu not in range [1, %d]", mom.size(), max_contract_mom());
+
+    const int Lt = x.X()[3];
+    const int T = Lt * comm_dim(3);
+    const int n_mom = mom.size();
+
+    // each rank only holds its own time slices, so the reduction is
+    // local and the global correlator is assembled afterwards
+    std::vector<array<double, 32>> local(n_mom * Lt);
+    commGlobalReductionPush(false);
+    instantiate<ContractionMomentum>(x, y, local, cType, mom);
+    commGlobalReductionPop();
+
+    std::vector<double> global(n_mom * T * 32, 0.0);
+    for (int m = 0; m < n_mom; m++) {
+      for (int t = 0; t < Lt; t++) {
+        auto t_global = comm_coord(3) * Lt + t;
+        for (int i = 0; i < 32; i++) global[(m * T + t_global) * 32 + i] = local[m * Lt + t][i];
+      }
+    }
+    comm_allreduce_sum(global);
+
+    result.resize(n_mom * T * 16);
+    for (auto i = 0u; i < result.size(); i++) result[i] = Complex(global[2 * i + 0], global[2 * i + 1]);
+    getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+  }
+
+  void contractMesonFieldQuda(cvector_ref<const ColorSpinorField> &w, cvector_ref<const ColorSpinorField> &v,
+                              std::vector<Complex> &result, const QudaContractType cType,
+                              const std::vector<array<int, 3>> &mom)
+  {
+    using namespace blas_lapack;
+
+    if (w.size() == 0 || v.size() == 0) errorQuda("Empty vector block w=%lu v=%lu", w.size(), v.size());
+    if (mom.size() == 0) errorQuda("No momenta requested");
+    for (auto i = 0u; i < w.size(); i++) {
+      for (auto j = 0u; j < v.size(); j++) {
+        checkPrecision(w[i], v[j]);
+        checkLocation(w[i], v[j]);
+      }
+    }
+    for (auto &x : {std::cref(w[0]), std::cref(v[0])}) {
+      if (x.get().GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS) errorQuda("Unexpected gamma basis %d", x.get().GammaBasis());
+      if (x.get().Nspin() != 4) errorQuda("Unexpected number of spins %d", x.get().Nspin());
+      if (x.get().SiteSubset() != QUDA_FULL_SITE_SUBSET) errorQuda("Meson field requires full fields");
+    }
+    if (cType != QUDA_CONTRACT_TYPE_OPEN && cType != QUDA_CONTRACT_TYPE_DR)
+      errorQuda("Unexpected contraction type %d", cType);
+
+    getProfile().TPSTART(QUDA_PROFILE_INIT);
+    const auto location = w[0].Location();
+    const int N = w.size();
+    const int M = v.size();
+    const int n_mom = mom.size();
+    const int nSpin = 4;
+    const int nColor = w[0].Ncolor();
+    const int Lt = w[0].X()[3];
+    const int T = Lt * comm_dim(3);
+    const int K = 2 * (w[0].VolumeCB() / Lt) * nColor;
+    const bool is_double = w[0].Precision() == QUDA_DOUBLE_PRECISION;
+    const size_t complex_size = is_double ? sizeof(std::complex<double>) : sizeof(std::complex<float>);
+
+    const size_t w_bytes = static_cast<size_t>(Lt) * K * nSpin * N * complex_size;
+    const size_t v_bytes = static_cast<size_t>(Lt) * K * nSpin * M * complex_size;
+    const size_t o_bytes = static_cast<size_t>(n_mom) * Lt * nSpin * N * nSpin * M * complex_size;
+
+    auto alloc = [=](size_t bytes) {
+      return location == QUDA_CUDA_FIELD_LOCATION ? pool_device_malloc(bytes) : safe_malloc(bytes);
+    };
+    auto release = [=](void *ptr) {
+      if (location == QUDA_CUDA_FIELD_LOCATION) pool_device_free(ptr);
+      else host_free(ptr);
+    };
+
+    void *w_pack = alloc(w_bytes);
+    void *v_pack = alloc(v_bytes);
+    void *v_phase = alloc(v_bytes);
+    void *o = alloc(o_bytes);
+    if (location == QUDA_CUDA_FIELD_LOCATION) qudaMemset(o, 0, o_bytes);
+    else memset(o, 0, o_bytes);
+    getProfile().TPSTOP(QUDA_PROFILE_INIT);
+
+    getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+    // pack each block once into per-time-slice column-major matrices,
+    // with W packed as W^dagger so that neither operand is transposed
+    for (int i = 0; i < N; i++) instantiate<MesonFieldPackBlock>(w[i], w_pack, i, N, true);
+    for (int j = 0; j < M; j++) instantiate<MesonFieldPackBlock>(v[j], v_pack, j, M, false);
+
+    // O[p][t] = W_t^dagger (phase_p V_t), batched over the local time slices
+    QudaBLASParam blas_param = newQudaBLASParam();
+    blas_param.trans_a = QUDA_BLAS_OP_N;
+    blas_param.trans_b = QUDA_BLAS_OP_N;
+    blas_param.m = nSpin * N;
+    blas_param.n = nSpin * M;
+    blas_param.k = K;
+    blas_param.lda = nSpin * N;
+    blas_param.ldb = K;
+    blas_param.ldc = nSpin * N;
+    blas_param.a_offset = 0;
+    blas_param.b_offset = 0;
+    blas_param.c_offset = 0;
+    blas_param.a_stride = 1;
+    blas_param.b_stride = 1;
+    blas_param.c_stride = 1;
+    blas_param.alpha = 1.0;
+    blas_param.beta = 0.0;
+    blas_param.batch_count = Lt;
+    blas_param.data_type = is_double ? QUDA_BLAS_DATATYPE_Z : QUDA_BLAS_DATATYPE_C;
+    blas_param.data_order = QUDA_BLAS_DATAORDER_COL;
+
+    auto gemm = (location == QUDA_CUDA_FIELD_LOCATION && use_native()) ? native::stridedBatchGEMM :
+                                                                          generic::stridedBatchGEMM;
+
+    for (int p = 0; p < n_mom; p++) {
+      instantiate<MesonFieldPhaseBlock>(v[0], v_pack, v_phase, M, mom[p]);
+      auto o_p = static_cast<char *>(o) + p * (o_bytes / n_mom);
+      gemm(w_pack, v_phase, o_p, blas_param, location);
+    }
+    getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    release(v_phase);
+    release(v_pack);
+    release(w_pack);
+
+    // apply the gamma insertion to the open-spin result and assemble
+    // the global [T][mom][gamma][N][M] tensor
+    std::vector<char> o_h_(location == QUDA_CUDA_FIELD_LOCATION ? o_bytes : 0);
+    void *o_h = o;
+    if (location == QUDA_CUDA_FIELD_LOCATION) {
+      getProfile().TPSTART(QUDA_PROFILE_D2H);
+      qudaMemcpy(o_h_.data(), o, o_bytes, qudaMemcpyDeviceToHost);
+      getProfile().TPSTOP(QUDA_PROFILE_D2H);
+      o_h = o_h_.data();
+    }
+
+    getProfile().TPSTART(QUDA_PROFILE_EPILOGUE);
+    const size_t nGamma = nSpin * nSpin;
+    std::vector<double> global(2 * T * n_mom * nGamma * N * M, 0.0);
+    auto elem = [&](size_t idx) {
+      return is_double ? complex<double>(static_cast<std::complex<double> *>(o_h)[idx].real(),
+                                         static_cast<std::complex<double> *>(o_h)[idx].imag()) :
+                         complex<double>(static_cast<std::complex<float> *>(o_h)[idx].real(),
+                                         static_cast<std::complex<float> *>(o_h)[idx].imag());
+    };
+
+#pragma omp parallel for collapse(2)
+    for (int p = 0; p < n_mom; p++) {
+      for (int t = 0; t < Lt; t++) {
+        const int t_global = comm_coord(3) * Lt + t;
+        const size_t o_base = (static_cast<size_t>(p) * Lt + t) * nSpin * N * nSpin * M;
+        for (int j = 0; j < M; j++) {
+          for (int i = 0; i < N; i++) {
+            complex<double> spin_elem[4][4];
+            for (int mu = 0; mu < nSpin; mu++)
+              for (int nu = 0; nu < nSpin; nu++)
+                spin_elem[mu][nu] = elem(o_base + (j * nSpin + nu) * nSpin * N + i * nSpin + mu);
+
+            complex<double> A[16];
+            if (cType == QUDA_CONTRACT_TYPE_DR) {
+              degrandRossiProject(A, spin_elem);
+            } else {
+              for (int mu = 0; mu < nSpin; mu++)
+                for (int nu = 0; nu < nSpin; nu++) A[mu * nSpin + nu] = spin_elem[mu][nu];
+            }
+
+            for (size_t g = 0; g < nGamma; g++) {
+              auto idx = (((static_cast<size_t>(t_global) * n_mom + p) * nGamma + g) * N + i) * M + j;
+              global[2 * idx + 0] = A[g].real();
+              global[2 * idx + 1] = A[g].imag();
+            }
+          }
+        }
+      }
+    }
+    release(o);
+    comm_allreduce_sum(global);
+
+    result.resize(global.size() / 2);
+    for (auto i = 0u; i < result.size(); i++) result[i] = Complex(global[2 * i + 0], global[2 * i + 1]);
+    getProfile().TPSTOP(QUDA_PROFILE_EPILOGUE);
+  }
 #else
   void contractQuda(const ColorSpinorField &, const ColorSpinorField &, void *, const QudaContractType)
   {
     errorQuda("Contraction code has not been built");
   }
+
+  void contractSummedQuda(const ColorSpinorField &, const ColorSpinorField &, std::vector<Complex> &,
+                          const QudaContractType, const std::vector<array<int, 3>> &)
+  {
+    errorQuda("Contraction code has not been built");
+  }
+
+  void contractMesonFieldQuda(cvector_ref<const ColorSpinorField> &, cvector_ref<const ColorSpinorField> &,
+                              std::vector<Complex> &, const QudaContractType, const std::vector<array<int, 3>> &)
+  {
+    errorQuda("Contraction code has not been built");
+  }
 #endif
 
 } // namespace quda
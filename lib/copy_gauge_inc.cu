@@ -63,8 +63,9 @@ namespace quda {
     } else if (out.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef BUILD_QDP_INTERFACE
-      copyGauge<FloatOut, FloatIn, length, fine_grain()>(QDPOrder<FloatOut, length>(out, Out, outGhost), inOrder, out,
-                                                         in, location, type);
+      instantiateLegacyRecon<QDPOrder, FloatOut, length>(out, Out, outGhost, [&](auto outOrder) {
+        copyGauge<FloatOut, FloatIn, length, fine_grain()>(std::move(outOrder), inOrder, out, in, location, type);
+      });
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
@@ -90,8 +91,9 @@ namespace quda {
     } else if (out.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef BUILD_MILC_INTERFACE
-      copyGauge<FloatOut, FloatIn, length, fine_grain()>(MILCOrder<FloatOut, length>(out, Out, outGhost), inOrder, out,
-                                                         in, location, type);
+      instantiateLegacyRecon<MILCOrder, FloatOut, length>(out, Out, outGhost, [&](auto outOrder) {
+        copyGauge<FloatOut, FloatIn, length, fine_grain()>(std::move(outOrder), inOrder, out, in, location, type);
+      });
 #else
       errorQuda("MILC interface has not been built\n");
 #endif
@@ -190,8 +192,9 @@ namespace quda {
     } else if (in.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef BUILD_QDP_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length>(in, In, inGhost),
-					 out, in, location, Out, outGhost, type);
+      instantiateLegacyRecon<QDPOrder, FloatIn, length>(in, In, inGhost, [&](const auto &inOrder) {
+        copyGauge<FloatOut, FloatIn, length>(inOrder, out, in, location, Out, outGhost, type);
+      });
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
@@ -217,8 +220,9 @@ namespace quda {
     } else if (in.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef BUILD_MILC_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>(MILCOrder<FloatIn,length>(in, In, inGhost),
-					 out, in, location, Out, outGhost, type);
+      instantiateLegacyRecon<MILCOrder, FloatIn, length>(in, In, inGhost, [&](const auto &inOrder) {
+        copyGauge<FloatOut, FloatIn, length>(inOrder, out, in, location, Out, outGhost, type);
+      });
 #else
       errorQuda("MILC interface has not been built\n");
 #endif
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <deflation_store.h>
+#include <blas_quda.h>
+
+namespace quda
+{
+
+  DeflationStore::DeflationStore(const DiracMatrix &mat, QudaPrecision prec) :
+    mat(&mat), prec(prec), work_prec(QUDA_INVALID_PRECISION)
+  {
+    if (prec < QUDA_QUARTER_PRECISION || prec > QUDA_DOUBLE_PRECISION) errorQuda("Invalid storage precision %d", prec);
+  }
+
+  bool DeflationStore::direct(const ColorSpinorField &y) const
+  {
+    // fixed-point and mixed-precision multi-blas kernels require site
+    // unrolling, and the stored vectors cannot exceed the precision of y
+    bool site_unroll = prec <= QUDA_HALF_PRECISION || prec != y.Precision();
+    return prec <= y.Precision() && (!site_unroll || (y.Ncolor() == 3 && y.Nspin() != 2));
+  }
+
+  void DeflationStore::stage(int first, int last, const ColorSpinorField &meta) const
+  {
+    if (work.empty() || work[0].Precision() != meta.Precision()) {
+      ColorSpinorParam param(v[0]);
+      param.create = QUDA_NULL_FIELD_CREATE;
+      param.setPrecision(meta.Precision(), QUDA_INVALID_PRECISION, true);
+      work.clear();
+      resize(work, tile, param);
+    }
+    for (int i = first; i < last; i++) blas::copy(work[i - first], v[i]);
+  }
+
+  void DeflationStore::dot(std::vector<Complex> &s, int first, int last, cvector_ref<const ColorSpinorField> &y) const
+  {
+    const auto ny = y.size();
+    s.resize((last - first) * ny);
+
+    if (direct(y[0])) {
+      blas::cDotProduct(s, {v.begin() + first, v.begin() + last}, y);
+      return;
+    }
+
+    std::vector<Complex> s_tile;
+    for (int i = first; i < last; i += tile) {
+      const int n = std::min(tile, last - i);
+      stage(i, i + n, y[0]);
+      blas::cDotProduct(s_tile, {work.begin(), work.begin() + n}, y);
+      std::copy(s_tile.begin(), s_tile.end(), s.begin() + (i - first) * ny);
+    }
+  }
+
+  void DeflationStore::axpy(const std::vector<Complex> &a, cvector_ref<ColorSpinorField> &y) const
+  {
+    const auto ny = y.size();
+
+    if (direct(y[0])) {
+      blas::caxpy(a, {v.begin(), v.end()}, y);
+      return;
+    }
+
+    for (int i = 0; i < size(); i += tile) {
+      const int n = std::min(tile, size() - i);
+      stage(i, i + n, y[0]);
+      std::vector<Complex> a_tile(a.begin() + i * ny, a.begin() + (i + n) * ny);
+      blas::caxpy(a_tile, {work.begin(), work.begin() + n}, y);
+    }
+  }
+
+  void DeflationStore::extend(int first)
+  {
+    H.resize(size());
+    L.resize(size());
+    if (first == size()) return;
+
+    ColorSpinorParam param(v[0]);
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.setPrecision(work_prec, QUDA_INVALID_PRECISION, true);
+    ColorSpinorField tmp(param);
+    std::vector<ColorSpinorField> Av;
+    resize(Av, std::min(tile, size() - first), param);
+
+    std::vector<Complex> h;
+    for (int k0 = first; k0 < size(); k0 += tile) {
+      const int n = std::min(tile, size() - k0);
+
+      // Av_j = A v_{k0 + j}, then h[p * n + j] = H_{p, k0 + j} = (v_p, A v_{k0 + j})
+      for (int j = 0; j < n; j++) {
+        blas::copy(tmp, v[k0 + j]);
+        (*mat)(Av[j], tmp);
+      }
+      dot(h, 0, k0 + n, {Av.begin(), Av.begin() + n});
+
+      for (int j = 0; j < n; j++) {
+        const int k = k0 + j;
+        H[k].resize(k + 1);
+        for (int p = 0; p <= k; p++) H[k][p] = conj(h[p * n + j]);
+        H[k][k] = H[k][k].real();
+
+        // border the Cholesky factor: H_{kp} = sum_q L_{kq} conj(L_{pq})
+        L[k].assign(k + 1, 0.0);
+        double d = H[k][k].real();
+        for (int p = 0; p < k; p++) {
+          if (L[p][p] == 0.0) continue; // dropped vector
+          Complex l = H[k][p];
+          for (int q = 0; q < p; q++) l -= L[k][q] * conj(L[p][q]);
+          L[k][p] = l / L[p][p];
+          d -= norm(L[k][p]);
+        }
+
+        if (d > H[k][k].real() * std::numeric_limits<double>::epsilon() * size()) {
+          L[k][k] = sqrt(d);
+        } else {
+          // the vector is (numerically) in the span of the previous ones, or the operator is not positive definite
+          warningQuda("Dropping deflation vector %d with projected pivot %e", k, d);
+          L[k].assign(k + 1, 0.0);
+        }
+      }
+    }
+  }
+
+  void DeflationStore::add(std::vector<ColorSpinorField> &vecs)
+  {
+    if (vecs.size() == 0) return;
+    if (work_prec == QUDA_INVALID_PRECISION) work_prec = vecs[0].Precision();
+    if (vecs[0].Precision() != work_prec) errorQuda("Precision %d does not match %d", vecs[0].Precision(), work_prec);
+
+    const int first = size();
+    ColorSpinorParam param(vecs[0]);
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.setPrecision(prec, QUDA_INVALID_PRECISION, true);
+
+    // compress one vector at a time, releasing the source as we go
+    v.reserve(first + vecs.size());
+    for (auto &vi : vecs) {
+      v.emplace_back(param);
+      blas::copy(v.back(), vi);
+      vi = ColorSpinorField();
+    }
+    vecs.clear();
+
+    extend(first);
+
+    logQuda(QUDA_VERBOSE, "Deflation store holds %d vectors in %lu bytes\n", size(), bytes());
+  }
+
+  void DeflationStore::rebuild()
+  {
+    H.clear();
+    L.clear();
+    extend(0);
+  }
+
+  void DeflationStore::deflate(cvector_ref<ColorSpinorField> &sol, cvector_ref<const ColorSpinorField> &src,
+                               bool accumulate) const
+  {
+    if (size() == 0) {
+      warningQuda("deflate called with an empty deflation store");
+      return;
+    }
+    logQuda(QUDA_VERBOSE, "Deflating %d compressed vectors\n", size());
+
+    const int n = size();
+    const auto ny = src.size();
+
+    // 1. s = V^dag src
+    std::vector<Complex> s;
+    dot(s, 0, n, src);
+
+    // 2. solve (L L^dag) c = s for each source, skipping dropped vectors
+    for (auto j = 0u; j < ny; j++) {
+      for (int k = 0; k < n; k++) {
+        if (L[k][k] == 0.0) {
+          s[k * ny + j] = 0.0;
+          continue;
+        }
+        Complex z = s[k * ny + j];
+        for (int q = 0; q < k; q++) z -= L[k][q] * s[q * ny + j];
+        s[k * ny + j] = z / L[k][k];
+      }
+      for (int k = n - 1; k >= 0; k--) {
+        if (L[k][k] == 0.0) continue;
+        Complex c = s[k * ny + j];
+        for (int p = k + 1; p < n; p++) c -= conj(L[p][k]) * s[p * ny + j];
+        s[k * ny + j] = c / L[k][k];
+      }
+    }
+
+    // 3. sol (+)= V c
+    if (!accumulate)
+      for (auto &x : sol) blas::zero(x);
+    axpy(s, sol);
+  }
+
+  size_t DeflationStore::bytes() const
+  {
+    size_t bytes = 0;
+    for (auto &vi : v) bytes += vi.Bytes();
+    return bytes;
+  }
+
+} // namespace quda
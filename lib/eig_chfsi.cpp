@@ -0,0 +1,262 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <eigensolve_quda.h>
+#include <random_quda.h>
+#include <qio_field.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <util_quda.h>
+#include <tune_quda.h>
+#include <eigen_helper.h>
+
+namespace quda
+{
+  // Chebyshev-Filtered Subspace Iteration constructor
+  CHFSI::CHFSI(const DiracMatrix &mat, QudaEigParam *eig_param, TimeProfile &profile) :
+    EigenSolver(mat, eig_param, profile)
+  {
+    bool profile_running = profile.isRunning(QUDA_PROFILE_INIT);
+    if (!profile_running) profile.TPSTART(QUDA_PROFILE_INIT);
+
+    // Ritz values of the search subspace
+    ritz.resize(n_kr, 0.0);
+
+    // CHFSI specific checks
+    if (!eig_param->use_poly_acc) errorQuda("Polynomial acceleration must be enabled for the CHFSI solver");
+
+    // The filter amplifies the spectrum below a_min, so only the low end can be computed
+    if (eig_param->spectrum != QUDA_SPECTRUM_SR_EIG)
+      errorQuda("Only the smallest real spectrum type (SR) can be passed to the CHFSI solver");
+
+    if (block_size <= 0) errorQuda("Block size %d passed to CHFSI solver must be positive", block_size);
+
+    if (!profile_running) profile.TPSTOP(QUDA_PROFILE_INIT);
+  }
+
+  void CHFSI::operator()(std::vector<ColorSpinorField> &kSpace, std::vector<Complex> &evals)
+  {
+    // Pre-launch checks and preparation
+    //---------------------------------------------------------------------------
+    queryPrec(kSpace[0].Precision());
+    // Check to see if we are loading eigenvectors
+    if (strcmp(eig_param->vec_infile, "") != 0) {
+      logQuda(QUDA_VERBOSE, "Loading evecs from file name %s\n", eig_param->vec_infile);
+      loadFromFile(kSpace, evals);
+      return;
+    }
+
+    // Increase the size of kSpace passed to the function, will be trimmed to
+    // original size before exit.
+    prepareKrylovSpace(kSpace, evals);
+
+    // The whole search subspace is the initial guess. Any vectors passed in
+    // are preserved, e.g., a deflation space from a previous gauge field,
+    // and the remainder are populated with rands.
+    RNG rng(kSpace[0], 1234);
+    for (int i = 0; i < n_kr; i++) {
+      if (sqrt(blas::norm2(kSpace[i])) == 0.0) { spinorNoise(kSpace[i], rng, QUDA_NOISE_UNIFORM); }
+    }
+
+    bool orthed = false;
+    int k = 0;
+    while (!orthed && k < max_ortho_attempts) {
+      logQuda(QUDA_SUMMARIZE, "Orthonormalising initial subspace with Modified Gram Schmidt, iter k=%d\n", k);
+      orthonormalizeHMGS(kSpace, ortho_block_size, n_kr);
+      orthed = orthoCheck(kSpace, n_kr);
+      k++;
+    }
+    if (!orthed)
+      errorQuda("Failed to orthonormalise initial subspace with %d orthonormalisation attempts (max = %d)", k + 1,
+                max_ortho_attempts);
+
+    // Estimate the Chebyshev maximum using the workspace, so that the
+    // initial subspace is left intact
+    if (eig_param->a_max <= 0.0) {
+      eig_param->a_max = estimateChebyOpMax(kSpace[n_kr], r[0]);
+      logQuda(QUDA_SUMMARIZE, "Chebyshev maximum estimate: %e.\n", eig_param->a_max);
+    }
+    checkChebyOpMax(kSpace);
+
+    // The lower bound of the damped interval follows the largest Ritz
+    // value of the subspace, restore the user's value on exit
+    const double a_min = eig_param->a_min;
+
+    // Convergence criterion
+    double mat_norm = 0.0;
+
+    // Print Eigensolver params
+    printEigensolverSetup();
+    //---------------------------------------------------------------------------
+
+    // Begin CHFSI Eigensolver computation
+    //---------------------------------------------------------------------------
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    // Loop over filter iterations.
+    while (restart_iter < max_restarts && !converged) {
+
+      // Filter the unlocked vectors, then orthonormalise them against the
+      // locked vectors and each other. The filtered vectors are strongly
+      // dominated by the lowest modes, so we orthonormalise twice.
+      filter(kSpace);
+      for (int i = 0; i < 2; i++) orthonormalizeHMGS(kSpace, ortho_block_size, n_kr, num_locked);
+
+      // Rotate the unlocked vectors into the Ritz vectors
+      rayleighRitz(kSpace);
+
+      // mat_norm is updated.
+      for (int i = num_locked; i < n_kr; i++)
+        if (fabs(ritz[i]) > mat_norm) mat_norm = fabs(ritz[i]);
+
+      // Lock the converged Ritz pairs
+      lock(kSpace, mat_norm);
+      num_converged = num_locked;
+
+      // Damp everything above the search subspace in the next filter
+      if (ritz[n_kr - 1] < eig_param->a_max) eig_param->a_min = ritz[n_kr - 1];
+
+      logQuda(QUDA_VERBOSE, "%04d converged eigenvalues at restart iter %04d\n", num_converged, restart_iter + 1);
+
+      logQuda(QUDA_DEBUG_VERBOSE, "iter Lock = %d\n", iter_locked);
+      logQuda(QUDA_DEBUG_VERBOSE, "num_locked = %d\n", num_locked);
+      logQuda(QUDA_DEBUG_VERBOSE, "a-min = %e\n", eig_param->a_min);
+      for (int i = 0; i < n_kr; i++) {
+        logQuda(QUDA_DEBUG_VERBOSE, "Ritz[%d] = %.16e residual[%d] = %.16e\n", i, ritz[i], i, residua[i]);
+      }
+
+      // Check for convergence
+      if (num_converged >= n_conv) converged = true;
+      restart_iter++;
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    eig_param->a_min = a_min;
+
+    // Post computation report
+    //---------------------------------------------------------------------------
+    if (!converged) {
+      if (eig_param->require_convergence) {
+        errorQuda("CHFSI failed to compute the requested %d vectors with a %d search space and %d subspace size "
+                  "in %d restart steps. Exiting.",
+                  n_conv, n_ev, n_kr, max_restarts);
+      } else {
+        warningQuda("CHFSI failed to compute the requested %d vectors with a %d search space and %d subspace size "
+                    "in %d restart steps. Continuing with current subspace.",
+                    n_conv, n_ev, n_kr, max_restarts);
+      }
+    } else {
+      logQuda(QUDA_SUMMARIZE,
+              "CHFSI computed the requested %d vectors in %d restart steps with %d block size and "
+              "%d OP*x operations.\n",
+              n_conv, restart_iter, block_size, iter);
+
+      // Dump all Ritz values and residua
+      for (int i = 0; i < n_conv; i++) {
+        logQuda(QUDA_SUMMARIZE, "RitzValue[%04d]: (%+.16e, %+.16e) residual %.16e\n", i, ritz[i], 0.0, residua[i]);
+      }
+
+      // Compute eigenvalues
+      computeEvals(kSpace, evals);
+      if (compute_svd) computeSVD(kSpace, evals);
+    }
+
+    // Local clean-up
+    cleanUpEigensolver(kSpace, evals);
+  }
+
+  // CHFSI Member functions
+  //---------------------------------------------------------------------------
+  void CHFSI::filter(std::vector<ColorSpinorField> &v)
+  {
+    // v[n_kr:n_kr + block_size] is the workspace
+    for (int j = num_locked; j < n_kr; j += block_size) {
+      int n = std::min(block_size, n_kr - j);
+      chebyOp({v.begin() + n_kr, v.begin() + n_kr + n}, {v.begin() + j, v.begin() + j + n});
+      for (int b = 0; b < n; b++) std::swap(v[j + b], v[n_kr + b]);
+    }
+    iter += (n_kr - num_locked) * eig_param->poly_deg;
+  }
+
+  void CHFSI::rayleighRitz(std::vector<ColorSpinorField> &v)
+  {
+    int dim = n_kr - num_locked;
+    MatrixXcd H = MatrixXcd::Zero(dim, dim);
+    std::vector<Complex> h;
+
+    // Build the lower triangle of H = V^dag A V a block of columns at a
+    // time, with w = A v_j in the workspace, h[i * n + b] = (v_{j + i}, w_b)
+    for (int j = num_locked; j < n_kr; j += block_size) {
+      int n = std::min(block_size, n_kr - j);
+      mat({v.begin() + n_kr, v.begin() + n_kr + n}, {v.begin() + j, v.begin() + j + n});
+
+      h.resize((n_kr - j) * n);
+      blas::cDotProduct(h, {v.begin() + j, v.begin() + n_kr}, {v.begin() + n_kr, v.begin() + n_kr + n});
+
+      for (int i = j; i < n_kr; i++) {
+        for (int b = 0; b < n; b++) {
+          H(i - num_locked, j + b - num_locked) = h[(i - j) * n + b];
+          if (i >= j + n) H(j + b - num_locked, i - num_locked) = conj(h[(i - j) * n + b]);
+        }
+      }
+    }
+    iter += dim;
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    profile.TPSTART(QUDA_PROFILE_EIGEN);
+
+    // Symmetrise the diagonal blocks
+    H = 0.5 * (H + H.adjoint()).eval();
+
+    // Eigensolve the projected matrix, the eigenvalues are in ascending order
+    SelfAdjointEigenSolver<MatrixXcd> eigensolver;
+    eigensolver.compute(H);
+
+    for (int i = 0; i < dim; i++) ritz[i + num_locked] = eigensolver.eigenvalues()[i];
+
+    // Multi-BLAS friendly rotation array: ROW major
+    std::vector<Complex> ritz_mat(dim * dim);
+    for (int i = 0; i < dim; i++)
+      for (int k = 0; k < dim; k++) ritz_mat[i * dim + k] = eigensolver.eigenvectors()(i, k);
+
+    profile.TPSTOP(QUDA_PROFILE_EIGEN);
+
+    rotateVecs(v, ritz_mat, n_kr + block_size, dim, dim, num_locked, profile);
+
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+  }
+
+  void CHFSI::lock(std::vector<ColorSpinorField> &v, double mat_norm)
+  {
+    // Pairs are locked in order, so we stop computing residuals at the
+    // first block that holds an unconverged pair
+    iter_locked = 0;
+    bool locking = true;
+    for (int j = num_locked; j < n_ev && locking; j += block_size) {
+      int n = std::min(block_size, n_ev - j);
+      mat({v.begin() + n_kr, v.begin() + n_kr + n}, {v.begin() + j, v.begin() + j + n});
+      iter += n;
+
+      for (int b = 0; b < n; b++) {
+        // r = A v - lambda v
+        residua[j + b] = sqrt(blas::axpyNorm(-ritz[j + b], v[j + b], v[n_kr + b]));
+        if (locking && residua[j + b] < tol * mat_norm) {
+          logQuda(QUDA_DEBUG_VERBOSE, "**** Locking %d resid=%+.6e condition=%.6e ****\n", j + b, residua[j + b],
+                  tol * mat_norm);
+          iter_locked++;
+        } else {
+          locking = false;
+        }
+      }
+    }
+
+    num_locked += iter_locked;
+  }
+
+} // namespace quda
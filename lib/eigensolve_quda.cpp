@@ -119,6 +119,10 @@ namespace quda
       logQuda(QUDA_VERBOSE, "Creating Block TR Lanczos eigensolver\n");
       eig_solver = new BLKTRLM(mat, eig_param, profile);
       break;
+    case QUDA_EIG_CHFSI:
+      logQuda(QUDA_VERBOSE, "Creating Chebyshev-filtered subspace iteration eigensolver\n");
+      eig_solver = new CHFSI(mat, eig_param, profile);
+      break;
     default: errorQuda("Invalid eig solver type");
     }
 
@@ -382,9 +386,9 @@ namespace quda
     return orthed;
   }
 
-  void EigenSolver::orthonormalizeHMGS(std::vector<ColorSpinorField> &vecs, int h_block_size, int size)
+  void EigenSolver::orthonormalizeHMGS(std::vector<ColorSpinorField> &vecs, int h_block_size, int size, int first)
   {
-    for (int i = 0; i < size; i++) {
+    for (int i = first; i < size; i++) {
       auto array_size = h_block_size;
       for (int j = 0; j < i; j += array_size) {
         if (i < h_block_size || h_block_size == 0) array_size = i;
@@ -57,7 +57,9 @@ namespace quda {
       } else if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
 
         if constexpr (is_enabled<QUDA_QDP_GAUGE_ORDER>()) {
-          ExtractGhost<Float, nColor, QDPOrder<Float,length>>(u, Ghost, extract, offset);
+          instantiateLegacyRecon<QDPOrder, Float, length>(u, nullptr, Ghost, [&](const auto &order) {
+            ExtractGhost<Float, nColor, std::decay_t<decltype(order)>>(u, Ghost, extract, offset);
+          });
         } else {
           errorQuda("QDP interface has not been built");
         }
@@ -81,7 +83,9 @@ namespace quda {
       } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
 
         if constexpr (is_enabled<QUDA_MILC_GAUGE_ORDER>()) {
-          ExtractGhost<Float, nColor, MILCOrder<Float,length>>(u, Ghost, extract, offset);
+          instantiateLegacyRecon<MILCOrder, Float, length>(u, nullptr, Ghost, [&](const auto &order) {
+            ExtractGhost<Float, nColor, std::decay_t<decltype(order)>>(u, Ghost, extract, offset);
+          });
         } else {
           errorQuda("MILC interface has not been built");
         }
@@ -0,0 +1,170 @@
+#include <fft_distributed.h>
+#include <comm_quda.h>
+#include <tunable_nd.h>
+#include <kernels/fft_distributed.cuh>
+
+namespace quda
+{
+
+  int comm_rank_from_coords(const int *coords);
+
+  template <typename Float> class FFTTransposer : TunableKernel1D
+  {
+    complex<Float> *out;
+    const complex<Float> *in;
+    const lat_dim_t &X;
+    int d;
+    int P;
+    FFTTransposeType type;
+    size_t volume;
+    unsigned int minThreads() const { return volume; }
+
+  public:
+    FFTTransposer(const LatticeField &meta, void *out, const void *in, const lat_dim_t &X, int d, int P,
+                  FFTTransposeType type) :
+      TunableKernel1D(meta),
+      out(static_cast<complex<Float> *>(out)),
+      in(static_cast<const complex<Float> *>(in)),
+      X(X),
+      d(d),
+      P(P),
+      type(type),
+      volume(static_cast<size_t>(X[0]) * X[1] * X[2] * X[3])
+    {
+      char tmp[TuneKey::aux_n];
+      sprintf(tmp, ",d=%d,P=%d", d, P);
+      strcat(aux, tmp);
+      strcat(aux, type == FFT_PACK ? ",pack" : type == FFT_UNPACK ? ",unpack" : type == FFT_GATHER ? ",gather" : ",scatter");
+      apply(device::get_default_stream());
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      switch (type) {
+      case FFT_PACK: launch<FFTTranspose>(tp, stream, FFTTransposeArg<Float, FFT_PACK>(X, d, P, out, in)); break;
+      case FFT_UNPACK: launch<FFTTranspose>(tp, stream, FFTTransposeArg<Float, FFT_UNPACK>(X, d, P, out, in)); break;
+      case FFT_GATHER: launch<FFTTranspose>(tp, stream, FFTTransposeArg<Float, FFT_GATHER>(X, d, P, out, in)); break;
+      case FFT_SCATTER: launch<FFTTranspose>(tp, stream, FFTTransposeArg<Float, FFT_SCATTER>(X, d, P, out, in)); break;
+      default: errorQuda("Unexpected transpose type %d", type);
+      }
+    }
+
+    long long flops() const { return 0; }
+    long long bytes() const { return 2 * volume * sizeof(complex<Float>); }
+  };
+
+  FFTDistributed::FFTDistributed(const LatticeField &meta, QudaPrecision precision) :
+    meta(meta), precision(precision), volume(1)
+  {
+    if (precision != QUDA_DOUBLE_PRECISION && precision != QUDA_SINGLE_PRECISION)
+      errorQuda("Unsupported precision %d", precision);
+
+    bool partitioned = false;
+    for (int d = 0; d < 4; d++) {
+      X[d] = meta.LocalX()[d];
+      P[d] = comm_dim(d);
+      volume *= X[d];
+      if (P[d] > 1) partitioned = true;
+    }
+
+    for (int d = 0; d < 4; d++) {
+      if ((volume / X[d]) % P[d] != 0)
+        errorQuda("Number of lines %lu in dimension %d not divisible by the number of ranks %d", volume / X[d], d, P[d]);
+      // batched 1-d transform over contiguous lines of length L_d
+      int4 size = make_int4(volume / (X[d] * P[d]), 1, 1, X[d] * P[d]);
+      SetPlanFFTMany(plan[d], size, 1, precision);
+    }
+
+    size_t bytes = volume * 2 * precision;
+    for (auto &b : buffer) b = device_malloc(bytes);
+    if (partitioned) {
+      send = pinned_malloc(bytes);
+      recv = pinned_malloc(bytes);
+    }
+
+    logQuda(QUDA_VERBOSE, "Created distributed FFT with local volume %d x %d x %d x %d and grid %d x %d x %d x %d\n",
+            X[0], X[1], X[2], X[3], P[0], P[1], P[2], P[3]);
+  }
+
+  FFTDistributed::~FFTDistributed()
+  {
+    for (int d = 0; d < 4; d++) FFTDestroyPlan(plan[d]);
+    for (auto &b : buffer) device_free(b);
+    if (send) host_free(send);
+    if (recv) host_free(recv);
+  }
+
+  void FFTDistributed::exchange(void *data, int d)
+  {
+    const size_t bytes = volume * 2 * precision;
+    const size_t chunk = bytes / P[d];
+    const int me = comm_coord(d);
+
+    qudaMemcpy(send, data, bytes, qudaMemcpyDeviceToHost);
+
+    int coords[QUDA_MAX_DIM] = {};
+    for (int i = 0; i < 4; i++) coords[i] = comm_coord(i);
+
+    std::vector<MsgHandle *> mh;
+    for (int j = 0; j < P[d]; j++) {
+      auto s = static_cast<char *>(send) + j * chunk;
+      auto r = static_cast<char *>(recv) + j * chunk;
+      if (j == me) {
+        memcpy(r, s, chunk);
+      } else {
+        coords[d] = j;
+        int rank = comm_rank_from_coords(coords);
+        mh.push_back(comm_declare_recv_rank(r, rank, d, chunk));
+        mh.push_back(comm_declare_send_rank(s, rank, d, chunk));
+      }
+    }
+
+    for (auto &m : mh) comm_start(m);
+    for (auto &m : mh) comm_wait(m);
+    for (auto &m : mh) comm_free(m);
+
+    qudaMemcpy(data, recv, bytes, qudaMemcpyHostToDevice);
+  }
+
+  template <typename Float> void FFTDistributed::transform(void *out, const void *in, int direction)
+  {
+    using complex_t = std::conditional_t<std::is_same_v<Float, double>, double2, float2>;
+    auto fft = [&](int d, void *dst, void *src) {
+      ApplyFFT(plan[d], static_cast<complex_t *>(src), static_cast<complex_t *>(dst), direction);
+    };
+
+    for (int d = 0; d < 4; d++) {
+      const void *src = d == 0 ? in : out;
+      FFTTransposer<Float>(meta, buffer[0], src, X, d, P[d], FFT_PACK);
+
+      if (P[d] > 1) {
+        exchange(buffer[0], d);
+        FFTTransposer<Float>(meta, buffer[1], buffer[0], X, d, P[d], FFT_GATHER);
+        fft(d, buffer[0], buffer[1]);
+        FFTTransposer<Float>(meta, buffer[1], buffer[0], X, d, P[d], FFT_SCATTER);
+        exchange(buffer[1], d);
+      } else {
+        fft(d, buffer[1], buffer[0]);
+      }
+
+      FFTTransposer<Float>(meta, out, buffer[1], X, d, P[d], FFT_UNPACK);
+    }
+  }
+
+  void FFTDistributed::operator()(void *out, const void *in, int direction)
+  {
+    if (precision == QUDA_DOUBLE_PRECISION)
+      transform<double>(out, in, direction);
+    else
+      transform<float>(out, in, direction);
+  }
+
+  double FFTDistributed::flops() const
+  {
+    double flops = 0.0;
+    for (int d = 0; d < 4; d++) flops += 5.0 * volume * log2(static_cast<double>(X[d] * P[d]));
+    return flops;
+  }
+
+} // namespace quda
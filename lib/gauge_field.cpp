@@ -81,6 +81,10 @@ namespace quda {
       errorQuda("Cannot request a 12/8 reconstruct type without SU(3) link type");
     if (param.reconstruct == QUDA_RECONSTRUCT_10 && param.link_type != QUDA_ASQTAD_MOM_LINKS)
       errorQuda("10-reconstruction only supported with momentum links");
+    if ((param.reconstruct == QUDA_RECONSTRUCT_12 || param.reconstruct == QUDA_RECONSTRUCT_8)
+        && !gauge::isNative(param.order, param.Precision(), param.reconstruct) && param.order != QUDA_QDP_GAUGE_ORDER
+        && param.order != QUDA_MILC_GAUGE_ORDER)
+      errorQuda("Compressed storage not supported for gauge order %d", param.order);
 
     nColor = param.nColor;
     nFace = param.nFace;
@@ -373,7 +377,8 @@ namespace quda {
     bool comms_reset = ghost_field_reset || // FIXME add send buffer check
       (my_face_h[0] != ghost_pinned_send_buffer_h[0]) || (my_face_h[1] != ghost_pinned_send_buffer_h[1])
       || (from_face_h[0] != ghost_pinned_recv_buffer_h[0]) || (from_face_h[1] != ghost_pinned_recv_buffer_h[1])
-      || ghost_bytes != ghost_bytes_old; // ghost buffer has been resized (e.g., bidir to unidir)
+      || ghost_bytes != ghost_bytes_old // ghost buffer has been resized (e.g., bidir to unidir)
+      || comms_epoch != comms_plan_epoch; // message handles have been freed
 
     if (!initComms || comms_reset) LatticeField::createComms(no_comms_fill);
 
@@ -7,6 +7,7 @@
 #include <gauge_tools.h>
 
 #include <FFT_Plans.h>
+#include <fft_distributed.h>
 #include <instantiate.h>
 
 #include <tunable_nd.h>
@@ -67,17 +68,20 @@ namespace quda {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       launch<FixQualityFFT>(arg.result, tp, stream, arg);
 
-      arg.result[0] /= static_cast<double>(3 * Arg::gauge_dir * meta.Volume());
-      arg.result[1] /= static_cast<double>(3 * meta.Volume());
+      // the reduction is global, so normalize by the global volume
+      double volume = static_cast<double>(meta.LocalVolume()) * comm_size();
+      arg.result[0] /= 3 * Arg::gauge_dir * volume;
+      arg.result[1] /= 3 * volume;
     }
 
-    long long flops() const { return (36 * Arg::gauge_dir + 65) * meta.Volume(); }
+    long long flops() const { return (36 * Arg::gauge_dir + 65) * meta.LocalVolume(); }
     long long bytes() const
-    { return (Arg::gauge_dir * meta.Bytes() / 4) + 12 * meta.Volume() * meta.Precision(); }
+    { return (Arg::gauge_dir * meta.Bytes() / 4) + 12 * meta.LocalVolume() * meta.Precision(); }
   };
 
   enum GaugeFixFFTKernel {
     KERNEL_SET_INVPSQ,
+    KERNEL_SET_INVPSQ_LEX,
     KERNEL_NORMALIZE,
     KERNEL_GX,
     KERNEL_UEO
@@ -104,6 +108,7 @@ namespace quda {
       strcpy(aux, aux_tmp);
       switch (type) {
       case KERNEL_SET_INVPSQ: strcat(aux, ",set_invpsq"); break;
+      case KERNEL_SET_INVPSQ_LEX: strcat(aux, ",set_invpsq_lex"); break;
       case KERNEL_NORMALIZE: strcat(aux, ",normalize"); break;
       case KERNEL_GX: strcat(aux, ",gx"); break;
       case KERNEL_UEO:
@@ -121,6 +126,7 @@ namespace quda {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       switch (type) {
       case KERNEL_SET_INVPSQ: launch<set_invpsq>(tp, stream, arg); break;
+      case KERNEL_SET_INVPSQ_LEX: launch<set_invpsq_lex>(tp, stream, arg); break;
       case KERNEL_NORMALIZE: launch<mult_norm_2d>(tp, stream, arg); break;
       case KERNEL_GX: launch<GX>(tp, stream, arg); break;
 #ifdef GAUGEFIXING_DONT_USE_GX
@@ -153,7 +159,8 @@ namespace quda {
     long long flops() const
     {
       switch (type) {
-      case KERNEL_SET_INVPSQ: return 2 * field.Volume();
+      case KERNEL_SET_INVPSQ:
+      case KERNEL_SET_INVPSQ_LEX: return 2 * field.Volume();
       case KERNEL_NORMALIZE: return 2 * field.Volume();
       case KERNEL_GX: return (arg.elems == 6 ? 208 : 166) * field.Volume();
 #ifdef GAUGEFIXING_DONT_USE_GX
@@ -168,7 +175,8 @@ namespace quda {
     long long bytes() const
     {
       switch (type) {
-      case KERNEL_SET_INVPSQ: return sizeof(typename Arg::Float) * field.Volume();
+      case KERNEL_SET_INVPSQ:
+      case KERNEL_SET_INVPSQ_LEX: return sizeof(typename Arg::Float) * field.Volume();
       case KERNEL_NORMALIZE: return 3 * sizeof(typename Arg::Float) * field.Volume();
       case KERNEL_GX: return 4 * arg.elems * field.Precision() * field.Volume();
 #ifdef GAUGEFIXING_DONT_USE_GX
@@ -181,6 +189,150 @@ namespace quda {
     }
   };
 
+  template <typename Arg> class GaugeFixTransform : TunableKernel2D
+  {
+    Arg &arg;
+    const GaugeField &field;
+    bool compute_g; // true = compute g(x), false = apply g(x) to the links
+    unsigned int minThreads() const { return arg.threads.x; }
+
+  public:
+    GaugeFixTransform(Arg &arg, const GaugeField &field, bool compute_g) :
+      TunableKernel2D(field, 2), arg(arg), field(field), compute_g(compute_g)
+    {
+      strcat(aux, compute_g ? ",gx_field" : ",ueo_field");
+      apply(device::get_default_stream());
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      if (compute_g)
+        launch<GXField>(tp, stream, arg);
+      else
+        launch<U_EO_Field>(tp, stream, arg);
+    }
+
+    void preTune()
+    {
+      if (!compute_g) field.backup();
+    }
+    void postTune()
+    {
+      if (!compute_g) field.restore();
+    }
+
+    long long flops() const { return (compute_g ? 166 : 4 * 396) * field.LocalVolume(); }
+    long long bytes() const
+    {
+      return compute_g ? (6 * 2 + 18) * sizeof(typename Arg::Float) * field.LocalVolume() :
+                         field.Bytes() + 5 * 18 * sizeof(typename Arg::Float) * field.LocalVolume();
+    }
+  };
+
+  /**
+     @brief Fourier accelerated gauge fixing on a partitioned lattice.
+     The 4-d FFTs are performed by FFTDistributed, and the gauge
+     transformation is applied using an extended field for g(x) whose
+     halo is exchanged, since the update of U_mu(x) requires g(x+mu).
+     The gauge field must be extended with a border in the
+     partitioned dimensions.
+  */
+  template <typename Float, QudaReconstructType recon, int gauge_dir>
+  void gaugeFixingFFTDistributed(GaugeField &data, int Nsteps, int verbose_interval, double alpha0, int autotune,
+                                 double tolerance, int stopWtheta)
+  {
+    for (int d = 0; d < 4; d++)
+      if (comm_dim_partitioned(d) && data.R()[d] == 0)
+        errorQuda("Gauge field must be extended in partitioned dimension %d", d);
+
+    TimeProfile profileInternalGaugeFixFFT("InternalGaugeFixQudaFFT", false);
+    profileInternalGaugeFixFFT.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    using real = typename mapper<Float>::type;
+    const QudaPrecision fft_prec = sizeof(real) == sizeof(double) ? QUDA_DOUBLE_PRECISION : QUDA_SINGLE_PRECISION;
+
+    GaugeFieldParam gParam(data);
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    gParam.geometry = QUDA_SCALAR_GEOMETRY;
+    gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+    gParam.setPrecision(fft_prec, true);
+    GaugeField g(gParam);
+
+    GaugeFixArg<Float, recon> arg(data, alpha0);
+    FFTDistributed fft(data, fft_prec);
+
+    GaugeFixerFFT<decltype(arg)> gfix(arg, data);
+    gfix.set_type(KERNEL_SET_INVPSQ_LEX);
+    gfix.apply(device::get_default_stream());
+
+    GaugeFixQualityFFTArg<Float, recon, gauge_dir> argQ(data, arg.delta);
+    GaugeFixQuality<decltype(argQ)> gfixquality(argQ, data);
+    gfixquality.apply(device::get_default_stream());
+    double action0 = argQ.getAction();
+    logQuda(QUDA_SUMMARIZE, "Step: %d\tAction: %.16e\ttheta: %.16e\n", 0, argQ.getAction(), argQ.getTheta());
+
+    double diff = 0.0;
+    int iter = 0;
+    for (iter = 0; iter < Nsteps; iter++) {
+      for (int k = 0; k < 6; k++) {
+        // accelerate each element of Delta, using gx as the momentum-space array
+        complex<real> *_array = arg.delta + k * arg.volume;
+        fft(arg.gx, _array, FFT_FORWARD);
+        gfix.set_type(KERNEL_NORMALIZE);
+        gfix.apply(device::get_default_stream());
+        fft(_array, arg.gx, FFT_INVERSE);
+      }
+
+      GaugeFixTransformArg<Float, recon> argT(data, g, arg.delta, arg.alpha);
+      GaugeFixTransform<decltype(argT)>(argT, data, true);
+      g.exchangeExtendedGhost(g.R(), false);
+      GaugeFixTransform<decltype(argT)>(argT, data, false);
+      data.exchangeExtendedGhost(data.R(), false);
+
+      gfixquality.apply(device::get_default_stream());
+      double action = argQ.getAction();
+      diff = abs(action0 - action);
+      if ((iter % verbose_interval) == (verbose_interval - 1))
+        logQuda(QUDA_SUMMARIZE, "Step: %d\tAction: %.16e\ttheta: %.16e\tDelta: %.16e\n", iter + 1, argQ.getAction(),
+                argQ.getTheta(), diff);
+      if (autotune && ((action - action0) < -1e-14)) {
+        if (arg.alpha > 0.01) {
+          arg.alpha = 0.95 * arg.alpha;
+          logQuda(QUDA_SUMMARIZE, ">>>>>>>>>>>>>> Warning: changing alpha down -> %.4e\n", arg.alpha);
+        }
+      }
+      if (stopWtheta) {
+        if (argQ.getTheta() < tolerance) break;
+      } else {
+        if (diff < tolerance) break;
+      }
+
+      action0 = action;
+    }
+    if ((iter % verbose_interval) != (verbose_interval - 1))
+      logQuda(QUDA_SUMMARIZE, "Step: %d\tAction: %.16e\ttheta: %.16e\tDelta: %.16e\n", iter + 1, argQ.getAction(),
+              argQ.getTheta(), diff);
+
+    // Reunitarize at end
+    setUnitarizeLinksConstants(1e-14, 1e-10, 1, 0, 1e-6, 1e-6);
+    int *num_failures_h = static_cast<int *>(mapped_malloc(sizeof(int)));
+    int *num_failures_d = static_cast<int *>(get_mapped_device_pointer(num_failures_h));
+    *num_failures_h = 0;
+    unitarizeLinks(data, data, num_failures_d);
+    if (*num_failures_h > 0) errorQuda("Error in the unitarization (%d errors)\n", *num_failures_h);
+    host_free(num_failures_h);
+    data.exchangeExtendedGhost(data.R(), false);
+
+    arg.free();
+    qudaDeviceSynchronize();
+    profileInternalGaugeFixFFT.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    double secs = profileInternalGaugeFixFFT.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = iter * (12 * fft.flops() + gfixquality.flops()) * 1e-9 * comm_size() / secs;
+    logQuda(QUDA_SUMMARIZE, "Time: %6.6f s, %d iterations, FFT + quality Gflop/s = %6.1f\n", secs, iter, gflops);
+  }
+
   template <typename Float, QudaReconstructType recon, int gauge_dir>
   void gaugeFixingFFT(GaugeField& data, int Nsteps, int verbose_interval,
                       double alpha0, int autotune, double tolerance, int stopWtheta)
@@ -367,16 +519,26 @@ namespace quda {
     {
       if (gauge_dir != 3) {
         logQuda(QUDA_SUMMARIZE, "Starting Landau gauge fixing with FFTs...\n");
-        gaugeFixingFFT<Float, recon, 4>(data, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+        if (comm_partitioned())
+          gaugeFixingFFTDistributed<Float, recon, 4>(data, Nsteps, verbose_interval, alpha, autotune, tolerance,
+                                                     stopWtheta);
+        else
+          gaugeFixingFFT<Float, recon, 4>(data, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
       } else {
         logQuda(QUDA_SUMMARIZE, "Starting Coulomb gauge fixing with FFTs...\n");
-        gaugeFixingFFT<Float, recon, 3>(data, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+        if (comm_partitioned())
+          gaugeFixingFFTDistributed<Float, recon, 3>(data, Nsteps, verbose_interval, alpha, autotune, tolerance,
+                                                     stopWtheta);
+        else
+          gaugeFixingFFT<Float, recon, 3>(data, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
       }
     }
   };
 
   /**
-   * @brief Gauge fixing with Steepest descent method with FFTs with support for single GPU only.
+   * @brief Gauge fixing with Steepest descent method with FFTs.  On a
+   * partitioned lattice the field must be extended in the
+   * partitioned dimensions, and the FFTs are distributed.
    * @param[in,out] data, quda gauge field
    * @param[in] gauge_dir, 3 for Coulomb gauge fixing, other for Landau gauge fixing
    * @param[in] Nsteps, maximum number of steps to perform gauge fixing
@@ -390,7 +552,6 @@ namespace quda {
                       const int autotune, const double tolerance, const int stopWtheta)
   {
     getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
-    if (comm_partitioned()) errorQuda("Gauge Fixing with FFTs in multi-GPU support NOT implemented yet!");
     instantiate<GaugeFixingFFT>(data, gauge_dir, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
     getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
   }
@@ -13,6 +13,7 @@ namespace quda {
     GaugeField &U;
     RNG &rng;
     QudaNoiseType type;
+    CounterRNG counter;
     unsigned int minThreads() const { return U.VolumeCB(); }
 
   public:
@@ -20,9 +21,11 @@ namespace quda {
       TunableKernel2D(U, 2),
       U(U),
       rng(rng),
-      type(type)
+      type(type),
+      counter(rng.Counter())
     {
       strcat(aux, type == QUDA_NOISE_GAUSS ? ",gauss" : ",uniform");
+      if (counter.enabled) strcat(aux, ",philox");
       if (type == QUDA_NOISE_GAUSS) {
         logQuda(QUDA_SUMMARIZE, "Creating Gaussian distributed field\n");
       } else {
@@ -35,9 +38,9 @@ namespace quda {
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (type == QUDA_NOISE_UNIFORM)
-        launch<NoiseGauge>(tp, stream, GaugeNoiseArg<real, nColor, QUDA_NOISE_UNIFORM>(U, rng.State()));
+        launch<NoiseGauge>(tp, stream, GaugeNoiseArg<real, nColor, QUDA_NOISE_UNIFORM>(U, rng.State(), counter));
       else
-        launch<NoiseGauge>(tp, stream, GaugeNoiseArg<real, nColor, QUDA_NOISE_GAUSS>(U, rng.State()));
+        launch<NoiseGauge>(tp, stream, GaugeNoiseArg<real, nColor, QUDA_NOISE_GAUSS>(U, rng.State(), counter));
         
     }
 
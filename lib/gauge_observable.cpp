@@ -18,7 +18,10 @@ namespace quda
       pool_pinned_free(num_failures_h);
     }
 
-    if (param.compute_plaquette) {
+    // the plaquette is computed alongside the charge and energy when these are requested
+    const bool fused = param.compute_qcharge || param.compute_qcharge_density;
+
+    if (param.compute_plaquette && !fused) {
       double3 plaq = plaquette(u);
       param.plaquette[0] = plaq.x;
       param.plaquette[1] = plaq.y;
@@ -50,42 +53,29 @@ namespace quda
       for (int i = 0; i < param.num_paths; i++) { memcpy(param.traces + i, &loop_traces[i], sizeof(Complex)); }
     }
 
-    // no point constructing Fmunu unless we are going to use it
-    if (!param.compute_qcharge && !param.compute_qcharge_density) return;
-
-    // create the Fmunu field
-    // u is an extended field we need to shrink for the Fmunu field
-    lat_dim_t x;
-    for (int i = 0; i < 4; i++) x[i] = u.X()[i] - 2 * u.R()[i];
-    GaugeFieldParam tensorParam(x, u.Precision(), QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
-    tensorParam.location = QUDA_CUDA_FIELD_LOCATION;
-    tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
-    tensorParam.order = QUDA_FLOAT2_GAUGE_ORDER;
-    tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
-    GaugeField gaugeFmunu(tensorParam);
-
-    computeFmunu(gaugeFmunu, u);
-
-    if (param.compute_qcharge || param.compute_qcharge_density) {
-      profile.TPSTART(QUDA_PROFILE_INIT);
-      if (param.compute_qcharge_density && !param.qcharge_density)
-        errorQuda("Charge density requested, but destination field not defined");
-      size_t size = gaugeFmunu.Volume() * gaugeFmunu.Precision();
-      void *d_qDensity = param.compute_qcharge_density ? pool_device_malloc(size) : nullptr;
-      profile.TPSTOP(QUDA_PROFILE_INIT);
-
-      if (param.compute_qcharge_density)
-        computeQChargeDensity(param.energy, param.qcharge, d_qDensity, gaugeFmunu);
-      else
-        computeQCharge(param.energy, param.qcharge, gaugeFmunu);
-
-      if (param.compute_qcharge_density) {
-        profile.TPSTART(QUDA_PROFILE_D2H);
-        qudaMemcpy(param.qcharge_density, d_qDensity, size, qudaMemcpyDeviceToHost);
-        profile.TPSTOP(QUDA_PROFILE_D2H);
-
-        pool_device_free(d_qDensity);
-      }
+    if (!fused) return;
+
+    profile.TPSTART(QUDA_PROFILE_INIT);
+    if (param.compute_qcharge_density && !param.qcharge_density)
+      errorQuda("Charge density requested, but destination field not defined");
+    size_t size = u.LocalVolume() * u.Precision();
+    void *qDensity = nullptr;
+    if (param.compute_qcharge_density)
+      qDensity = u.Location() == QUDA_CUDA_FIELD_LOCATION ? pool_device_malloc(size) : param.qcharge_density;
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+
+    double plaq[3];
+    computeFusedGaugeObservables(u, plaq, param.energy, param.qcharge, qDensity);
+
+    if (param.compute_plaquette)
+      for (int i = 0; i < 3; i++) param.plaquette[i] = plaq[i];
+
+    if (param.compute_qcharge_density && u.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      profile.TPSTART(QUDA_PROFILE_D2H);
+      qudaMemcpy(param.qcharge_density, qDensity, size, qudaMemcpyDeviceToHost);
+      profile.TPSTOP(QUDA_PROFILE_D2H);
+
+      pool_device_free(qDensity);
     }
   }
 
@@ -0,0 +1,103 @@
+#include <gauge_field.h>
+#include <instantiate.h>
+#include <tunable_reduction.h>
+#include <kernels/gauge_observable_fused.cuh>
+
+namespace quda
+{
+
+  template <typename Float, int nColor, QudaReconstructType recon> class FusedGaugeObservables : TunableReduction2D
+  {
+    const GaugeField &u;
+    double *plaq;
+    double *energy;
+    double &qcharge;
+    void *qdensity;
+    bool density;
+
+  public:
+    FusedGaugeObservables(const GaugeField &u, double plaq[3], double energy[3], double &qcharge, void *qdensity) :
+      TunableReduction2D(u),
+      u(u),
+      plaq(plaq),
+      energy(energy),
+      qcharge(qcharge),
+      qdensity(qdensity),
+      density(qdensity != nullptr)
+    {
+      if (u.Location() == QUDA_CUDA_FIELD_LOCATION && !u.isNative())
+        errorQuda("Device gauge observables only supported on native ordered fields");
+      if (u.Location() == QUDA_CPU_FIELD_LOCATION && u.Order() != QUDA_QDP_GAUGE_ORDER)
+        errorQuda("Host gauge observables only supported on QDP ordered fields");
+      strcat(aux, comm_dim_partitioned_string());
+      if (density) strcat(aux, ",density");
+      apply(device::get_default_stream());
+    }
+
+    template <bool density, bool host = false> using Arg = FusedObservablesArg<Float, nColor, recon, density, host>;
+
+    template <bool host> void launch_(typename Arg<false>::reduce_t &result, const TuneParam &tp, const qudaStream_t &stream)
+    {
+      if (density) {
+        Arg<true, host> arg(u, static_cast<Float *>(qdensity));
+        if constexpr (host) launch_host<FusedObservables>(result, tp, stream, arg);
+        else launch<FusedObservables>(result, tp, stream, arg);
+      } else {
+        Arg<false, host> arg(u);
+        if constexpr (host) launch_host<FusedObservables>(result, tp, stream, arg);
+        else launch<FusedObservables>(result, tp, stream, arg);
+      }
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+
+      typename Arg<false>::reduce_t result {};
+      if (u.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        launch_<false>(result, tp, stream);
+      } else if constexpr (recon == QUDA_RECONSTRUCT_NO
+                           && (std::is_same_v<Float, double> || std::is_same_v<Float, float>)) {
+        launch_<true>(result, tp, stream);
+      } else {
+        errorQuda("Host gauge observables not supported for precision %d and reconstruct %d", u.Precision(), recon);
+      }
+
+      const double volume = static_cast<double>(u.LocalVolume()) * comm_size();
+      double plq[2];
+      for (int i = 0; i < 2; i++) plq[i] = result[i] / (9. * volume);
+      plaq[0] = 0.5 * (plq[0] + plq[1]);
+      plaq[1] = plq[0];
+      plaq[2] = plq[1];
+
+      for (int i = 0; i < 2; i++) energy[i + 1] = result[i + 2] / volume;
+      energy[0] = energy[1] + energy[2];
+      qcharge = result[4];
+    }
+
+    long long flops() const
+    {
+      auto Nc = u.Ncolor();
+      auto mm_flops = 8 * Nc * Nc * (Nc - 2);
+      auto traceless_flops = (Nc * Nc + Nc + 1);
+      auto clover_flops = 6 * (2430 + 36 + 2 * Nc);
+      auto energy_flops = 6 * (mm_flops + traceless_flops + Nc);
+      auto q_flops = 3 * mm_flops + 2 * Nc + 2;
+      return u.LocalVolume() * (clover_flops + energy_flops + q_flops);
+    }
+
+    long long bytes() const
+    {
+      return 16 * 6 * u.LocalVolume() * u.Reconstruct() * u.Precision() + u.LocalVolume() * (density * u.Precision());
+    }
+  };
+
+  void computeFusedGaugeObservables(const GaugeField &u, double plaq[3], double energy[3], double &qcharge,
+                                    void *qdensity)
+  {
+    getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+    instantiate<FusedGaugeObservables, ReconstructWilson>(u, plaq, energy, qcharge, qdensity);
+    getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+  }
+
+} // namespace quda
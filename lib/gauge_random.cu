@@ -15,6 +15,7 @@ namespace quda {
     RNG &rng;
     Float sigma;
     bool group;
+    CounterRNG counter;
     unsigned int minThreads() const { return U.VolumeCB(); }
 
   public:
@@ -23,7 +24,8 @@ namespace quda {
       U(U),
       rng(rng),
       sigma(static_cast<Float>(sigma)),
-      group(U.LinkType() == QUDA_SU3_LINKS)
+      group(U.LinkType() == QUDA_SU3_LINKS),
+      counter(rng.Counter())
     {
       if (group) {
         logQuda(QUDA_SUMMARIZE, "Creating Gaussian distributed Lie group field with sigma = %e\n", sigma);
@@ -31,6 +33,7 @@ namespace quda {
         logQuda(QUDA_SUMMARIZE, "Creating Gaussian distributed Lie algebra field\n");
       }
       strcat(aux, group ? ",lie_group" : "lie_algebra");
+      if (counter.enabled) strcat(aux, ",philox");
       apply(device::get_default_stream());
     }
 
@@ -38,9 +41,9 @@ namespace quda {
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (group) {
-        launch<GaussGauge>(tp, stream, GaugeGaussArg<Float, nColor, recon, true>(U, rng.State(), sigma));
+        launch<GaussGauge>(tp, stream, GaugeGaussArg<Float, nColor, recon, true>(U, rng.State(), counter, sigma));
       } else {
-        launch<GaussGauge>(tp, stream, GaugeGaussArg<Float, nColor, recon, false>(U, rng.State(), sigma));
+        launch<GaussGauge>(tp, stream, GaugeGaussArg<Float, nColor, recon, false>(U, rng.State(), counter, sigma));
       }
     }
 
@@ -1,6 +1,7 @@
 #include <quda_internal.h>
 #include <gauge_field.h>
 #include <tunable_nd.h>
+#include <tunable_reduction.h>
 #include <kernels/gauge_wilson_flow.cuh>
 #include <instantiate.h>
 
@@ -13,6 +14,7 @@ namespace quda {
     GaugeField &out;
     GaugeField &temp;
     const GaugeField &in;
+    GaugeField *emb;
     const real epsilon;
     const QudaGaugeSmearType wflow_type;
     const WFlowStepType step_type;
@@ -29,11 +31,13 @@ namespace quda {
     }
 
   public:
-    GaugeWFlowStep(GaugeField &out, GaugeField &temp, const GaugeField &in, const double epsilon, const QudaGaugeSmearType wflow_type, const WFlowStepType step_type) :
+    GaugeWFlowStep(GaugeField &out, GaugeField &temp, const GaugeField &in, const double epsilon,
+                   const QudaGaugeSmearType wflow_type, const WFlowStepType step_type, GaugeField *emb = nullptr) :
       TunableKernel3D(in, 2, wflow_dim),
       out(out),
       temp(temp),
       in(in),
+      emb(emb),
       epsilon(epsilon),
       wflow_type(wflow_type),
       step_type(step_type)
@@ -48,6 +52,7 @@ namespace quda {
       switch (step_type) {
       case WFLOW_STEP_W1: strcat(aux, "_W1"); break;
       case WFLOW_STEP_W2: strcat(aux, "_W2"); break;
+      case WFLOW_STEP_W2_EMBEDDED: strcat(aux, "_W2E"); break;
       case WFLOW_STEP_VT: strcat(aux, "_VT"); break;
       default : errorQuda("Unknown Wilson Flow step type %d", step_type);
       }
@@ -72,6 +77,9 @@ namespace quda {
         case WFLOW_STEP_W2:
           launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_W2>(out, temp, in, epsilon));
           break;
+        case WFLOW_STEP_W2_EMBEDDED:
+          launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_W2_EMBEDDED>(out, temp, in, epsilon, emb));
+          break;
         case WFLOW_STEP_VT:
           launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_VT>(out, temp, in, epsilon));
           break;
@@ -86,6 +94,9 @@ namespace quda {
         case WFLOW_STEP_W2:
           launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_W2>(out, temp, in, epsilon));
           break;
+        case WFLOW_STEP_W2_EMBEDDED:
+          launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_W2_EMBEDDED>(out, temp, in, epsilon, emb));
+          break;
         case WFLOW_STEP_VT:
           launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_VT>(out, temp, in, epsilon));
           break;
@@ -95,8 +106,18 @@ namespace quda {
       }
     }
 
-    void preTune() { out.backup(); temp.backup(); }
-    void postTune() { out.restore(); temp.restore(); }
+    void preTune()
+    {
+      out.backup();
+      temp.backup();
+      if (emb) emb->backup();
+    }
+    void postTune()
+    {
+      out.restore();
+      temp.restore();
+      if (emb) emb->restore();
+    }
 
     long long flops() const
     {
@@ -120,11 +141,38 @@ namespace quda {
       case QUDA_GAUGE_SMEAR_SYMANZIK_FLOW: links = 24; break;
       default : errorQuda("Unknown Wilson Flow type");
       }
-      auto temp_io = step_type == WFLOW_STEP_W2 ? 2 : step_type == WFLOW_STEP_VT ? 1 : 0;
-      return ((1 + (wflow_dim - 1) * links) * in.Bytes() + out.Bytes() + temp_io * temp.Bytes());
+      auto temp_io = (step_type == WFLOW_STEP_W2 || step_type == WFLOW_STEP_W2_EMBEDDED) ? 2 :
+        step_type == WFLOW_STEP_VT                                                   ? 1 :
+                                                                                       0;
+      auto emb_bytes = (step_type == WFLOW_STEP_W2_EMBEDDED && emb) ? emb->Bytes() : 0;
+      return ((1 + (wflow_dim - 1) * links) * in.Bytes() + out.Bytes() + temp_io * temp.Bytes() + emb_bytes);
     }
   }; // GaugeWFlowStep
 
+  template <typename Float, int nColor, QudaReconstructType recon> class WFlowDistance : TunableReduction2D
+  {
+    const GaugeField &u;
+    const GaugeField &v;
+    double &distance;
+
+  public:
+    WFlowDistance(const GaugeField &u, const GaugeField &v, double &distance) :
+      TunableReduction2D(u), u(u), v(v), distance(distance)
+    {
+      apply(device::get_default_stream());
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      LinkDistanceArg<Float, nColor, recon> arg(u, v);
+      launch<LinkDistance>(distance, tp, stream, arg);
+    }
+
+    long long flops() const { return 4ll * u.LocalVolume() * (2 * nColor * nColor + 4 * nColor * nColor); }
+    long long bytes() const { return u.Bytes() + v.Bytes(); }
+  }; // WFlowDistance
+
   void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, const double epsilon, const QudaGaugeSmearType smear_type)
   {
     checkPrecision(out, temp, in);
@@ -148,4 +196,33 @@ namespace quda {
     out.exchangeExtendedGhost(out.R(), false);
   }
 
+  double WFlowStepEmbedded(GaugeField &out, GaugeField &temp, GaugeField &in, GaugeField &emb, const double epsilon,
+                           const QudaGaugeSmearType smear_type)
+  {
+    checkPrecision(out, temp, in, emb);
+    checkReconstruct(out, in, emb);
+    checkNative(out, in, emb);
+    if (temp.Reconstruct() != QUDA_RECONSTRUCT_NO) errorQuda("Temporary vector must not use reconstruct");
+    if (!(smear_type == QUDA_GAUGE_SMEAR_WILSON_FLOW || smear_type == QUDA_GAUGE_SMEAR_SYMANZIK_FLOW))
+      errorQuda("Gauge smear type %d not supported for flow kernels", smear_type);
+
+    // Step W1
+    instantiate<GaugeWFlowStep>(out, temp, in, epsilon, smear_type, WFLOW_STEP_W1);
+    out.exchangeExtendedGhost(out.R(), false);
+
+    // Step W2, also writing the embedded second-order solution
+    instantiate<GaugeWFlowStep>(in, temp, out, epsilon, smear_type, WFLOW_STEP_W2_EMBEDDED, &emb);
+    in.exchangeExtendedGhost(in.R(), false);
+
+    // Step Vt
+    instantiate<GaugeWFlowStep>(out, temp, in, epsilon, smear_type, WFLOW_STEP_VT);
+    out.exchangeExtendedGhost(out.R(), false);
+
+    getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+    double distance = 0.0;
+    instantiate<WFlowDistance>(out, emb, distance);
+    getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+    return distance;
+  }
+
 }
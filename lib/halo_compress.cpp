@@ -0,0 +1,423 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include <quda_internal.h>
+#include <timer.h>
+#include <halo_compress.h>
+
+namespace quda
+{
+
+  namespace halo_compress
+  {
+
+    enum Format : uint32_t { RAW, PACKED };
+
+    /**
+       Header preceding every encoded face
+     */
+    struct Header {
+      uint32_t format;    /** RAW or PACKED */
+      uint32_t word;      /** Word size of the byte shuffle */
+      uint64_t raw_bytes; /** Size of the decoded face */
+      uint64_t size;      /** Size of the payload following the header */
+      uint64_t pad;
+    };
+
+    constexpr int max_word = 16;
+
+    /**
+       The dictionary coding of one byte plane.  Each plane starts with
+       its bits per byte, with 8 meaning the plane is stored verbatim,
+       else followed by the dictionary size and the dictionary, and
+       then the bit-packed dictionary indices.
+     */
+    struct PlaneCode {
+      int bits = 8;       /** Bits per byte */
+      int count = 0;      /** Number of distinct byte values */
+      uint8_t dict[256];  /** The distinct byte values */
+      uint8_t index[256]; /** The dictionary index of each byte value */
+      size_t bytes(size_t n) const { return bits == 8 ? 1 + n : 2 + count + (n * bits + 7) / 8; }
+    };
+
+    static void analyze(PlaneCode &code, const uint8_t *src, size_t n, int word)
+    {
+      bool present[256] = {};
+      for (size_t i = 0; i < n; i++) present[src[i * word]] = true;
+
+      code.count = 0;
+      for (int v = 0; v < 256; v++) {
+        if (!present[v]) continue;
+        code.index[v] = code.count;
+        code.dict[code.count++] = v;
+      }
+      code.bits = 0;
+      while ((1 << code.bits) < code.count) code.bits++;
+      if (code.bits == 8 || code.bytes(n) >= 1 + n) code.bits = 8;
+    }
+
+    static uint8_t *pack_plane(uint8_t *out, const PlaneCode &code, const uint8_t *src, size_t n, int word)
+    {
+      *out++ = code.bits;
+      if (code.bits == 8) {
+        for (size_t i = 0; i < n; i++) *out++ = src[i * word];
+        return out;
+      }
+
+      *out++ = code.count - 1;
+      memcpy(out, code.dict, code.count);
+      out += code.count;
+      if (code.bits == 0) return out;
+
+      uint64_t acc = 0;
+      int nacc = 0;
+      for (size_t i = 0; i < n; i++) {
+        acc |= uint64_t(code.index[src[i * word]]) << nacc;
+        nacc += code.bits;
+        while (nacc >= 8) {
+          *out++ = acc & 0xff;
+          acc >>= 8;
+          nacc -= 8;
+        }
+      }
+      if (nacc > 0) *out++ = acc & 0xff;
+      return out;
+    }
+
+    static const uint8_t *unpack_plane(uint8_t *dst, const uint8_t *in, size_t n, int word)
+    {
+      const int bits = *in++;
+      if (bits == 8) {
+        for (size_t i = 0; i < n; i++) dst[i * word] = *in++;
+        return in;
+      }
+
+      const int count = *in++ + 1;
+      const uint8_t *dict = in;
+      in += count;
+
+      if (bits == 0) {
+        for (size_t i = 0; i < n; i++) dst[i * word] = dict[0];
+        return in;
+      }
+
+      const uint64_t mask = (uint64_t(1) << bits) - 1;
+      uint64_t acc = 0;
+      int nacc = 0;
+      for (size_t i = 0; i < n; i++) {
+        while (nacc < bits) {
+          acc |= uint64_t(*in++) << nacc;
+          nacc += 8;
+        }
+        dst[i * word] = dict[acc & mask];
+        acc >>= bits;
+        nacc -= bits;
+      }
+      return in;
+    }
+
+    size_t max_bytes(size_t bytes) { return sizeof(Header) + bytes; }
+
+    size_t encode(void *dst_, const void *src_, size_t bytes, int word, bool compress)
+    {
+      auto dst = static_cast<uint8_t *>(dst_);
+      auto src = static_cast<const uint8_t *>(src_);
+      if (word < 1 || word > max_word) errorQuda("Invalid word size %d", word);
+
+      Header header = {RAW, static_cast<uint32_t>(word), bytes, bytes, 0};
+
+      if (compress) {
+        const size_t n = bytes / word;
+        PlaneCode code[max_word];
+        size_t size = bytes - n * word; // trailing bytes are stored verbatim
+        for (int p = 0; p < word; p++) {
+          analyze(code[p], src + p, n, word);
+          size += code[p].bytes(n);
+        }
+
+        if (size < bytes) {
+          uint8_t *out = dst + sizeof(Header);
+          for (int p = 0; p < word; p++) out = pack_plane(out, code[p], src + p, n, word);
+          memcpy(out, src + n * word, bytes - n * word);
+          header.format = PACKED;
+          header.size = size;
+        }
+      }
+
+      if (header.format == RAW) memcpy(dst + sizeof(Header), src, bytes);
+      memcpy(dst, &header, sizeof(Header));
+      return sizeof(Header) + header.size;
+    }
+
+    void decode(void *dst_, const void *src_, size_t bytes)
+    {
+      auto dst = static_cast<uint8_t *>(dst_);
+      auto src = static_cast<const uint8_t *>(src_);
+
+      Header header;
+      memcpy(&header, src, sizeof(Header));
+      if (header.raw_bytes != bytes)
+        errorQuda("Encoded size %lu does not match expected size %lu", header.raw_bytes, bytes);
+      const uint8_t *in = src + sizeof(Header);
+
+      if (header.format == RAW) {
+        memcpy(dst, in, bytes);
+      } else if (header.format == PACKED) {
+        const int word = header.word;
+        const size_t n = bytes / word;
+        for (int p = 0; p < word; p++) in = unpack_plane(dst + p, in, n, word);
+        memcpy(dst + n * word, in, bytes - n * word);
+      } else {
+        errorQuda("Unknown halo encoding %u", header.format);
+      }
+    }
+
+    /**
+       Running model of the cost and benefit of compressing the faces
+       sent in a given dimension and direction
+     */
+    struct Model {
+      double ratio = 1.0;   /** Running compression ratio (encoded / raw) */
+      double rate = 0.0;    /** Running encode throughput (bytes / s), zero if not yet measured */
+      unsigned int count = 0;
+    };
+
+    /** Faces that are not compressed are probed every this many messages */
+    constexpr unsigned int probe_interval = 64;
+
+    /**
+       Running least-squares fit of the time a send takes from start to
+       observed completion, t = latency + bytes / bandwidth, over the
+       sends of all faces, with exponentially decaying weights so that
+       the fit follows changes in load.  Compressed and uncompressed
+       sends, and faces of different dimensions, supply the spread in
+       message size that separates the bandwidth from the latency.
+     */
+    struct LinkModel {
+      static constexpr double decay = 0.99;
+      double w = 0.0, x = 0.0, y = 0.0, xx = 0.0, xy = 0.0;
+
+      void add(double bytes, double t)
+      {
+        w = decay * w + 1.0;
+        x = decay * x + bytes;
+        y = decay * y + t;
+        xx = decay * xx + bytes * bytes;
+        xy = decay * xy + bytes * t;
+      }
+
+      /**
+         @return The fitted bandwidth in bytes / s, zero if there are
+         too few samples, or infinite if the time does not grow with
+         the message size
+       */
+      double bandwidth() const
+      {
+        if (w < 2.0) return 0.0;
+        const double var = w * xx - x * x;
+        // all messages of (nearly) the same size: attribute all of the time to bandwidth
+        if (var <= 1e-6 * w * xx) return y > 0.0 ? x / y : 0.0;
+        const double slope = (w * xy - x * y) / var;
+        return slope > 0.0 ? 1.0 / slope : std::numeric_limits<double>::infinity();
+      }
+    };
+
+    /**
+       Encoded messages are padded to a multiple of 1/n_bucket of the
+       send buffer, so that each face needs at most n_bucket + 1
+       persistent send handles
+     */
+    constexpr unsigned int n_bucket = 64;
+
+    /**
+       Staging buffers and message handles of the compressed exchange
+     */
+    struct Channel {
+      void *send = nullptr;
+      void *recv = nullptr;
+      size_t send_capacity = 0;
+      size_t recv_capacity = 0;
+      size_t recv_bytes = 0; // decoded size of the face being received
+      MsgHandle *mh_send_bucket[n_bucket + 1] = {}; // persistent send handles, one per message size bucket
+      MsgHandle *mh_send = nullptr;                 // the send in flight, if any
+      MsgHandle *mh_recv = nullptr;
+      bool recv_done = false;
+      size_t send_bytes = 0; // wire size of the send in flight
+      host_timer_t send_timer;
+
+      size_t bucket_bytes() const { return (send_capacity + n_bucket - 1) / n_bucket; }
+
+      void free_send()
+      {
+        for (auto &mh : mh_send_bucket)
+          if (mh) comm_free(mh);
+        if (send) host_free(send);
+        send = nullptr;
+        send_capacity = 0;
+      }
+    };
+
+    static Channel channel[2][QUDA_MAX_DIM][2];
+    static Model model[QUDA_MAX_DIM][2];
+    static LinkModel link;
+
+    static int compress_enabled = -1;
+    static double bandwidth = 0.0;                 // fixed bandwidth, if set by the user
+    constexpr double default_bandwidth = 12.5e9;   // assumed until the link has been measured
+
+    bool enabled()
+    {
+      if (compress_enabled < 0) {
+        compress_enabled = 0;
+        char *enable_compress = getenv("QUDA_ENABLE_HALO_COMPRESSION");
+        if (enable_compress && strcmp(enable_compress, "1") == 0) {
+          compress_enabled = 1;
+          char *bandwidth_str = getenv("QUDA_HALO_COMPRESSION_BANDWIDTH");
+          if (bandwidth_str) {
+            bandwidth = atof(bandwidth_str) * 1e9;
+            if (bandwidth <= 0.0) errorQuda("Invalid QUDA_HALO_COMPRESSION_BANDWIDTH=%s", bandwidth_str);
+            logQuda(QUDA_SUMMARIZE, "Using halo compression with network bandwidth %g GB/s\n", bandwidth / 1e9);
+          } else {
+            logQuda(QUDA_SUMMARIZE, "Using halo compression with measured network bandwidth\n");
+          }
+        }
+      }
+      return compress_enabled;
+    }
+
+    /**
+       @brief Decide whether to compress a face: compressing pays off if
+       the bytes saved take longer to send than the encode and decode,
+       which we assume to run at the same rate.  The link bandwidth is
+       the user's if given, else the measured one.
+     */
+    static bool select(Model &m, size_t bytes)
+    {
+      if (m.rate == 0.0 || m.count++ % probe_interval == 0) return true;
+      double link_bandwidth = bandwidth > 0.0 ? bandwidth : link.bandwidth();
+      if (link_bandwidth == 0.0) link_bandwidth = default_bandwidth;
+      const double saving = (1.0 - m.ratio) * bytes / link_bandwidth;
+      const double cost = 2.0 * bytes / m.rate;
+      return saving > cost;
+    }
+
+    void recv_start(int b, int dim, int dir, size_t bytes)
+    {
+      auto &c = channel[b][dim][dir];
+      if (max_bytes(bytes) > c.recv_capacity) {
+        if (c.mh_recv) comm_free(c.mh_recv);
+        if (c.recv) host_free(c.recv);
+        c.recv_capacity = max_bytes(bytes);
+        c.recv = pinned_malloc(c.recv_capacity);
+      }
+      // the receive is posted for the largest encoding, and a shorter
+      // message is received into the front of the buffer
+      if (!c.mh_recv) c.mh_recv = comm_declare_receive_relative(c.recv, dim, dir == 0 ? -1 : +1, c.recv_capacity);
+      c.recv_bytes = bytes;
+      c.recv_done = false;
+      comm_start(c.mh_recv);
+    }
+
+    void send_start(int b, int dim, int dir, const void *src, size_t bytes, int word)
+    {
+      auto &c = channel[b][dim][dir];
+      if (c.mh_send) errorQuda("Compressed send %d %d %d still in flight", b, dim, dir);
+      if (max_bytes(bytes) > c.send_capacity) {
+        c.free_send();
+        c.send_capacity = max_bytes(bytes);
+        c.send = pinned_malloc(c.send_capacity);
+        memset(c.send, 0, c.send_capacity); // the padding is sent as well
+      }
+
+      auto &m = model[dim][dir];
+      const bool compress = select(m, bytes);
+
+      host_timer_t timer;
+      timer.start();
+      size_t size = encode(c.send, src, bytes, word, compress);
+      timer.stop();
+
+      if (compress) {
+        // exponentially weighted running estimates
+        const double ratio = static_cast<double>(size - sizeof(Header)) / bytes;
+        const double rate = timer.last_interval > 0.0 ? bytes / timer.last_interval : 1e12;
+        m.ratio = m.rate == 0.0 ? ratio : 0.75 * m.ratio + 0.25 * ratio;
+        m.rate = m.rate == 0.0 ? rate : 0.75 * m.rate + 0.25 * rate;
+      }
+
+      // reuse the persistent handle of this message size, declaring it on first use
+      const size_t bucket = (size + c.bucket_bytes() - 1) / c.bucket_bytes();
+      auto &mh = c.mh_send_bucket[bucket];
+      if (!mh)
+        mh = comm_declare_send_relative(c.send, dim, dir == 0 ? -1 : +1,
+                                        std::min(bucket * c.bucket_bytes(), c.send_capacity));
+      c.mh_send = mh;
+      c.send_bytes = std::min(bucket * c.bucket_bytes(), c.send_capacity);
+      c.send_timer.start();
+      comm_start(c.mh_send);
+    }
+
+    int send_query(int b, int dim, int dir)
+    {
+      auto &c = channel[b][dim][dir];
+      if (!c.mh_send) return 1;
+      if (!comm_query(c.mh_send)) return 0;
+      // completion is observed while polling, so the elapsed time is a
+      // fair measure of the time on the wire
+      c.send_timer.stop();
+      link.add(c.send_bytes, c.send_timer.last());
+      c.mh_send = nullptr;
+      return 1;
+    }
+
+    void send_wait(int b, int dim, int dir)
+    {
+      auto &c = channel[b][dim][dir];
+      if (!c.mh_send) return;
+      comm_wait(c.mh_send);
+      // a wait may be entered long after the send completed, so it
+      // does not give a measurement of the link
+      c.send_timer.stop();
+      c.mh_send = nullptr;
+    }
+
+    int recv_query(int b, int dim, int dir, void *dst)
+    {
+      auto &c = channel[b][dim][dir];
+      if (c.recv_done) return 1;
+      if (!comm_query(c.mh_recv)) return 0;
+      decode(dst, c.recv, c.recv_bytes);
+      c.recv_done = true;
+      return 1;
+    }
+
+    void recv_wait(int b, int dim, int dir, void *dst)
+    {
+      auto &c = channel[b][dim][dir];
+      if (c.recv_done) return;
+      comm_wait(c.mh_recv);
+      decode(dst, c.recv, c.recv_bytes);
+      c.recv_done = true;
+    }
+
+    void destroy()
+    {
+      for (auto &cb : channel) {
+        for (auto &cd : cb) {
+          for (auto &c : cd) {
+            if (c.mh_send) comm_wait(c.mh_send);
+            c.free_send();
+            if (c.mh_recv) comm_free(c.mh_recv);
+            if (c.recv) host_free(c.recv);
+            c = Channel();
+          }
+        }
+      }
+    }
+
+  } // namespace halo_compress
+
+} // namespace quda
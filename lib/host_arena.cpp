@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <quda_internal.h>
+#include <host_arena.h>
+
+namespace quda
+{
+
+  namespace host_arena
+  {
+
+    constexpr int min_log2 = 6;  // smallest class is 64 bytes, which sets the minimum alignment
+    constexpr int max_log2 = 36; // largest class is 64 GiB
+    constexpr int n_class = max_log2 - min_log2 + 1;
+    constexpr int max_node = 16;
+    constexpr size_t min_span = 16ul << 30; // minimum address space per class per node
+
+    // free-list heads are tagged offsets: the lower 48 bits hold the
+    // offset of the first block from the arena base, the upper 16 bits
+    // a counter that is incremented on every update to avoid ABA
+    constexpr int offset_bits = 48;
+    constexpr uint64_t offset_mask = (uint64_t(1) << offset_bits) - 1;
+    constexpr uint64_t empty = offset_mask;
+
+    constexpr size_t class_size(int k) { return size_t(1) << (k + min_log2); }
+    constexpr size_t class_span(int k) { return std::max(min_span, 4 * class_size(k)); }
+
+    /**
+       Per NUMA node and size class state
+     */
+    struct Pool {
+      std::atomic<uint64_t> head {empty}; /** Tagged offset of the first free block */
+      std::atomic<size_t> top {0};        /** Number of bytes carved from the class region */
+    };
+
+    struct Arena {
+      char *base = nullptr;
+      size_t reserved = 0;
+      int n_node = 1;
+      size_t node_span = 0;
+      size_t class_offset[n_class + 1] = {};
+      Pool pool[max_node][n_class];
+      std::atomic<size_t> bytes {0};
+      std::atomic<size_t> peak {0};
+
+      Arena()
+      {
+        char *enable_arena = getenv("QUDA_ENABLE_HOST_ARENA");
+        if (!enable_arena || strcmp(enable_arena, "1") != 0) return;
+
+        // number of NUMA nodes from sysfs, e.g., "0-3"
+        std::ifstream possible("/sys/devices/system/node/possible");
+        std::string nodes;
+        if (possible >> nodes) {
+          auto dash = nodes.find_last_of("-,");
+          n_node = std::stoi(dash == std::string::npos ? nodes : nodes.substr(dash + 1)) + 1;
+        }
+        n_node = std::min(std::max(n_node, 1), max_node);
+
+        for (int k = 0; k < n_class; k++) class_offset[k + 1] = class_offset[k] + class_span(k);
+        node_span = class_offset[n_class];
+        reserved = n_node * node_span;
+        if (reserved > offset_mask) errorQuda("Host arena size %lu exceeds addressable offset", reserved);
+
+        // reserve the address space, over-allocating to align the base to a huge page
+        void *ptr = mmap(nullptr, reserved + huge_page_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (ptr == MAP_FAILED) {
+          warningQuda("Failed to reserve %lu bytes of address space for the host arena, disabling", reserved);
+          return;
+        }
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(ptr) + huge_page_size - 1) & ~(huge_page_size - 1);
+        base = reinterpret_cast<char *>(aligned);
+        advise_huge_pages(base, reserved);
+
+        warningQuda("Using host arena allocator with %d NUMA node%s", n_node, n_node > 1 ? "s" : "");
+      }
+
+      /**
+         @return The NUMA node of the calling thread
+       */
+      int node() const
+      {
+        if (n_node == 1) return 0;
+        unsigned int cpu, node;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return 0;
+        return node % n_node;
+      }
+
+      char *block(int node, int k, size_t offset) const { return base + node * node_span + class_offset[k] + offset; }
+
+      /**
+         @brief Find the NUMA node and size class of a block from its address
+       */
+      void locate(const void *ptr, int &node, int &k) const
+      {
+        size_t offset = static_cast<const char *>(ptr) - base;
+        node = offset / node_span;
+        offset -= node * node_span;
+        k = std::upper_bound(class_offset, class_offset + n_class + 1, offset) - class_offset - 1;
+      }
+
+      void push(Pool &p, char *ptr)
+      {
+        const uint64_t offset = ptr - base;
+        auto next = reinterpret_cast<std::atomic<uint64_t> *>(ptr);
+        uint64_t old = p.head.load(std::memory_order_relaxed);
+        uint64_t update;
+        do {
+          next->store(old & offset_mask, std::memory_order_relaxed);
+          update = (((old >> offset_bits) + 1) << offset_bits) | offset;
+        } while (!p.head.compare_exchange_weak(old, update, std::memory_order_release, std::memory_order_relaxed));
+      }
+
+      char *pop(Pool &p)
+      {
+        uint64_t old = p.head.load(std::memory_order_acquire);
+        while ((old & offset_mask) != empty) {
+          // the block may be concurrently popped and reused, but the
+          // memory is never unmapped, and the tag ensures the
+          // exchange then fails
+          char *ptr = base + (old & offset_mask);
+          uint64_t next = reinterpret_cast<std::atomic<uint64_t> *>(ptr)->load(std::memory_order_relaxed);
+          uint64_t update = (((old >> offset_bits) + 1) << offset_bits) | next;
+          if (p.head.compare_exchange_weak(old, update, std::memory_order_acquire, std::memory_order_acquire))
+            return ptr;
+        }
+        return nullptr;
+      }
+    };
+
+    static Arena &arena()
+    {
+      static Arena arena;
+      return arena;
+    }
+
+    /**
+       @brief Touch the pages of a new block in parallel, such that
+       each page is placed on the NUMA node of the thread that will
+       process it under a static schedule
+     */
+    static void first_touch(char *ptr, size_t bytes)
+    {
+      const size_t page = sysconf(_SC_PAGESIZE);
+      const int64_t n = (bytes + page - 1) / page;
+#pragma omp parallel for schedule(static)
+      for (int64_t i = 0; i < n; i++) ptr[i * page] = 0;
+    }
+
+    bool enabled() { return arena().base != nullptr; }
+
+    void *allocate(size_t bytes)
+    {
+      auto &a = arena();
+      if (!a.base) return nullptr;
+
+      int k = 0;
+      while (k < n_class && class_size(k) < bytes) k++;
+      if (k == n_class) return nullptr;
+
+      const int node = a.node();
+      Pool &p = a.pool[node][k];
+      char *ptr = a.pop(p);
+      if (!ptr) {
+        size_t offset = p.top.fetch_add(class_size(k), std::memory_order_relaxed);
+        if (offset + class_size(k) > class_span(k)) return nullptr; // class region exhausted
+        ptr = a.block(node, k, offset);
+        if (class_size(k) >= huge_page_size) first_touch(ptr, bytes);
+      }
+
+      size_t total = a.bytes.fetch_add(class_size(k), std::memory_order_relaxed) + class_size(k);
+      size_t peak = a.peak.load(std::memory_order_relaxed);
+      while (total > peak && !a.peak.compare_exchange_weak(peak, total, std::memory_order_relaxed)) { }
+
+      return ptr;
+    }
+
+    void deallocate(void *ptr)
+    {
+      auto &a = arena();
+      int node, k;
+      a.locate(ptr, node, k);
+      a.push(a.pool[node][k], static_cast<char *>(ptr));
+      a.bytes.fetch_sub(class_size(k), std::memory_order_relaxed);
+    }
+
+    bool owns(const void *ptr)
+    {
+      auto &a = arena();
+      return a.base && ptr >= a.base && ptr < a.base + a.reserved;
+    }
+
+    size_t allocated() { return arena().bytes.load(std::memory_order_relaxed); }
+
+    size_t allocated_peak() { return arena().peak.load(std::memory_order_relaxed); }
+
+    void advise_huge_pages(void *ptr, size_t bytes)
+    {
+#ifdef MADV_HUGEPAGE
+      if (bytes < huge_page_size) return;
+      // madvise requires a page-aligned range
+      const uintptr_t page = sysconf(_SC_PAGESIZE);
+      uintptr_t begin = (reinterpret_cast<uintptr_t>(ptr) + page - 1) & ~(page - 1);
+      uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + bytes) & ~(page - 1);
+      if (end > begin && madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE) != 0)
+        logQuda(QUDA_DEBUG_VERBOSE, "madvise(MADV_HUGEPAGE) failed for %p of %lu bytes\n", ptr, bytes);
+#else
+      (void)ptr;
+      (void)bytes;
+#endif
+    }
+
+  } // namespace host_arena
+
+} // namespace quda
@@ -3,6 +3,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <deque>
 #include <sys/time.h>
 #include <complex.h>
 
@@ -17,6 +18,7 @@
 #include <dirac_quda.h>
 #include <dslash_quda.h>
 #include <invert_quda.h>
+#include <chronology.h>
 #include <eigensolve_quda.h>
 #include <color_spinor_field.h>
 #include <clover_field.h>
@@ -70,6 +72,7 @@ static lat_dim_t R = {};
 static bool redundant_comms = false;
 
 #include <blas_lapack.h>
+#include <numa_affinity.h>
 
 GaugeField *gaugePrecise = nullptr;
 GaugeField *gaugeSloppy = nullptr;
@@ -108,7 +111,7 @@ std::vector<ColorSpinorField> solutionResident;
 // vector of spinors used for forecasting solutions in HMC
 #define QUDA_MAX_CHRONO 12
 // each entry is one p
-std::vector<std::vector<ColorSpinorField>> chronoResident(QUDA_MAX_CHRONO);
+std::vector<Chronology> chronoResident(QUDA_MAX_CHRONO);
 
 // Mapped memory buffer used to hold unitarization failures
 static int *num_failures_h = nullptr;
@@ -137,6 +140,9 @@ static TimeProfile profileInvertMultiSrc("invertMultiSrcQuda");
 //!< Profiler for invertMultiShiftQuda
 static TimeProfile profileMulti("invertMultiShiftQuda");
 
+//!< Profiler for invertMultiShiftMultiSrcQuda
+static TimeProfile profileMultiShiftMultiSrc("invertMultiShiftMultiSrcQuda");
+
 //!< Profiler for eigensolveQuda
 static TimeProfile profileEigensolve("eigensolveQuda");
 
@@ -484,6 +490,9 @@ void initQudaMemory()
   // initalize the memory pool allocators
   pool::init();
 
+  // bind host threads to cores if requested
+  topology::init();
+
   createDslashEvents();
 
   blas_lapack::native::init();
@@ -550,6 +559,39 @@ void freeUniqueSloppyGaugeUtility(GaugeField *&precise, GaugeField *&sloppy, Gau
 void freeUniqueGaugeUtility(GaugeField *&precise, GaugeField *&sloppy, GaugeField *&precondition, GaugeField *&refinement,
                             GaugeField *&eigensolver, GaugeField *&extended, bool preserve_precise);
 
+/**
+   @brief Compute the checksums of a host gauge field if requested,
+   verifying them against those given in the gauge parameters and /
+   or returning them in the gauge parameters.  A zero expected
+   checksum is treated as unknown and is not verified.
+   @param[in] u Host gauge field
+   @param[in,out] param Gauge parameters
+ */
+static void checksumGauge(const GaugeField &u, QudaGaugeParam &param)
+{
+  if (param.compute_checksum == QUDA_BOOLEAN_FALSE && param.verify_checksum == QUDA_BOOLEAN_FALSE) return;
+
+  auto sum = ChecksumSciDAC(u, param.checksum_prec);
+  logQuda(QUDA_VERBOSE, "Gauge field SciDAC checksum a = %x, b = %x, QUDA checksum = %llx\n", sum.suma, sum.sumb,
+          static_cast<unsigned long long>(sum.quda));
+
+  if (param.verify_checksum == QUDA_BOOLEAN_TRUE) {
+    if ((param.checksum_scidac[0] != 0 || param.checksum_scidac[1] != 0)
+        && (param.checksum_scidac[0] != sum.suma || param.checksum_scidac[1] != sum.sumb))
+      errorQuda("SciDAC checksum mismatch: expected a = %x, b = %x, computed a = %x, b = %x", param.checksum_scidac[0],
+                param.checksum_scidac[1], sum.suma, sum.sumb);
+    if (param.checksum_quda != 0 && param.checksum_quda != sum.quda)
+      errorQuda("QUDA checksum mismatch: expected %llx, computed %llx", param.checksum_quda,
+                static_cast<unsigned long long>(sum.quda));
+  }
+
+  if (param.compute_checksum == QUDA_BOOLEAN_TRUE) {
+    param.checksum_scidac[0] = sum.suma;
+    param.checksum_scidac[1] = sum.sumb;
+    param.checksum_quda = sum.quda;
+  }
+}
+
 void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 {
   auto profile = pushProfile(profileGauge);
@@ -563,6 +605,7 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 
   if (gauge_param.order <= 4) gauge_param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
   GaugeField *in = GaugeField::Create(gauge_param);
+  checksumGauge(*in, *param);
 
   if (in->Order() == QUDA_BQCD_GAUGE_ORDER) {
     static size_t checksum = SIZE_MAX;
@@ -776,6 +819,7 @@ void saveGaugeQuda(void *h_gauge, QudaGaugeParam *param)
   }
 
   cpuGauge.copy(*cudaGauge);
+  checksumGauge(cpuGauge, *param);
 
   if (param->type == QUDA_SMEARED_LINKS) { delete cudaGauge; }
 }
@@ -1317,6 +1361,7 @@ void flushChronoQuda(int i)
   if (i >= QUDA_MAX_CHRONO)
     errorQuda("Requested chrono index %d is outside of max %d\n", i, QUDA_MAX_CHRONO);
 
+  if (getVerbosity() >= QUDA_SUMMARIZE) chronoResident[i].print_stats(i);
   chronoResident[i].clear();
 }
 
@@ -1375,6 +1420,7 @@ void endQuda(void)
     profileInvert.Print();
     profileInvertMultiSrc.Print();
     profileMulti.Print();
+    profileMultiShiftMultiSrc.Print();
     profileEigensolve.Print();
     profileFatLink.Print();
     profileGaugeForce.Print();
@@ -2781,6 +2827,10 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     errorQuda("Chronological forcasting only presently supported for M^dagger M solver");
   }
 
+  if ((param->chrono_use_resident || param->chrono_make_resident) && param->chrono_index >= QUDA_MAX_CHRONO)
+    errorQuda("Requested chrono index %d is outside of max %d\n", param->chrono_index, QUDA_MAX_CHRONO);
+  const bool chrono_forecast = param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0;
+
   profileInvert.TPSTOP(QUDA_PROFILE_PREAMBLE);
 
   if (mat_solution && !direct_solve && !norm_error_solve) { // prepare source: b' = A^dag b
@@ -2800,29 +2850,20 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     DiracM m(dirac), mSloppy(diracSloppy), mPre(diracPre), mEig(diracEig);
     SolverParam solverParam(*param);
     // chronological forecasting
-    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0) {
+    if (chrono_forecast) {
       profileInvert.TPSTART(QUDA_PROFILE_CHRONO);
 
-      auto &basis = chronoResident[param->chrono_index];
-
-      ColorSpinorParam cs_param(basis[0]);
-      std::vector<ColorSpinorField> Ap(basis.size(), cs_param);
-
-      if (param->chrono_precision == param->cuda_prec) {
-        for (unsigned int j = 0; j < basis.size(); j++) m(Ap[j], basis[j]);
-      } else if (param->chrono_precision == param->cuda_prec_sloppy) {
-        for (unsigned int j = 0; j < basis.size(); j++) mSloppy(Ap[j], basis[j]);
+      // apply the operator in the lowest precision that can represent the basis
+      auto &chrono = chronoResident[param->chrono_index];
+      if (param->chrono_precision != param->cuda_prec && param->chrono_precision <= param->cuda_prec_sloppy) {
+        chrono.forecast(*out, *in, mSloppy, param->cuda_prec_sloppy, false);
+      } else if (param->chrono_precision <= param->cuda_prec) {
+        chrono.forecast(*out, *in, m, param->cuda_prec, false);
       } else {
-        errorQuda("Unexpected precision %d for chrono vectors (doesn't match outer %d or sloppy precision %d)",
-                  param->chrono_precision, param->cuda_prec, param->cuda_prec_sloppy);
+        errorQuda("Unexpected precision %d for chrono vectors (exceeds outer %d precision)", param->chrono_precision,
+                  param->cuda_prec);
       }
 
-      bool orthogonal = true;
-      bool apply_mat = false;
-      bool hermitian = false;
-      MinResExt mre(m, orthogonal, apply_mat, hermitian);
-      mre(*out, *in, basis, Ap);
-
       profileInvert.TPSTOP(QUDA_PROFILE_CHRONO);
     }
 
@@ -2835,29 +2876,20 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     SolverParam solverParam(*param);
 
     // chronological forecasting
-    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0) {
+    if (chrono_forecast) {
       profileInvert.TPSTART(QUDA_PROFILE_CHRONO);
 
-      auto &basis = chronoResident[param->chrono_index];
-
-      ColorSpinorParam cs_param(basis[0]);
-      std::vector<ColorSpinorField> Ap(basis.size(), cs_param);
-
-      if (param->chrono_precision == param->cuda_prec) {
-        for (unsigned int j = 0; j < basis.size(); j++) m(Ap[j], basis[j]);
-      } else if (param->chrono_precision == param->cuda_prec_sloppy) {
-        for (unsigned int j = 0; j < basis.size(); j++) mSloppy(Ap[j], basis[j]);
+      // apply the operator in the lowest precision that can represent the basis
+      auto &chrono = chronoResident[param->chrono_index];
+      if (param->chrono_precision != param->cuda_prec && param->chrono_precision <= param->cuda_prec_sloppy) {
+        chrono.forecast(*out, *in, mSloppy, param->cuda_prec_sloppy, true);
+      } else if (param->chrono_precision <= param->cuda_prec) {
+        chrono.forecast(*out, *in, m, param->cuda_prec, true);
       } else {
-        errorQuda("Unexpected precision %d for chrono vectors (doesn't match outer %d or sloppy precision %d)",
-                  param->chrono_precision, param->cuda_prec, param->cuda_prec_sloppy);
+        errorQuda("Unexpected precision %d for chrono vectors (exceeds outer %d precision)", param->chrono_precision,
+                  param->cuda_prec);
       }
 
-      bool orthogonal = true;
-      bool apply_mat = false;
-      bool hermitian = true;
-      MinResExt mre(m, orthogonal, apply_mat, hermitian);
-      mre(*out, *in, basis, Ap);
-
       profileInvert.TPSTOP(QUDA_PROFILE_CHRONO);
     }
 
@@ -2888,33 +2920,22 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
   logQuda(QUDA_VERBOSE, "Solution = %g\n", blas::norm2(x));
 
   profileInvert.TPSTART(QUDA_PROFILE_EPILOGUE);
+  if (param->chrono_use_resident || param->chrono_make_resident)
+    chronoResident[param->chrono_index].record(param->iter, chrono_forecast);
+
   if (param->chrono_make_resident) {
     if(param->chrono_max_dim < 1){
       errorQuda("Cannot chrono_make_resident with chrono_max_dim %i", param->chrono_max_dim);
     }
 
-    const int i = param->chrono_index;
-    if (i >= QUDA_MAX_CHRONO)
-      errorQuda("Requested chrono index %d is outside of max %d\n", i, QUDA_MAX_CHRONO);
-
-    auto &basis = chronoResident[i];
+    auto &chrono = chronoResident[param->chrono_index];
 
-    if (param->chrono_max_dim < (int)basis.size()) {
-      errorQuda("Requested chrono_max_dim %i is smaller than already existing chronology %lu", param->chrono_max_dim, basis.size());
+    if (param->chrono_max_dim < (int)chrono.size()) {
+      errorQuda("Requested chrono_max_dim %i is smaller than already existing chronology %lu", param->chrono_max_dim, chrono.size());
     }
 
-    if(not param->chrono_replace_last){
-      // if we have not filled the space yet just augment
-      if ((int)basis.size() < param->chrono_max_dim) {
-        ColorSpinorParam cs_param(*out);
-        cs_param.setPrecision(param->chrono_precision);
-        basis.emplace_back(cs_param);
-      }
-
-      // shuffle every entry down one and bring the last to the front
-      std::rotate(basis.begin(), basis.end() - 1, basis.end());
-    }
-    basis[0] = *out; // set first entry to new solution
+    int max_dim = Chronology::max_dim(param->chrono_max_dim, param->chrono_memory_budget, *out, param->chrono_precision);
+    chrono.add(*out, max_dim, param->chrono_precision, param->chrono_replace_last);
   }
   dirac.reconstruct(x, b, param->solution_type);
 
@@ -3193,7 +3214,10 @@ void callMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param, // col
 
     comm_barrier();
 
-    // Split input fermion field
+    // The fermion fields are redistributed in batches of one source
+    // per sub-partition, pipelined with the solves: the split of the
+    // next batch and the join of the previous batch are in flight
+    // while the current batch is solved
     quda::ColorSpinorParam cpu_cs_param_split(*_h_x[0]);
     cpu_cs_param_split.location = QUDA_CPU_FIELD_LOCATION;
     for (int d = 0; d < CommKey::n_dim; d++) { cpu_cs_param_split.x[d] *= split_key[d]; }
@@ -3202,12 +3226,14 @@ void callMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param, // col
     for (int n = 0; n < param->num_src_per_sub_partition; n++) {
       _collect_b[n] = new quda::ColorSpinorField(cpu_cs_param_split);
       _collect_x[n] = new quda::ColorSpinorField(cpu_cs_param_split);
-      auto first = _h_b.begin() + n * num_sub_partition;
-      auto last = _h_b.begin() + (n + 1) * num_sub_partition;
-      std::vector<ColorSpinorField *> _v_b(first, last);
-      split_field(*_collect_b[n], _v_b, split_key, pc_type);
     }
-    comm_barrier();
+
+    auto batch = [&](std::vector<ColorSpinorField *> &v, int n) {
+      return std::vector<ColorSpinorField *>(v.begin() + n * num_sub_partition, v.begin() + (n + 1) * num_sub_partition);
+    };
+
+    auto pipeline = std::make_unique<SplitGridPipeline<ColorSpinorField>>(*_h_x[0], split_key, pc_type);
+    pipeline->split_start(0, batch(_h_b, 0));
 
     push_communicator(split_key);
     updateR();
@@ -3238,26 +3264,28 @@ void callMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param, // col
     }
 
     for (int n = 0; n < param->num_src_per_sub_partition; n++) {
+      pipeline->split_wait(n, *_collect_b[n]);
+      if (n + 1 < param->num_src_per_sub_partition) pipeline->split_start(n + 1, batch(_h_b, n + 1));
+
       op(_collect_x[n]->data(), _collect_b[n]->data(), param, args...);
+
+      pipeline->join_start(n, *_collect_x[n]);
+      if (n > 0) pipeline->join_wait(n - 1, batch(_h_x, n - 1));
     }
+    pipeline->join_wait(param->num_src_per_sub_partition - 1, batch(_h_x, param->num_src_per_sub_partition - 1));
 
     profileInvertMultiSrc.TPSTART(QUDA_PROFILE_EPILOGUE);
     push_communicator(default_comm_key);
     updateR();
     comm_barrier();
 
+    pipeline.reset();
+
     for (int d = 0; d < CommKey::n_dim; d++) {
       gauge_param->X[d] /= split_key[d];
       gauge_param->ga_pad /= split_key[d];
     }
 
-    for (int n = 0; n < param->num_src_per_sub_partition; n++) {
-      auto first = _h_x.begin() + n * num_sub_partition;
-      auto last = _h_x.begin() + (n + 1) * num_sub_partition;
-      std::vector<ColorSpinorField *> _v_x(first, last);
-      join_field(_v_x, *_collect_x[n], split_key, pc_type);
-    }
-
     for (auto p : _collect_b) { delete p; }
     for (auto p : _collect_x) { delete p; }
 
@@ -3315,6 +3343,85 @@ void invertMultiSrcCloverQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param
   callMultiSrcQuda(_hp_x, _hp_b, param, h_gauge, nullptr, nullptr, gauge_param, h_clover, h_clovinv, op);
 }
 
+void invertDilutedNoiseQuda(void **hp_x, void *hp_noise, QudaInvertParam *param, void *h_gauge,
+                            QudaGaugeParam *gauge_param, unsigned long long seed, QudaNoiseType noise_type,
+                            QudaDilutionType dilution_type, const int *dilution_block)
+{
+  if (!initialized) errorQuda("QUDA not initialized");
+  checkInvertParam(param);
+  GaugeField *cudaGauge = checkGauge(param);
+
+  bool pc_solution
+    = (param->solution_type == QUDA_MATPC_SOLUTION) || (param->solution_type == QUDA_MATPCDAG_MATPC_SOLUTION);
+  const auto X = cudaGauge->X();
+
+  // the noise source and its dilution are generated in native order
+  // on the device, but in the user's gamma basis, since spin dilution
+  // does not commute with a change of basis
+  ColorSpinorParam cpuParam(hp_noise, *param, X, pc_solution, param->input_location);
+  ColorSpinorParam cudaParam(cpuParam, *param, QUDA_CUDA_FIELD_LOCATION);
+  cudaParam.gammaBasis = param->gamma_basis;
+  cudaParam.create = QUDA_NULL_FIELD_CREATE;
+  ColorSpinorField eta(cudaParam);
+  spinorNoise(eta, seed, noise_type);
+
+  if (hp_noise) {
+    ColorSpinorField h_noise(cpuParam);
+    h_noise.copy(eta);
+  }
+
+  lat_dim_t block = {};
+  if (dilution_block) {
+    for (int d = 0; d < 4; d++) block[d] = dilution_block[d];
+    if (pc_solution) block[0] /= 2;
+  }
+  const int n = spinorDiluteSize(eta, dilution_type, block);
+
+  CommKey split_key = {param->split_grid[0], param->split_grid[1], param->split_grid[2], param->split_grid[3]};
+  const int num_sub_partition = quda::product(split_key);
+  const int batch = param->num_src > 0 ? std::min(param->num_src, n) : n;
+  if (num_sub_partition > 1 && (batch % num_sub_partition != 0 || n % batch != 0))
+    errorQuda("Batch size %d must be a multiple of the number of sub partitions %d and divide the dilution set size %d",
+              batch, num_sub_partition, n);
+
+  logQuda(QUDA_SUMMARIZE, "Solving for %d diluted sources (dilution type %d) in batches of %d\n", n, dilution_type,
+          batch);
+
+  // The sources handed to the multi-source solver are in the
+  // user's order.  Without split grid these remain on the device,
+  // else the split requires them to be on the host.
+  ColorSpinorParam bParam(nullptr, *param, X, pc_solution,
+                          num_sub_partition > 1 ? QUDA_CPU_FIELD_LOCATION : QUDA_CUDA_FIELD_LOCATION);
+  bParam.create = QUDA_NULL_FIELD_CREATE;
+  std::vector<ColorSpinorField> b(batch, bParam);
+  std::vector<ColorSpinorField> tmp(batch, cudaParam);
+
+  const int num_src = param->num_src;
+  const int num_src_per_sub_partition = param->num_src_per_sub_partition;
+  const QudaFieldLocation input_location = param->input_location;
+  param->input_location = bParam.location;
+
+  for (int offset = 0; offset < n; offset += batch) {
+    const int m = std::min(batch, n - offset);
+    vector_ref<ColorSpinorField> v(tmp.begin(), tmp.begin() + m);
+    spinorDilute(v, eta, dilution_type, block, offset);
+
+    std::vector<void *> hp_b(m);
+    for (int i = 0; i < m; i++) {
+      b[i].copy(tmp[i]);
+      hp_b[i] = b[i].data();
+    }
+
+    param->num_src = m;
+    param->num_src_per_sub_partition = m / num_sub_partition;
+    invertMultiSrcQuda(hp_x + offset, hp_b.data(), param, h_gauge, gauge_param);
+  }
+
+  param->num_src = num_src;
+  param->num_src_per_sub_partition = num_src_per_sub_partition;
+  param->input_location = input_location;
+}
+
 void dslashMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param, QudaParity parity, void *h_gauge,
                         QudaGaugeParam *gauge_param)
 {
@@ -3348,15 +3455,18 @@ void dslashMultiSrcCloverQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param
  * For Staggered-type fermions, the solution_type must be MATPC, and the
  * solve type must be DIRECT_PC. This difference in convention is because
  * preconditioned staggered operator is normal, unlike with Wilson-type fermions.
+ *
+ * With more than one source the sources are solved together with
+ * MultiShiftMultiSrcCG, and the resident solutions are stored source
+ * major, e.g., solution i of source s is at s * num_offset + i.
  */
-void invertMultiShiftQuda(void **hp_x, void *hp_b, QudaInvertParam *param)
+static void callMultiShiftQuda(void ***hp_x, void **hp_b, int n_src, QudaInvertParam *param, TimeProfile &profile)
 {
-  auto profile = pushProfile(profileMulti, param->secs, param->gflops);
-  profilerStart(__func__);
-
   if (!initialized) errorQuda("QUDA not initialized");
 
-  checkInvertParam(param, hp_x[0], hp_b);
+  if (n_src < 1) errorQuda("Invalid number of sources %d", n_src);
+
+  checkInvertParam(param, hp_x[0][0], hp_b[0]);
 
   // check the gauge fields have been created
   checkGauge(param);
@@ -3432,7 +3542,7 @@ void invertMultiShiftQuda(void **hp_x, void *hp_b, QudaInvertParam *param)
   dirac.prefetch(QUDA_CUDA_FIELD_LOCATION);
   diracSloppy.prefetch(QUDA_CUDA_FIELD_LOCATION);
 
-  std::vector<double> r2_old(param->num_offset);
+  std::vector<std::vector<double>> r2_old(n_src, std::vector<double>(param->num_offset));
 
   // Grab the dimension array of the input gauge field.
   const auto X = (param->dslash_type == QUDA_ASQTAD_DSLASH) ? gaugeFatPrecise->X() : gaugePrecise->X();
@@ -3442,24 +3552,33 @@ void invertMultiShiftQuda(void **hp_x, void *hp_b, QudaInvertParam *param)
   // the solution is on a checkerboard instruction or not. These can
   // then be used as 'instructions' to create the actual
   // ColorSpinorField
-  ColorSpinorParam cpuParam(hp_b, *param, X, pc_solution, param->input_location);
-  ColorSpinorField h_b(cpuParam);
+  ColorSpinorParam cpuParam(hp_b[0], *param, X, pc_solution, param->input_location);
+  std::vector<ColorSpinorField> h_b(n_src);
+  for (int s = 0; s < n_src; s++) {
+    cpuParam.v = hp_b[s];
+    h_b[s] = ColorSpinorField(cpuParam);
+  }
 
-  std::vector<std::unique_ptr<ColorSpinorField>> h_x;
-  h_x.resize(param->num_offset);
+  std::vector<std::vector<std::unique_ptr<ColorSpinorField>>> h_x(n_src);
 
   cpuParam.location = param->output_location;
-  for(int i=0; i < param->num_offset; i++) {
-    cpuParam.v = hp_x[i];
-    h_x[i] = std::make_unique<ColorSpinorField>(cpuParam);
+  for (int s = 0; s < n_src; s++) {
+    h_x[s].resize(param->num_offset);
+    for (int i = 0; i < param->num_offset; i++) {
+      cpuParam.v = hp_x[s][i];
+      h_x[s][i] = std::make_unique<ColorSpinorField>(cpuParam);
+    }
   }
 
   // Now I need a colorSpinorParam for the device
   ColorSpinorParam cudaParam(cpuParam, *param, QUDA_CUDA_FIELD_LOCATION);
   // This setting will download a host vector
   cudaParam.create = QUDA_COPY_FIELD_CREATE;
-  cudaParam.field = &h_b;
-  ColorSpinorField b(cudaParam); // Creates b and downloads h_b to it
+  std::vector<ColorSpinorField> b(n_src);
+  for (int s = 0; s < n_src; s++) {
+    cudaParam.field = &h_b[s];
+    b[s] = ColorSpinorField(cudaParam); // Creates b and downloads h_b to it
+  }
 
   // Create the solution fields filled with zero
   cudaParam.create = QUDA_ZERO_FIELD_CREATE;
@@ -3474,34 +3593,41 @@ void invertMultiShiftQuda(void **hp_x, void *hp_b, QudaInvertParam *param)
 
   // grow/shrink resident solutions to be correct size
   auto old_size = solutionResident.size();
-  solutionResident.resize(param->num_offset);
+  solutionResident.resize(n_src * param->num_offset);
   for (auto i = old_size; i < solutionResident.size(); i++) solutionResident[i] = ColorSpinorField(cudaParam);
 
-  std::vector<ColorSpinorField> &x = solutionResident;
-  std::vector<ColorSpinorField> p;
-
-  profileMulti.TPSTART(QUDA_PROFILE_PREAMBLE);
+  // the solutions of each source alias the resident solutions
+  std::vector<std::vector<ColorSpinorField>> x(n_src);
+  for (int s = 0; s < n_src; s++)
+    for (int i = 0; i < param->num_offset; i++)
+      x[s].push_back(solutionResident[s * param->num_offset + i].create_alias());
+  std::vector<std::vector<ColorSpinorField>> p(n_src);
 
-  // Check source norms
-  double nb = blas::norm2(b);
-  if (nb==0.0) errorQuda("Source has zero norm");
-
-  if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
-    printfQuda("Source: CPU = %g, CUDA copy = %g\n", blas::norm2(h_b), nb);
-  } else if (getVerbosity() >= QUDA_VERBOSE) {
-    printfQuda("Source: %g\n", nb);
-  }
-
-  // rescale the source vector to help prevent the onset of underflow
-  if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) { blas::ax(1.0 / sqrt(nb), b); }
+  profile.TPSTART(QUDA_PROFILE_PREAMBLE);
 
   // backup shifts
   double unscaled_shifts[QUDA_MAX_MULTI_SHIFT];
   for (int i = 0; i < param->num_offset; i++) { unscaled_shifts[i] = param->offset[i]; }
 
-  // rescale
-  massRescale(b, *param, true);
-  profileMulti.TPSTOP(QUDA_PROFILE_PREAMBLE);
+  std::vector<double> nb(n_src);
+  for (int s = 0; s < n_src; s++) {
+    // Check source norms
+    nb[s] = blas::norm2(b[s]);
+    if (nb[s] == 0.0) errorQuda("Source %d has zero norm", s);
+
+    if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
+      printfQuda("Source %d: CPU = %g, CUDA copy = %g\n", s, blas::norm2(h_b[s]), nb[s]);
+    } else if (getVerbosity() >= QUDA_VERBOSE) {
+      printfQuda("Source %d: %g\n", s, nb[s]);
+    }
+
+    // rescale the source vector to help prevent the onset of underflow
+    if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) { blas::ax(1.0 / sqrt(nb[s]), b[s]); }
+
+    // rescale, with the shifts only rescaled once
+    massRescale(b[s], *param, s == 0);
+  }
+  profile.TPSTOP(QUDA_PROFILE_PREAMBLE);
 
   DiracMatrix *m, *mSloppy;
 
@@ -3515,129 +3641,156 @@ void invertMultiShiftQuda(void **hp_x, void *hp_b, QudaInvertParam *param)
   }
 
   SolverParam solverParam(*param);
-  {
-    MultiShiftCG cg_m(*m, *mSloppy, solverParam, profileMulti);
-    cg_m(x, b, p, r2_old);
+  std::unique_ptr<MultiShiftMultiSrcCG> cg_multi;
+  if (n_src == 1) {
+    MultiShiftCG cg_m(*m, *mSloppy, solverParam, profile);
+    cg_m(x[0], b[0], p[0], r2_old[0]);
+  } else {
+    cg_multi = std::make_unique<MultiShiftMultiSrcCG>(*m, *mSloppy, solverParam, profile);
+    (*cg_multi)(x, b, p, r2_old);
   }
   solverParam.updateInvertParam(*param);
 
   delete m;
   delete mSloppy;
 
-  if (param->compute_true_res) {
-    // check each shift has the desired tolerance and use sequential CG to refine
-    cudaParam.create = QUDA_ZERO_FIELD_CREATE;
-    ColorSpinorField r(cudaParam);
-    QudaInvertParam refineparam = *param;
-    refineparam.cuda_prec_sloppy = param->cuda_prec_refinement_sloppy;
-    Dirac &dirac = *d;
-    Dirac &diracSloppy = *dRefine;
-    diracSloppy.prefetch(QUDA_CUDA_FIELD_LOCATION);
+  // worst residual for each shift over all sources
+  std::vector<double> true_res_max(param->num_offset, 0.0);
+  std::vector<double> iter_res_max(param->num_offset, 0.0);
+  std::vector<double> true_res_hq_max(param->num_offset, 0.0);
+
+  for (int s = 0; s < n_src; s++) {
+    if (cg_multi) cg_multi->updateInvertParam(*param, s);
+
+    if (param->compute_true_res) {
+      // check each shift has the desired tolerance and use sequential CG to refine
+      cudaParam.create = QUDA_ZERO_FIELD_CREATE;
+      ColorSpinorField r(cudaParam);
+      QudaInvertParam refineparam = *param;
+      refineparam.cuda_prec_sloppy = param->cuda_prec_refinement_sloppy;
+      Dirac &dirac = *d;
+      Dirac &diracSloppy = *dRefine;
+      diracSloppy.prefetch(QUDA_CUDA_FIELD_LOCATION);
 
 #define REFINE_INCREASING_MASS
 #ifdef REFINE_INCREASING_MASS
-    for(int i=0; i < param->num_offset; i++) {
+      for(int i=0; i < param->num_offset; i++) {
 #else
-    for(int i=param->num_offset-1; i >= 0; i--) {
+      for(int i=param->num_offset-1; i >= 0; i--) {
 #endif
-      double rsd_hq = param->residual_type & QUDA_HEAVY_QUARK_RESIDUAL ?
-	param->true_res_hq_offset[i] : 0;
-      double tol_hq = param->residual_type & QUDA_HEAVY_QUARK_RESIDUAL ?
-	param->tol_hq_offset[i] : 0;
-
-      /*
-	In the case where the shifted systems have zero tolerance
-	specified, we refine these systems until either the limit of
-	precision is reached (prec_tol) or until the tolerance reaches
-	the iterated residual tolerance of the previous multi-shift
-	solver (iter_res_offset[i]), which ever is greater.
-      */
-      const double prec_tol = std::pow(10.,(-2*(int)param->cuda_prec+4)); // implicit refinment limit of 1e-12
-      const double iter_tol = (param->iter_res_offset[i] < prec_tol ? prec_tol : (param->iter_res_offset[i] *1.1));
-      const double refine_tol = (param->tol_offset[i] == 0.0 ? iter_tol : param->tol_offset[i]);
-      // refine if either L2 or heavy quark residual tolerances have not been met, only if desired residual is > 0
-      if (param->true_res_offset[i] > refine_tol || rsd_hq > tol_hq) {
-        logQuda(QUDA_SUMMARIZE, "Refining shift %d: L2 residual %e / %e, heavy quark %e / %e (actual / requested)\n", i,
-                param->true_res_offset[i], param->tol_offset[i], rsd_hq, tol_hq);
-
-        // for staggered the shift is just a change in mass term (FIXME: for twisted mass also)
-        if (param->dslash_type == QUDA_ASQTAD_DSLASH ||
-            param->dslash_type == QUDA_STAGGERED_DSLASH) {
-          dirac.setMass(sqrt(param->offset[i]/4));
-          diracSloppy.setMass(sqrt(param->offset[i]/4));
-        }
-
-        DiracMatrix *m, *mSloppy;
-
-        if (param->dslash_type == QUDA_ASQTAD_DSLASH ||
-            param->dslash_type == QUDA_STAGGERED_DSLASH) {
-          m = new DiracM(dirac);
-          mSloppy = new DiracM(diracSloppy);
-        } else {
-          m = new DiracMdagM(dirac);
-          mSloppy = new DiracMdagM(diracSloppy);
-        }
-
-        // need to curry in the shift if we are not doing staggered
-        if (param->dslash_type != QUDA_ASQTAD_DSLASH && param->dslash_type != QUDA_STAGGERED_DSLASH) {
-          m->shift = param->offset[i];
-          mSloppy->shift = param->offset[i];
-        }
-
-        if (false) { // experimenting with Minimum residual extrapolation
-                     // only perform MRE using current and previously refined solutions
+        double rsd_hq = param->residual_type & QUDA_HEAVY_QUARK_RESIDUAL ?
+          param->true_res_hq_offset[i] : 0;
+        double tol_hq = param->residual_type & QUDA_HEAVY_QUARK_RESIDUAL ?
+          param->tol_hq_offset[i] : 0;
+
+        /*
+          In the case where the shifted systems have zero tolerance
+          specified, we refine these systems until either the limit of
+          precision is reached (prec_tol) or until the tolerance reaches
+          the iterated residual tolerance of the previous multi-shift
+          solver (iter_res_offset[i]), which ever is greater.
+        */
+        const double prec_tol = std::pow(10.,(-2*(int)param->cuda_prec+4)); // implicit refinment limit of 1e-12
+        const double iter_tol = (param->iter_res_offset[i] < prec_tol ? prec_tol : (param->iter_res_offset[i] *1.1));
+        const double refine_tol = (param->tol_offset[i] == 0.0 ? iter_tol : param->tol_offset[i]);
+        // refine if either L2 or heavy quark residual tolerances have not been met, only if desired residual is > 0
+        if (param->true_res_offset[i] > refine_tol || rsd_hq > tol_hq) {
+          logQuda(QUDA_SUMMARIZE, "Refining source %d shift %d: L2 residual %e / %e, heavy quark %e / %e (actual / requested)\n",
+                  s, i, param->true_res_offset[i], param->tol_offset[i], rsd_hq, tol_hq);
+
+          // for staggered the shift is just a change in mass term (FIXME: for twisted mass also)
+          if (param->dslash_type == QUDA_ASQTAD_DSLASH ||
+              param->dslash_type == QUDA_STAGGERED_DSLASH) {
+            dirac.setMass(sqrt(param->offset[i]/4));
+            diracSloppy.setMass(sqrt(param->offset[i]/4));
+          }
+
+          DiracMatrix *m, *mSloppy;
+
+          if (param->dslash_type == QUDA_ASQTAD_DSLASH ||
+              param->dslash_type == QUDA_STAGGERED_DSLASH) {
+            m = new DiracM(dirac);
+            mSloppy = new DiracM(diracSloppy);
+          } else {
+            m = new DiracMdagM(dirac);
+            mSloppy = new DiracMdagM(diracSloppy);
+          }
+
+          // need to curry in the shift if we are not doing staggered
+          if (param->dslash_type != QUDA_ASQTAD_DSLASH && param->dslash_type != QUDA_STAGGERED_DSLASH) {
+            m->shift = param->offset[i];
+            mSloppy->shift = param->offset[i];
+          }
+
+          if (false) { // experimenting with Minimum residual extrapolation
+                       // only perform MRE using current and previously refined solutions
 #ifdef REFINE_INCREASING_MASS
-	  const int nRefine = i+1;
+            const int nRefine = i+1;
 #else
-	  const int nRefine = param->num_offset - i + 1;
+            const int nRefine = param->num_offset - i + 1;
 #endif
 
-          cudaParam.create = QUDA_NULL_FIELD_CREATE;
-          std::vector<ColorSpinorField> q(nRefine, cudaParam);
-          std::vector<ColorSpinorField> z(nRefine, cudaParam);
+            cudaParam.create = QUDA_NULL_FIELD_CREATE;
+            std::vector<ColorSpinorField> q(nRefine, cudaParam);
+            std::vector<ColorSpinorField> z(nRefine, cudaParam);
 
-          z[0] = x[0]; // zero solution already solved
+            z[0] = x[s][0]; // zero solution already solved
 #ifdef REFINE_INCREASING_MASS
-          for (int j = 1; j < nRefine; j++) z[j] = x[j];
+            for (int j = 1; j < nRefine; j++) z[j] = x[s][j];
 #else
-          for (int j = 1; j < nRefine; j++) z[j] = x[param->num_offset - j];
+            for (int j = 1; j < nRefine; j++) z[j] = x[s][param->num_offset - j];
 #endif
 
-          bool orthogonal = false;
-          bool apply_mat = true;
-          bool hermitian = true;
-          MinResExt mre(*m, orthogonal, apply_mat, hermitian);
-          mre(x[i], b, z, q);
-        }
-
-        SolverParam solverParam(refineparam);
-        solverParam.iter = 0;
-        solverParam.use_init_guess = QUDA_USE_INIT_GUESS_YES;
-        solverParam.tol = (param->tol_offset[i] > 0.0 ? param->tol_offset[i] : iter_tol); // set L2 tolerance
-        solverParam.tol_hq = param->tol_hq_offset[i];                                     // set heavy quark tolerance
-        solverParam.delta = param->reliable_delta_refinement;
-
-        {
-          CG cg(*m, *mSloppy, *mSloppy, *mSloppy, solverParam, profileMulti);
-          if (i==0)
-            cg(x[i], b, &p[i], r2_old[i]);
-          else
-            cg(x[i], b);
+            bool orthogonal = false;
+            bool apply_mat = true;
+            bool hermitian = true;
+            MinResExt mre(*m, orthogonal, apply_mat, hermitian);
+            mre(x[s][i], b[s], z, q);
+          }
+
+          SolverParam solverParam(refineparam);
+          solverParam.iter = 0;
+          solverParam.use_init_guess = QUDA_USE_INIT_GUESS_YES;
+          solverParam.tol = (param->tol_offset[i] > 0.0 ? param->tol_offset[i] : iter_tol); // set L2 tolerance
+          solverParam.tol_hq = param->tol_hq_offset[i];                                     // set heavy quark tolerance
+          solverParam.delta = param->reliable_delta_refinement;
+
+          {
+            CG cg(*m, *mSloppy, *mSloppy, *mSloppy, solverParam, profile);
+            if (i==0)
+              cg(x[s][i], b[s], &p[s][i], r2_old[s][i]);
+            else
+              cg(x[s][i], b[s]);
+          }
+
+          solverParam.true_res_offset[i] = solverParam.true_res;
+          solverParam.true_res_hq_offset[i] = solverParam.true_res_hq;
+          solverParam.updateInvertParam(*param,i);
+
+          if (param->dslash_type == QUDA_ASQTAD_DSLASH ||
+              param->dslash_type == QUDA_STAGGERED_DSLASH) {
+            dirac.setMass(sqrt(param->offset[0]/4)); // restore just in case
+            diracSloppy.setMass(sqrt(param->offset[0]/4)); // restore just in case
+          }
+
+          delete m;
+          delete mSloppy;
         }
+      }
+    }
 
-        solverParam.true_res_offset[i] = solverParam.true_res;
-        solverParam.true_res_hq_offset[i] = solverParam.true_res_hq;
-        solverParam.updateInvertParam(*param,i);
-
-        if (param->dslash_type == QUDA_ASQTAD_DSLASH ||
-            param->dslash_type == QUDA_STAGGERED_DSLASH) {
-          dirac.setMass(sqrt(param->offset[0]/4)); // restore just in case
-          diracSloppy.setMass(sqrt(param->offset[0]/4)); // restore just in case
-        }
+    for (int i = 0; i < param->num_offset; i++) {
+      true_res_max[i] = std::max(true_res_max[i], param->true_res_offset[i]);
+      iter_res_max[i] = std::max(iter_res_max[i], param->iter_res_offset[i]);
+      true_res_hq_max[i] = std::max(true_res_hq_max[i], param->true_res_hq_offset[i]);
+    }
+  }
 
-        delete m;
-        delete mSloppy;
-      }
+  if (n_src > 1) {
+    for (int i = 0; i < param->num_offset; i++) {
+      param->true_res_offset[i] = true_res_max[i];
+      param->iter_res_offset[i] = iter_res_max[i];
+      param->true_res_hq_offset[i] = true_res_hq_max[i];
     }
   }
 
@@ -3645,26 +3798,31 @@ void invertMultiShiftQuda(void **hp_x, void *hp_b, QudaInvertParam *param)
   for (int i = 0; i < param->num_offset; i++) param->offset[i] = unscaled_shifts[i];
 
   if (param->compute_action) {
+    // the action is summed over the sources
     Complex action(0);
-    for (int i = 0; i < param->num_offset; i++) action += param->residue[i] * blas::cDotProduct(b, x[i]);
+    for (int s = 0; s < n_src; s++)
+      for (int i = 0; i < param->num_offset; i++) action += param->residue[i] * blas::cDotProduct(b[s], x[s][i]);
     param->action[0] = action.real();
     param->action[1] = action.imag();
   }
 
-  for(int i=0; i < param->num_offset; i++) {
-    if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) { // rescale the solution
-      blas::ax(sqrt(nb), x[i]);
-    }
+  for (int s = 0; s < n_src; s++) {
+    for (int i = 0; i < param->num_offset; i++) {
+      if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) { // rescale the solution
+        blas::ax(sqrt(nb[s]), x[s][i]);
+      }
 
-    logQuda(QUDA_VERBOSE, "Solution %d = %g\n", i, blas::norm2(x[i]));
-    if (!param->make_resident_solution) *h_x[i] = x[i];
+      logQuda(QUDA_VERBOSE, "Solution %d = %g\n", s * param->num_offset + i, blas::norm2(x[s][i]));
+      if (!param->make_resident_solution) *h_x[s][i] = x[s][i];
+    }
   }
 
-  profileMulti.TPSTART(QUDA_PROFILE_EPILOGUE);
+  profile.TPSTART(QUDA_PROFILE_EPILOGUE);
 
+  x.clear();
   if (!param->make_resident_solution) solutionResident.clear();
 
-  profileMulti.TPSTOP(QUDA_PROFILE_EPILOGUE);
+  profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
 
   delete d;
   delete dSloppy;
@@ -3674,10 +3832,29 @@ void invertMultiShiftQuda(void **hp_x, void *hp_b, QudaInvertParam *param)
   // cache is written out even if a long benchmarking job gets interrupted
   saveTuneCache();
 
-  profilerStop(__func__);
   popVerbosity();
 }
 
+void invertMultiShiftQuda(void **hp_x, void *hp_b, QudaInvertParam *param)
+{
+  auto profile = pushProfile(profileMulti, param->secs, param->gflops);
+  profilerStart(__func__);
+
+  callMultiShiftQuda(&hp_x, &hp_b, 1, param, profileMulti);
+
+  profilerStop(__func__);
+}
+
+void invertMultiShiftMultiSrcQuda(void ***hp_x, void **hp_b, QudaInvertParam *param)
+{
+  auto profile = pushProfile(profileMultiShiftMultiSrc, param->secs, param->gflops);
+  profilerStart(__func__);
+
+  callMultiShiftQuda(hp_x, hp_b, param->num_src, param, profileMultiShiftMultiSrc);
+
+  profilerStop(__func__);
+}
+
 void computeKSLinkQuda(void *fatlink, void *longlink, void *ulink, void *inlink, double *path_coeff, QudaGaugeParam *param)
 {
   auto profile = pushProfile(profileFatLink);
@@ -5119,6 +5296,144 @@ void performGaugeSmearQuda(QudaGaugeSmearParam *smear_param, QudaGaugeObservable
   popOutputPrefix();
 }
 
+namespace
+{
+
+  /**
+     Measurement of the flowed field at flow time t, with the loop
+     traces held locally so that they can be interpolated
+  */
+  struct FlowMeasurement {
+    double t;
+    QudaGaugeObservableParam obs;
+    std::vector<Complex> traces;
+
+    FlowMeasurement(double t, const QudaGaugeObservableParam &obs) : t(t), obs(obs), traces(obs.num_paths)
+    {
+      if (obs.compute_gauge_loop_trace)
+        for (int i = 0; i < obs.num_paths; i++) memcpy(&traces[i], obs.traces + i, sizeof(Complex));
+      this->obs.traces = nullptr;
+    }
+  };
+
+  /**
+     Lagrange interpolation through the (up to three) most recent
+     measurements onto flow time t
+  */
+  template <typename F> auto flowInterpolate(const std::deque<FlowMeasurement> &m, double t, F &&f)
+  {
+    decltype(f(m[0])) y = 0.0;
+    for (auto i = 0u; i < m.size(); i++) {
+      double w = 1.0;
+      for (auto j = 0u; j < m.size(); j++)
+        if (j != i) w *= (t - m[j].t) / (m[i].t - m[j].t);
+      y += w * f(m[i]);
+    }
+    return y;
+  }
+
+  void flowInterpolate(QudaGaugeObservableParam &obs, const std::deque<FlowMeasurement> &m, double t)
+  {
+    for (int i = 0; i < 3; i++) {
+      obs.plaquette[i] = flowInterpolate(m, t, [i](const FlowMeasurement &x) { return x.obs.plaquette[i]; });
+      obs.energy[i] = flowInterpolate(m, t, [i](const FlowMeasurement &x) { return x.obs.energy[i]; });
+    }
+    for (int i = 0; i < 2; i++)
+      obs.ploop[i] = flowInterpolate(m, t, [i](const FlowMeasurement &x) { return x.obs.ploop[i]; });
+    obs.qcharge = flowInterpolate(m, t, [](const FlowMeasurement &x) { return x.obs.qcharge; });
+    if (obs.compute_gauge_loop_trace) {
+      for (int i = 0; i < obs.num_paths; i++) {
+        Complex trace = flowInterpolate(m, t, [i](const FlowMeasurement &x) { return x.traces[i]; });
+        memcpy(obs.traces + i, &trace, sizeof(Complex));
+      }
+    }
+  }
+
+} // namespace
+
+/**
+   Adaptive step-size flow: each step forms the embedded second-order
+   solution alongside the third-order one, and the step size is
+   controlled on the distance between them.  Observables are measured
+   after each accepted step and interpolated onto the requested flow
+   times meas_interval * epsilon.
+*/
+static void performWFlowAdaptive(QudaGaugeSmearParam *smear_param, QudaGaugeObservableParam *obs_param,
+                                 GaugeField &in, GaugeField &out, GaugeField &temp)
+{
+  for (unsigned int k = 0; k <= smear_param->n_steps / smear_param->meas_interval; k++)
+    if (obs_param[k].compute_qcharge_density)
+      errorQuda("Charge density not supported with the adaptive step-size flow");
+
+  GaugeFieldParam gParamEx(in);
+  GaugeField emb(gParamEx);
+  GaugeField save(gParamEx);
+
+  const double tol = smear_param->adaptive_tol;
+  const double t_end = smear_param->n_steps * smear_param->epsilon;
+  const double dt_meas = smear_param->meas_interval * smear_param->epsilon;
+  const unsigned int n_meas = smear_param->n_steps / smear_param->meas_interval;
+
+  // measurements along the trajectory use the flags of the initial measurement
+  std::deque<FlowMeasurement> history;
+  history.emplace_back(0.0, obs_param[0]);
+  std::vector<Complex> traces(obs_param[0].num_paths);
+
+  double t = 0.0;
+  double h = smear_param->epsilon;
+  const double h_min = 1e-6 * smear_param->epsilon;
+  unsigned int measurement_n = 1;
+  int steps = 0;
+  int rejected = 0;
+
+  while (t < t_end) {
+    double h_step = std::min(h, t_end - t);
+    save.copy(in);
+    double distance = WFlowStepEmbedded(out, temp, in, emb, h_step, smear_param->smear_type);
+
+    // standard controller for a scheme with local error O(h^3), a
+    // non-finite error (e.g., from a NaN) is treated as a maximal rejection
+    const bool finite = std::isfinite(distance);
+    double scale = !finite ? 0.2 : distance > 0.0 ? 0.95 * std::cbrt(tol / distance) : 5.0;
+    h = h_step * std::min(5.0, std::max(0.2, scale));
+
+    if (!finite || distance > tol) {
+      if (h < h_min)
+        errorQuda("Adaptive flow step size %e at t = %e fell below the minimum %e (error %e, %d rejected steps)", h, t,
+                  h_min, distance, rejected + 1);
+      logQuda(QUDA_VERBOSE, "t = %e: rejected step %e with error %e, retrying with %e\n", t, h_step, distance, h);
+      rejected++;
+      in.copy(save);
+      in.exchangeExtendedGhost(in.R(), false);
+      continue;
+    }
+
+    t = (t_end - t <= h_step) ? t_end : t + h_step;
+    steps++;
+    std::swap(in, out); // accepted solution becomes input for next step
+    logQuda(QUDA_DEBUG_VERBOSE, "t = %e: accepted step %e with error %e\n", t, h_step, distance);
+
+    QudaGaugeObservableParam obs = obs_param[0];
+    obs.traces = reinterpret_cast<decltype(obs.traces)>(traces.data());
+    gaugeObservables(in, obs);
+    history.emplace_back(t, obs);
+    if (history.size() > 3) history.pop_front();
+
+    for (; measurement_n <= n_meas && measurement_n * dt_meas <= t * (1.0 + 1e-12); measurement_n++) {
+      double t_meas = measurement_n * dt_meas;
+      auto &obs_n = obs_param[measurement_n];
+      flowInterpolate(obs_n, history, t_meas);
+      logQuda(QUDA_SUMMARIZE, "%le %.16e %+.16e %+.16e %+.16e %+.16e\n", t_meas, obs_n.plaquette[0], obs_n.energy[0],
+              obs_n.energy[1], obs_n.energy[2], obs_n.qcharge);
+    }
+  }
+
+  logQuda(QUDA_SUMMARIZE, "Adaptive flow to t = %e took %d steps (%d rejected), versus %u fixed steps\n", t, steps,
+          rejected, smear_param->n_steps);
+  smear_param->adaptive_steps = steps;
+  smear_param->adaptive_rejected = rejected;
+}
+
 void performWFlowQuda(QudaGaugeSmearParam *smear_param, QudaGaugeObservableParam *obs_param)
 {
   auto profile = pushProfile(profileWFlow);
@@ -5147,6 +5462,12 @@ void performWFlowQuda(QudaGaugeSmearParam *smear_param, QudaGaugeObservableParam
   logQuda(QUDA_SUMMARIZE, "%le %.16e %+.16e %+.16e %+.16e %+.16e\n", 0.0, obs_param[0].plaquette[0],
           obs_param[0].energy[0], obs_param[0].energy[1], obs_param[0].energy[2], obs_param[0].qcharge);
 
+  if (smear_param->adaptive_tol > 0.0) {
+    performWFlowAdaptive(smear_param, obs_param, in, out, gaugeTemp);
+    popOutputPrefix();
+    return;
+  }
+
   for (unsigned int i = 0; i < smear_param->n_steps; i++) {
     // Perform W1, W2, and Vt Wilson Flow steps as defined in
     // https://arxiv.org/abs/1006.4518v3
@@ -5230,7 +5551,15 @@ int computeGaugeFixingFFTQuda(void *gauge, const unsigned int gauge_dir, const u
   cudaInGauge.copy(cpuGauge);
 
   // perform the update
-  gaugeFixingFFT(cudaInGauge, gauge_dir, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+  if (comm_partitioned()) {
+    // the distributed transform needs the halo of the gauge transformation
+    GaugeField *cudaInGaugeEx = createExtendedGauge(cudaInGauge, R, GaugeFixFFTQuda);
+    gaugeFixingFFT(*cudaInGaugeEx, gauge_dir, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+    copyExtendedGauge(cudaInGauge, *cudaInGaugeEx, QUDA_CUDA_FIELD_LOCATION);
+    delete cudaInGaugeEx;
+  } else {
+    gaugeFixingFFT(cudaInGauge, gauge_dir, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+  }
 
   // copy the gauge field back to the host
   cpuGauge.copy(cudaInGauge);
@@ -5286,6 +5615,43 @@ void contractQuda(const void *hp_x, const void *hp_y, void *h_result, const Quda
   pool_device_free(d_result);
 }
 
+void contractSummedQuda(const void *hp_x, const void *hp_y, double *h_result, const QudaContractType cType,
+                        const int *mom, int n_mom, QudaInvertParam *param, const int *X)
+{
+  auto profile = pushProfile(profileContract);
+
+  // wrap CPU host side pointers
+  lat_dim_t X_ = {X[0], X[1], X[2], X[3]};
+  ColorSpinorParam cpuParam((void *)hp_x, *param, X_, false, param->input_location);
+  ColorSpinorField h_x(cpuParam);
+
+  cpuParam.v = (void *)hp_y;
+  ColorSpinorField h_y(cpuParam);
+
+  // Create device parameter
+  ColorSpinorParam cudaParam(cpuParam);
+  cudaParam.location = QUDA_CUDA_FIELD_LOCATION;
+  cudaParam.create = QUDA_NULL_FIELD_CREATE;
+  // Quda uses Degrand-Rossi gamma basis for contractions and will
+  // automatically reorder data if necessary.
+  cudaParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  cudaParam.setPrecision(cpuParam.Precision(), cpuParam.Precision(), true);
+
+  ColorSpinorField x(cudaParam);
+  ColorSpinorField y(cudaParam);
+  x = h_x;
+  y = h_y;
+
+  std::vector<array<int, 3>> mom_v(n_mom);
+  for (int i = 0; i < n_mom; i++)
+    for (int d = 0; d < 3; d++) mom_v[i][d] = mom[3 * i + d];
+
+  std::vector<Complex> result;
+  contractSummedQuda(x, y, result, cType, mom_v);
+
+  memcpy(h_result, result.data(), result.size() * sizeof(Complex));
+}
+
 void gaugeObservablesQuda(QudaGaugeObservableParam *param)
 {
   auto profile = pushProfile(profileGaugeObs);
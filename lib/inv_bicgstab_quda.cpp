@@ -80,7 +80,8 @@ namespace quda {
 
     if (param.deflate) {
       // Construct the eigensolver and deflation space if requested.
-      if (param.eig_param.eig_type == QUDA_EIG_TR_LANCZOS || param.eig_param.eig_type == QUDA_EIG_BLK_TR_LANCZOS) {
+      if (param.eig_param.eig_type == QUDA_EIG_TR_LANCZOS || param.eig_param.eig_type == QUDA_EIG_BLK_TR_LANCZOS
+          || param.eig_param.eig_type == QUDA_EIG_CHFSI) {
         constructDeflationSpace(b, matMdagM);
       } else {
         // Use Arnoldi to inspect the space only and turn off deflation
@@ -101,8 +102,7 @@ namespace quda {
         deflate_compute = false;
       }
       if (recompute_evals) {
-        eig_solve->computeEvals(evecs, evals);
-        eig_solve->computeSVD(evecs, evals);
+        recomputeSVD();
         recompute_evals = false;
       }
     }
@@ -120,7 +120,7 @@ namespace quda {
 
     if (param.deflate && param.maxiter > 1) {
       // Deflate: Hardcoded to SVD. If maxiter == 1, this is a dummy solve
-      eig_solve->deflateSVD(x, r, evecs, evals, true);
+      deflateSVD(x, r, true);
 
       // Compute r_defl = RHS - A * LHS
       mat(r, x);
@@ -401,7 +401,7 @@ namespace quda
   {
     if (param.is_preconditioner) commGlobalReductionPush(param.global_reduction);
 
-    const int n_krylov = param.Nkrylov;
+    int n_krylov = param.Nkrylov;
 
     if (param.maxiter == 0 || n_krylov == 0) {
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
@@ -428,7 +428,7 @@ namespace quda
         deflate_compute = false;
       }
       if (recompute_evals) {
-        eig_solve->computeEvals(evecs, evals);
+        recomputeEvals();
         recompute_evals = false;
       }
     }
@@ -451,7 +451,7 @@ namespace quda
 
     if (param.deflate && param.maxiter > 1) {
       // Deflate and add solution to accumulator
-      eig_solve->deflate(x, r, evecs, evals, true);
+      deflate(x, r, true);
 
       mat(r, x);
       if (!fixed_iteration) {
@@ -472,12 +472,28 @@ namespace quda
         profile.TPSTART(QUDA_PROFILE_INIT);
       }
 
-      // Perform 100 power iterations, normalizing every 10 mat-vecs, using r as an initial seed
-      // and Q[0]/AQ[0] as temporaries for the power iterations
-      lambda_max = 1.1 * Solver::performPowerIterations(matSloppy, r, Q[0], AQ[0], 100, 10);
-      logQuda(QUDA_SUMMARIZE, "CA-CG Approximate lambda max = 1.1 x %e\n", lambda_max / 1.1);
+      if (param.ca_adaptive) {
+        // Estimate both ends of the spectrum from a short Lanczos run seeded with r, using
+        // the basis vectors as the workspace (S[0] is skipped since r aliases it if uni-precision)
+        double lambda_min_, lambda_max_;
+        vector_ref<ColorSpinorField> work {S.begin() + 1, S.end()};
+        for (auto v : {&AS, &Q, &AQ, &Qtmp})
+          for (auto &vi : *v) work.push_back(vi);
+        if (Solver::estimateSpectrumBounds(matSloppy, r, work, lambda_min_, lambda_max_)) {
+          lambda_min = std::max(lambda_min_, 0.0);
+          lambda_max = 1.1 * lambda_max_;
+          logQuda(QUDA_SUMMARIZE, "CA-CG Approximate lambda min = %e, lambda max = 1.1 x %e\n", lambda_min,
+                  lambda_max / 1.1);
+          lambda_init = true;
+        }
+      } else {
+        // Perform 100 power iterations, normalizing every 10 mat-vecs, using r as an initial seed
+        // and Q[0]/AQ[0] as temporaries for the power iterations
+        lambda_max = 1.1 * Solver::performPowerIterations(matSloppy, r, Q[0], AQ[0], 100, 10);
+        logQuda(QUDA_SUMMARIZE, "CA-CG Approximate lambda max = 1.1 x %e\n", lambda_max / 1.1);
 
-      lambda_init = true;
+        lambda_init = true;
+      }
 
       if (!param.is_preconditioner) {
         profile.TPSTOP(QUDA_PROFILE_INIT);
@@ -535,11 +551,37 @@ namespace quda
 
     blas::copy(S[0], r); // no op if uni-precision
 
+    // set when the basis selection below has already built the first Krylov space
+    bool krylov_space_built = false;
+
+    if (param.ca_adaptive && !fixed_iteration && !basis_size_init && n_krylov > 1 && r2 > 0.0) {
+      // build the full basis once from the initial residual and keep the largest stable leading block
+      computeCAKrylovSpace(matSloppy, AS, S, n_krylov, basis, m_map, b_map);
+      int s = Solver::selectCABasisSize(S, n_krylov, 1.0 / sqrt(precisionEpsilon(param.precision_sloppy)));
+      logQuda(QUDA_SUMMARIZE, "CA-CG adaptive basis size = %d (maximum %d)\n", s, n_krylov);
+
+      if (s < n_krylov) {
+        Q_AQandg.resize(s * (s + 1));
+        Q_AS.resize(s * s);
+        alpha.resize(s);
+        beta.resize(s * s);
+        AS.resize(s);
+        Q.resize(s);
+        AQ.resize(s);
+        Qtmp.resize(s);
+        S.resize(s);
+        n_krylov = param.Nkrylov = s;
+      }
+      basis_size_init = true;
+      krylov_space_built = true; // the leading s vectors of the basis do not depend on its size
+    }
+
     PrintStats("CA-CG", total_iter, r2, b2, heavy_quark_res);
     while (!convergence(r2, heavy_quark_res, stop, param.tol_hq) && total_iter < param.maxiter) {
 
       // build up a space of size n_krylov, assumes S[0] is in place
-      computeCAKrylovSpace(matSloppy, AS, S, n_krylov, basis, m_map, b_map);
+      if (!krylov_space_built) computeCAKrylovSpace(matSloppy, AS, S, n_krylov, basis, m_map, b_map);
+      krylov_space_built = false;
 
       // we can greatly simplify the workflow for fixed iterations
       if (!fixed_iteration) {
@@ -619,7 +661,7 @@ namespace quda
 
         if (param.deflate && sqrt(r2) < maxr_deflate * param.tol_restart) {
           // Deflate and add solution to accumulator
-          eig_solve->deflate(x, r, evecs, evals, true);
+          deflate(x, r, true);
 
           // Compute r_defl = RHS - A * LHS
           mat(r, x);
@@ -131,7 +131,7 @@ namespace quda
   */
   void CAGCR::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
-    const int n_krylov = param.Nkrylov;
+    int n_krylov = param.Nkrylov;
 
     if (param.maxiter == 0 || n_krylov == 0) {
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
@@ -149,7 +149,8 @@ namespace quda
 
     if (param.deflate) {
       // Construct the eigensolver and deflation space if requested.
-      if (param.eig_param.eig_type == QUDA_EIG_TR_LANCZOS || param.eig_param.eig_type == QUDA_EIG_BLK_TR_LANCZOS) {
+      if (param.eig_param.eig_type == QUDA_EIG_TR_LANCZOS || param.eig_param.eig_type == QUDA_EIG_BLK_TR_LANCZOS
+          || param.eig_param.eig_type == QUDA_EIG_CHFSI) {
         constructDeflationSpace(b, matMdagM);
       } else {
         // Use Arnoldi to inspect the space only and turn off deflation
@@ -170,8 +171,7 @@ namespace quda
         deflate_compute = false;
       }
       if (recompute_evals) {
-        eig_solve->computeEvals(evecs, evals);
-        eig_solve->computeSVD(evecs, evals);
+        recomputeSVD();
         recompute_evals = false;
       }
     }
@@ -194,7 +194,7 @@ namespace quda
 
     if (param.deflate && param.maxiter > 1) {
       // Deflate: Hardcoded to SVD. If maxiter == 1, this is a dummy solve
-      eig_solve->deflateSVD(x, r, evecs, evals, true);
+      deflateSVD(x, r, true);
 
       // Compute r_defl = RHS - A * LHS
       mat(r, x);
@@ -216,12 +216,27 @@ namespace quda
         profile.TPSTART(QUDA_PROFILE_INIT);
       }
 
-      // Perform 100 power iterations, normalizing every 10 mat-vecs, using r_ as an initial seed
-      // and q[0]/q[1] as temporaries for the power iterations. Technically illegal if n_krylov == 1, but in that case lambda_max isn't used anyway.
-      lambda_max = 1.1 * Solver::performPowerIterations(matSloppy, r, q[0], q[1], 100, 10);
-      logQuda(QUDA_SUMMARIZE, "CA-GCR Approximate lambda max = 1.1 x %e\n", lambda_max / 1.1);
+      if (param.ca_adaptive) {
+        // Estimate both ends of the spectrum from a short Arnoldi run seeded with r, using
+        // the basis vectors as the workspace (p[0] is skipped since r aliases it if uni-precision)
+        double lambda_min_, lambda_max_;
+        vector_ref<ColorSpinorField> work {p.begin() + 1, p.end()};
+        for (auto &qi : q) work.push_back(qi);
+        if (Solver::estimateSpectrumBounds(matSloppy, r, work, lambda_min_, lambda_max_)) {
+          lambda_min = std::max(lambda_min_, 0.0);
+          lambda_max = 1.1 * lambda_max_;
+          logQuda(QUDA_SUMMARIZE, "CA-GCR Approximate lambda min = %e, lambda max = 1.1 x %e\n", lambda_min,
+                  lambda_max / 1.1);
+          lambda_init = true;
+        }
+      } else {
+        // Perform 100 power iterations, normalizing every 10 mat-vecs, using r_ as an initial seed
+        // and q[0]/q[1] as temporaries for the power iterations. Technically illegal if n_krylov == 1, but in that case lambda_max isn't used anyway.
+        lambda_max = 1.1 * Solver::performPowerIterations(matSloppy, r, q[0], q[1], 100, 10);
+        logQuda(QUDA_SUMMARIZE, "CA-GCR Approximate lambda max = 1.1 x %e\n", lambda_max / 1.1);
 
-      lambda_init = true;
+        lambda_init = true;
+      }
 
       if (!param.is_preconditioner) {
         profile.TPSTOP(QUDA_PROFILE_INIT);
@@ -233,6 +248,26 @@ namespace quda
     double m_map = 2. / (lambda_max - lambda_min);
     double b_map = -(lambda_max + lambda_min) / (lambda_max - lambda_min);
 
+    // set when the basis selection below has already built the first Krylov space
+    bool krylov_space_built = false;
+
+    if (param.ca_adaptive && !fixed_iteration && !basis_size_init && n_krylov > 1 && r2 > 0.0) {
+      // build the full basis once from the initial residual and keep the largest stable leading block
+      blas::copy(p[0], r); // no op if uni-precision
+      computeCAKrylovSpace(matSloppy, q, p, n_krylov, basis, m_map, b_map);
+      int s = Solver::selectCABasisSize(q, n_krylov, 1.0 / sqrt(precisionEpsilon(param.precision_sloppy)));
+      logQuda(QUDA_SUMMARIZE, "CA-GCR adaptive basis size = %d (maximum %d)\n", s, n_krylov);
+
+      if (s < n_krylov) {
+        alpha.resize(s);
+        p.resize(basis == QUDA_POWER_BASIS ? s + 1 : s);
+        q.resize(s);
+        n_krylov = param.Nkrylov = s;
+      }
+      basis_size_init = true;
+      krylov_space_built = true; // the leading s vectors of the basis do not depend on its size
+    }
+
     // Check to see that we're not trying to invert on a zero-field source
     if (b2 == 0) {
       if (param.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_NO) {
@@ -278,7 +313,8 @@ namespace quda
     while (!convergence(r2, heavy_quark_res, stop, param.tol_hq) && total_iter < param.maxiter) {
 
       // build up a space of size n_krylov
-      computeCAKrylovSpace(matSloppy, q, p, n_krylov, basis, m_map, b_map);
+      if (!krylov_space_built) computeCAKrylovSpace(matSloppy, q, p, n_krylov, basis, m_map, b_map);
+      krylov_space_built = false;
 
       solve(alpha, q, p[0]);
 
@@ -311,7 +347,7 @@ namespace quda
 
         if (param.deflate && sqrt(r2) < maxr_deflate * param.tol_restart) {
           // Deflate and accumulate to solution vector
-          eig_solve->deflateSVD(x, r, evecs, evals, true);
+          deflateSVD(x, r, true);
 
           // Compute r_defl = RHS - A * LHS
           mat(r, x);
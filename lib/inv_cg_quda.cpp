@@ -293,7 +293,7 @@ namespace quda {
         deflate_compute = false;
       }
       if (recompute_evals) {
-        eig_solve->computeEvals(evecs, evals);
+        recomputeEvals();
         recompute_evals = false;
       }
     }
@@ -334,7 +334,7 @@ namespace quda {
 
     if (param.deflate && param.maxiter > 1) {
       // Deflate and accumulate to solution vector
-      eig_solve->deflate(y, r, evecs, evals, true);
+      deflate(y, r, true);
       mat(r, y);
       r2 = blas::xmyNorm(b, r);
     }
@@ -476,27 +476,25 @@ namespace quda {
         if (advanced_feature) { ru.accumulate_norm(x_update_batch.get_current_alpha()); }
       } else {
 
-        x_update_batch.accumulate_x(xSloppy);
+        // y += xSloppy + sum_i alpha_i p_i in a single pass
+        x_update_batch.accumulate_x(y, xSloppy);
         x_update_batch.reset_next();
 
-        blas::copy(x, xSloppy); // nop when these pointers alias
-
-        blas::xpy(x, y); // swap these around?
-        mat(r, y);       //  here we can use x as tmp
-        r2 = blas::xmyNorm(b, r);
+        // r = b - A y, its norm and the sloppy copy of r in a single pass
+        mat(r, y);
+        r2 = blas::xmyNormCopy(b, r, rSloppy);
 
         if (param.deflate && sqrt(r2) < ru.maxr_deflate * param.tol_restart) {
           // Deflate and accumulate to solution vector
-          eig_solve->deflate(y, r, evecs, evals, true);
+          deflate(y, r, true);
 
           // Compute r_defl = RHS - A * LHS
           mat(r, y);
-          r2 = blas::xmyNorm(b, r);
+          r2 = blas::xmyNormCopy(b, r, rSloppy);
 
           ru.update_maxr_deflate(r2);
         }
 
-        blas::copy(rSloppy, r); //nop when these pointers alias
         blas::zero(xSloppy);
 
         if (advanced_feature) { ru.update_norm(r2, y); }
@@ -191,7 +191,8 @@ namespace quda {
     profile.TPSTART(QUDA_PROFILE_INIT);
     if (param.deflate) {
       // Construct the eigensolver and deflation space if requested.
-      if (param.eig_param.eig_type == QUDA_EIG_TR_LANCZOS || param.eig_param.eig_type == QUDA_EIG_BLK_TR_LANCZOS) {
+      if (param.eig_param.eig_type == QUDA_EIG_TR_LANCZOS || param.eig_param.eig_type == QUDA_EIG_BLK_TR_LANCZOS
+          || param.eig_param.eig_type == QUDA_EIG_CHFSI) {
         constructDeflationSpace(b, matMdagM);
       } else {
         // Use Arnoldi to inspect the space only and turn off deflation
@@ -212,8 +213,7 @@ namespace quda {
         deflate_compute = false;
       }
       if (recompute_evals) {
-        eig_solve->computeEvals(evecs, evals);
-        eig_solve->computeSVD(evecs, evals);
+        recomputeSVD();
         recompute_evals = false;
       }
     }
@@ -235,7 +235,7 @@ namespace quda {
 
     if (param.deflate && param.maxiter > 1) {
       // Deflate: Hardcoded to SVD. If maxiter == 1, this is a dummy solve
-      eig_solve->deflateSVD(x, r, evecs, evals, true);
+      deflateSVD(x, r, true);
 
       // Compute r_defl = RHS - A * LHS
       mat(r, x);
@@ -337,7 +337,7 @@ namespace quda {
 
         if (param.deflate && sqrt(r2) < maxr_deflate * param.tol_restart) {
           // Deflate: Hardcoded to SVD.
-          eig_solve->deflateSVD(x, r, evecs, evals, true);
+          deflateSVD(x, r, true);
 
           // Compute r_defl = RHS - A * LHS
           mat(r, x);
@@ -490,4 +490,417 @@ namespace quda {
     popOutputPrefix();
   }
 
+  MultiShiftMultiSrcCG::MultiShiftMultiSrcCG(const DiracMatrix &mat, const DiracMatrix &matSloppy,
+                                             SolverParam &param, TimeProfile &profile) :
+    MultiShiftSolver(mat, matSloppy, param, profile)
+  {
+  }
+
+  void MultiShiftMultiSrcCG::updateInvertParam(QudaInvertParam &inv_param, int src) const
+  {
+    if (src < 0 || src >= static_cast<int>(true_res.size())) errorQuda("Invalid source index %d", src);
+    for (int i = 0; i < num_offset; i++) {
+      inv_param.true_res_offset[i] = true_res[src][i];
+      inv_param.iter_res_offset[i] = iter_res[src][i];
+      inv_param.true_res_hq_offset[i] = true_res_hq[src][i];
+    }
+  }
+
+  void MultiShiftMultiSrcCG::operator()(std::vector<std::vector<ColorSpinorField>> &x,
+                                        std::vector<ColorSpinorField> &b,
+                                        std::vector<std::vector<ColorSpinorField>> &p,
+                                        std::vector<std::vector<double>> &r2_old_array)
+  {
+    pushOutputPrefix("MultiShiftMultiSrcCG: ");
+
+    const int n_src = b.size();
+    num_offset = param.num_offset;
+    if (static_cast<int>(x.size()) != n_src) errorQuda("Number of solutions %lu != number of sources %d", x.size(), n_src);
+
+    true_res.assign(n_src, std::vector<double>(num_offset, 0.0));
+    iter_res.assign(n_src, std::vector<double>(num_offset, 0.0));
+    true_res_hq.assign(n_src, std::vector<double>(num_offset, 0.0));
+
+    if (num_offset == 0 || n_src == 0) {
+      popOutputPrefix();
+      return;
+    }
+
+    profile.TPSTART(QUDA_PROFILE_INIT);
+
+    for (int s = 0; s < n_src; s++) {
+      if (static_cast<int>(x[s].size()) < num_offset)
+        errorQuda("Source %d has %lu solutions, expected %d", s, x[s].size(), num_offset);
+      MultiShiftSolver::create(x[s], b[s]);
+    }
+
+    double *offset = param.offset;
+
+    bool reliable = false;
+    for (int j = 0; j < num_offset; j++)
+      if (param.tol_offset[j] < param.delta) reliable = true;
+
+    const bool mixed = param.precision_sloppy != param.precision;
+    const bool group_update = mixed && param.use_sloppy_partial_accumulator;
+
+    // whether we will switch to refinement on unshifted system after other shifts have converged
+    const bool zero_refinement = param.precision_refinement_sloppy != param.precision;
+
+    std::vector<ColorSpinorField> r(n_src);
+    std::vector<ColorSpinorField> r_sloppy(n_src);
+    std::vector<ColorSpinorField> Ap(n_src);
+    std::vector<std::vector<ColorSpinorField>> x_sloppy(n_src);
+    p.resize(n_src);
+    r2_old_array.resize(n_src);
+
+    for (int s = 0; s < n_src; s++) {
+      r[s] = b[s];
+
+      ColorSpinorParam csParam(b[s]);
+      csParam.create = QUDA_NULL_FIELD_CREATE;
+      if (group_update) csParam.setPrecision(param.precision_sloppy);
+
+      x_sloppy[s].resize(num_offset);
+      for (int i = 0; i < num_offset; i++) {
+        x_sloppy[s][i] = group_update ? ColorSpinorField(csParam) : x[s][i].create_alias(csParam);
+        blas::zero(x_sloppy[s][i]);
+      }
+
+      csParam.setPrecision(param.precision_sloppy);
+      csParam.field = &r[s];
+      csParam.create = QUDA_COPY_FIELD_CREATE;
+      r_sloppy[s] = mixed ? ColorSpinorField(csParam) : r[s].create_alias(csParam);
+
+      p[s].resize(num_offset);
+      for (auto &pi : p[s]) pi = r_sloppy[s];
+
+      csParam.create = QUDA_NULL_FIELD_CREATE;
+      Ap[s] = ColorSpinorField(csParam);
+
+      r2_old_array[s].resize(num_offset);
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+    profile.TPSTART(QUDA_PROFILE_PREAMBLE);
+
+    // this is the limit of precision possible
+    const double sloppy_tol = param.precision_sloppy == 8 ?
+      std::numeric_limits<double>::epsilon() :
+      ((param.precision_sloppy == 4) ? std::numeric_limits<float>::epsilon() : pow(2., -17));
+    const double fine_tol = pow(10., (-2 * (int)b[0].Precision() + 1));
+    std::vector<double> prec_tol(num_offset);
+
+    prec_tol[0] = mixed ? sloppy_tol : fine_tol;
+    for (int i = 1; i < num_offset; i++) {
+      prec_tol[i] = std::min(sloppy_tol, std::max(fine_tol, sqrt(param.tol_offset[i] * sloppy_tol)));
+    }
+
+    // per-source iteration state, where j_low is always the unshifted system
+    const int j_low = 0;
+    std::vector<std::vector<double>> zeta(n_src, std::vector<double>(num_offset, 1.0));
+    std::vector<std::vector<double>> zeta_old(n_src, std::vector<double>(num_offset, 1.0));
+    std::vector<std::vector<double>> alpha(n_src, std::vector<double>(num_offset, 1.0));
+    std::vector<std::vector<double>> beta(n_src, std::vector<double>(num_offset, 0.0));
+
+    std::vector<double> b2(n_src);
+    std::vector<std::vector<double>> r2(n_src);
+    std::vector<std::vector<double>> stop(n_src, std::vector<double>(num_offset));
+    std::vector<std::vector<int>> iter(n_src, std::vector<int>(num_offset + 1, 0));
+    std::vector<std::vector<double>> rNorm(n_src), r0Norm(n_src), maxrx(n_src), maxrr(n_src);
+    std::vector<std::vector<int>> resIncreaseTotal(n_src, std::vector<int>(num_offset, 0));
+    std::vector<int> resIncrease(n_src, 0);
+    std::vector<int> num_offset_now(n_src, num_offset);
+    std::vector<int> k_src(n_src, 0);
+    std::vector<bool> exit_early(n_src, false);
+    std::vector<bool> done(n_src, false);
+
+    const int maxResIncrease = param.max_res_increase;
+    const int maxResIncreaseTotal = param.max_res_increase_total;
+    const double delta = param.delta;
+
+    for (int s = 0; s < n_src; s++) {
+      b2[s] = blas::norm2(b[s]);
+      r2[s].assign(num_offset, b2[s]);
+      for (int i = 0; i < num_offset; i++)
+        stop[s][i] = Solver::stopping(param.tol_offset[i], b2[s], param.residual_type);
+      iter[s][num_offset] = 1; // this initial condition ensures that the heaviest shift can be removed
+
+      rNorm[s].resize(num_offset);
+      for (int i = 0; i < num_offset; i++) rNorm[s][i] = sqrt(r2[s][i]);
+      r0Norm[s] = rNorm[s];
+      maxrx[s] = rNorm[s];
+      maxrr[s] = rNorm[s];
+
+      // Check to see that we're not trying to invert on a zero-field source
+      if (b2[s] == 0) {
+        warningQuda("inverting on zero-field source %d", s);
+        for (int i = 0; i < num_offset; i++) blas::zero(x[s][i]);
+        done[s] = true;
+      }
+    }
+
+    int k = 0;
+    int rUpdate = 0; // number of iterations with a reliable update on any source
+    std::vector<int> rUpdate_src(n_src, 0);
+
+    profile.TPSTOP(QUDA_PROFILE_PREAMBLE);
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    while (k < param.maxiter) {
+      std::vector<int> active;
+      for (int s = 0; s < n_src; s++)
+        if (!done[s]) active.push_back(s);
+      if (active.empty()) break;
+
+      // apply the operator to the unshifted search direction of every active source at once
+      {
+        vector_ref<ColorSpinorField> Ap_set;
+        vector_ref<const ColorSpinorField> p_set;
+        for (auto s : active) {
+          Ap_set.push_back(Ap[s]);
+          p_set.push_back(p[s][0]);
+        }
+        matSloppy(Ap_set, p_set);
+      }
+
+      std::vector<int> update; // sources that require a reliable update this iteration
+      std::vector<double> r2_old(n_src);
+
+      for (auto s : active) {
+        // at some point we should curry these into the Dirac operator
+        double pAp = r[s].Nspin() == 4 ? blas::axpyReDot(offset[0], p[s][0], Ap[s]) : blas::reDotProduct(p[s][0], Ap[s]);
+
+        // compute zeta and alpha
+        for (int j = 1; j < num_offset_now[s]; j++) r2_old_array[s][j] = zeta[s][j] * zeta[s][j] * r2[s][0];
+        updateAlphaZeta(alpha[s], zeta[s], zeta_old[s], r2[s], beta[s], pAp, offset, num_offset_now[s], j_low);
+
+        r2_old[s] = r2[s][0];
+        r2_old_array[s][0] = r2_old[s];
+
+        auto cg_norm = blas::axpyCGNorm(-alpha[s][j_low], Ap[s], r_sloppy[s]);
+        r2[s][0] = cg_norm.x;
+        double zn = cg_norm.y;
+
+        // reliable update conditions, which as for the single source solver are set by shift 0
+        rNorm[s][0] = sqrt(r2[s][0]);
+        for (int j = 1; j < num_offset_now[s]; j++) rNorm[s][j] = rNorm[s][0] * zeta[s][j];
+
+        if (rNorm[s][0] > maxrx[s][0]) maxrx[s][0] = rNorm[s][0];
+        if (rNorm[s][0] > maxrr[s][0]) maxrr[s][0] = rNorm[s][0];
+        bool updateX = (rNorm[s][0] < delta * r0Norm[s][0] && r0Norm[s][0] <= maxrx[s][0]);
+        bool updateR = ((rNorm[s][0] < delta * maxrr[s][0] && r0Norm[s][0] <= maxrr[s][0]) || updateX);
+
+        if (!(updateR || updateX) || !reliable) {
+          beta[s][0] = zn / r2_old[s];
+          // update p[0] and x[0]
+          blas::axpyZpbx(alpha[s][0], p[s][0], x_sloppy[s][0], r_sloppy[s], beta[s][0]);
+
+          // the shifted updates are applied directly since there is
+          // no single dslash to overlap with
+          const int n = num_offset_now[s];
+          for (int j = 1; j < n; j++)
+            beta[s][j] = beta[s][j_low] * zeta[s][j] * alpha[s][j] / (zeta_old[s][j] * alpha[s][j_low]);
+          if (n > 1)
+            blas::axpyBzpcx({alpha[s].begin() + 1, alpha[s].begin() + n}, {p[s].begin() + 1, p[s].begin() + n},
+                            {x_sloppy[s].begin() + 1, x_sloppy[s].begin() + n}, {zeta[s].begin() + 1, zeta[s].begin() + n},
+                            r_sloppy[s], {beta[s].begin() + 1, beta[s].begin() + n});
+        } else {
+          for (int j = 0; j < num_offset_now[s]; j++) {
+            blas::axpy(alpha[s][j], p[s][j], x_sloppy[s][j]);
+            if (group_update) {
+              if (rUpdate_src[s] == 0)
+                x[s][j] = x_sloppy[s][j];
+              else
+                blas::xpy(x_sloppy[s][j], x[s][j]);
+            }
+          }
+          update.push_back(s);
+        }
+      }
+
+      if (update.size() > 0) {
+        // the true residuals of all sources updating on this iteration are computed together
+        {
+          vector_ref<ColorSpinorField> r_set;
+          vector_ref<const ColorSpinorField> x_set;
+          for (auto s : update) {
+            r_set.push_back(r[s]);
+            x_set.push_back(x[s][0]);
+          }
+          mat(r_set, x_set);
+        }
+
+        for (auto s : update) {
+          if (r[s].Nspin() == 4) blas::axpy(offset[0], x[s][0], r[s]);
+
+          r2[s][0] = blas::xmyNorm(b[s], r[s]);
+          for (int j = 1; j < num_offset_now[s]; j++) r2[s][j] = zeta[s][j] * zeta[s][j] * r2[s][0];
+          for (int j = 0; j < num_offset_now[s]; j++)
+            if (group_update) blas::zero(x_sloppy[s][j]);
+
+          blas::copy(r_sloppy[s], r[s]);
+
+          // break-out check if we have reached the limit of the precision
+          if (sqrt(r2[s][0]) > r0Norm[s][0]) { // reuse r0Norm for this
+            resIncrease[s]++;
+            resIncreaseTotal[s][0]++;
+            warningQuda("Source %d, updated residual %e is greater than previous residual %e (total #inc %i)", s,
+                        sqrt(r2[s][0]), r0Norm[s][0], resIncreaseTotal[s][0]);
+
+            if (resIncrease[s] > maxResIncrease or resIncreaseTotal[s][0] > maxResIncreaseTotal) {
+              warningQuda("solver exiting on source %d due to too many true residual norm increases", s);
+              done[s] = true;
+            }
+          } else {
+            resIncrease[s] = 0;
+          }
+
+          // explicitly restore the orthogonality of the gradient vector
+          for (int j = 0; j < num_offset_now[s]; j++) {
+            Complex rp = blas::cDotProduct(r_sloppy[s], p[s][j]) / (r2[s][0]);
+            blas::caxpy(-rp, r_sloppy[s], p[s][j]);
+          }
+
+          // update beta and p
+          beta[s][0] = r2[s][0] / r2_old[s];
+          blas::xpay(r_sloppy[s], beta[s][0], p[s][0]);
+          for (int j = 1; j < num_offset_now[s]; j++) {
+            beta[s][j] = beta[s][j_low] * zeta[s][j] * alpha[s][j] / (zeta_old[s][j] * alpha[s][j_low]);
+            blas::axpby(zeta[s][j], r_sloppy[s], beta[s][j], p[s][j]);
+          }
+
+          // update reliable update parameters
+          rNorm[s][0] = sqrt(r2[s][0]);
+          maxrr[s][0] = rNorm[s][0];
+          maxrx[s][0] = rNorm[s][0];
+          r0Norm[s][0] = rNorm[s][0];
+          rUpdate_src[s]++;
+        }
+        rUpdate++;
+      }
+
+      k++;
+
+      for (auto s : active) {
+        k_src[s] = k;
+
+        // now we can check if any of the shifts have converged and remove them
+        int converged = 0;
+        for (int j = num_offset_now[s] - 1; j >= 1; j--) {
+          if (zeta[s][j] == 0.0 && (j + 1 == num_offset || r2[s][j + 1] < stop[s][j + 1])) {
+            converged++;
+            logQuda(QUDA_VERBOSE, "Source %d shift %d converged after %d iterations\n", s, j, k);
+          } else {
+            r2[s][j] = zeta[s][j] * zeta[s][j] * r2[s][0];
+            // only remove if shift above has converged
+            if ((r2[s][j] < stop[s][j] || sqrt(r2[s][j] / b2[s]) < prec_tol[j]) && iter[s][j + 1]) {
+              converged++;
+              iter[s][j] = k;
+              logQuda(QUDA_VERBOSE, "Source %d shift %d converged after %d iterations\n", s, j, k);
+            }
+          }
+        }
+        num_offset_now[s] -= converged;
+
+        // exit early so that we can finish of shift 0 using CG and allowing for mixed precison refinement
+        if ((mixed || zero_refinement) and param.compute_true_res and num_offset_now[s] == 1) {
+          exit_early[s] = true;
+          num_offset_now[s]--;
+        }
+
+        if (convergence(r2[s], stop[s], num_offset_now[s]) || exit_early[s]) {
+          for (int j = 0; j < num_offset_now[s]; j++) iter[s][j] = k;
+          done[s] = true;
+        }
+
+        logQuda(QUDA_VERBOSE, "%d iterations, source %d <r,r> = %e, |r|/|b| = %e\n", k, s, r2[s][0],
+                sqrt(r2[s][0] / b2[s]));
+      }
+    }
+
+    for (int s = 0; s < n_src; s++) {
+      for (int i = 0; i < num_offset; i++) {
+        if (iter[s][i] == 0) iter[s][i] = k_src[s];
+        if (group_update) blas::xpy(x_sloppy[s][i], x[s][i]);
+      }
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    profile.TPSTART(QUDA_PROFILE_EPILOGUE);
+
+    logQuda(QUDA_VERBOSE, "Reliable updates = %d\n", rUpdate);
+    if (k == param.maxiter) warningQuda("Exceeded maximum iterations %d\n", param.maxiter);
+
+    param.iter += k;
+
+    for (int s = 0; s < n_src; s++)
+      for (int i = 0; i < num_offset; i++) iter_res[s][i] = b2[s] > 0.0 ? sqrt(r2[s][i] / b2[s]) : 0.0;
+
+    if (param.compute_true_res) {
+      for (int i = 0; i < num_offset; i++) {
+        // only calculate true residual if we need to:
+        // 1.) For higher shifts if we did not use mixed precision
+        // 2.) For shift 0 if we did not exit early  (we went to the full solution)
+        std::vector<int> src;
+        for (int s = 0; s < n_src; s++) {
+          if (b2[s] == 0.0) continue;
+          if ((i > 0 and not mixed) or (i == 0 and not exit_early[s])) {
+            src.push_back(s);
+          } else {
+            true_res[s][i] = std::numeric_limits<double>::infinity();
+            true_res_hq[s][i] = std::numeric_limits<double>::infinity();
+          }
+        }
+        if (src.empty()) continue;
+
+        vector_ref<ColorSpinorField> r_set;
+        vector_ref<const ColorSpinorField> x_set;
+        for (auto s : src) {
+          r_set.push_back(r[s]);
+          x_set.push_back(x[s][i]);
+        }
+        mat(r_set, x_set);
+
+        for (auto s : src) {
+          if (r[s].Nspin() == 4) {
+            blas::axpy(offset[i], x[s][i], r[s]); // Offset it.
+          } else if (i != 0) {
+            blas::axpy(offset[i] - offset[0], x[s][i], r[s]); // Offset it.
+          }
+          double true_r2 = blas::xmyNorm(b[s], r[s]);
+          true_res[s][i] = sqrt(true_r2 / b2[s]);
+          true_res_hq[s][i] = sqrt(blas::HeavyQuarkResidualNorm(x[s][i], r[s]).z);
+        }
+      }
+    }
+
+    // param reports the worst residual over the sources
+    for (int i = 0; i < num_offset; i++) {
+      param.true_res_offset[i] = 0.0;
+      param.iter_res_offset[i] = 0.0;
+      param.true_res_hq_offset[i] = 0.0;
+      for (int s = 0; s < n_src; s++) {
+        param.true_res_offset[i] = std::max(param.true_res_offset[i], true_res[s][i]);
+        param.iter_res_offset[i] = std::max(param.iter_res_offset[i], iter_res[s][i]);
+        param.true_res_hq_offset[i] = std::max(param.true_res_hq_offset[i], true_res_hq[s][i]);
+      }
+    }
+
+    logQuda(QUDA_SUMMARIZE, "Converged %d sources after %d iterations\n", n_src, k);
+    for (int s = 0; s < n_src; s++) {
+      for (int i = 0; i < num_offset; i++) {
+        if (!param.compute_true_res || std::isinf(true_res[s][i])) {
+          logQuda(QUDA_SUMMARIZE, " source=%d, shift=%d, %d iterations, relative residual: iterated = %e\n", s, i,
+                  iter[s][i], iter_res[s][i]);
+        } else {
+          logQuda(QUDA_SUMMARIZE, " source=%d, shift=%d, %d iterations, relative residual: iterated = %e, true = %e\n",
+                  s, i, iter[s][i], iter_res[s][i], true_res[s][i]);
+        }
+      }
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
+    popOutputPrefix();
+  }
+
 } // namespace quda
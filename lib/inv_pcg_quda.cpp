@@ -134,7 +134,7 @@ namespace quda
         deflate_compute = false;
       }
       if (recompute_evals) {
-        eig_solve->computeEvals(evecs, evals);
+        recomputeEvals();
         recompute_evals = false;
       }
     }
@@ -165,7 +165,7 @@ namespace quda
 
     if (param.deflate && param.maxiter > 1) {
       // Deflate and accumulate to solution vector
-      eig_solve->deflate(y, r, evecs, evals, true);
+      deflate(y, r, true);
       mat(r, y);
       r2 = blas::xmyNorm(b, r);
     }
@@ -297,27 +297,25 @@ namespace quda
       } else { // reliable update
 
         // Now that we are performing reliable update, need to update x with the p's that have
-        // not been used yet
-        x_update_batch.accumulate_x(x_sloppy);
+        // not been used yet, fused with y += x
+        x_update_batch.accumulate_x(y, x_sloppy);
         x_update_batch.reset_next();
 
-        xpy(x_sloppy, y);          // y += x
-        // Now compute r
+        // Now compute r, its norm and its sloppy copy
         mat(r, y);
-        r2 = xmyNorm(b, r);
+        r2 = xmyNormCopy(b, r, r_sloppy);
 
         if (param.deflate && sqrt(r2) < ru.maxr_deflate * param.tol_restart) {
           // Deflate and accumulate to solution vector
-          eig_solve->deflate(y, r, evecs, evals, true);
+          deflate(y, r, true);
 
           // Compute r_defl = RHS - A * LHS
           mat(r, y);
-          r2 = blas::xmyNorm(b, r);
+          r2 = blas::xmyNormCopy(b, r, r_sloppy);
 
           ru.update_maxr_deflate(r2);
         }
 
-        copy(r_sloppy, r);
         zero(x_sloppy);
 
         bool L2breakdown = false;
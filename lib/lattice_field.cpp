@@ -1,12 +1,33 @@
+#include <map>
 #include <typeinfo>
+#include <vector>
 #include <quda_internal.h>
 #include <lattice_field.h>
 #include <color_spinor_field.h>
 #include <gauge_field.h>
 #include <clover_field.h>
+#include <halo_compress.h>
 
 namespace quda {
 
+  /**
+     The persistent message handles for one halo layout on the static
+     ghost buffers
+   */
+  struct CommsPlan {
+    array_3d<MsgHandle *, 2, QUDA_MAX_DIM, 2> mh_recv = {};
+    array_3d<MsgHandle *, 2, QUDA_MAX_DIM, 2> mh_send = {};
+    array_3d<MsgHandle *, 2, QUDA_MAX_DIM, 2> mh_recv_rdma = {};
+    array_3d<MsgHandle *, 2, QUDA_MAX_DIM, 2> mh_send_rdma = {};
+  };
+
+  /**
+     Cache of comms plans, keyed by the partitioning, whether GDR is
+     enabled, and the face size and offsets of each partitioned
+     dimension
+   */
+  static std::map<std::vector<size_t>, CommsPlan> comms_plan_cache;
+
   LatticeFieldParam::LatticeFieldParam(const LatticeField &field) :
     location(field.Location()),
     precision(field.Precision()),
@@ -228,6 +249,7 @@ namespace quda {
     mh_recv_rdma = std::exchange(src.mh_recv_rdma, {});
     mh_send_rdma = std::exchange(src.mh_send_rdma, {});
     initComms = std::exchange(src.initComms, false);
+    comms_epoch = std::exchange(src.comms_epoch, 0);
     vol_string = std::exchange(src.vol_string, {});
     aux_string = std::exchange(src.aux_string, {});
     mem_type = std::exchange(src.mem_type, QUDA_MEMORY_INVALID);
@@ -261,6 +283,7 @@ namespace quda {
           // before we free any comms buffers
           qudaDeviceSynchronize();
           comm_barrier();
+          destroyCommsPlans();
           for (int b=0; b<2; b++) {
             device_comms_pinned_free(ghost_recv_buffer_d[b]);
             device_comms_pinned_free(ghost_send_buffer_d[b]);
@@ -310,6 +333,8 @@ namespace quda {
 
     if (!initGhostFaceBuffer) return;
 
+    destroyCommsPlans();
+
     for (int b=0; b<2; b++) {
       // free receive buffer
       if (ghost_recv_buffer_d[b]) device_comms_pinned_free(ghost_recv_buffer_d[b]);
@@ -333,16 +358,43 @@ namespace quda {
     initGhostFaceBuffer = false;
   }
 
-  void LatticeField::createComms(bool no_comms_fill)
+  void LatticeField::destroyCommsPlans()
   {
-    destroyComms(); // if we are requesting a new number of faces destroy and start over
+    halo_compress::destroy();
 
-    // before allocating local comm handles, synchronize since the
-    // comms buffers are static so remove potential for interferring
-    // with any outstanding exchanges to the same buffers
+    if (comms_plan_cache.empty()) return;
+
+    // ensure that all processes bring down their communicators
+    // synchronously so that we don't end up in an undefined state
     qudaDeviceSynchronize();
     comm_barrier();
 
+    for (auto &entry : comms_plan_cache) {
+      auto &plan = entry.second;
+      for (int b = 0; b < 2; ++b) {
+        for (int i = 0; i < QUDA_MAX_DIM; i++) {
+          for (int dir = 0; dir < 2; dir++) {
+            if (plan.mh_recv[b][i][dir]) comm_free(plan.mh_recv[b][i][dir]);
+            if (plan.mh_send[b][i][dir]) comm_free(plan.mh_send[b][i][dir]);
+            if (plan.mh_recv_rdma[b][i][dir]) comm_free(plan.mh_recv_rdma[b][i][dir]);
+            if (plan.mh_send_rdma[b][i][dir]) comm_free(plan.mh_send_rdma[b][i][dir]);
+          }
+        }
+      }
+    }
+    logQuda(QUDA_DEBUG_VERBOSE, "Destroyed %lu comms plans\n", comms_plan_cache.size());
+    comms_plan_cache.clear();
+    comms_plan_epoch++; // fields holding these handles must recreate their comms
+
+    // local take down complete - now synchronize to ensure globally complete
+    qudaDeviceSynchronize();
+    comm_barrier();
+  }
+
+  void LatticeField::createComms(bool no_comms_fill)
+  {
+    destroyComms(); // if we are requesting a new number of faces destroy and start over
+
     // initialize the ghost pinned buffers
     for (int b=0; b<2; b++) {
       my_face_h[b] = ghost_pinned_send_buffer_h[b];
@@ -373,24 +425,56 @@ namespace quda {
 
     bool gdr = comm_gdr_enabled(); // only allocate rdma buffers if GDR enabled
 
-    // initialize the message handlers
-    for (int i=0; i<nDimComms; i++) {
+    // the message handles only depend on the halo layout, so are
+    // shared by all fields with the same layout
+    std::vector<size_t> key = {static_cast<size_t>(nDimComms), gdr};
+    for (int i = 0; i < nDimComms; i++) {
       if (!commDimPartitioned(i)) continue;
+      key.insert(key.end(), {static_cast<size_t>(i), ghost_face_bytes[i], ghost_offset[i][0], ghost_offset[i][1]});
+    }
 
-      for (int dir = 0; dir < 2; dir++) {
-        int hop = dir == 0 ? -1 : +1;
-        for (int b = 0; b < 2; ++b) {
-          mh_send[b][i][dir] = comm_declare_send_relative(my_face_dim_dir_h[b][i][dir], i, hop, ghost_face_bytes[i]);
-          mh_recv[b][i][dir] = comm_declare_receive_relative(from_face_dim_dir_h[b][i][dir], i, hop, ghost_face_bytes[i]);
-          mh_send_rdma[b][i][dir]
-            = gdr ? comm_declare_send_relative(my_face_dim_dir_d[b][i][dir], i, hop, ghost_face_bytes[i]) : nullptr;
-          mh_recv_rdma[b][i][dir]
-            = gdr ? comm_declare_receive_relative(from_face_dim_dir_d[b][i][dir], i, hop, ghost_face_bytes[i]) : nullptr;
-        }
-      } // loop over b
+    auto plan = comms_plan_cache.find(key);
+    if (plan == comms_plan_cache.end()) {
+      // before allocating local comm handles, synchronize since the
+      // comms buffers are static so remove potential for interferring
+      // with any outstanding exchanges to the same buffers
+      qudaDeviceSynchronize();
+      comm_barrier();
 
-    } // loop over dimension
+      CommsPlan new_plan;
+
+      // initialize the message handlers
+      for (int i = 0; i < nDimComms; i++) {
+        if (!commDimPartitioned(i)) continue;
 
+        for (int dir = 0; dir < 2; dir++) {
+          int hop = dir == 0 ? -1 : +1;
+          for (int b = 0; b < 2; ++b) {
+            auto send_h = static_cast<char *>(ghost_pinned_send_buffer_h[b]) + ghost_offset[i][dir];
+            auto recv_h = static_cast<char *>(ghost_pinned_recv_buffer_h[b]) + ghost_offset[i][dir];
+            auto send_d = static_cast<char *>(ghost_send_buffer_d[b]) + ghost_offset[i][dir];
+            auto recv_d = static_cast<char *>(ghost_recv_buffer_d[b]) + ghost_offset[i][dir];
+            new_plan.mh_send[b][i][dir] = comm_declare_send_relative(send_h, i, hop, ghost_face_bytes[i]);
+            new_plan.mh_recv[b][i][dir] = comm_declare_receive_relative(recv_h, i, hop, ghost_face_bytes[i]);
+            new_plan.mh_send_rdma[b][i][dir]
+              = gdr ? comm_declare_send_relative(send_d, i, hop, ghost_face_bytes[i]) : nullptr;
+            new_plan.mh_recv_rdma[b][i][dir]
+              = gdr ? comm_declare_receive_relative(recv_d, i, hop, ghost_face_bytes[i]) : nullptr;
+          }
+        } // loop over b
+
+      } // loop over dimension
+
+      plan = comms_plan_cache.emplace(key, new_plan).first;
+      logQuda(QUDA_DEBUG_VERBOSE, "Created comms plan %lu\n", comms_plan_cache.size());
+    }
+
+    mh_send = plan->second.mh_send;
+    mh_recv = plan->second.mh_recv;
+    mh_send_rdma = plan->second.mh_send_rdma;
+    mh_recv_rdma = plan->second.mh_recv_rdma;
+
+    comms_epoch = comms_plan_epoch;
     initComms = true;
   }
 
@@ -400,11 +484,6 @@ namespace quda {
 
     if (initComms) {
 
-      // ensure that all processes bring down their communicators
-      // synchronously so that we don't end up in an undefined state
-      qudaDeviceSynchronize();
-      comm_barrier();
-
       my_face_h = {};
       my_face_hd = {};
       my_face_d = {};
@@ -419,26 +498,12 @@ namespace quda {
       from_face_dim_dir_hd = {};
       from_face_dim_dir_d = {};
 
-      for (int b=0; b<2; ++b) {
-	for (int i=0; i<nDimComms; i++) {
-          for (int dir = 0; dir < 2; dir++) {
-            if (mh_recv[b][i][dir]) comm_free(mh_recv[b][i][dir]);
-            if (mh_send[b][i][dir]) comm_free(mh_send[b][i][dir]);
-            if (mh_recv_rdma[b][i][dir]) comm_free(mh_recv_rdma[b][i][dir]);
-            if (mh_send_rdma[b][i][dir]) comm_free(mh_send_rdma[b][i][dir]);
-          }
-        }
-      } // loop over b
-
+      // the message handles are owned by the comms plan cache
       mh_recv = {};
       mh_send = {};
       mh_recv_rdma = {};
       mh_send_rdma = {};
 
-      // local take down complete - now synchronize to ensure globally complete
-      qudaDeviceSynchronize();
-      comm_barrier();
-
       initComms = false;
     }
 
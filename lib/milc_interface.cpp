@@ -1465,6 +1465,7 @@ struct mgInputStruct {
   char mg_vec_infile[QUDA_MAX_MG_LEVEL][256];    // ignored on first and last level
   char mg_vec_outfile[QUDA_MAX_MG_LEVEL][256];   // ignored on first and last level
   bool mg_vec_partfile[QUDA_MAX_MG_LEVEL];       // ignored on first and last level
+  QudaPrecision mg_vec_save_prec[QUDA_MAX_MG_LEVEL]; // ignored on first and last level
   int geo_block_size[QUDA_MAX_MG_LEVEL][4]; // ignored on first and last level (values on first level are prescribed)
 
   /**
@@ -1514,6 +1515,7 @@ struct mgInputStruct {
       mg_vec_infile[i][0] = 0;
       mg_vec_outfile[i][0] = 0;
       mg_vec_partfile[i] = false;
+      mg_vec_save_prec[i] = QUDA_INVALID_PRECISION;
       for (int d = 0; d < 4; d++) { geo_block_size[i][d] = 2; }
 
       setup_use_mma[i] = true;
@@ -1672,6 +1674,8 @@ struct mgInputStruct {
       return QUDA_SINGLE_PRECISION;
     } else if (strcmp(name, "half") == 0) {
       return QUDA_HALF_PRECISION;
+    } else if (strcmp(name, "quarter") == 0) {
+      return QUDA_QUARTER_PRECISION;
     } else {
       return QUDA_INVALID_PRECISION;
     }
@@ -1850,6 +1854,13 @@ struct mgInputStruct {
       } else {
         mg_vec_partfile[atoi(input_line[1].c_str())] = input_line[2][0] == 't' ? true : false;
       }
+
+    } else if (strcmp(input_line[0].c_str(), "mg_vec_save_prec") == 0) {
+      if (input_line.size() < 3) {
+        error_code = 1;
+      } else {
+        mg_vec_save_prec[atoi(input_line[1].c_str())] = getQudaPrecision(input_line[2].c_str());
+      }
     } else /* Begin Solvers */
       if (strcmp(input_line[0].c_str(), "coarse_solve_type") == 0) {
       if (input_line.size() < 3) {
@@ -2378,6 +2389,7 @@ void milcSetMultigridParam(milcMultigridPack *mg_pack, QudaPrecision host_precis
       mg_param.mg_vec_partfile[i] = input_struct.mg_vec_partfile[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
     else
       mg_param.mg_vec_partfile[i] = input_struct.deflate_vec_partfile ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+    mg_param.vec_save_prec[i] = input_struct.mg_vec_save_prec[i];
   }
 
   mg_param.coarse_guess = QUDA_BOOLEAN_FALSE; // mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
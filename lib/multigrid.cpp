@@ -599,7 +599,7 @@ namespace quda
         if (defl_size > 0 && transfer && param.mg_global.preserve_deflation) {
           // Deflation space exists and we are going to create a new solver. Extract deflation space.
           if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Extracting deflation space size %d to MG\n", defl_size);
-          coarse_solver_inner.extractDeflationSpace(evecs);
+          coarse_solver_inner.extractDeflationSpace(evecs, defl_store);
         }
         delete coarse_solver;
         coarse_solver = nullptr;
@@ -724,7 +724,7 @@ namespace quda
       if (param.level == param.Nlevel - 2 && param.mg_global.use_eig_solver[param.level + 1]) {
 
         // Test if a coarse grid deflation space needs to be transferred to the coarse solver to prevent recomputation
-        int defl_size = evecs.size();
+        int defl_size = deflationSpaceSize();
         auto &coarse_solver_inner = reinterpret_cast<PreconditionedSolver *>(coarse_solver)->ExposeSolver();
         if (defl_size > 0 && transfer && param.mg_global.preserve_deflation) {
           // We shall not recompute the deflation space, we shall transfer
@@ -734,7 +734,7 @@ namespace quda
           if (getVerbosity() >= QUDA_VERBOSE)
             printfQuda("Transferring deflation space size %d to coarse solver\n", defl_size);
           // Create space in coarse solver to hold deflation space, destroy space in MG.
-          coarse_solver_inner.injectDeflationSpace(evecs);
+          coarse_solver_inner.injectDeflationSpace(evecs, defl_store);
         }
 
         // Run a dummy solve so that the deflation space is constructed and computed if needed during the MG setup,
@@ -1334,7 +1334,7 @@ namespace quda
       VectorIO io(vec_infile);
       vector_ref<ColorSpinorField> B_ref;
       for (auto i = 0u; i < B.size(); i++) B_ref.push_back(*B[i]);
-      io.load(std::move(B_ref));
+      io.load(std::move(B_ref), param.mg_global.vec_save_prec[param.level]);
       popLevel();
       profile_global.TPSTOP(QUDA_PROFILE_IO);
       if (is_running) profile_global.TPSTART(QUDA_PROFILE_INIT);
@@ -1358,7 +1358,7 @@ namespace quda
       VectorIO io(vec_outfile, false, param.mg_global.mg_vec_partfile[param.level]);
       vector_ref<const ColorSpinorField> B_ref;
       for (auto i = 0u; i < B.size(); i++) B_ref.push_back(*B[i]);
-      io.save(std::move(B_ref));
+      io.save(std::move(B_ref), param.mg_global.vec_save_prec[param.level]);
       popLevel();
       profile_global.TPSTOP(QUDA_PROFILE_IO);
       if (is_running) profile_global.TPSTART(QUDA_PROFILE_INIT);
@@ -4,8 +4,19 @@
  *
  */
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <pthread.h>
+#include <sched.h>
 #include <numa_affinity.h>
 #include <quda_internal.h>
+#include <comm_quda.h>
+#include <device.h>
 
 #ifdef NUMA_NVML
 #include <nvml.h>
@@ -51,3 +62,273 @@ int setNumaAffinityNVML(int devid)
   return -1;
 #endif
 }
+
+namespace quda
+{
+
+  namespace topology
+  {
+
+    static bool initialized = false;
+    static bool requested = false;
+    static bool bind_threads = false;
+    static std::vector<int> role_cpus[2];
+    static int numa_node_device = -1;
+
+    /**
+       @brief Read the first line of a file
+       @return The line, or an empty string if the file cannot be read
+     */
+    static std::string read_line(const std::string &path)
+    {
+      std::ifstream file(path);
+      std::string line;
+      if (file) std::getline(file, line);
+      return line;
+    }
+
+    /**
+       @brief Parse a list of cpus in the kernel's format, e.g., "0-3,8,10-11"
+     */
+    static std::vector<int> parse_cpulist(const std::string &list)
+    {
+      std::vector<int> cpus;
+      std::stringstream ss(list);
+      std::string range;
+      while (std::getline(ss, range, ',')) {
+        if (range.empty()) continue;
+        auto dash = range.find('-');
+        int lo = std::stoi(range.substr(0, dash));
+        int hi = dash == std::string::npos ? lo : std::stoi(range.substr(dash + 1));
+        for (int i = lo; i <= hi; i++) cpus.push_back(i);
+      }
+      return cpus;
+    }
+
+    static std::string to_cpulist(const std::vector<int> &cpus)
+    {
+      std::string list;
+      for (size_t i = 0; i < cpus.size(); i++) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) j++;
+        if (!list.empty()) list += ",";
+        list += std::to_string(cpus[i]);
+        if (j > i) list += "-" + std::to_string(cpus[j]);
+        i = j;
+      }
+      return list.empty() ? "none" : list;
+    }
+
+    /**
+       @return The cpus of the cgroup cpuset of this process, or an
+       empty list if there is no cpuset restriction we can read
+     */
+    static std::vector<int> cgroup_cpus()
+    {
+      std::ifstream cgroup("/proc/self/cgroup");
+      std::string line;
+      while (std::getline(cgroup, line)) {
+        // each line is hierarchy-ID:controller-list:cgroup-path
+        auto c1 = line.find(':');
+        auto c2 = line.find(':', c1 + 1);
+        if (c1 == std::string::npos || c2 == std::string::npos) continue;
+        std::string controllers = line.substr(c1 + 1, c2 - c1 - 1);
+        std::string path = line.substr(c2 + 1);
+
+        std::string list;
+        if (controllers.empty()) { // cgroup v2
+          list = read_line("/sys/fs/cgroup" + path + "/cpuset.cpus.effective");
+        } else if (("," + controllers + ",").find(",cpuset,") != std::string::npos) { // cgroup v1
+          list = read_line("/sys/fs/cgroup/cpuset" + path + "/cpuset.effective_cpus");
+          if (list.empty()) list = read_line("/sys/fs/cgroup/cpuset" + path + "/cpuset.cpus");
+        }
+        if (!list.empty()) return parse_cpulist(list);
+      }
+      return {};
+    }
+
+    /**
+       @return The cpus in the affinity mask of this process
+     */
+    static std::vector<int> affinity_cpus()
+    {
+      std::vector<int> cpus;
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      if (sched_getaffinity(0, sizeof(set), &set) != 0) return cpus;
+      for (int i = 0; i < CPU_SETSIZE; i++)
+        if (CPU_ISSET(i, &set)) cpus.push_back(i);
+      return cpus;
+    }
+
+    static std::vector<int> intersect(const std::vector<int> &a, const std::vector<int> &b)
+    {
+      std::vector<int> c;
+      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(c));
+      return c;
+    }
+
+    /**
+       @brief Determine this rank's index among, and the number of,
+       the ranks that share its node
+     */
+    static void local_rank(int &rank, int &size)
+    {
+      std::vector<char> hostname(QUDA_MAX_HOSTNAME_STRING * comm_size());
+      comm_gather_hostname(hostname.data());
+      rank = 0;
+      size = 0;
+      for (int i = 0; i < comm_size(); i++) {
+        if (!strncmp(comm_hostname(), &hostname[QUDA_MAX_HOSTNAME_STRING * i], QUDA_MAX_HOSTNAME_STRING)) {
+          if (i < comm_rank()) rank++;
+          size++;
+        }
+      }
+    }
+
+    void init()
+    {
+      if (initialized) return;
+      initialized = true;
+
+      char *enable_affinity = getenv("QUDA_ENABLE_AFFINITY");
+      if (!enable_affinity || strcmp(enable_affinity, "1") != 0) return;
+      requested = true;
+
+      // collective, so done before any rank may bail out
+      int rank, size;
+      local_rank(rank, size);
+
+      // the cpus we are allowed to run on
+      auto allowed = affinity_cpus();
+      auto cpuset = cgroup_cpus();
+      auto online = cpuset.empty() ? parse_cpulist(read_line("/sys/devices/system/cpu/online")) : cpuset;
+      if (!cpuset.empty()) allowed = intersect(allowed, cpuset);
+      if (allowed.empty()) {
+        warningQuda("Unable to determine the allowed cpus, not binding threads");
+        print();
+        return;
+      }
+
+      // numa node of each cpu
+      std::map<int, int> cpu_node;
+      {
+        auto nodes = parse_cpulist(read_line("/sys/devices/system/node/online"));
+        for (auto n : nodes)
+          for (auto c : parse_cpulist(read_line("/sys/devices/system/node/node" + std::to_string(n) + "/cpulist")))
+            cpu_node[c] = n;
+      }
+
+      char bus_id[16];
+      device::get_pci_bus_id(bus_id);
+      std::string numa_node = read_line(std::string("/sys/bus/pci/devices/") + bus_id + "/numa_node");
+      numa_node_device = numa_node.empty() ? -1 : std::stoi(numa_node);
+
+      // group the hardware threads into physical cores, ordered by numa node, package and core
+      using core_t = std::tuple<int, int, int>;
+      std::map<core_t, std::vector<int>> core_map;
+      for (auto c : allowed) {
+        std::string topo = "/sys/devices/system/cpu/cpu" + std::to_string(c) + "/topology/";
+        std::string package = read_line(topo + "physical_package_id");
+        std::string core = read_line(topo + "core_id");
+        int node = cpu_node.count(c) ? cpu_node[c] : 0;
+        core_map[{node, package.empty() ? 0 : std::stoi(package), core.empty() ? c : std::stoi(core)}].push_back(c);
+      }
+      std::vector<std::vector<int>> cores;
+      for (auto &core : core_map) cores.push_back(core.second);
+
+      // if the launcher has not bound the ranks on this node, split the cores between them
+      if (size > 1 && allowed.size() == online.size()) {
+        const size_t n = cores.size();
+        size_t begin = (rank * n) / size, end = ((rank + 1) * n) / size;
+        if (n < static_cast<size_t>(size)) {
+          warningQuda("%lu cores shared between %d ranks on %s", n, size, comm_hostname());
+          begin = rank % n;
+          end = begin + 1;
+        }
+        cores = std::vector<std::vector<int>>(cores.begin() + begin, cores.begin() + end);
+      }
+
+      // reserve a core for the progress thread if we can
+      auto &worker = role_cpus[static_cast<int>(ThreadRole::WORKER)];
+      auto &progress = role_cpus[static_cast<int>(ThreadRole::PROGRESS)];
+      int n_reserved = cores.size() >= 2 ? 1 : 0;
+      for (size_t i = 0; i < cores.size() - n_reserved; i++) worker.insert(worker.end(), cores[i].begin(), cores[i].end());
+      progress = n_reserved > 0 ? cores.back() : worker;
+      for (auto &r : role_cpus) std::sort(r.begin(), r.end());
+
+      bind_threads = true;
+
+      // Bind the OpenMP worker threads.  The calling thread takes part
+      // in the parallel region, so its mask is restored afterwards
+      // unless QUDA_AFFINITY_BIND_CALLER=1.
+      char *bind_caller_env = getenv("QUDA_AFFINITY_BIND_CALLER");
+      bool bind_caller = bind_caller_env && strcmp(bind_caller_env, "1") == 0;
+      cpu_set_t caller_set;
+      CPU_ZERO(&caller_set);
+      bool restore = !bind_caller && pthread_getaffinity_np(pthread_self(), sizeof(caller_set), &caller_set) == 0;
+#ifdef QUDA_OPENMP
+#pragma omp parallel
+#endif
+      bind(ThreadRole::WORKER);
+      if (restore) {
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(caller_set), &caller_set);
+        if (error != 0) warningQuda("Failed to restore the affinity of the calling thread (error %d)", error);
+      }
+
+      print();
+    }
+
+    bool enabled() { return bind_threads; }
+
+    void bind(ThreadRole role)
+    {
+      if (!bind_threads) return;
+
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (auto c : cpus(role)) CPU_SET(c, &set);
+      int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+      if (error != 0) warningQuda("Failed to set the affinity of thread role %d (error %d)", static_cast<int>(role), error);
+    }
+
+    const std::vector<int> &cpus(ThreadRole role) { return role_cpus[static_cast<int>(role)]; }
+
+    void print()
+    {
+      if (!requested) return;
+
+      // gather the assignment of every rank, so that they can all be
+      // printed from the print rank: each row holds the device numa
+      // node, the number of worker and progress cpus, and the cpus
+      auto &worker = cpus(ThreadRole::WORKER);
+      auto &progress = cpus(ThreadRole::PROGRESS);
+      int width = 3 + worker.size() + progress.size();
+      comm_allreduce_max(width);
+      std::vector<double> map(static_cast<size_t>(width) * comm_size(), 0.0);
+      double *mine = map.data() + static_cast<size_t>(width) * comm_rank();
+      mine[0] = numa_node_device;
+      mine[1] = worker.size();
+      mine[2] = progress.size();
+      std::copy(worker.begin(), worker.end(), mine + 3);
+      std::copy(progress.begin(), progress.end(), mine + 3 + worker.size());
+      comm_allreduce_sum(map);
+
+      std::vector<char> hostname(QUDA_MAX_HOSTNAME_STRING * comm_size());
+      comm_gather_hostname(hostname.data());
+
+      if (getVerbosity() >= QUDA_SUMMARIZE) {
+        for (int r = 0; r < comm_size(); r++) {
+          const double *row = map.data() + static_cast<size_t>(width) * r;
+          std::vector<int> w(row + 3, row + 3 + static_cast<int>(row[1]));
+          std::vector<int> p(row + 3 + w.size(), row + 3 + w.size() + static_cast<int>(row[2]));
+          printfQuda("Rank %d on %.*s (device numa node %d): worker cpus %s, progress cpus %s\n", r,
+                     QUDA_MAX_HOSTNAME_STRING, &hostname[QUDA_MAX_HOSTNAME_STRING * r], static_cast<int>(row[0]),
+                     to_cpulist(w).c_str(), to_cpulist(p).c_str());
+        }
+      }
+    }
+
+  } // namespace topology
+
+} // namespace quda
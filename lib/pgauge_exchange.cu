@@ -53,7 +53,7 @@ namespace quda {
     const char *dim_str[4] = { "0", "1", "2", "3" };
     unsigned int minThreads() const override { return arg.threads.x; }
 
-    PGaugeExchanger(GaugeField& U, const int dir, const int parity) :
+    PGaugeExchanger(GaugeField& U, const int dir, const int parity, bool sync_device) :
       TunableKernel1D(U),
       U(U),
       arg(U)
@@ -111,7 +111,10 @@ namespace quda {
         }
       }
 
-      qudaDeviceSynchronize();
+      // when overlapping with work on other streams, only the links
+      // updated on the default stream need to be complete
+      if (sync_device) qudaDeviceSynchronize();
+      else qudaStreamSynchronize(device::get_default_stream());
       for (int d = 0; d < 4; d++) {
         if (!commDimPartitioned(d)) continue;
         comm_start(mh_recv_back[d]);
@@ -163,7 +166,7 @@ namespace quda {
         qudaStreamSynchronize(device::get_stream(0));
         qudaStreamSynchronize(device::get_stream(1));
       }
-      qudaDeviceSynchronize();
+      if (sync_device) qudaDeviceSynchronize();
     }
 
     TuneKey tuneKey() const override
@@ -182,9 +185,9 @@ namespace quda {
     long long bytes() const override { return 2 * U.SurfaceCB(arg.face) * U.Reconstruct() * U.Precision(); }
   };
 
-  void PGaugeExchange(GaugeField& U, const int dir, const int parity)
+  void PGaugeExchange(GaugeField& U, const int dir, const int parity, bool sync_device)
   {
-    if (comm_partitioned()) instantiate<PGaugeExchanger>(U, dir, parity);
+    if (comm_partitioned()) instantiate<PGaugeExchanger>(U, dir, parity, sync_device);
   }
 
 }
@@ -11,40 +11,84 @@
 
 namespace quda {
 
+  /**
+     @brief Threaded host heatbath.  Links of a given direction and
+     parity are independent of each other, since their staples only
+     involve links of other directions or the opposite parity.
+  */
+  template <template <typename> class Functor, typename Arg> void MonteHost(const Arg &arg)
+  {
+    Functor<Arg> f(arg);
+#pragma omp parallel for
+    for (int x_cb = 0; x_cb < static_cast<int>(arg.threads.x); x_cb++) f(x_cb);
+  }
+
   template <typename Float, int nColor, QudaReconstructType recon>
   class GaugeHB : TunableKernel1D {
     GaugeField &U;
     Float beta;
     RNG &rng;
+    CounterRNG counter;
     int mu;
     int parity;
-    bool heatbath; // true = heatbath, false = over relaxation
+    int n_hb;      // number of heatbath hits per link
+    bool ovr;      // whether to apply an overrelaxation hit
+    bool heatbath; // true = heatbath (optionally followed by overrelaxation), false = over relaxation only
+    MonteRegion region;
     char aux2[TuneKey::aux_n];
     unsigned int minThreads() const { return U.LocalVolumeCB(); }
 
   public:
-    GaugeHB(GaugeField &U, double beta, RNG &rng, int mu, int parity, bool heatbath) :
+    GaugeHB(GaugeField &U, double beta, RNG &rng, const CounterRNG &counter, int mu, int parity, int n_hb, bool ovr,
+            MonteRegion region = MONTE_ALL, const qudaStream_t &stream = device::get_default_stream()) :
       TunableKernel1D(U),
       U(U),
       beta(static_cast<Float>(beta)),
       rng(rng),
+      counter(counter),
       mu(mu),
       parity(parity),
-      heatbath(heatbath)
+      n_hb(n_hb),
+      ovr(ovr),
+      heatbath(n_hb > 0),
+      region(region)
     {
+      if (U.Location() == QUDA_CPU_FIELD_LOCATION) {
+        if (U.Order() != QUDA_QDP_GAUGE_ORDER) errorQuda("Host heatbath only supported on QDP ordered fields");
+        if (heatbath && !counter.enabled) errorQuda("Host heatbath requires the counter-based generator");
+      }
       strcat(aux, mu == 0 ? ",mu=0" : mu == 1 ? ",mu=1" : mu == 2 ? ",mu=2" : ",mu=3");
       strcat(aux, parity ? ",parity=1" : ",parity=0");
-      strcat(aux, heatbath ? ",heatbath" : ",ovr");
-      apply(device::get_default_stream());
+      if (n_hb + ovr == 1) {
+        strcat(aux, heatbath ? ",heatbath" : ",ovr");
+      } else {
+        strcat(aux, ",hb=");
+        u32toa(aux + strlen(aux), n_hb);
+        if (ovr) strcat(aux, ",ovr");
+      }
+      if (counter.enabled) strcat(aux, ",philox");
+      if (region == MONTE_INTERIOR) strcat(aux, ",interior");
+      else if (region == MONTE_BOUNDARY) strcat(aux, ",boundary");
+      apply(stream);
     }
 
+    template <bool hb, bool host = false> using Arg = MonteArg<Float, nColor, recon, hb, host>;
+
     void apply(const qudaStream_t &stream)
     {
+      if (U.Location() == QUDA_CPU_FIELD_LOCATION) {
+        if (heatbath)
+          MonteHost<HB>(Arg<true, true>(U, beta, nullptr, counter, mu, parity, n_hb, ovr, region));
+        else
+          MonteHost<HB>(Arg<false, true>(U, beta, nullptr, counter, mu, parity, n_hb, ovr, region));
+        return;
+      }
+
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (heatbath) {
-        launch<HB>(tp, stream, MonteArg<Float, nColor, recon, true>(U, beta, rng.State(), mu, parity));
+        launch<HB>(tp, stream, Arg<true>(U, beta, rng.State(), counter, mu, parity, n_hb, ovr, region));
       } else {
-        launch<HB>(tp, stream, MonteArg<Float, nColor, recon, false>(U, beta, rng.State(), mu, parity));
+        launch<HB>(tp, stream, Arg<false>(U, beta, rng.State(), counter, mu, parity, n_hb, ovr, region));
       }
     }
 
@@ -62,21 +106,13 @@ namespace quda {
     {
       //NEED TO CHECK THIS!!!!!!
       if ( nColor == 3 ) {
-        long long flop = 2268LL;
-        if (heatbath) {
-          flop += 801LL;
-        } else {
-          flop += 843LL;
-        }
+        long long flop = 2268LL + n_hb * 801LL + (ovr ? 843LL : 0LL);
         flop *= U.LocalVolumeCB();
         return flop;
       } else {
         long long flop = nColor * nColor * nColor * 84LL;
-        if (heatbath) {
-          flop += nColor * nColor * nColor + (nColor * ( nColor - 1) / 2) * (46LL + 48LL + 56LL * nColor);
-        } else {
-          flop += nColor * nColor * nColor + (nColor * ( nColor - 1) / 2) * (17LL + 112LL * nColor);
-        }
+        flop += n_hb * (nColor * nColor * nColor + (nColor * ( nColor - 1) / 2) * (46LL + 48LL + 56LL * nColor));
+        flop += ovr * (nColor * nColor * nColor + (nColor * ( nColor - 1) / 2) * (17LL + 112LL * nColor));
         flop *= U.LocalVolumeCB();
         return flop;
       }
@@ -87,18 +123,73 @@ namespace quda {
       //NEED TO CHECK THIS!!!!!!
       if ( nColor == 3 ) {
         long long byte = 20LL * recon * sizeof(Float);
-        if (heatbath) byte += 2LL * sizeof(RNGState);
+        if (heatbath && !counter.enabled) byte += 2LL * sizeof(RNGState);
         byte *= U.LocalVolumeCB();
         return byte;
       } else {
         long long byte = 20LL * nColor * nColor * 2 * sizeof(Float);
-        if (heatbath) byte += 2LL * sizeof(RNGState);
+        if (heatbath && !counter.enabled) byte += 2LL * sizeof(RNGState);
         byte *= U.LocalVolumeCB();
         return byte;
       }
     }
   };
 
+  /**
+     @brief Exchange the halo of the links of direction mu and the
+     given parity after they have been updated.
+  */
+  static void MonteExchange(GaugeField &U, int mu, int parity, bool sync_device = true)
+  {
+    if (U.Location() == QUDA_CPU_FIELD_LOCATION) {
+      // the host exchange is not link specific, so refresh the whole halo
+      if (comm_partitioned()) U.exchangeExtendedGhost(U.R());
+    } else {
+      PGaugeExchange(U, mu, parity, sync_device);
+    }
+  }
+
+  /**
+     @brief Update every link once, with n_hb heatbath hits followed
+     by an optional overrelaxation hit.  The links are updated parity
+     by parity and direction by direction, since the update of each
+     depends on the halo of the ones updated before it.  On a
+     partitioned device lattice, the halo exchange of each updated
+     link is overlapped with the update of the interior sites of the
+     next one, whose staples do not reach into the halo; its boundary
+     sites are then updated once the exchange is complete.
+  */
+  template <typename Float, int nColor, QudaReconstructType recon>
+  void MonteSweep(GaugeField &U, RNG &rng, Float beta, int n_hb, bool ovr)
+  {
+    auto counter = [&]() { return n_hb > 0 ? rng.Counter() : CounterRNG(); };
+
+    if (U.Location() == QUDA_CPU_FIELD_LOCATION || !comm_partitioned()) {
+      for (int parity = 0; parity < 2; parity++) {
+        for (int mu = 0; mu < 4; mu++) {
+          GaugeHB<Float, nColor, recon>(U, beta, rng, counter(), mu, parity, n_hb, ovr);
+          MonteExchange(U, mu, parity);
+        }
+      }
+      return;
+    }
+
+    const qudaStream_t &interior = device::get_stream(2); // streams 0 and 1 are used by the exchange
+    GaugeHB<Float, nColor, recon>(U, beta, rng, counter(), 0, 0, n_hb, ovr);
+    for (int link = 1; link < 8; link++) {
+      int parity = link / 4, mu = link % 4;
+      int prev_parity = (link - 1) / 4, prev_mu = (link - 1) % 4;
+      // the same counter is used for both halves, so the result is independent of the split
+      auto link_counter = counter();
+      qudaStreamSynchronize(device::get_default_stream());
+      GaugeHB<Float, nColor, recon>(U, beta, rng, link_counter, mu, parity, n_hb, ovr, MONTE_INTERIOR, interior);
+      MonteExchange(U, prev_mu, prev_parity, false);
+      qudaStreamSynchronize(interior);
+      GaugeHB<Float, nColor, recon>(U, beta, rng, link_counter, mu, parity, n_hb, ovr, MONTE_BOUNDARY);
+    }
+    MonteExchange(U, 3, 1);
+  }
+
   template <typename Float, int nColor, QudaReconstructType recon>
   struct MonteAlg {
     MonteAlg(GaugeField& data, RNG &rngstate, Float Beta, int nhb, int nover)
@@ -107,14 +198,7 @@ namespace quda {
       double hb_time = 0.0, ovr_time = 0.0;
       if (getVerbosity() >= QUDA_VERBOSE) timer.start();
 
-      for (int step = 0; step < nhb; step++) {
-        for (int parity = 0; parity < 2; parity++) {
-          for (int mu = 0; mu < 4; ++mu) {
-            GaugeHB<Float, nColor, recon>(data, Beta, rngstate, mu, parity, true);
-            PGaugeExchange(data, mu, parity);
-          }
-        }
-      }
+      for (int step = 0; step < nhb; step++) MonteSweep<Float, nColor, recon>(data, rngstate, Beta, 1, false);
 
       if (getVerbosity() >= QUDA_VERBOSE) {
         qudaDeviceSynchronize();
@@ -123,14 +207,7 @@ namespace quda {
         timer.start();
       }
 
-      for (int step = 0; step < nover; step++) {
-        for (int parity = 0; parity < 2; parity++) {
-          for (int mu = 0; mu < 4; mu++) {
-            GaugeHB<Float, nColor, recon>(data, Beta, rngstate, mu, parity, false);
-            PGaugeExchange(data, mu, parity);
-          }
-        }
-      }
+      for (int step = 0; step < nover; step++) MonteSweep<Float, nColor, recon>(data, rngstate, Beta, 0, true);
 
       if (getVerbosity() >= QUDA_VERBOSE) {
         qudaDeviceSynchronize();
@@ -141,6 +218,13 @@ namespace quda {
     }
   };
 
+  template <typename Float, int nColor, QudaReconstructType recon> struct MonteMultiHitAlg {
+    MonteMultiHitAlg(GaugeField &data, RNG &rngstate, Float Beta, int n_hb, bool ovr)
+    {
+      MonteSweep<Float, nColor, recon>(data, rngstate, Beta, n_hb, ovr);
+    }
+  };
+
   /** @brief Perform heatbath and overrelaxation. Performs nhb heatbath steps followed by nover overrelaxation steps.
    *
    * @param[in,out] data Gauge field
@@ -154,4 +238,10 @@ namespace quda {
     instantiate<MonteAlg>(data, rngstate, (float)Beta, nhb, nover);
   }
 
+  void MonteMultiHit(GaugeField &data, RNG &rngstate, double Beta, int n_hb, bool ovr)
+  {
+    if (n_hb < 0 || n_hb + ovr == 0) errorQuda("Invalid number of hits n_hb = %d ovr = %d", n_hb, ovr);
+    instantiate<MonteMultiHitAlg>(data, rngstate, (float)Beta, n_hb, ovr);
+  }
+
 }
@@ -36,14 +36,17 @@ namespace quda {
   class InitGaugeHot : TunableKernel1D {
     const GaugeField &U;
     RNG &rng;
+    CounterRNG counter;
     unsigned int minThreads() const { return U.LocalVolumeCB(); }
 
   public:
     InitGaugeHot(GaugeField &U, RNG &rng) :
       TunableKernel1D(U),
       U(U),
-      rng(rng)
+      rng(rng),
+      counter(rng.Counter())
     {
+      if (counter.enabled) strcat(aux, ",philox");
       apply(device::get_default_stream());
       qudaDeviceSynchronize();
       U.exchangeExtendedGhost(U.R(),false);
@@ -52,7 +55,7 @@ namespace quda {
     void apply(const qudaStream_t &stream)
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-      launch<HotStart>(tp, stream, InitGaugeHotArg<Float, nColors, recon>(U, rng.State()));
+      launch<HotStart>(tp, stream, InitGaugeHotArg<Float, nColors, recon>(U, rng.State(), counter));
     }
 
     void preTune() { rng.backup(); }
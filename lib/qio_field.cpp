@@ -193,6 +193,7 @@ int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cp
   QIO_string_destroy(xml_record_in);
   QIO_destroy_record_info(rec_info);
   printfQuda("%s: QIO_read_record_data returns status %d\n", __func__, status);
+  if (status == QIO_CHECKSUM_MISMATCH) errorQuda("SciDAC checksum mismatch reading record");
   if (status != QIO_SUCCESS) return 1;
   return 0;
 }
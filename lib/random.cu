@@ -34,11 +34,42 @@ namespace quda {
     long long bytes() const { return 0; }
   };
 
-  RNG::RNG(const LatticeField &meta, unsigned long long seedin) :
-    size(meta.LocalVolume()),
-    state((RNGState *)device_malloc(size * sizeof(RNGState)), [](RNGState *ptr){ device_free(ptr); } ),
-    seed(seedin)
+  static bool counter_rng_enabled()
   {
+    static bool init = false;
+    static bool enabled = false;
+    if (!init) {
+      char *enable_counter_rng = getenv("QUDA_ENABLE_COUNTER_RNG");
+      if (enable_counter_rng && strcmp(enable_counter_rng, "1") == 0) {
+        logQuda(QUDA_SUMMARIZE, "Enabling counter-based RNG\n");
+        enabled = true;
+      }
+      init = true;
+    }
+    return enabled;
+  }
+
+  RNG::RNG(const LatticeField &meta, unsigned long long seedin, bool counter_based) :
+    size(meta.LocalVolume()), seed(seedin)
+  {
+    if (counter_based || counter_rng_enabled()) {
+      // no state to allocate, the stream is a pure function of the seed and global site index
+      counter.enabled = true;
+      counter.seed = seed;
+      for (int i = 0; i < 4; i++) {
+        counter.X[i] = meta.LocalX()[i];
+        counter.commCoord[i] = comm_coord(i);
+      }
+      // the site index is always defined with respect to the full lattice
+      if (meta.SiteSubset() == QUDA_PARITY_SITE_SUBSET) counter.X[0] *= 2;
+      for (int i = 0; i < 4; i++) counter.X_global[i] = counter.X[i] * comm_dim(i);
+      logQuda(QUDA_VERBOSE, "Using counter-based Philox4x32-10\n");
+      return;
+    }
+
+    state = std::shared_ptr<RNGState>((RNGState *)device_malloc(size * sizeof(RNGState)),
+                                      [](RNGState *ptr) { device_free(ptr); });
+
 #if defined(XORWOW)
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Using randStateXORWOW\n");
 #elif defined(RG32k3a)
@@ -54,9 +85,17 @@ namespace quda {
     RNGInit(*this, meta, seed);
   }
 
+  CounterRNG RNG::Counter()
+  {
+    CounterRNG rng = counter;
+    counter.stream++;
+    return rng;
+  }
+
   /*! @brief Backup CURAND array states initialization */
   void RNG::backup()
   {
+    if (counter.enabled) return; // nothing to save, the stream is only advanced once per use
     backup_state = (RNGState *)safe_malloc(size * sizeof(RNGState));
     qudaMemcpy(backup_state, state.get(), size * sizeof(RNGState), qudaMemcpyDeviceToHost);
   }
@@ -64,6 +103,7 @@ namespace quda {
   /*! @brief Restore CURAND array states initialization */
   void RNG::restore()
   {
+    if (counter.enabled) return;
     qudaMemcpy(state.get(), backup_state, size * sizeof(RNGState), qudaMemcpyHostToDevice);
     host_free(backup_state);
   }
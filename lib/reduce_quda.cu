@@ -48,10 +48,12 @@ namespace quda {
       {
         checkLocation(x, y, z, w, v);
         checkLength(x, y, z, w, v);
-        auto x_prec = checkPrecision(x, z, w, v);
-        auto y_prec = y.Precision();
-        auto x_order = checkOrder(x, z, w, v);
-        auto y_order = y.FieldOrder();
+        // when v_mixed is set the v field takes the precision of y
+        constexpr bool v_mixed = decltype(r)::v_mixed;
+        auto x_prec = v_mixed ? checkPrecision(x, z, w) : checkPrecision(x, z, w, v);
+        auto y_prec = v_mixed ? checkPrecision(y, v) : y.Precision();
+        auto x_order = v_mixed ? checkOrder(x, z, w) : checkOrder(x, z, w, v);
+        auto y_order = v_mixed ? checkOrder(y, v) : y.FieldOrder();
         if (sizeof(store_t) != x_prec) errorQuda("Expected precision %lu but received %d", sizeof(store_t), x_prec);
         if (sizeof(y_store_t) != y_prec) errorQuda("Expected precision %lu but received %d", sizeof(y_store_t), y_prec);
         if (x_prec == y_prec && x_order != y_order) errorQuda("Orders %d %d do not match", x_order, y_order);
@@ -180,6 +182,18 @@ namespace quda {
       return instantiateReduce<axpbyzNorm2, false>(a, b, 0.0, x, y, z, x, x);
     }
 
+    double xmyNormCopy(const ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z)
+    {
+      if (y.data() == z.data()) return xmyNorm(x, y);
+      if (y.Precision() != z.Precision() && (y.Ncolor() != 3 || y.Nspin() == 2)) {
+        // mixed-precision reductions require site unrolling
+        double y2 = xmyNorm(x, y);
+        copy(z, y);
+        return y2;
+      }
+      return instantiateReduce<xmyNormCopy_, true>(0.0, 0.0, 0.0, z, y, z, z, x);
+    }
+
     double axpyReDot(double a, const ColorSpinorField &x, ColorSpinorField &y)
     {
       return instantiateReduce<AxpyReDot, false>(a, 0.0, 0.0, x, y, x, x, x);
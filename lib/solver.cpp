@@ -2,8 +2,10 @@
 #include <invert_quda.h>
 #include <multigrid.h>
 #include <eigensolve_quda.h>
+#include <deflation_store.h>
 #include <accelerator.h>
 #include <madwf_ml.h> // For MADWF
+#include <eigen_helper.h>
 #include <cmath>
 #include <limits>
 
@@ -238,6 +240,7 @@ namespace quda {
       inner.ca_basis = outer.ca_basis_precondition;
       inner.ca_lambda_min = outer.ca_lambda_min_precondition;
       inner.ca_lambda_max = outer.ca_lambda_max_precondition;
+      inner.ca_adaptive = outer.ca_adaptive_precondition;
     } else {
       inner.Nsteps = outer.precondition_cycle;
     }
@@ -250,10 +253,11 @@ namespace quda {
 
   void Solver::extractInnerSolverParam(SolverParam &outer, const SolverParam &inner)
   {
-    // extract a_max, which may have been determined via power iterations
+    // extract a_max (and a_min if adaptive), which may have been determined via power iterations or Arnoldi
     if ((outer.inv_type_precondition == QUDA_CA_CG_INVERTER || outer.inv_type_precondition == QUDA_CA_GCR_INVERTER)
         && outer.ca_basis_precondition == QUDA_CHEBYSHEV_BASIS) {
       outer.ca_lambda_max_precondition = inner.ca_lambda_max;
+      if (outer.ca_adaptive_precondition) outer.ca_lambda_min_precondition = inner.ca_lambda_min;
     }
   }
 
@@ -283,7 +287,21 @@ namespace quda {
 
       deflation_space *space = reinterpret_cast<deflation_space *>(param.eig_param.preserve_deflation_space);
 
-      if (space && space->evecs.size() != 0) {
+      if (space && space->store) {
+        logQuda(QUDA_VERBOSE, "Restoring compressed deflation space of size %d\n", space->store->size());
+
+        if (param.eig_param.n_conv != space->store->size())
+          errorQuda("Preserved deflation space size %d does not match expected %d", space->store->size(),
+                    param.eig_param.n_conv);
+
+        // the store is reused as is, bound to this solver's operator
+        defl_store = std::move(space->store);
+        defl_store->setOperator(mat);
+
+        delete space;
+        param.eig_param.preserve_deflation_space = nullptr;
+        deflate_compute = false;
+      } else if (space && space->evecs.size() != 0) {
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Restoring deflation space of size %lu\n", space->evecs.size());
 
         if ((!space->svd && param.eig_param.n_conv != (int)space->evecs.size())
@@ -321,7 +339,7 @@ namespace quda {
   {
     if (deflate_init) {
       if (param.eig_param.preserve_deflation) {
-        if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Preserving deflation space of size %lu\n", evecs.size());
+        if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Preserving deflation space of size %d\n", deflationSpaceSize());
 
         if (param.eig_param.preserve_deflation_space) {
           deflation_space *space = reinterpret_cast<deflation_space *>(param.eig_param.preserve_deflation_space);
@@ -331,30 +349,77 @@ namespace quda {
         deflation_space *space = new deflation_space;
 
         // if evecs size = 2x evals size then we are doing an SVD deflation
-        space->svd = (evecs.size() == 2 * evals.size()) ? true : false;
+        space->svd = (!defl_store && evecs.size() == 2 * evals.size()) ? true : false;
 
         space->evecs = std::move(evecs);
         space->evals = std::move(evals);
+        space->store = std::move(defl_store);
 
         param.eig_param.preserve_deflation_space = space;
       }
 
       evecs.clear();
       evals.clear();
+      defl_store.reset();
       deflate_init = false;
     }
   }
 
-  void Solver::injectDeflationSpace(std::vector<ColorSpinorField> &defl_space)
+  void Solver::deflate(cvector_ref<ColorSpinorField> &sol, cvector_ref<const ColorSpinorField> &src, bool accumulate)
+  {
+    if (!defl_store && !evecs.empty() && param.eig_param.deflation_prec < evecs[0].Precision()) {
+      // move the eigenvectors into compressed storage, the store is
+      // then preserved and transferred in place of the eigenvectors
+      defl_store = std::make_shared<DeflationStore>(matEig, param.eig_param.deflation_prec);
+      defl_store->add(evecs);
+      logQuda(QUDA_SUMMARIZE, "Compressed deflation space of %d vectors to %lu bytes\n", defl_store->size(),
+              defl_store->bytes());
+      evals.clear();
+    }
+
+    if (defl_store)
+      defl_store->deflate(sol, src, accumulate);
+    else
+      eig_solve->deflate(sol, src, evecs, evals, accumulate);
+  }
+
+  void Solver::recomputeEvals()
+  {
+    if (defl_store)
+      defl_store->rebuild();
+    else
+      eig_solve->computeEvals(evecs, evals);
+  }
+
+  void Solver::deflateSVD(cvector_ref<ColorSpinorField> &sol, cvector_ref<const ColorSpinorField> &src, bool accumulate)
   {
-    if (!evecs.empty()) errorQuda("Solver deflation space should be empty, instead size=%lu\n", evecs.size());
+    if (defl_store) errorQuda("SVD deflation is not supported with a compressed deflation space");
+    eig_solve->deflateSVD(sol, src, evecs, evals, accumulate);
+  }
+
+  void Solver::recomputeSVD()
+  {
+    if (defl_store) errorQuda("SVD deflation is not supported with a compressed deflation space");
+    eig_solve->computeEvals(evecs, evals);
+    eig_solve->computeSVD(evecs, evals);
+  }
+
+  int Solver::deflationSpaceSize() const { return defl_store ? defl_store->size() : (int)evecs.size(); }
+
+  void Solver::injectDeflationSpace(std::vector<ColorSpinorField> &defl_space, std::shared_ptr<DeflationStore> &store)
+  {
+    if (deflationSpaceSize() != 0)
+      errorQuda("Solver deflation space should be empty, instead size=%d\n", deflationSpaceSize());
+    defl_store = std::move(store);
+    if (defl_store) defl_store->setOperator(matEig);
     evecs = std::move(defl_space); // move defl_space to evecs
   }
 
-  void Solver::extractDeflationSpace(std::vector<ColorSpinorField> &defl_space)
+  void Solver::extractDeflationSpace(std::vector<ColorSpinorField> &defl_space, std::shared_ptr<DeflationStore> &store)
   {
     if (!defl_space.empty())
       errorQuda("Container deflation space should be empty, instead size=%lu\n", defl_space.size());
+    store = std::move(defl_store); // a compressed space is transferred as is
     defl_space = std::move(evecs); // move evecs to defl_space
   }
 
@@ -512,6 +577,30 @@ namespace quda {
     return true;
   }
 
+  /**
+    @brief Returns the largest numerically stable CA basis size, see invert_quda.h
+  */
+  int Solver::selectCABasisSize(const std::vector<ColorSpinorField> &v, int s_max, double cond_max)
+  {
+    if (static_cast<int>(v.size()) < s_max) errorQuda("Invalid v.size() %lu < s_max %d", v.size(), s_max);
+
+    std::vector<Complex> G_(s_max * s_max);
+    blas::cDotProduct(G_, {v.begin(), v.begin() + s_max}, {v.begin(), v.begin() + s_max});
+
+    // scale by the diagonal so we measure the linear dependence of the basis, not the growth of its norm
+    Matrix<Complex, Dynamic, Dynamic> G(s_max, s_max);
+    for (int i = 0; i < s_max; i++)
+      for (int j = 0; j < s_max; j++) G(i, j) = G_[i * s_max + j] / sqrt(G_[i * s_max + i].real() * G_[j * s_max + j].real());
+
+    for (int s = s_max; s > 1; s--) {
+      SelfAdjointEigenSolver<Matrix<Complex, Dynamic, Dynamic>> eigen(G.topLeftCorner(s, s), EigenvaluesOnly);
+      double cond = eigen.eigenvalues()(s - 1) / eigen.eigenvalues()(0);
+      logQuda(QUDA_DEBUG_VERBOSE, "CA basis size %d has condition number %e\n", s, cond);
+      if (eigen.eigenvalues()(0) > 0.0 && cond <= cond_max) return s;
+    }
+    return 1;
+  }
+
   /**
     @brief Returns if a solver is CA or not
     @return true if CA, false otherwise
@@ -2,11 +2,15 @@
 #include <quda_internal.h>
 #include <invert_quda.h>
 #include <blas_quda.h>
+#include <eigen_helper.h>
 #include <cmath>
 
 namespace quda
 {
 
+  /** Maximum number of Arnoldi steps used to estimate the Chebyshev bounds in the adaptive CA solvers */
+  constexpr int ca_adaptive_steps = 16;
+
   /**
      @brief Compute power iterations on a Dirac matrix
      @param[in] diracm Dirac matrix used for power iterations
@@ -93,4 +97,77 @@ namespace quda
     }
   }
 
+  /**
+     @brief Estimate the extremal eigenvalues of a Dirac matrix using Arnoldi
+     @param[in] diracm Dirac matrix whose spectrum we are estimating
+     @param[in] start Starting vector for the Krylov space (preserved)
+     @param[in,out] v Workspace holding the Krylov basis, which must not alias start
+     @param[out] lambda_min Lower estimate of the smallest real part of the spectrum
+     @param[out] lambda_max Largest real part of the Ritz values
+     @param[in] args Parameter pack of ColorSpinorFields used as temporary passed to Dirac
+     @return Whether the estimate succeeded (fails for a zero starting vector)
+  */
+  template <typename... Args>
+  bool Solver::estimateSpectrumBounds(const DiracMatrix &diracm, const ColorSpinorField &start,
+                                      cvector_ref<ColorSpinorField> &v, double &lambda_min, double &lambda_max,
+                                      Args &&...args)
+  {
+    const int n_step = std::min(ca_adaptive_steps, static_cast<int>(v.size()) - 1);
+    if (n_step < 1) errorQuda("Insufficient workspace %lu for spectrum estimation", v.size());
+
+    Matrix<Complex, Dynamic, Dynamic> H = Matrix<Complex, Dynamic, Dynamic>::Zero(n_step + 1, n_step);
+
+    blas::copy(v[0], start);
+    double start_norm = sqrt(blas::norm2(v[0]));
+    if (start_norm == 0.0) return false;
+    blas::ax(1.0 / start_norm, v[0]);
+
+    int m = n_step;
+    for (int j = 0; j < n_step; j++) {
+      diracm(v[j + 1], v[j], args...);
+
+      // classical Gram-Schmidt applied twice for numerical stability
+      for (int pass = 0; pass < 2; pass++) {
+        std::vector<Complex> h(j + 1);
+        blas::cDotProduct(h, {v.begin(), v.begin() + j + 1}, {v[j + 1]});
+        for (int i = 0; i <= j; i++) {
+          H(i, j) += h[i];
+          h[i] = -h[i];
+        }
+        blas::caxpy(h, {v.begin(), v.begin() + j + 1}, {v[j + 1]});
+      }
+
+      double beta = sqrt(blas::norm2(v[j + 1]));
+      H(j + 1, j) = beta;
+      if (beta < 1e-12 * H.col(j).norm()) { // invariant subspace found so Ritz values are exact
+        m = j + 1;
+        break;
+      }
+      blas::ax(1.0 / beta, v[j + 1]);
+    }
+
+    ComplexEigenSolver<Matrix<Complex, Dynamic, Dynamic>> eigen(H.topLeftCorner(m, m), true);
+    const double beta = m < n_step ? 0.0 : H(m, m - 1).real();
+    double ritz_min = std::numeric_limits<double>::max();
+    double resid_min = 0.0;
+    lambda_max = std::numeric_limits<double>::lowest();
+    for (int i = 0; i < m; i++) {
+      double ritz = eigen.eigenvalues()(i).real();
+      if (ritz < ritz_min) {
+        // the residual norm of the Ritz pair is |beta| |s_{m-1}| / |s|
+        auto s = eigen.eigenvectors().col(i);
+        ritz_min = ritz;
+        resid_min = beta * std::abs(s(m - 1)) / s.norm();
+      }
+      lambda_max = std::max(lambda_max, ritz);
+    }
+
+    // A short Krylov space overestimates the smallest eigenvalue, so
+    // we lower it by the larger of its residual norm and 10%
+    lambda_min = ritz_min - std::max(resid_min, 0.1 * std::abs(ritz_min));
+    logQuda(QUDA_VERBOSE, "Arnoldi (%d steps) approximate spectrum = [%e, %e], smallest Ritz value %e residual %e\n",
+            m, lambda_min, lambda_max, ritz_min, resid_min);
+    return true;
+  }
+
 } // namespace quda
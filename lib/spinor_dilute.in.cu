@@ -6,19 +6,40 @@
 namespace quda
 {
 
+  /**
+     @brief Returns true if a non-block dilution is to be composed
+     with block dilution, which is the case when all of the block
+     dimensions are set
+  */
+  static bool is_blocked(QudaDilutionType type, const lat_dim_t &local_block)
+  {
+    if (type == QUDA_DILUTION_BLOCK) return false;
+    for (int i = 0; i < 4; i++)
+      if (local_block[i] == 0) return false;
+    return true;
+  }
+
   template <typename real, int Ns, int Nc> class SpinorDilute : TunableKernel2D
   {
-    std::vector<ColorSpinorField> &v;
+    cvector_ref<ColorSpinorField> &v;
     const ColorSpinorField &src;
     QudaDilutionType type;
     const lat_dim_t &local_block;
+    int offset;
+    bool blocked;
     unsigned int minThreads() const { return src.VolumeCB(); }
     template <QudaDilutionType type> using Arg = SpinorDiluteArg<real, Ns, Nc, type>;
 
   public:
-    SpinorDilute(const ColorSpinorField &src, std::vector<ColorSpinorField> &v, QudaDilutionType type,
-                 const lat_dim_t &local_block) :
-      TunableKernel2D(src, src.SiteSubset()), v(v), src(src), type(type), local_block(local_block)
+    SpinorDilute(const ColorSpinorField &src, cvector_ref<ColorSpinorField> &v, QudaDilutionType type,
+                 const lat_dim_t &local_block, int offset) :
+      TunableKernel2D(src, src.SiteSubset()),
+      v(v),
+      src(src),
+      type(type),
+      local_block(local_block),
+      offset(offset),
+      blocked(is_blocked(type, local_block))
     {
       switch (type) {
       case QUDA_DILUTION_SPIN: strcat(aux, ",spin_dilution"); break;
@@ -28,20 +49,9 @@ namespace quda
       case QUDA_DILUTION_BLOCK: strcat(aux, ",block_dilution"); break;
       default: errorQuda("Unsupported dilution type %d", type);
       }
-      if (type != QUDA_DILUTION_BLOCK && v.size() != static_cast<unsigned int>(get_size<Ns, Nc>(type)))
-        errorQuda("Input container size %lu does not match expected size %d for dilution type", v.size(),
-                  get_size<Ns, Nc>(type));
-
-      size_t block_volume = 1;
-      for (int i = 0; i < src.Ndim(); i++) block_volume *= local_block[i];
-      size_t n_blocks = comm_size() * src.Volume() / block_volume;
-      if (type == QUDA_DILUTION_BLOCK) {
-        if (v.size() != n_blocks)
-          errorQuda("Input container size %lu does not match expected size %lu for dilution block size (%d,%d,%d,%d)",
-                    v.size(), n_blocks, local_block[0], local_block[1], local_block[2], local_block[3]);
-        if (v.size() > Arg<QUDA_DILUTION_BLOCK>::max_dilution_size)
-          errorQuda("Container size %lu exceeds maximum size %d", v.size(), Arg<QUDA_DILUTION_BLOCK>::max_dilution_size);
+      if (blocked) strcat(aux, ",blocked");
 
+      if (type == QUDA_DILUTION_BLOCK || blocked) {
         for (auto i = 0; i < src.Ndim(); i++) {
           if (local_block[i] == 0) errorQuda("Dim %d: Dilution block size = 0", i);
           if ((src.X(i) * comm_dim(i)) % local_block[i] != 0)
@@ -50,6 +60,10 @@ namespace quda
         }
       }
 
+      size_t size = spinorDiluteSize(src, type, local_block);
+      if (offset < 0 || offset + v.size() > size)
+        errorQuda("Batch [%d, %lu) exceeds the dilution set size %lu", offset, offset + v.size(), size);
+
       apply(device::get_default_stream());
     }
 
@@ -60,7 +74,12 @@ namespace quda
 
     template <QudaDilutionType type> void apply(TuneParam &tp, const qudaStream_t &stream)
     {
-      launch<DiluteSpinor>(tp, stream, Arg<type>(v, src, local_block, sequence<type>()));
+      // the argument struct holds at most max_dilution_size fields, so launch in chunks
+      constexpr size_t max = Arg<type>::max_dilution_size;
+      for (size_t i = 0; i < v.size(); i += max) {
+        vector_ref<ColorSpinorField> chunk(v.begin() + i, v.begin() + std::min(i + max, v.size()));
+        launch<DiluteSpinor>(tp, stream, Arg<type>(chunk, src, local_block, offset + i, blocked, sequence<type>()));
+      }
     }
 
     void apply(const qudaStream_t &stream)
@@ -76,51 +95,78 @@ namespace quda
       }
     }
 
-    long long bytes() const { return v.size() * v[0].Bytes() + src.Bytes(); }
+    long long bytes() const
+    {
+      size_t max = get_size<Ns, Nc>(type);
+      size_t n_chunk = (v.size() + max - 1) / max;
+      return v.size() * v[0].Bytes() + n_chunk * src.Bytes();
+    }
   };
 
   template <int...> struct IntList {
   };
 
   template <typename real, int Ns, int Nc, int... N>
-  void spinorDilute(const ColorSpinorField &src, std::vector<ColorSpinorField> &v, QudaDilutionType type,
-                    const lat_dim_t &local_block, IntList<Nc, N...>)
+  void spinorDilute(const ColorSpinorField &src, cvector_ref<ColorSpinorField> &v, QudaDilutionType type,
+                    const lat_dim_t &local_block, int offset, IntList<Nc, N...>)
   {
     if (src.Ncolor() == Nc) {
-      SpinorDilute<real, Ns, Nc>(src, v, type, local_block);
+      SpinorDilute<real, Ns, Nc>(src, v, type, local_block, offset);
     } else {
       if constexpr (sizeof...(N) > 0)
-        spinorDilute<real, Ns>(src, v, type, local_block, IntList<N...>());
+        spinorDilute<real, Ns>(src, v, type, local_block, offset, IntList<N...>());
       else
         errorQuda("nColor = %d not implemented", src.Ncolor());
     }
   }
 
   template <typename real>
-  void spinorDilute(const ColorSpinorField &src, std::vector<ColorSpinorField> &v, QudaDilutionType type,
-                    const lat_dim_t &local_block)
+  void spinorDilute(const ColorSpinorField &src, cvector_ref<ColorSpinorField> &v, QudaDilutionType type,
+                    const lat_dim_t &local_block, int offset)
   {
     checkNative(src);
     if (!is_enabled_spin(src.Nspin())) errorQuda("spinorNoise has not been built for nSpin=%d fields", src.Nspin());
 
     if (src.Nspin() == 4) {
-      if constexpr (is_enabled_spin(4)) spinorDilute<real, 4>(src, v, type, local_block, IntList<3>());
+      if constexpr (is_enabled_spin(4)) spinorDilute<real, 4>(src, v, type, local_block, offset, IntList<3>());
     } else if (src.Nspin() == 2) {
       if constexpr (is_enabled_spin(2))
-        spinorDilute<real, 2>(src, v, type, local_block, IntList<3, @QUDA_MULTIGRID_NVEC_LIST@>());
+        spinorDilute<real, 2>(src, v, type, local_block, offset, IntList<3, @QUDA_MULTIGRID_NVEC_LIST@>());
     } else if (src.Nspin() == 1) {
-      if constexpr (is_enabled_spin(1)) spinorDilute<real, 1>(src, v, type, local_block, IntList<3>());
+      if constexpr (is_enabled_spin(1)) spinorDilute<real, 1>(src, v, type, local_block, offset, IntList<3>());
     } else {
       errorQuda("Nspin = %d not implemented", src.Nspin());
     }
   }
 
-  void spinorDilute(std::vector<ColorSpinorField> &v, const ColorSpinorField &src, QudaDilutionType type,
-                    const lat_dim_t &local_block)
+  size_t spinorDiluteSize(const ColorSpinorField &src, QudaDilutionType type, const lat_dim_t &local_block)
+  {
+    size_t n_blocks = 1;
+    if (type == QUDA_DILUTION_BLOCK || is_blocked(type, local_block)) {
+      size_t block_volume = 1;
+      for (int i = 0; i < src.Ndim(); i++) block_volume *= local_block[i];
+      if (block_volume == 0) errorQuda("Dilution block size = 0");
+      n_blocks = comm_size() * src.Volume() / block_volume;
+    }
+
+    switch (type) {
+    case QUDA_DILUTION_SPIN: return n_blocks * src.Nspin();
+    case QUDA_DILUTION_COLOR: return n_blocks * src.Ncolor();
+    case QUDA_DILUTION_SPIN_COLOR: return n_blocks * src.Nspin() * src.Ncolor();
+    case QUDA_DILUTION_SPIN_COLOR_EVEN_ODD: return n_blocks * src.Nspin() * src.Ncolor() * 2;
+    case QUDA_DILUTION_BLOCK: return n_blocks;
+    default: errorQuda("Unsupported dilution type %d", type);
+    }
+    return 0;
+  }
+
+  void spinorDilute(cvector_ref<ColorSpinorField> &v, const ColorSpinorField &src, QudaDilutionType type,
+                    const lat_dim_t &local_block, int offset)
   {
+    if (v.size() == 0) return;
     switch (src.Precision()) {
-    case QUDA_DOUBLE_PRECISION: spinorDilute<double>(src, v, type, local_block); break;
-    case QUDA_SINGLE_PRECISION: spinorDilute<float>(src, v, type, local_block); break;
+    case QUDA_DOUBLE_PRECISION: spinorDilute<double>(src, v, type, local_block, offset); break;
+    case QUDA_SINGLE_PRECISION: spinorDilute<float>(src, v, type, local_block, offset); break;
     default: errorQuda("Not instantiated %d\n", src.Precision());
     }
   }
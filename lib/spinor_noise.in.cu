@@ -11,6 +11,7 @@ namespace quda {
     ColorSpinorField &v;
     RNG &rng;
     QudaNoiseType type;
+    CounterRNG counter;
     unsigned int minThreads() const { return v.VolumeCB(); }
 
   public:
@@ -18,21 +19,27 @@ namespace quda {
       TunableKernel2D(v, v.SiteSubset()),
       v(v),
       rng(rng),
-      type(type)
+      type(type),
+      counter(rng.Counter())
     {
       strcat(aux, type == QUDA_NOISE_GAUSS ? ",gauss" : ",uniform");
+      if (counter.enabled) strcat(aux, ",philox");
       apply(device::get_default_stream());
     }
 
+    template <QudaNoiseType noise> void launch_(const TuneParam &tp, const qudaStream_t &stream)
+    {
+      if (v.Location() == QUDA_CUDA_FIELD_LOCATION)
+        launch_device<NoiseSpinor>(tp, stream, SpinorNoiseArg<real, Ns, Nc, noise>(v, rng.State(), counter));
+      else
+        launch_host<NoiseSpinor>(tp, stream, SpinorNoiseArg<real, Ns, Nc, noise, true>(v, rng.State(), counter));
+    }
+
     void apply(const qudaStream_t &stream) {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       switch (type) {
-      case QUDA_NOISE_GAUSS:
-        launch<NoiseSpinor>(tp, stream, SpinorNoiseArg<real, Ns, Nc, QUDA_NOISE_GAUSS>(v, rng.State()));
-        break;
-      case QUDA_NOISE_UNIFORM:
-        launch<NoiseSpinor>(tp, stream, SpinorNoiseArg<real, Ns, Nc, QUDA_NOISE_UNIFORM>(v, rng.State()));
-        break;
+      case QUDA_NOISE_GAUSS: launch_<QUDA_NOISE_GAUSS>(tp, stream); break;
+      case QUDA_NOISE_UNIFORM: launch_<QUDA_NOISE_UNIFORM>(tp, stream); break;
       default: errorQuda("Noise type %d not implemented", type);
       }
     }
@@ -58,7 +65,7 @@ namespace quda {
   template <typename real>
   void spinorNoise(ColorSpinorField &src, RNG& randstates, QudaNoiseType type)
   {
-    checkNative(src);
+    if (src.Location() == QUDA_CUDA_FIELD_LOCATION) checkNative(src);
     if (!is_enabled_spin(src.Nspin()))
       errorQuda("spinorNoise has not been built for nSpin=%d fields", src.Nspin());
 
@@ -75,11 +82,14 @@ namespace quda {
 
   void spinorNoise(ColorSpinorField &src_, RNG &randstates, QudaNoiseType type)
   {
-    // if src is a CPU field then create GPU field
+    // if src is a CPU field then create GPU field, unless the counter-based generator can fill it in place
     ColorSpinorField src;
     ColorSpinorParam param(src_);
     bool copy_back = false;
-    if (src_.Location() == QUDA_CPU_FIELD_LOCATION || src_.Precision() < QUDA_SINGLE_PRECISION) {
+    // the counter-based generator produces the same field on the host, so we can generate in place
+    bool host = src_.Location() == QUDA_CPU_FIELD_LOCATION && randstates.isCounterBased()
+      && src_.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER && src_.Precision() >= QUDA_SINGLE_PRECISION;
+    if (!host && (src_.Location() == QUDA_CPU_FIELD_LOCATION || src_.Precision() < QUDA_SINGLE_PRECISION)) {
       QudaPrecision prec = std::max(src_.Precision(), QUDA_SINGLE_PRECISION);
       param.setPrecision(prec, prec, true); // change to native field order
       param.create = QUDA_NULL_FIELD_CREATE;
@@ -144,6 +144,14 @@ namespace quda
       }
     }
 
+    void get_pci_bus_id(char bus_id[16])
+    {
+      if (device_id == -1) errorQuda("No device has been initialized for this process");
+      cudaDeviceProp prop;
+      CHECK_CUDA_ERROR(cudaGetDeviceProperties(&prop, device_id));
+      snprintf(bus_id, 16, "%04x:%02x:%02x.0", prop.pciDomainID, prop.pciBusID, prop.pciDeviceID);
+    }
+
     void print_device_properties()
     {
       for (int device = 0; device < get_device_count(); device++) {
@@ -5,6 +5,7 @@
 #include <unistd.h>   // for getpagesize()
 #include <execinfo.h> // for backtrace
 #include <quda_internal.h>
+#include <host_arena.h>
 #include <device.h>
 #include <shmem_helper.cuh>
 #include "timer.h"
@@ -66,7 +67,7 @@ namespace quda
 
   size_t managed_allocated() { return total_bytes[MANAGED]; }
 
-  size_t host_allocated() { return total_bytes[HOST]; }
+  size_t host_allocated() { return total_bytes[HOST] + host_arena::allocated(); }
 
   size_t device_allocated_peak() { return max_total_bytes[DEVICE]; }
 
@@ -76,7 +77,7 @@ namespace quda
 
   size_t managed_allocated_peak() { return max_total_bytes[MANAGED]; }
 
-  size_t host_allocated_peak() { return max_total_bytes[HOST]; }
+  size_t host_allocated_peak() { return max_total_bytes[HOST] + host_arena::allocated_peak(); }
 
   static void print_trace(void)
   {
@@ -156,14 +157,17 @@ namespace quda
     if (!ptr) {
 #else
     // we need to manually align to page boundaries to allow us to bind a texture to mapped memory
+    // large allocations are aligned to, and backed by, huge pages
     static int page_size = 2 * getpagesize();
-    a.base_size = ((size + page_size - 1) / page_size) * page_size; // round up to the nearest multiple of page_size
-    int align = posix_memalign(&ptr, page_size, a.base_size);
-    if (!ptr || align != 0) {
+    size_t align = size >= host_arena::huge_page_size ? host_arena::huge_page_size : page_size;
+    a.base_size = ((size + align - 1) / align) * align; // round up to the nearest multiple of the alignment
+    int align_err = posix_memalign(&ptr, align, a.base_size);
+    if (!ptr || align_err != 0) {
 #endif
       errorQuda("Failed to allocate aligned host memory of size %zu (%s:%d in %s())\n", size, a.file.c_str(), a.line,
                 a.func.c_str());
     }
+    host_arena::advise_huge_pages(ptr, a.base_size);
     return ptr;
   }
 
@@ -282,6 +286,16 @@ namespace quda
    */
   void *safe_malloc_(const char *func, const char *file, int line, size_t size)
   {
+    if (host_arena::enabled()) {
+      void *ptr = host_arena::allocate(size);
+      if (ptr) {
+#ifdef HOST_DEBUG
+        memset(ptr, 0xff, size);
+#endif
+        return ptr;
+      }
+    }
+
     MemAlloc a(func, file, line);
     a.size = a.base_size = size;
 
@@ -483,7 +497,9 @@ namespace quda
   void host_free_(const char *func, const char *file, int line, void *ptr)
   {
     if (!ptr) { errorQuda("Attempt to free NULL host pointer (%s:%d in %s())\n", file, line, func); }
-    if (alloc[HOST].count(ptr)) {
+    if (host_arena::owns(ptr)) {
+      host_arena::deallocate(ptr);
+    } else if (alloc[HOST].count(ptr)) {
       track_free(HOST, ptr);
       free(ptr);
     } else if (alloc[PINNED].count(ptr)) {
@@ -550,7 +566,8 @@ namespace quda
     printfQuda("Managed memory used = %.1f MiB\n", max_total_bytes[MANAGED] / (double)(1 << 20));
     printfQuda("Shmem memory used = %.1f MiB\n", max_total_bytes[SHMEM] / (double)(1 << 20));
     printfQuda("Page-locked host memory used = %.1f MiB\n", max_total_pinned_bytes / (double)(1 << 20));
-    printfQuda("Total host memory used >= %.1f MiB\n", max_total_host_bytes / (double)(1 << 20));
+    printfQuda("Total host memory used >= %.1f MiB\n",
+               (max_total_host_bytes + host_arena::allocated_peak()) / (double)(1 << 20));
   }
 
   void assertAllMemFree()
@@ -568,6 +585,8 @@ namespace quda
       print_alloc(MAPPED);
       printfQuda("\n");
     }
+    if (host_arena::allocated() > 0)
+      warningQuda("%lu bytes of host arena allocations were not freed", host_arena::allocated());
   }
 
   QudaFieldLocation get_pointer_location(const void *ptr)
@@ -91,6 +91,14 @@ namespace quda
       }
     }
 
+    void get_pci_bus_id(char bus_id[16])
+    {
+      if (device_id == -1) errorQuda("No device has been initialized for this process");
+      hipDeviceProp_t prop;
+      CHECK_HIP_ERROR(hipGetDeviceProperties(&prop, device_id));
+      snprintf(bus_id, 16, "%04x:%02x:%02x.0", prop.pciDomainID, prop.pciBusID, prop.pciDeviceID);
+    }
+
     void create_context()
     {
       streams = new hipStream_t[Nstream];
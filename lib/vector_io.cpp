@@ -1,12 +1,125 @@
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <limits>
 #include <color_spinor_field.h>
 #include <qio_field.h>
 #include <vector_io.h>
 #include <blas_quda.h>
+#include <comm_quda.h>
 #include <timer.h>
 
 namespace quda
 {
 
+  /**
+     Header written at the start of every compressed per-rank file.
+     All of the geometry is the local geometry of the writing rank.
+   */
+  struct CompressedVectorHeader {
+    char magic[8];                // file identifier
+    int32_t version;              // format version
+    int32_t precision;            // storage precision of the fixed-point data
+    int32_t real_size;            // size in bytes of the real type used when saving
+    int32_t nColor;               // number of colors
+    int32_t nSpin;                // number of spins
+    int32_t nDim;                 // number of dimensions
+    int32_t siteSubset;           // site subset of the fields
+    int32_t nVec;                 // number of vectors in the file
+    int32_t x[QUDA_MAX_DIM];      // local dimensions
+    int32_t comm_dim[4];          // process grid
+    int32_t comm_coord[4];        // coordinate of the writing rank in the process grid
+    uint64_t block_length;        // number of reals sharing one scale factor
+    uint64_t n_block;             // number of blocks per vector
+  };
+
+  static constexpr char compressed_magic[8] = {'Q', 'U', 'D', 'A', 'N', 'V', 'E', 'C'};
+  static constexpr int32_t compressed_version = 1;
+
+  /**
+     @brief Compress a field into fixed point with one scale factor
+     per block.  Following QUDA's fixed-point field orders, the scale
+     is the maximum absolute value in the block, and the stored
+     integer is the value normalized by the scale multiplied by the
+     maximum integer value of store_t.
+     @param[out] q The fixed-point output array
+     @param[out] scale The per-block scale factors
+     @param[in] v The input array
+     @param[in] n_block The number of blocks
+     @param[in] block_length The number of reals in each block
+  */
+  template <typename store_t, typename real_t>
+  static void compress(store_t *q, float *scale, const real_t *v, int64_t n_block, int64_t block_length)
+  {
+    constexpr float fixed_max = std::numeric_limits<store_t>::max();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t b = 0; b < n_block; b++) {
+      const real_t *v_b = v + b * block_length;
+      store_t *q_b = q + b * block_length;
+      real_t max = 0.0;
+      for (int64_t i = 0; i < block_length; i++) max = std::max(max, static_cast<real_t>(std::abs(v_b[i])));
+      scale[b] = static_cast<float>(max);
+      const double inv_scale = scale[b] > 0.0f ? fixed_max / static_cast<double>(scale[b]) : 0.0;
+      for (int64_t i = 0; i < block_length; i++) {
+        // clamp since the rounding of the scale to float can push us over the limit
+        double q_i = std::rint(v_b[i] * inv_scale);
+        q_b[i] = static_cast<store_t>(std::max(-static_cast<double>(fixed_max), std::min(q_i, static_cast<double>(fixed_max))));
+      }
+    }
+  }
+
+  /**
+     @brief Decompress a field stored in fixed point with one scale
+     factor per block.
+     @param[out] v The output array
+     @param[in] q The fixed-point input array
+     @param[in] scale The per-block scale factors
+     @param[in] n_block The number of blocks
+     @param[in] block_length The number of reals in each block
+  */
+  template <typename real_t, typename store_t>
+  static void decompress(real_t *v, const store_t *q, const float *scale, int64_t n_block, int64_t block_length)
+  {
+    constexpr double fixed_max = std::numeric_limits<store_t>::max();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t b = 0; b < n_block; b++) {
+      const real_t s = scale[b] / fixed_max;
+      for (int64_t i = 0; i < block_length; i++) v[b * block_length + i] = s * q[b * block_length + i];
+    }
+  }
+
+  template <typename store_t>
+  static void compress(void *q, float *scale, const ColorSpinorField &v, int64_t n_block, int64_t block_length)
+  {
+    switch (v.Precision()) {
+    case QUDA_DOUBLE_PRECISION:
+      compress(static_cast<store_t *>(q), scale, v.data<const double *>(), n_block, block_length);
+      break;
+    case QUDA_SINGLE_PRECISION:
+      compress(static_cast<store_t *>(q), scale, v.data<const float *>(), n_block, block_length);
+      break;
+    default: errorQuda("Unsupported precision %d", v.Precision());
+    }
+  }
+
+  template <typename store_t>
+  static void decompress(ColorSpinorField &v, const void *q, const float *scale, int64_t n_block, int64_t block_length)
+  {
+    switch (v.Precision()) {
+    case QUDA_DOUBLE_PRECISION:
+      decompress(v.data<double *>(), static_cast<const store_t *>(q), scale, n_block, block_length);
+      break;
+    case QUDA_SINGLE_PRECISION:
+      decompress(v.data<float *>(), static_cast<const store_t *>(q), scale, n_block, block_length);
+      break;
+    default: errorQuda("Unsupported precision %d", v.Precision());
+    }
+  }
+
   VectorIO::VectorIO(const std::string &filename, bool parity_inflate, bool partfile) :
     filename(filename), parity_inflate(parity_inflate), partfile(partfile)
   {
@@ -14,8 +127,210 @@ namespace quda
       errorQuda("No eigenspace input file defined (filename = %s, parity_inflate = %d", filename.c_str(), parity_inflate);
   }
 
-  void VectorIO::load(cvector_ref<ColorSpinorField> &vecs)
+  std::string VectorIO::compressed_filename() const
   {
+    char rank_str[16];
+    snprintf(rank_str, sizeof(rank_str), ".rank%05d", comm_rank());
+    return filename + rank_str;
+  }
+
+  bool VectorIO::compressed_exists() const
+  {
+    FILE *fp = fopen(compressed_filename().c_str(), "rb");
+    int found = fp ? 1 : 0;
+    if (fp) fclose(fp);
+    comm_allreduce_int(found);
+    if (found != 0 && found != static_cast<int>(comm_size()))
+      errorQuda("Compressed vector files %s.rank* found on %d of %lu ranks", filename.c_str(), found, comm_size());
+    return found != 0;
+  }
+
+  /**
+     @brief Return a host field in space-spin-color order with at
+     least single precision that can be used as a staging buffer for
+     the compressed format, or an empty field if v can be used as is.
+     If inflate is set, single-parity fields are staged as full
+     fields, with the other parity zeroed.
+  */
+  static ColorSpinorField create_compressed_staging(const ColorSpinorField &v, bool inflate)
+  {
+    const QudaPrecision real_prec = v.Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : v.Precision();
+    inflate = inflate && v.SiteSubset() == QUDA_PARITY_SITE_SUBSET;
+    if (real_prec == v.Precision() && v.Location() == QUDA_CPU_FIELD_LOCATION
+        && v.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER && !inflate)
+      return ColorSpinorField();
+
+    ColorSpinorParam csParam(v);
+    csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    csParam.setPrecision(real_prec);
+    csParam.location = QUDA_CPU_FIELD_LOCATION;
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    if (inflate) {
+      csParam.x[0] *= 2;                          // corrects for the factor of two in the X direction
+      csParam.siteSubset = QUDA_FULL_SITE_SUBSET; // create a full-parity field.
+      csParam.create = QUDA_ZERO_FIELD_CREATE;    // to explicitly zero the other parity.
+    }
+    return ColorSpinorField(csParam);
+  }
+
+  void VectorIO::load_compressed(cvector_ref<ColorSpinorField> &vecs)
+  {
+    const int Nvec = vecs.size();
+    const bool inflate = vecs[0].SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate;
+    auto spinor_parity = vecs[0].SuggestedParity();
+    if (inflate && spinor_parity != QUDA_EVEN_PARITY && spinor_parity != QUDA_ODD_PARITY)
+      errorQuda("When loading single parity vectors, the suggested parity must be set.");
+
+    if (!compressed_exists()) errorQuda("Compressed vector files %s.rank* not found", filename.c_str());
+    auto fname = compressed_filename();
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Start loading %04d vectors from %s.rank* in compressed format\n", Nvec, filename.c_str());
+
+    // the geometry in the file is that of the (possibly inflated) staging field
+    ColorSpinorField tmp = create_compressed_staging(vecs[0], parity_inflate);
+    const ColorSpinorField &v0 = tmp.empty() ? vecs[0] : tmp;
+
+    quda::host_timer_t host_timer;
+    host_timer.start();
+
+    FILE *fp = fopen(fname.c_str(), "rb");
+    if (!fp) errorQuda("Unable to open file %s", fname.c_str());
+
+    CompressedVectorHeader header;
+    if (fread(&header, sizeof(header), 1, fp) != 1) errorQuda("Failed to read header from %s", fname.c_str());
+    if (memcmp(header.magic, compressed_magic, sizeof(compressed_magic)) != 0)
+      errorQuda("File %s is not a compressed vector file", fname.c_str());
+    if (header.version != compressed_version)
+      errorQuda("Unsupported compressed vector file version %d (expected %d)", header.version, compressed_version);
+    if (header.nColor != v0.Ncolor() || header.nSpin != v0.Nspin() || header.nDim != v0.Ndim()
+        || header.siteSubset != v0.SiteSubset())
+      errorQuda("Field mismatch: file has nColor = %d nSpin = %d nDim = %d siteSubset = %d, field has nColor = %d nSpin = "
+                "%d nDim = %d siteSubset = %d",
+                header.nColor, header.nSpin, header.nDim, header.siteSubset, v0.Ncolor(), v0.Nspin(), v0.Ndim(),
+                v0.SiteSubset());
+    for (int d = 0; d < v0.Ndim(); d++)
+      if (header.x[d] != v0.X(d)) errorQuda("Local dimension mismatch x[%d] = %d, expected %d", d, header.x[d], v0.X(d));
+    for (int d = 0; d < 4; d++)
+      if (header.comm_dim[d] != comm_dim(d) || header.comm_coord[d] != comm_coord(d))
+        errorQuda("Process grid mismatch in dimension %d: file has comm_dim = %d comm_coord = %d, expected %d %d", d,
+                  header.comm_dim[d], header.comm_coord[d], comm_dim(d), comm_coord(d));
+    if (header.nVec < Nvec) errorQuda("File %s only contains %d vectors, requested %d", fname.c_str(), header.nVec, Nvec);
+    if (header.precision != QUDA_HALF_PRECISION && header.precision != QUDA_QUARTER_PRECISION)
+      errorQuda("Unexpected storage precision %d", header.precision);
+
+    const auto n_block = header.n_block;
+    const auto block_length = header.block_length;
+    if (n_block * block_length != static_cast<uint64_t>(v0.Volume() * v0.Nspin() * v0.Ncolor() * 2))
+      errorQuda("Unexpected field length %lu (expected %lu)", n_block * block_length,
+                static_cast<uint64_t>(v0.Volume() * v0.Nspin() * v0.Ncolor() * 2));
+
+    std::vector<float> scale(n_block);
+    std::vector<char> q(n_block * block_length * header.precision);
+
+    for (int i = 0; i < Nvec; i++) {
+      if (fread(scale.data(), sizeof(float), n_block, fp) != n_block || fread(q.data(), 1, q.size(), fp) != q.size())
+        errorQuda("Failed to read vector %d from %s", i, fname.c_str());
+
+      ColorSpinorField &v = tmp.empty() ? vecs[i] : tmp;
+      if (header.precision == QUDA_HALF_PRECISION)
+        decompress<short>(v, q.data(), scale.data(), n_block, block_length);
+      else
+        decompress<int8_t>(v, q.data(), scale.data(), n_block, block_length);
+      if (inflate)
+        vecs[i] = spinor_parity == QUDA_EVEN_PARITY ? tmp.Even() : tmp.Odd();
+      else if (!tmp.empty())
+        vecs[i] = tmp;
+    }
+
+    fclose(fp);
+    host_timer.stop();
+    logQuda(QUDA_SUMMARIZE, "Time spent loading vectors from %s.rank* = %g secs\n", filename.c_str(), host_timer.last());
+    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done loading vectors\n");
+  }
+
+  void VectorIO::save_compressed(cvector_ref<const ColorSpinorField> &vecs, QudaPrecision prec, int Nvec)
+  {
+    if (vecs[0].Ndim() != 4 && vecs[0].Ndim() != 5) errorQuda("Unexpected field dimension %d", vecs[0].Ndim());
+    if (prec != QUDA_HALF_PRECISION && prec != QUDA_QUARTER_PRECISION) errorQuda("Unsupported precision %d", prec);
+    const bool inflate = vecs[0].SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate;
+    auto spinor_parity = vecs[0].SuggestedParity();
+    if (inflate && spinor_parity != QUDA_EVEN_PARITY && spinor_parity != QUDA_ODD_PARITY)
+      errorQuda("When saving single parity vectors, the suggested parity must be set.");
+
+    // the geometry written is that of the (possibly inflated) staging field
+    ColorSpinorField tmp = create_compressed_staging(vecs[0], parity_inflate);
+    const ColorSpinorField &v0 = tmp.empty() ? vecs[0] : tmp;
+
+    auto fname = compressed_filename();
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Start saving %d vectors to %s.rank* in compressed format (precision = %d)\n", Nvec, filename.c_str(),
+                 prec);
+
+    quda::host_timer_t host_timer;
+    host_timer.start();
+
+    // one scale factor per site, matching the native fixed-point spinor field orders
+    const uint64_t block_length = v0.Nspin() * v0.Ncolor() * 2;
+    const uint64_t n_block = v0.Volume();
+
+    CompressedVectorHeader header = {};
+    memcpy(header.magic, compressed_magic, sizeof(compressed_magic));
+    header.version = compressed_version;
+    header.precision = prec;
+    header.real_size = v0.Precision();
+    header.nColor = v0.Ncolor();
+    header.nSpin = v0.Nspin();
+    header.nDim = v0.Ndim();
+    header.siteSubset = v0.SiteSubset();
+    header.nVec = Nvec;
+    for (int d = 0; d < v0.Ndim(); d++) header.x[d] = v0.X(d);
+    for (int d = 0; d < 4; d++) {
+      header.comm_dim[d] = comm_dim(d);
+      header.comm_coord[d] = comm_coord(d);
+    }
+    header.block_length = block_length;
+    header.n_block = n_block;
+
+    FILE *fp = fopen(fname.c_str(), "wb");
+    if (!fp) errorQuda("Unable to open file %s", fname.c_str());
+    if (fwrite(&header, sizeof(header), 1, fp) != 1) errorQuda("Failed to write header to %s", fname.c_str());
+
+    std::vector<float> scale(n_block);
+    std::vector<char> q(n_block * block_length * prec);
+
+    for (int i = 0; i < Nvec; i++) {
+      if (inflate)
+        blas::copy(spinor_parity == QUDA_EVEN_PARITY ? tmp.Even() : tmp.Odd(), vecs[i]);
+      else if (!tmp.empty())
+        tmp = vecs[i];
+      const ColorSpinorField &v = tmp.empty() ? vecs[i] : tmp;
+      if (prec == QUDA_HALF_PRECISION)
+        compress<short>(q.data(), scale.data(), v, n_block, block_length);
+      else
+        compress<int8_t>(q.data(), scale.data(), v, n_block, block_length);
+
+      if (fwrite(scale.data(), sizeof(float), n_block, fp) != n_block || fwrite(q.data(), 1, q.size(), fp) != q.size())
+        errorQuda("Failed to write vector %d to %s", i, fname.c_str());
+    }
+
+    fclose(fp);
+    comm_barrier();
+    host_timer.stop();
+
+    size_t bytes = sizeof(header) + Nvec * (n_block * sizeof(float) + q.size());
+    logQuda(QUDA_SUMMARIZE, "Time spent saving vectors to %s.rank* = %g secs (%lu bytes per rank, ratio %.2f)\n",
+            filename.c_str(), host_timer.last(), bytes,
+            static_cast<double>(Nvec) * n_block * block_length * header.real_size / bytes);
+    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done saving vectors\n");
+  }
+
+  void VectorIO::load(cvector_ref<ColorSpinorField> &vecs, QudaPrecision prec)
+  {
+    if (prec == QUDA_HALF_PRECISION || prec == QUDA_QUARTER_PRECISION) {
+      load_compressed(vecs);
+      return;
+    }
+
     const ColorSpinorField &v0 = vecs[0];
     const int Nvec = vecs.size();
     const QudaPrecision load_prec = v0.Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : v0.Precision();
@@ -83,6 +398,10 @@ namespace quda
   {
     const ColorSpinorField &v0 = vecs[0];
     const int Nvec = (size != 0 && size < vecs.size()) ? size : vecs.size();
+    if (prec == QUDA_HALF_PRECISION || prec == QUDA_QUARTER_PRECISION) {
+      save_compressed(vecs, prec, Nvec);
+      return;
+    }
     if (prec < QUDA_SINGLE_PRECISION && prec != QUDA_INVALID_PRECISION) errorQuda("Unsupported precision %d", prec);
     const QudaPrecision save_prec = prec != QUDA_INVALID_PRECISION ? prec :
       v0.Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : v0.Precision();
@@ -91,6 +91,7 @@ enum class Kernel {
   norm2,
   reDotProduct,
   axpbyzNorm,
+  xmyNormCopy,
   axpyCGNorm,
   caxpyNorm,
   cabxpyzAxNorm,
@@ -137,6 +138,7 @@ const std::map<Kernel, std::string> kernel_map
      {Kernel::norm2, "norm2"},
      {Kernel::reDotProduct, "reDotProduct"},
      {Kernel::axpbyzNorm, "axpbyzNorm"},
+     {Kernel::xmyNormCopy, "xmyNormCopy"},
      {Kernel::axpyCGNorm, "axpyCGNorm"},
      {Kernel::caxpyNorm, "caxpyNorm"},
      {Kernel::cabxpyzAxNorm, "cabxpyzAxNorm"},
@@ -430,6 +432,10 @@ protected:
         for (int i = 0; i < niter; ++i) blas::axpbyzNorm(a, xD, b, yD, zD);
         break;
 
+      case Kernel::xmyNormCopy:
+        for (int i = 0; i < niter; ++i) blas::xmyNormCopy(xoD, yoD, zD);
+        break;
+
       case Kernel::axpyCGNorm:
         for (int i = 0; i < niter; ++i) blas::axpyCGNorm(a, xD, yoD);
         break;
@@ -717,6 +723,17 @@ protected:
       }
       break;
 
+    case Kernel::xmyNormCopy:
+      xoD = xH;
+      yoD = yH;
+      {
+        double d = blas::xmyNormCopy(xoD, yoD, zD);
+        double h = blas::xmyNorm(xH, yH);
+        zH = yH;
+        error = ERROR(yo) + ERROR(z) + fabs(d - h) / fabs(h);
+      }
+      break;
+
     case Kernel::axpyCGNorm:
       xD = xH;
       yoD = yH;
@@ -0,0 +1,136 @@
+#include <numeric>
+#include <vector>
+
+#include <quda.h>
+#include <test.h>
+
+/*
+   This test checks the processor grid and rank placement advisor on
+   its own, without any communication: that the advised layout is
+   consistent with the lattice, rank count and node topology, that the
+   rank mapping of the layout is a bijection onto the ranks, and that
+   each node and socket block of the grid maps to consecutive ranks.
+ */
+
+// tuple types: number of ranks, ranks per node, ranks per socket
+using comm_advisor_test_t = ::testing::tuple<int, int, int>;
+
+class CommAdvisorTest : public ::testing::TestWithParam<comm_advisor_test_t>
+{
+protected:
+  int n_ranks;
+  QudaCommsTopology topology;
+  int lattice[4] = {16, 16, 16, 32};
+
+public:
+  CommAdvisorTest() : n_ranks(::testing::get<0>(GetParam()))
+  {
+    topology = {::testing::get<1>(GetParam()), ::testing::get<2>(GetParam()), 0.0, 0.0, 0.0};
+  }
+
+  /**
+     @brief Check a layout against the lattice and topology, and that
+     its rank mapping places every node and socket block on
+     consecutive ranks, with every rank used exactly once
+   */
+  void check(QudaCommsLayout &layout)
+  {
+    int grid_size = 1, node_size = 1, socket_size = 1;
+    for (int d = 0; d < 4; d++) {
+      ASSERT_GT(layout.grid[d], 0);
+      EXPECT_EQ((lattice[d] / layout.grid[d]) % 2, 0);
+      EXPECT_EQ(lattice[d] % layout.grid[d], 0);
+      EXPECT_EQ(layout.grid[d] % layout.node_grid[d], 0);
+      EXPECT_EQ(layout.node_grid[d] % layout.socket_grid[d], 0);
+      grid_size *= layout.grid[d];
+      node_size *= layout.node_grid[d];
+      socket_size *= layout.socket_grid[d];
+    }
+    EXPECT_EQ(grid_size, n_ranks);
+    EXPECT_EQ(node_size, topology.ranks_per_node);
+    EXPECT_EQ(socket_size, topology.ranks_per_socket);
+
+    std::vector<int> count(n_ranks, 0);
+    int x[4];
+    for (x[0] = 0; x[0] < layout.grid[0]; x[0]++)
+      for (x[1] = 0; x[1] < layout.grid[1]; x[1]++)
+        for (x[2] = 0; x[2] < layout.grid[2]; x[2]++)
+          for (x[3] = 0; x[3] < layout.grid[3]; x[3]++) {
+            int rank = rankFromCoordsLayoutQuda(x, &layout);
+            ASSERT_GE(rank, 0);
+            ASSERT_LT(rank, n_ranks);
+            count[rank]++;
+
+            // the node and socket of a rank are those of its block of the grid
+            int node = 0, socket = 0;
+            for (int d = 0; d < 4; d++) {
+              node = node * (layout.grid[d] / layout.node_grid[d]) + x[d] / layout.node_grid[d];
+              socket = socket * (layout.node_grid[d] / layout.socket_grid[d])
+                + (x[d] % layout.node_grid[d]) / layout.socket_grid[d];
+            }
+            EXPECT_EQ(rank / topology.ranks_per_node, node);
+            EXPECT_EQ((rank % topology.ranks_per_node) / topology.ranks_per_socket, socket);
+          }
+
+    for (int r = 0; r < n_ranks; r++) EXPECT_EQ(count[r], 1) << "rank " << r;
+  }
+};
+
+// the advisor chooses the grid freely
+TEST_P(CommAdvisorTest, free)
+{
+  QudaCommsLayout layout = {};
+  ASSERT_EQ(adviseCommsLayoutQuda(&layout, lattice, n_ranks, &topology), 0);
+  check(layout);
+}
+
+// the advisor keeps a fixed grid, and only chooses the placement
+TEST_P(CommAdvisorTest, fixed)
+{
+  QudaCommsLayout layout = {};
+  layout.grid[0] = 1;
+  layout.grid[1] = 1;
+  layout.grid[2] = n_ranks >= 4 ? 2 : 1;
+  layout.grid[3] = n_ranks / layout.grid[2];
+  QudaCommsLayout fixed = layout;
+  ASSERT_EQ(adviseCommsLayoutQuda(&layout, lattice, n_ranks, &topology), 0);
+  for (int d = 0; d < 4; d++) EXPECT_EQ(layout.grid[d], fixed.grid[d]);
+  check(layout);
+}
+
+using ::testing::Values;
+
+INSTANTIATE_TEST_SUITE_P(CommAdvisor, CommAdvisorTest,
+                         Values(comm_advisor_test_t(1, 1, 1), comm_advisor_test_t(2, 2, 1),
+                                comm_advisor_test_t(8, 4, 2), comm_advisor_test_t(16, 4, 4),
+                                comm_advisor_test_t(16, 8, 4), comm_advisor_test_t(32, 4, 1)),
+                         [](testing::TestParamInfo<comm_advisor_test_t> param) {
+                           return std::string("ranks") + std::to_string(::testing::get<0>(param.param)) + "_node"
+                             + std::to_string(::testing::get<1>(param.param)) + "_socket"
+                             + std::to_string(::testing::get<2>(param.param));
+                         });
+
+// invalid requests are reported through the return value, and leave the layout unchanged
+TEST(CommAdvisor, invalid)
+{
+  QudaCommsTopology topology = {4, 2, 0.0, 0.0, 0.0};
+  int lattice[4] = {16, 16, 16, 32};
+  int odd[4] = {16, 16, 15, 32};
+
+  QudaCommsLayout layout = {};
+  EXPECT_NE(adviseCommsLayoutQuda(&layout, odd, 8, &topology), 0);      // odd lattice extent
+  EXPECT_NE(adviseCommsLayoutQuda(&layout, lattice, 6, &topology), 0);  // ranks not a multiple of the ranks per node
+  EXPECT_NE(adviseCommsLayoutQuda(&layout, lattice, 0, &topology), 0);  // no ranks
+  EXPECT_NE(adviseCommsLayoutQuda(nullptr, lattice, 8, &topology), 0);  // null layout
+  layout.grid[0] = 3;
+  EXPECT_NE(adviseCommsLayoutQuda(&layout, lattice, 12, &topology), 0); // fixed extent does not divide the lattice
+  EXPECT_EQ(layout.grid[0], 3);
+  EXPECT_EQ(layout.node_grid[0], 0);
+}
+
+int main(int argc, char **argv)
+{
+  quda_test test("Comm Advisor Test", argc, argv);
+  test.init();
+  return test.execute();
+}
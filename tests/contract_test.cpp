@@ -17,6 +17,7 @@
 // In a typical application, quda.h is the only QUDA header required.
 #include <quda.h>
 #include <color_spinor_field.h>
+#include <contract_quda.h>
 
 // If you add a new contraction type, this must be updated++
 constexpr int NcontractType = 2;
@@ -166,6 +167,146 @@ int test(int contractionType, QudaPrecision test_prec)
   return faults;
 }
 
+// Performs the CPU GPU comparison of the momentum-projected time-slice contraction
+int test_summed(int contractionType, QudaPrecision test_prec)
+{
+  int X[4] = {xdim, ydim, zdim, tdim};
+
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setContractInvertParam(inv_param);
+  inv_param.cpu_prec = test_prec;
+  inv_param.cuda_prec = test_prec;
+  inv_param.cuda_prec_sloppy = test_prec;
+  inv_param.cuda_prec_precondition = test_prec;
+
+  constexpr int n_mom = 4;
+  const int mom[3 * n_mom] = {0, 0, 0, 1, 0, 0, 0, 1, 1, -1, 2, 0};
+  const int T = tdim * comm_dim(3);
+
+  size_t data_size = (test_prec == QUDA_DOUBLE_PRECISION) ? sizeof(double) : sizeof(float);
+  void *spinorX = safe_malloc(V * spinor_site_size * data_size);
+  void *spinorY = safe_malloc(V * spinor_site_size * data_size);
+  std::vector<double> d_result(2 * n_mom * T * 16);
+
+  if (test_prec == QUDA_SINGLE_PRECISION) {
+    for (auto i = 0lu; i < V * spinor_site_size; i++) {
+      ((float *)spinorX)[i] = rand() / (float)RAND_MAX;
+      ((float *)spinorY)[i] = rand() / (float)RAND_MAX;
+    }
+  } else {
+    for (auto i = 0lu; i < V * spinor_site_size; i++) {
+      ((double *)spinorX)[i] = rand() / (double)RAND_MAX;
+      ((double *)spinorY)[i] = rand() / (double)RAND_MAX;
+    }
+  }
+
+  QudaContractType cType = QUDA_CONTRACT_TYPE_INVALID;
+  switch (contractionType) {
+  case 0: cType = QUDA_CONTRACT_TYPE_OPEN; break;
+  case 1: cType = QUDA_CONTRACT_TYPE_DR; break;
+  default: errorQuda("Undefined contraction type %d\n", contractionType);
+  }
+
+  // Perform GPU contraction, momentum projection and time-slice sum
+  contractSummedQuda(spinorX, spinorY, d_result.data(), cType, mom, n_mom, &inv_param, X);
+
+  int faults = 0;
+  if (test_prec == QUDA_DOUBLE_PRECISION) {
+    faults = contraction_summed_reference((double *)spinorX, (double *)spinorY, d_result.data(), cType, mom, n_mom);
+  } else {
+    faults = contraction_summed_reference((float *)spinorX, (float *)spinorY, d_result.data(), cType, mom, n_mom);
+  }
+
+  printfQuda("Momentum-projected contraction comparison for contraction type %s complete with %d/%lu faults\n",
+             get_contract_str(cType), faults, d_result.size());
+
+  host_free(spinorX);
+  host_free(spinorY);
+
+  return faults;
+}
+
+// Compares the batched meson field, on both the device and host, against
+// the momentum-projected contraction of each pair of vectors
+int test_meson_field(int contractionType, QudaPrecision test_prec)
+{
+  int X[4] = {xdim, ydim, zdim, tdim};
+
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setContractInvertParam(inv_param);
+  inv_param.cpu_prec = test_prec;
+  inv_param.cuda_prec = test_prec;
+  inv_param.cuda_prec_sloppy = test_prec;
+  inv_param.cuda_prec_precondition = test_prec;
+
+  constexpr int N = 2;
+  constexpr int M = 3;
+  constexpr int n_mom = 2;
+  const int mom[3 * n_mom] = {0, 0, 0, 1, -1, 2};
+  const int T = tdim * comm_dim(3);
+
+  QudaContractType cType = QUDA_CONTRACT_TYPE_INVALID;
+  switch (contractionType) {
+  case 0: cType = QUDA_CONTRACT_TYPE_OPEN; break;
+  case 1: cType = QUDA_CONTRACT_TYPE_DR; break;
+  default: errorQuda("Undefined contraction type %d\n", contractionType);
+  }
+
+  lat_dim_t X_ = {X[0], X[1], X[2], X[3]};
+  ColorSpinorParam cpu_param(nullptr, inv_param, X_, false, QUDA_CPU_FIELD_LOCATION);
+  cpu_param.create = QUDA_ZERO_FIELD_CREATE;
+  ColorSpinorParam cuda_param(cpu_param);
+  cuda_param.location = QUDA_CUDA_FIELD_LOCATION;
+  cuda_param.create = QUDA_NULL_FIELD_CREATE;
+  cuda_param.setPrecision(test_prec, test_prec, true);
+
+  std::vector<ColorSpinorField> w_h(N, cpu_param), v_h(M, cpu_param);
+  std::vector<ColorSpinorField> w_d(N, cuda_param), v_d(M, cuda_param);
+  auto fill = [&](ColorSpinorField &h, ColorSpinorField &d) {
+    for (auto k = 0lu; k < V * spinor_site_size; k++) {
+      if (test_prec == QUDA_SINGLE_PRECISION)
+        h.data<float *>()[k] = rand() / (float)RAND_MAX;
+      else
+        h.data<double *>()[k] = rand() / (double)RAND_MAX;
+    }
+    d = h;
+  };
+  for (int i = 0; i < N; i++) fill(w_h[i], w_d[i]);
+  for (int j = 0; j < M; j++) fill(v_h[j], v_d[j]);
+
+  std::vector<array<int, 3>> mom_v(n_mom);
+  for (int p = 0; p < n_mom; p++)
+    for (int d = 0; d < 3; d++) mom_v[p][d] = mom[3 * p + d];
+
+  std::vector<Complex> meson_d, meson_h;
+  contractMesonFieldQuda(w_d, v_d, meson_d, cType, mom_v);
+  contractMesonFieldQuda(w_h, v_h, meson_h, cType, mom_v);
+
+  double tol = (test_prec == QUDA_DOUBLE_PRECISION ? 1e-9 : 2e-5) * sqrt(V);
+  int faults = 0;
+  std::vector<double> summed(2 * n_mom * T * 16);
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < M; j++) {
+      contractSummedQuda(w_h[i].data(), v_h[j].data(), summed.data(), cType, mom, n_mom, &inv_param, X);
+      for (int p = 0; p < n_mom; p++) {
+        for (int t = 0; t < T; t++) {
+          for (int g = 0; g < 16; g++) {
+            Complex ref(summed[2 * ((p * T + t) * 16 + g)], summed[2 * ((p * T + t) * 16 + g) + 1]);
+            auto idx = (((t * n_mom + p) * 16 + g) * N + i) * M + j;
+            if (abs(meson_d[idx] - ref) > tol) faults++;
+            if (abs(meson_h[idx] - ref) > tol) faults++;
+          }
+        }
+      }
+    }
+  }
+
+  printfQuda("Meson field comparison for contraction type %s complete with %d/%lu faults\n", get_contract_str(cType),
+             faults, 2 * meson_d.size());
+
+  return faults;
+}
+
 // The following tests gets each contraction type and precision using google testing framework
 using ::testing::Bool;
 using ::testing::Combine;
@@ -193,6 +334,24 @@ TEST_P(ContractionTest, verify)
   EXPECT_EQ(faults, 0) << "CPU and GPU implementations do not agree";
 }
 
+TEST_P(ContractionTest, momentum)
+{
+  QudaPrecision prec = getPrecision(::testing::get<0>(GetParam()));
+  int contractionType = ::testing::get<1>(GetParam());
+  if ((QUDA_PRECISION & prec) == 0) GTEST_SKIP();
+  auto faults = test_summed(contractionType, prec);
+  EXPECT_EQ(faults, 0) << "CPU and GPU momentum-projected contractions do not agree";
+}
+
+TEST_P(ContractionTest, meson_field)
+{
+  QudaPrecision prec = getPrecision(::testing::get<0>(GetParam()));
+  int contractionType = ::testing::get<1>(GetParam());
+  if ((QUDA_PRECISION & prec) == 0) GTEST_SKIP();
+  auto faults = test_meson_field(contractionType, prec);
+  EXPECT_EQ(faults, 0) << "Meson field and pairwise contractions do not agree";
+}
+
 // Helper function to construct the test name
 std::string getContractName(testing::TestParamInfo<::testing::tuple<int, int>> param)
 {
@@ -96,6 +96,138 @@ TEST_P(DilutionTest, verify)
   }
 }
 
+TEST_P(DilutionTest, batched)
+{
+  using namespace quda;
+
+  if (!is_enabled_spin(nSpin)) GTEST_SKIP();
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setWilsonGaugeParam(gauge_param);
+  setInvertParam(inv_param);
+
+  ColorSpinorParam param;
+  constructWilsonTestSpinorParam(&param, &inv_param, &gauge_param);
+  param.siteSubset = site_subset;
+  if (site_subset == QUDA_PARITY_SITE_SUBSET) param.x[0] /= 2;
+  param.nSpin = nSpin;
+  param.setPrecision(inv_param.cuda_prec, inv_param.cuda_prec, true);
+  param.location = QUDA_CUDA_FIELD_LOCATION;
+  param.create = QUDA_NULL_FIELD_CREATE;
+  ColorSpinorField src(param);
+
+  // compose the non-block types with time dilution, and use the
+  // requested block size otherwise
+  lat_dim_t block_size;
+  if (dilution_type == QUDA_DILUTION_BLOCK) {
+    block_size = {dilution_block_size[0], dilution_block_size[1], dilution_block_size[2], dilution_block_size[3]};
+    if (src.SiteSubset() == QUDA_PARITY_SITE_SUBSET) block_size[0] /= 2;
+  } else {
+    block_size = {src.X(0) * comm_dim(0), src.X(1) * comm_dim(1), src.X(2) * comm_dim(2), 1};
+  }
+
+  spinorNoise(src, 1234, QUDA_NOISE_GAUSS);
+
+  const int n = spinorDiluteSize(src, dilution_type, block_size);
+  const int batch = 5; // deliberately not commensurate with the pattern
+  logQuda(QUDA_VERBOSE, "Dilution set size = %d, batch size = %d\n", n, batch);
+
+  std::vector<ColorSpinorField> v(batch, param);
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  ColorSpinorField sum(param);
+
+  double norm2 = 0.0;
+  for (int offset = 0; offset < n; offset += batch) {
+    vector_ref<ColorSpinorField> v_batch(v.begin(), v.begin() + std::min(batch, n - offset));
+    spinorDilute(v_batch, src, dilution_type, block_size, offset);
+    for (auto i = 0u; i < v_batch.size(); i++) norm2 += blas::norm2(v_batch[i]);
+    blas::axpy(std::vector<double>(v_batch.size(), 1.0), v_batch, sum);
+  }
+
+  // the elements of the set are disjoint and their sum is the source
+  EXPECT_NEAR(norm2 / blas::norm2(src), 1.0, getTolerance(inv_param.cuda_prec));
+  EXPECT_EQ(blas::xmyNorm(src, sum), 0.0);
+}
+
+class DilutedNoiseTest : public ::testing::TestWithParam<QudaGammaBasis>
+{
+};
+
+TEST_P(DilutedNoiseTest, spin)
+{
+  using namespace quda;
+
+  if (!is_enabled_spin(4)) GTEST_SKIP();
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setWilsonGaugeParam(gauge_param);
+  setInvertParam(inv_param);
+  gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  inv_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  inv_param.dslash_type = QUDA_WILSON_DSLASH;
+  inv_param.inv_type = QUDA_BICGSTAB_INVERTER;
+  inv_param.solution_type = QUDA_MAT_SOLUTION;
+  inv_param.solve_type = QUDA_DIRECT_PC_SOLVE;
+  inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.num_src = 0;
+  inv_param.gamma_basis = GetParam();
+
+  setDims(gauge_param.X);
+  std::vector<char> gauge_(4 * V * gauge_site_size * sizeof(double));
+  void *gauge[4];
+  for (int i = 0; i < 4; i++) gauge[i] = gauge_.data() + i * V * gauge_site_size * sizeof(double);
+  constructQudaGaugeField(gauge, 1, gauge_param.cpu_prec, &gauge_param);
+  loadGaugeQuda(gauge, &gauge_param);
+
+  // spin dilution in the user's basis: each diluted source, recovered
+  // by applying the operator to its solution, must be supported on a
+  // single spin component in that basis
+  constexpr int n = 4;
+  std::vector<double> noise(V * spinor_site_size);
+  std::vector<std::vector<double>> x(n, std::vector<double>(V * spinor_site_size));
+  std::vector<double> b(V * spinor_site_size);
+  std::vector<void *> hp_x(n);
+  for (int i = 0; i < n; i++) hp_x[i] = x[i].data();
+
+  invertDilutedNoiseQuda(hp_x.data(), noise.data(), &inv_param, gauge, &gauge_param, 1234, QUDA_NOISE_GAUSS,
+                         QUDA_DILUTION_SPIN, nullptr);
+
+  std::vector<double> sum(V * spinor_site_size, 0.0);
+  for (int i = 0; i < n; i++) {
+    MatQuda(b.data(), x[i].data(), &inv_param);
+    double norm2[4] = {};
+    for (int x_ = 0; x_ < V; x_++) {
+      for (int s = 0; s < 4; s++) {
+        for (int c = 0; c < 6; c++) {
+          double v = b[x_ * spinor_site_size + s * 6 + c];
+          norm2[s] += v * v;
+        }
+      }
+    }
+    for (size_t j = 0; j < b.size(); j++) sum[j] += b[j];
+    double total = norm2[0] + norm2[1] + norm2[2] + norm2[3];
+    quda::comm_allreduce_sum(total);
+    quda::comm_allreduce_sum(norm2[i]);
+    logQuda(QUDA_VERBOSE, "Diluted source %d: fraction outside spin %d = %e\n", i, i, 1.0 - norm2[i] / total);
+    EXPECT_LE(1.0 - norm2[i] / total, 1e-6);
+  }
+
+  // and the diluted sources must sum to the returned noise
+  double dev2 = 0.0, norm2 = 0.0;
+  for (size_t j = 0; j < sum.size(); j++) {
+    dev2 += (sum[j] - noise[j]) * (sum[j] - noise[j]);
+    norm2 += noise[j] * noise[j];
+  }
+  quda::comm_allreduce_sum(dev2);
+  quda::comm_allreduce_sum(norm2);
+  EXPECT_LE(dev2 / norm2, 1e-6);
+
+  freeGaugeQuda();
+}
+
 using ::testing::Combine;
 using ::testing::Values;
 
@@ -142,6 +274,11 @@ INSTANTIATE_TEST_SUITE_P(StaggeredParity, DilutionTest,
                            return get_dilution_type_str(::testing::get<1>(param.param));
                          });
 
+INSTANTIATE_TEST_SUITE_P(Wilson, DilutedNoiseTest, Values(QUDA_UKQCD_GAMMA_BASIS, QUDA_DEGRAND_ROSSI_GAMMA_BASIS),
+                         [](testing::TestParamInfo<QudaGammaBasis> param) {
+                           return param.param == QUDA_UKQCD_GAMMA_BASIS ? "UKQCD" : "DeGrandRossi";
+                         });
+
 struct dilution_test : quda_test {
   void display_info() const override
   {
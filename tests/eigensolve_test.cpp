@@ -36,7 +36,8 @@ void display_test_info(QudaEigParam &param)
   printfQuda("\n   Eigensolver parameters\n");
   printfQuda(" - solver mode %s\n", get_eig_type_str(param.eig_type));
   printfQuda(" - spectrum requested %s\n", get_eig_spectrum_str(param.spectrum));
-  if (param.eig_type == QUDA_EIG_BLK_TR_LANCZOS) printfQuda(" - eigenvector block size %d\n", param.block_size);
+  if (param.eig_type == QUDA_EIG_BLK_TR_LANCZOS || param.eig_type == QUDA_EIG_CHFSI)
+    printfQuda(" - eigenvector block size %d\n", param.block_size);
   printfQuda(" - number of eigenvectors requested %d\n", param.n_conv);
   printfQuda(" - size of eigenvector search space %d\n", param.n_ev);
   printfQuda(" - size of Krylov space %d\n", param.n_kr);
@@ -143,14 +144,17 @@ std::vector<double> eigensolve(test_t test_param)
 
   // For gtest testing, we prohibit the use of polynomial acceleration as
   // the fine tuning required can inhibit convergence of an otherwise
-  // perfectly good algorithm. We also have a default value of 4
+  // perfectly good algorithm. The exception is CHFSI, which is built on
+  // the Chebyshev filter, so there we re-estimate the maximum for each
+  // operator. We also have a default value of 4
   // for the block size in Block TRLM, and 4 for the batched rotation.
   // The user may change these values via the command line:
   // --eig-block-size
   // --eig-batched-rotate
   if (enable_testing) {
-    eig_use_poly_acc = false;
-    eig_param.use_poly_acc = QUDA_BOOLEAN_FALSE;
+    eig_use_poly_acc = eig_param.eig_type == QUDA_EIG_CHFSI;
+    eig_param.use_poly_acc = eig_use_poly_acc ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+    eig_param.a_max = eig_amax;
     eig_block_size != 4 ? eig_param.block_size = eig_block_size : eig_param.block_size = 4;
     eig_batched_rotate != 0 ? eig_param.batched_rotate = eig_batched_rotate : eig_param.batched_rotate = 4;
   }
@@ -13,6 +13,7 @@
 
 #include <pgauge_monte.h>
 #include <random_quda.h>
+#include <color_spinor_field.h>
 #include <unitarization_links.h>
 
 #include <qio_field.h>
@@ -34,6 +35,29 @@ bool gauge_store;
 
 std::array<std::vector<char>, 4> host_gauge;
 
+/**
+   @brief Reference Philox4x32-10 block function, used to check the
+   counter-based generator independently of the library
+   @param[in] seed The 64-bit key
+   @param[in] ctr The 128-bit counter
+   @param[out] out The four 32-bit words of output
+ */
+void philox_reference(uint64_t seed, const uint32_t ctr[4], uint32_t out[4])
+{
+  uint32_t c[4] = {ctr[0], ctr[1], ctr[2], ctr[3]};
+  uint32_t k[2] = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+  for (int r = 0; r < 10; r++) {
+    uint64_t p0 = static_cast<uint64_t>(0xD2511F53) * c[0];
+    uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57) * c[2];
+    uint32_t t[4] = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<uint32_t>(p1),
+                     static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<uint32_t>(p0)};
+    for (int i = 0; i < 4; i++) c[i] = t[i];
+    k[0] += 0x9E3779B9;
+    k[1] += 0xBB67AE85;
+  }
+  for (int i = 0; i < 4; i++) out[i] = c[i];
+}
+
 class GaugeAlgTest : public ::testing::Test
 {
 protected:
@@ -231,20 +255,16 @@ protected:
   virtual void run_fft()
   {
     if (execute) {
-      if (!comm_partitioned()) {
-        printfQuda("Landau gauge fixing with steepest descent method with FFTs\n");
-        gaugeFixingFFT(*U, gf_gauge_dir, gf_maxiter, gf_verbosity_interval, gf_fft_alpha, gf_fft_autotune, gf_tolerance,
-                       gf_theta_condition);
-
-        auto plaq_gf = plaquette(*U);
-        printfQuda("Plaq:    %.16e, %.16e, %.16e\n", plaq.x, plaq.y, plaq.z);
-        printfQuda("Plaq GF: %.16e, %.16e, %.16e\n", plaq_gf.x, plaq_gf.y, plaq_gf.z);
-        ASSERT_TRUE(comparePlaquette(plaq, plaq_gf));
-        // Save if output string is specified
-        if (gauge_store) save_gauge();
-      } else {
-        errorQuda("Cannot perform FFT gauge fixing with MPI partitions.");
-      }
+      printfQuda("Landau gauge fixing with steepest descent method with FFTs\n");
+      gaugeFixingFFT(*U, gf_gauge_dir, gf_maxiter, gf_verbosity_interval, gf_fft_alpha, gf_fft_autotune, gf_tolerance,
+                     gf_theta_condition);
+
+      auto plaq_gf = plaquette(*U);
+      printfQuda("Plaq:    %.16e, %.16e, %.16e\n", plaq.x, plaq.y, plaq.z);
+      printfQuda("Plaq GF: %.16e, %.16e, %.16e\n", plaq_gf.x, plaq_gf.y, plaq_gf.z);
+      ASSERT_TRUE(comparePlaquette(plaq, plaq_gf));
+      // Save if output string is specified
+      if (gauge_store) save_gauge();
     }
   }
 
@@ -288,6 +308,230 @@ TEST_F(GaugeAlgTest, Generation)
   }
 }
 
+TEST_F(GaugeAlgTest, CounterRNG)
+{
+  if (execute) {
+    // the counter-based generator must reproduce the same field
+    // independently of autotuning, and a heatbath sweep from the same
+    // starting configuration must reproduce the same ensemble
+    GaugeFieldParam gParam(*U);
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    GaugeField V(gParam);
+
+    double3 plaq_rng[2];
+    for (int i = 0; i < 2; i++) {
+      RNG rng(V, 4321, true);
+      gaugeGauss(V, rng, 0.5);
+      Monte(V, rng, heatbath_beta_value, 1, 1);
+      plaq_rng[i] = plaquette(V);
+    }
+    printfQuda("Counter RNG plaq: %.16e, %.16e\n", plaq_rng[0].x, plaq_rng[1].x);
+    ASSERT_EQ(plaq_rng[0].x, plaq_rng[1].x);
+    ASSERT_EQ(plaq_rng[0].y, plaq_rng[1].y);
+    ASSERT_EQ(plaq_rng[0].z, plaq_rng[1].z);
+
+    // the stream is a pure function of the global site, so noise
+    // generated on the host (space-spin-color order) and on the device
+    // (native order) must agree, and both must match the values drawn
+    // for the same global site of an unpartitioned lattice
+    ColorSpinorParam cs_param;
+    cs_param.nColor = 3;
+    cs_param.nSpin = 4;
+    cs_param.nDim = 4;
+    for (int d = 0; d < 4; d++) cs_param.x[d] = U->X()[d] - 2 * U->R()[d];
+    cs_param.siteSubset = QUDA_FULL_SITE_SUBSET;
+    cs_param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+    cs_param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+    cs_param.setPrecision(QUDA_DOUBLE_PRECISION);
+    cs_param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    cs_param.create = QUDA_ZERO_FIELD_CREATE;
+    cs_param.pc_type = QUDA_4D_PC;
+    cs_param.location = QUDA_CPU_FIELD_LOCATION;
+    ColorSpinorField host(cs_param);
+    ColorSpinorField device_copy(cs_param);
+
+    ColorSpinorParam device_param(cs_param);
+    device_param.location = QUDA_CUDA_FIELD_LOCATION;
+    device_param.setPrecision(QUDA_DOUBLE_PRECISION, QUDA_DOUBLE_PRECISION, true);
+    ColorSpinorField device(device_param);
+
+    const int nSpin = cs_param.nSpin;
+    const int nColor = cs_param.nColor;
+    const auto *h = host.data<std::complex<double> *>();
+    const auto *d = device_copy.data<std::complex<double> *>();
+
+    for (auto noise : {QUDA_NOISE_UNIFORM, QUDA_NOISE_GAUSS}) {
+      RNG rng_host(host, 4321, true);
+      RNG rng_device(device, 4321, true);
+      spinorNoise(host, rng_host, noise);
+      spinorNoise(device, rng_device, noise);
+      device_copy.copy(device);
+
+      // the uniform stream is bit exact, the Gaussian transform may differ in the last ulp
+      double max_dev = 0.0;
+      for (auto i = 0u; i < host.Volume() * nSpin * nColor; i++) max_dev = std::max(max_dev, std::abs(h[i] - d[i]));
+      printfQuda("Counter RNG %s host vs device max deviation %e\n", noise == QUDA_NOISE_UNIFORM ? "uniform" : "gauss",
+                 max_dev);
+      if (noise == QUDA_NOISE_UNIFORM)
+        EXPECT_EQ(max_dev, 0.0);
+      else
+        EXPECT_LE(max_dev, 1e-12);
+    }
+
+    // regenerate the uniform field and compare with a reference
+    // generator indexed by the global coordinate, as for a lattice that
+    // is not partitioned
+    RNG rng_host(host, 4321, true);
+    spinorNoise(host, rng_host, QUDA_NOISE_UNIFORM);
+
+    // check the reference against the published known-answer vector
+    uint32_t zero[4] = {0, 0, 0, 0}, kat[4];
+    philox_reference(0, zero, kat);
+    EXPECT_EQ(kat[0], 0x6627e8d5u);
+    EXPECT_EQ(kat[1], 0xe169c58du);
+    EXPECT_EQ(kat[2], 0xbc57ac4cu);
+    EXPECT_EQ(kat[3], 0x9b00dbd8u);
+
+    int X[4], G[4];
+    for (int i = 0; i < 4; i++) {
+      X[i] = cs_param.x[i];
+      G[i] = X[i] * comm_dim(i);
+    }
+
+    size_t mismatch = 0;
+    int x[4];
+    for (x[3] = 0; x[3] < X[3]; x[3]++) {
+      for (x[2] = 0; x[2] < X[2]; x[2]++) {
+        for (x[1] = 0; x[1] < X[1]; x[1]++) {
+          for (x[0] = 0; x[0] < X[0]; x[0]++) {
+            int g[4];
+            for (int i = 0; i < 4; i++) g[i] = x[i] + comm_coord(i) * X[i];
+            int parity = (x[0] + x[1] + x[2] + x[3]) & 1;
+            int x_cb = (((x[3] * X[2] + x[2]) * X[1] + x[1]) * X[0] + x[0]) / 2;
+            uint64_t site = ((static_cast<uint64_t>(g[3]) * G[2] + g[2]) * G[1] + g[1]) * G[0] + g[0];
+
+            // the first use of the generator is stream 0, and each site
+            // draws two 53-bit uniform deviates per spin-color component
+            uint32_t ctr[4] = {0, static_cast<uint32_t>(site), static_cast<uint32_t>(site >> 32), 0};
+            uint32_t words[4];
+            int n_word = 4;
+            auto next = [&]() {
+              if (n_word == 4) {
+                philox_reference(4321, ctr, words);
+                ctr[0]++;
+                n_word = 0;
+              }
+              return words[n_word++];
+            };
+            auto uniform = [&]() {
+              uint64_t a = next() >> 5;
+              uint64_t b = next() >> 6;
+              return static_cast<double>((a << 26) + b) * 0x1.0p-53 + 0x1.0p-54;
+            };
+
+            for (int i = 0; i < nSpin * nColor; i++) {
+              double re = uniform();
+              double im = uniform();
+              if (h[(parity * host.VolumeCB() + x_cb) * nSpin * nColor + i] != std::complex<double>(re, im)) mismatch++;
+            }
+          }
+        }
+      }
+    }
+    printfQuda("Counter RNG mismatches against the unpartitioned stream = %lu\n", mismatch);
+    EXPECT_EQ(mismatch, 0u);
+  }
+}
+
+TEST_F(GaugeAlgTest, HostHeatbath)
+{
+  if (execute) {
+    // with the counter-based generator, a sweep of the threaded host
+    // heatbath must reproduce the device one, which on a partitioned
+    // lattice overlaps the halo exchange with the interior update
+    GaugeFieldParam deviceParam(*U);
+    deviceParam.reconstruct = QUDA_RECONSTRUCT_NO;
+    deviceParam.create = QUDA_NULL_FIELD_CREATE;
+    deviceParam.setPrecision(QUDA_DOUBLE_PRECISION, true);
+    GaugeField U_device(deviceParam);
+    U_device.copy(*U);
+    U_device.exchangeExtendedGhost(U_device.R());
+
+    GaugeFieldParam hostParam(U_device);
+    hostParam.location = QUDA_CPU_FIELD_LOCATION;
+    hostParam.order = QUDA_QDP_GAUGE_ORDER;
+    GaugeField U_host(hostParam);
+    U_host.copy(U_device);
+    U_host.exchangeExtendedGhost(U_host.R());
+
+    RNG rng_device(U_device, 4321, true);
+    RNG rng_host(U_host, 4321, true);
+    MonteMultiHit(U_device, rng_device, heatbath_beta_value, 2, true);
+    MonteMultiHit(U_host, rng_host, heatbath_beta_value, 2, true);
+
+    GaugeField U_check(deviceParam);
+    U_check.copy(U_host);
+    double3 plaq_device = plaquette(U_device);
+    double3 plaq_host = plaquette(U_check);
+    printfQuda("Heatbath plaq device %.16e host %.16e\n", plaq_device.x, plaq_host.x);
+    EXPECT_LE(std::abs(plaq_device.x - plaq_host.x), 1e-12);
+    EXPECT_LE(std::abs(plaq_device.y - plaq_host.y), 1e-12);
+    EXPECT_LE(std::abs(plaq_device.z - plaq_host.z), 1e-12);
+  }
+}
+
+TEST_F(GaugeAlgTest, FusedObservables)
+{
+  if (execute) {
+    // the fused single-pass observables must agree with the separate
+    // plaquette, Fmunu and charge kernels, and the host path with the
+    // device path
+    double plaq_fused[3], energy_fused[3], q_fused;
+    computeFusedGaugeObservables(*U, plaq_fused, energy_fused, q_fused);
+
+    double3 plaq_ref = plaquette(*U);
+    lat_dim_t x;
+    for (int i = 0; i < 4; i++) x[i] = U->X()[i] - 2 * U->R()[i];
+    GaugeFieldParam tensorParam(x, U->Precision(), QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
+    tensorParam.location = QUDA_CUDA_FIELD_LOCATION;
+    tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+    tensorParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+    tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+    GaugeField Fmunu(tensorParam);
+    computeFmunu(Fmunu, *U);
+    double energy_ref[3], q_ref;
+    computeQCharge(energy_ref, q_ref, Fmunu);
+
+    GaugeFieldParam hostParam(*U);
+    hostParam.location = QUDA_CPU_FIELD_LOCATION;
+    hostParam.order = QUDA_QDP_GAUGE_ORDER;
+    hostParam.reconstruct = QUDA_RECONSTRUCT_NO;
+    hostParam.create = QUDA_NULL_FIELD_CREATE;
+    hostParam.setPrecision(QUDA_DOUBLE_PRECISION);
+    GaugeField U_host(hostParam);
+    U_host.copy(*U);
+    double plaq_host[3], energy_host[3], q_host;
+    computeFusedGaugeObservables(U_host, plaq_host, energy_host, q_host);
+
+    printfQuda("Plaq   fused %.16e unfused %.16e host %.16e\n", plaq_fused[0], plaq_ref.x, plaq_host[0]);
+    printfQuda("Energy fused %.16e unfused %.16e host %.16e\n", energy_fused[0], energy_ref[0], energy_host[0]);
+    printfQuda("Charge fused %.16e unfused %.16e host %.16e\n", q_fused, q_ref, q_host);
+
+    // the device precision bounds the agreement
+    const double tol = prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+    auto compare = [&](double a, double b) { EXPECT_LE(std::abs(a - b), tol * std::max(1.0, std::abs(b))); };
+    double plaq_ref_[3] = {plaq_ref.x, plaq_ref.y, plaq_ref.z};
+    for (int i = 0; i < 3; i++) {
+      compare(plaq_fused[i], plaq_ref_[i]);
+      compare(plaq_host[i], plaq_fused[i]);
+      compare(energy_fused[i], energy_ref[i]);
+      compare(energy_host[i], energy_fused[i]);
+    }
+    compare(q_fused, q_ref);
+    compare(q_host, q_fused);
+  }
+}
+
 TEST_F(GaugeAlgTest, Landau_Overrelaxation)
 {
   if (execute) {
@@ -317,30 +561,26 @@ TEST_F(GaugeAlgTest, Coulomb_Overrelaxation)
 TEST_F(GaugeAlgTest, Landau_FFT)
 {
   if (execute) {
-    if (!comm_partitioned()) {
-      printfQuda("Landau gauge fixing with steepest descent method with FFTs\n");
-      gaugeFixingFFT(*U, 4, gf_maxiter, gf_verbosity_interval, gf_fft_alpha, gf_fft_autotune, gf_tolerance,
-                     gf_theta_condition);
-      auto plaq_gf = plaquette(*U);
-      printfQuda("Plaq:    %.16e, %.16e, %.16e\n", plaq.x, plaq.y, plaq.z);
-      printfQuda("Plaq GF: %.16e, %.16e, %.16e\n", plaq_gf.x, plaq_gf.y, plaq_gf.z);
-      ASSERT_TRUE(comparePlaquette(plaq, plaq_gf));
-    }
+    printfQuda("Landau gauge fixing with steepest descent method with FFTs\n");
+    gaugeFixingFFT(*U, 4, gf_maxiter, gf_verbosity_interval, gf_fft_alpha, gf_fft_autotune, gf_tolerance,
+                   gf_theta_condition);
+    auto plaq_gf = plaquette(*U);
+    printfQuda("Plaq:    %.16e, %.16e, %.16e\n", plaq.x, plaq.y, plaq.z);
+    printfQuda("Plaq GF: %.16e, %.16e, %.16e\n", plaq_gf.x, plaq_gf.y, plaq_gf.z);
+    ASSERT_TRUE(comparePlaquette(plaq, plaq_gf));
   }
 }
 
 TEST_F(GaugeAlgTest, Coulomb_FFT)
 {
   if (execute) {
-    if (!comm_partitioned()) {
-      printfQuda("Coulomb gauge fixing with steepest descent method with FFTs\n");
-      gaugeFixingFFT(*U, 4, gf_maxiter, gf_verbosity_interval, gf_fft_alpha, gf_fft_autotune, gf_tolerance,
-                     gf_theta_condition);
-      auto plaq_gf = plaquette(*U);
-      printfQuda("Plaq:    %.16e, %.16e, %.16e\n", plaq.x, plaq.y, plaq.z);
-      printfQuda("Plaq GF: %.16e, %.16e, %.16e\n", plaq_gf.x, plaq_gf.y, plaq_gf.z);
-      ASSERT_TRUE(comparePlaquette(plaq, plaq_gf));
-    }
+    printfQuda("Coulomb gauge fixing with steepest descent method with FFTs\n");
+    gaugeFixingFFT(*U, 4, gf_maxiter, gf_verbosity_interval, gf_fft_alpha, gf_fft_autotune, gf_tolerance,
+                   gf_theta_condition);
+    auto plaq_gf = plaquette(*U);
+    printfQuda("Plaq:    %.16e, %.16e, %.16e\n", plaq.x, plaq.y, plaq.z);
+    printfQuda("Plaq GF: %.16e, %.16e, %.16e\n", plaq_gf.x, plaq_gf.y, plaq_gf.z);
+    ASSERT_TRUE(comparePlaquette(plaq, plaq_gf));
   }
 }
 
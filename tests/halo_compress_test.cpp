@@ -0,0 +1,105 @@
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <halo_compress.h>
+#include <test.h>
+
+/*
+   This test checks that the halo encoding round trips, for both the
+   verbatim (RAW) and the compressed (PACKED) formats, for every word
+   size used by the ghost precisions, and for face sizes that are not
+   a multiple of the word size (the trailing bytes are stored
+   verbatim).
+ */
+
+using namespace quda;
+
+// tuple types: compress, word size, trailing bytes
+using halo_compress_test_t = ::testing::tuple<bool, int, int>;
+
+class HaloCompressTest : public ::testing::TestWithParam<halo_compress_test_t>
+{
+protected:
+  bool compress;
+  int word;
+  size_t bytes;
+
+public:
+  HaloCompressTest() :
+    compress(::testing::get<0>(GetParam())),
+    word(::testing::get<1>(GetParam())),
+    bytes(1024 * word + ::testing::get<2>(GetParam()))
+  {
+  }
+
+  /**
+     @brief Round trip a buffer through encode and decode
+     @param[in] src The buffer to encode
+     @return The encoded size
+   */
+  size_t round_trip(const std::vector<uint8_t> &src)
+  {
+    std::vector<uint8_t> encoded(halo_compress::max_bytes(bytes));
+    std::vector<uint8_t> decoded(bytes);
+
+    auto size = halo_compress::encode(encoded.data(), src.data(), bytes, word, compress);
+    EXPECT_LE(size, encoded.size());
+    halo_compress::decode(decoded.data(), encoded.data(), bytes);
+    EXPECT_EQ(memcmp(src.data(), decoded.data(), bytes), 0);
+    return size;
+  }
+};
+
+// bytes drawn from a small alphabet in the most significant byte of each word, as for a floating-point exponent
+TEST_P(HaloCompressTest, compressible)
+{
+  std::mt19937 rng(1234);
+  std::vector<uint8_t> src(bytes);
+  for (auto i = 0u; i < bytes; i++) src[i] = i % word == word - 1 ? 0x3c + rng() % 4 : rng() % 256;
+
+  auto size = round_trip(src);
+  if (compress)
+    EXPECT_LT(size, halo_compress::max_bytes(bytes)); // PACKED
+  else
+    EXPECT_EQ(size, halo_compress::max_bytes(bytes)); // RAW
+}
+
+// uniformly random bytes do not compress, and must fall back to the verbatim format
+TEST_P(HaloCompressTest, random)
+{
+  std::mt19937 rng(5678);
+  std::vector<uint8_t> src(bytes);
+  for (auto &s : src) s = rng() % 256;
+
+  EXPECT_EQ(round_trip(src), halo_compress::max_bytes(bytes));
+}
+
+// constant words compress to the dictionary alone
+TEST_P(HaloCompressTest, constant)
+{
+  std::vector<uint8_t> src(bytes);
+  for (auto i = 0u; i < bytes; i++) src[i] = i % word;
+
+  auto size = round_trip(src);
+  if (compress) EXPECT_LT(size, halo_compress::max_bytes(bytes));
+}
+
+using ::testing::Combine;
+using ::testing::Values;
+
+INSTANTIATE_TEST_SUITE_P(HaloCompress, HaloCompressTest, Combine(Values(false, true), Values(1, 2, 4, 8), Values(0, 1, 3, 7)),
+                         [](testing::TestParamInfo<halo_compress_test_t> param) {
+                           std::string name;
+                           name += ::testing::get<0>(param.param) ? "packed" : "raw";
+                           name += std::string("_word") + std::to_string(::testing::get<1>(param.param));
+                           name += std::string("_tail") + std::to_string(::testing::get<2>(param.param));
+                           return name;
+                         });
+
+int main(int argc, char **argv)
+{
+  quda_test test("Halo Compress Test", argc, argv);
+  test.init();
+  return test.execute();
+}
@@ -156,7 +156,10 @@ void heatbath_test(int argc, char **argv)
     // Do a warmup if requested
     if (nwarm > 0) {
       for (int step = 1; step <= nwarm; ++step) {
-        Monte(gaugeEx, randstates, beta_value, nhbsteps, novrsteps);
+        if (heatbath_multi_hit)
+          MonteMultiHit(gaugeEx, randstates, beta_value, nhbsteps, novrsteps > 0);
+        else
+          Monte(gaugeEx, randstates, beta_value, nhbsteps, novrsteps);
 
         quda::unitarizeLinks(gaugeEx, &num_failures_d);
         if (num_failures_h > 0) errorQuda("Error in the unitarization\n");
@@ -177,7 +180,10 @@ void heatbath_test(int argc, char **argv)
     freeGaugeQuda();
 
     for (int step = 1; step <= nsteps; ++step) {
-      Monte(gaugeEx, randstates, beta_value, nhbsteps, novrsteps);
+      if (heatbath_multi_hit)
+        MonteMultiHit(gaugeEx, randstates, beta_value, nhbsteps, novrsteps > 0);
+      else
+        Monte(gaugeEx, randstates, beta_value, nhbsteps, novrsteps);
 
       // Reunitarize gauge links...
       quda::unitarizeLinks(gaugeEx, &num_failures_d);
@@ -231,3 +231,51 @@ int contraction_reference(Float *spinorX, Float *spinorY, Float *d_result, QudaC
   host_free(h_result);
   return faults;
 };
+
+template <typename Float>
+int contraction_summed_reference(Float *spinorX, Float *spinorY, const double *d_result, QudaContractType cType,
+                                 const int *mom, int n_mom)
+{
+  int faults = 0;
+  double tol = (sizeof(Float) == sizeof(double) ? 1e-9 : 2e-5) * sqrt(V);
+  void *h_result = safe_malloc(V * 2 * 16 * sizeof(Float));
+
+  // compute spin elementals
+  contractColor(spinorX, spinorY, (Float *)h_result);
+
+  // Apply gamma insertion on host spin elementals
+  if (cType == QUDA_CONTRACT_TYPE_DR) contractDegrandRossi((Float *)h_result);
+
+  // momentum project and sum over each time slice
+  const int T = Z[3] * comm_dim(3);
+  std::vector<double> h_summed(n_mom * T * 16 * 2, 0.0);
+  for (int parity = 0; parity < 2; parity++) {
+    for (int x_cb = 0; x_cb < Vh; x_cb++) {
+      int idx = fullLatticeIndex(x_cb, parity);
+      int x[4];
+      for (int d = 0; d < 4; d++) {
+        x[d] = idx % Z[d] + comm_coord(d) * Z[d];
+        idx /= Z[d];
+      }
+      int site = parity * Vh + x_cb;
+      for (int m = 0; m < n_mom; m++) {
+        double phase = 0.0;
+        for (int d = 0; d < 3; d++) phase -= 2.0 * M_PI * mom[3 * m + d] * x[d] / (Z[d] * comm_dim(d));
+        complex<double> e(cos(phase), sin(phase));
+        for (int j = 0; j < 16; j++) {
+          complex<double> c(((Float *)h_result)[32 * site + 2 * j], ((Float *)h_result)[32 * site + 2 * j + 1]);
+          c *= e;
+          h_summed[2 * ((m * T + x[3]) * 16 + j) + 0] += c.real();
+          h_summed[2 * ((m * T + x[3]) * 16 + j) + 1] += c.imag();
+        }
+      }
+    }
+  }
+  quda::comm_allreduce_sum(h_summed);
+
+  for (auto i = 0u; i < h_summed.size(); i++)
+    if (abs(h_summed[i] - d_result[i]) > tol) faults++;
+
+  host_free(h_result);
+  return faults;
+}
@@ -50,7 +50,7 @@ void display_test_info()
       if (low_mode_check || mg_eig[i]) {
         printfQuda(" - level %d solver mode %s\n", i + 1, get_eig_type_str(mg_eig_type[i]));
         printfQuda(" - level %d spectrum requested %s\n", i + 1, get_eig_spectrum_str(mg_eig_spectrum[i]));
-        if (mg_eig_type[i] == QUDA_EIG_BLK_TR_LANCZOS)
+        if (mg_eig_type[i] == QUDA_EIG_BLK_TR_LANCZOS || mg_eig_type[i] == QUDA_EIG_CHFSI)
           printfQuda(" - eigenvector block size %d\n", mg_eig_block_size[i]);
         printfQuda(" - level %d number of eigenvectors requested n_conv %d\n", i + 1, nvec[i]);
         printfQuda(" - level %d size of eigenvector search space %d\n", i + 1, mg_eig_n_ev[i]);
@@ -76,7 +76,8 @@ void display_test_info()
     printfQuda("\n   Eigensolver parameters\n");
     printfQuda(" - solver mode %s\n", get_eig_type_str(eig_type));
     printfQuda(" - spectrum requested %s\n", get_eig_spectrum_str(eig_spectrum));
-    if (eig_type == QUDA_EIG_BLK_TR_LANCZOS) printfQuda(" - eigenvector block size %d\n", eig_block_size);
+    if (eig_type == QUDA_EIG_BLK_TR_LANCZOS || eig_type == QUDA_EIG_CHFSI)
+      printfQuda(" - eigenvector block size %d\n", eig_block_size);
     printfQuda(" - number of eigenvectors requested %d\n", eig_n_conv);
     printfQuda(" - size of eigenvector search space %d\n", eig_n_ev);
     printfQuda(" - size of Krylov space %d\n", eig_n_kr);
@@ -281,7 +282,20 @@ std::vector<std::array<double, 2>> solve(test_t param)
     out[i] = quda::ColorSpinorField(cs_param);
   }
 
-  if (!use_split_grid) {
+  if (!use_split_grid && multishift > 1 && multishift_multi_src) {
+
+    inv_param.num_src = Nsrc;
+    std::vector<void **> _hp_x(Nsrc);
+    std::vector<void *> _hp_b(Nsrc);
+    for (int i = 0; i < Nsrc; i++) {
+      _hp_x[i] = _hp_multi_x[i].data();
+      _hp_b[i] = in[i].data();
+    }
+    invertMultiShiftMultiSrcQuda(_hp_x.data(), _hp_b.data(), &inv_param);
+
+    printfQuda("Done: %d sources - %i iter / %g secs = %g Gflops\n", Nsrc, inv_param.iter, inv_param.secs,
+               inv_param.gflops / inv_param.secs);
+  } else if (!use_split_grid) {
 
     for (int i = 0; i < Nsrc; i++) {
       // If deflating, preserve the deflation space between solves
@@ -335,7 +349,7 @@ std::vector<std::array<double, 2>> solve(test_t param)
   if (inv_multigrid) destroyMultigridQuda(mg_preconditioner);
 
   // Compute performance statistics
-  if (Nsrc > 1 && !use_split_grid) performanceStats(time, gflops, iter);
+  if (Nsrc > 1 && !use_split_grid && !(multishift > 1 && multishift_multi_src)) performanceStats(time, gflops, iter);
 
   std::vector<std::array<double, 2>> res(Nsrc);
   // Perform host side verification of inversion if requested
@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <limits>
+#include <tuple>
 
 #include <instantiate.h>
 #include <color_spinor_field.h>
@@ -49,7 +50,10 @@ TEST_P(GaugeIOTest, verify)
     return plaq;
   };
 
+  // record the checksums of the field we write out
+  gauge_param.compute_checksum = QUDA_BOOLEAN_TRUE;
   auto plaq_old = get_plaq();
+  gauge_param.compute_checksum = QUDA_BOOLEAN_FALSE;
 
   auto file = "dummy.lat";
 
@@ -59,6 +63,8 @@ TEST_P(GaugeIOTest, verify)
   // read it back
   read_gauge_field(file, gauge, gauge_param.cpu_prec, gauge_param.X, 0, nullptr);
 
+  // the field read back must reproduce the checksums
+  gauge_param.verify_checksum = QUDA_BOOLEAN_TRUE;
   auto plaq_new = get_plaq();
 
   // test the plaquette is identical
@@ -71,6 +77,111 @@ TEST_P(GaugeIOTest, verify)
   for (int dir = 0; dir < 4; dir++) { host_free(gauge[dir]); }
 }
 
+// test the checksums computed on load and save are consistent and sensitive to the field
+TEST_P(GaugeIOTest, checksum)
+{
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  setWilsonGaugeParam(gauge_param);
+
+  gauge_param.cpu_prec = ::testing::get<0>(param);
+  if (!quda::is_enabled(gauge_param.cpu_prec)) GTEST_SKIP();
+  gauge_param.cuda_prec = gauge_param.cpu_prec;
+  gauge_param.reconstruct = QUDA_RECONSTRUCT_NO;
+  gauge_param.t_boundary = QUDA_PERIODIC_T;
+
+  void *gauge[4];
+  for (int dir = 0; dir < 4; dir++) gauge[dir] = safe_malloc(V * gauge_site_size * host_gauge_data_type_size);
+  constructHostGaugeField(gauge, gauge_param, 0, nullptr);
+
+  auto checksum = [&]() {
+    return std::make_tuple(gauge_param.checksum_scidac[0], gauge_param.checksum_scidac[1], gauge_param.checksum_quda);
+  };
+
+  gauge_param.compute_checksum = QUDA_BOOLEAN_TRUE;
+  loadGaugeQuda((void *)gauge, &gauge_param);
+  auto load_sum = checksum();
+
+  // device -> host must return the identical field
+  gauge_param.checksum_scidac[0] = gauge_param.checksum_scidac[1] = 0;
+  gauge_param.checksum_quda = 0;
+  saveGaugeQuda((void *)gauge, &gauge_param);
+  EXPECT_EQ(load_sum, checksum());
+  freeGaugeQuda();
+
+  // the SciDAC checksum depends on the file precision, QUDA's checksum does not
+  if (gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION) {
+    gauge_param.checksum_prec = QUDA_SINGLE_PRECISION;
+    loadGaugeQuda((void *)gauge, &gauge_param);
+    freeGaugeQuda();
+    EXPECT_NE(std::get<0>(load_sum), std::get<0>(checksum()));
+    EXPECT_EQ(std::get<2>(load_sum), std::get<2>(checksum()));
+    gauge_param.checksum_prec = QUDA_INVALID_PRECISION;
+  }
+
+  // perturbing a single link element must change both checksums
+  auto *link = static_cast<char *>(gauge[0]);
+  if (gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION)
+    reinterpret_cast<double *>(link)[0] *= 2.0;
+  else
+    reinterpret_cast<float *>(link)[0] *= 2.0f;
+  loadGaugeQuda((void *)gauge, &gauge_param);
+  freeGaugeQuda();
+  EXPECT_NE(std::get<0>(load_sum), std::get<0>(checksum()));
+  EXPECT_NE(std::get<1>(load_sum), std::get<1>(checksum()));
+  EXPECT_NE(std::get<2>(load_sum), std::get<2>(checksum()));
+
+  for (int dir = 0; dir < 4; dir++) host_free(gauge[dir]);
+}
+
+// test that a gauge field saved to, and loaded from, compressed host storage yields the same lattice
+TEST_P(GaugeIOTest, compressed)
+{
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  setWilsonGaugeParam(gauge_param);
+
+  gauge_param.cpu_prec = ::testing::get<0>(param);
+  if (!quda::is_enabled(gauge_param.cpu_prec)) GTEST_SKIP();
+  gauge_param.cuda_prec = gauge_param.cpu_prec;
+  gauge_param.reconstruct = QUDA_RECONSTRUCT_NO;
+
+  // reconstruction on the host uses the precision of the field
+  const double tol = gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION ? 1e-12 : 1e-5;
+
+  // the anti-periodic boundary exercises the temporal boundary phase in the reconstruction
+  for (auto t_boundary : {QUDA_PERIODIC_T, QUDA_ANTI_PERIODIC_T}) {
+    gauge_param.t_boundary = t_boundary;
+
+    void *gauge[4];
+    for (int dir = 0; dir < 4; dir++) gauge[dir] = safe_malloc(V * gauge_site_size * host_gauge_data_type_size);
+    constructHostGaugeField(gauge, gauge_param, 0, nullptr);
+
+    std::array<double, 3> plaq_old;
+    loadGaugeQuda((void *)gauge, &gauge_param);
+    plaqQuda(plaq_old.data());
+
+    for (auto recon : {QUDA_RECONSTRUCT_12, QUDA_RECONSTRUCT_8}) {
+      void *compressed[4];
+      for (int dir = 0; dir < 4; dir++) compressed[dir] = safe_malloc(V * recon * host_gauge_data_type_size);
+
+      // device -> compressed host -> device
+      gauge_param.cpu_reconstruct = recon;
+      saveGaugeQuda((void *)compressed, &gauge_param);
+      freeGaugeQuda();
+      loadGaugeQuda((void *)compressed, &gauge_param);
+      gauge_param.cpu_reconstruct = QUDA_RECONSTRUCT_NO;
+
+      std::array<double, 3> plaq_new;
+      plaqQuda(plaq_new.data());
+      for (int i = 0; i < 3; i++) EXPECT_NEAR(plaq_old[i], plaq_new[i], tol);
+
+      for (int dir = 0; dir < 4; dir++) host_free(compressed[dir]);
+    }
+
+    freeGaugeQuda();
+    for (int dir = 0; dir < 4; dir++) host_free(gauge[dir]);
+  }
+}
+
 using cs_test_t = ::testing::tuple<QudaSiteSubset, bool, QudaPrecision, QudaPrecision, int, bool, QudaFieldLocation>;
 
 class ColorSpinorIOTest : public ::testing::TestWithParam<cs_test_t>
@@ -144,7 +255,7 @@ TEST_P(ColorSpinorIOTest, verify)
   VectorIO io(file, inflate, partfile);
 
   io.save({v.begin(), v.end()}, prec_io, n_vector);
-  io.load(u);
+  io.load(u, prec_io);
 
   for (auto i = 0u; i < v.size(); i++) {
     auto dev = blas::max_deviation(u[i], v[i]);
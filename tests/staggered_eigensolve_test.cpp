@@ -28,7 +28,8 @@ void display_test_info()
   printfQuda("\n   Eigensolver parameters\n");
   printfQuda(" - solver mode %s\n", get_eig_type_str(eig_type));
   printfQuda(" - spectrum requested %s\n", get_eig_spectrum_str(eig_spectrum));
-  if (eig_type == QUDA_EIG_BLK_TR_LANCZOS) printfQuda(" - eigenvector block size %d\n", eig_block_size);
+  if (eig_type == QUDA_EIG_BLK_TR_LANCZOS || eig_type == QUDA_EIG_CHFSI)
+    printfQuda(" - eigenvector block size %d\n", eig_block_size);
   printfQuda(" - number of eigenvectors requested %d\n", eig_n_conv);
   printfQuda(" - size of eigenvector search space %d\n", eig_n_ev);
   printfQuda(" - size of Krylov space %d\n", eig_n_kr);
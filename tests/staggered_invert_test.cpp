@@ -45,7 +45,7 @@ void display_test_info()
       if (low_mode_check || mg_eig[i]) {
         printfQuda(" - level %d solver mode %s\n", i + 1, get_eig_type_str(mg_eig_type[i]));
         printfQuda(" - level %d spectrum requested %s\n", i + 1, get_eig_spectrum_str(mg_eig_spectrum[i]));
-        if (mg_eig_type[i] == QUDA_EIG_BLK_TR_LANCZOS)
+        if (mg_eig_type[i] == QUDA_EIG_BLK_TR_LANCZOS || mg_eig_type[i] == QUDA_EIG_CHFSI)
           printfQuda(" - eigenvector block size %d\n", mg_eig_block_size[i]);
         printfQuda(" - level %d number of eigenvectors requested n_conv %d\n", i + 1, nvec[i]);
         printfQuda(" - level %d size of eigenvector search space %d\n", i + 1, mg_eig_n_ev[i]);
@@ -71,7 +71,8 @@ void display_test_info()
     printfQuda("\n   Eigensolver parameters\n");
     printfQuda(" - solver mode %s\n", get_eig_type_str(eig_type));
     printfQuda(" - spectrum requested %s\n", get_eig_spectrum_str(eig_spectrum));
-    if (eig_type == QUDA_EIG_BLK_TR_LANCZOS) printfQuda(" - eigenvector block size %d\n", eig_block_size);
+    if (eig_type == QUDA_EIG_BLK_TR_LANCZOS || eig_type == QUDA_EIG_CHFSI)
+      printfQuda(" - eigenvector block size %d\n", eig_block_size);
     printfQuda(" - number of eigenvectors requested %d\n", eig_n_conv);
     printfQuda(" - size of eigenvector search space %d\n", eig_n_ev);
     printfQuda(" - size of Krylov space %d\n", eig_n_kr);
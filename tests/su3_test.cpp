@@ -22,6 +22,7 @@
 double gauge_smear_rho = 0.1;
 double gauge_smear_epsilon = 0.1;
 double gauge_smear_alpha = 0.6;
+double gauge_flow_adaptive_tol = 0.0;
 int gauge_smear_steps = 50;
 QudaGaugeSmearType gauge_smear_type = QUDA_GAUGE_SMEAR_STOUT;
 int measurement_interval = 5;
@@ -46,7 +47,10 @@ void display_test_info()
     printfQuda(" - epsilon %f\n", gauge_smear_epsilon);
     break;
   case QUDA_GAUGE_SMEAR_WILSON_FLOW:
-  case QUDA_GAUGE_SMEAR_SYMANZIK_FLOW: printfQuda(" - epsilon %f\n", gauge_smear_epsilon); break;
+  case QUDA_GAUGE_SMEAR_SYMANZIK_FLOW:
+    printfQuda(" - epsilon %f\n", gauge_smear_epsilon);
+    if (gauge_flow_adaptive_tol > 0.0) printfQuda(" - adaptive step-size tolerance %e\n", gauge_flow_adaptive_tol);
+    break;
   default: errorQuda("Undefined test type %d given", test_type);
   }
   printfQuda(" - smearing steps %d\n", gauge_smear_steps);
@@ -83,6 +87,10 @@ void add_su3_option_group(std::shared_ptr<QUDAApp> quda_app)
   opgroup->add_option("--su3-smear-epsilon", gauge_smear_epsilon,
                       "epsilon coefficient for Over-Improved Stout smearing or Wilson flow (default 0.1)");
 
+  opgroup->add_option("--su3-flow-adaptive-tol", gauge_flow_adaptive_tol,
+                      "If positive, use an adaptive step size for Wilson/Symanzik flow with this local error "
+                      "tolerance, flowing to t = epsilon * steps (default 0)");
+
   opgroup->add_option("--su3-smear-steps", gauge_smear_steps, "The number of smearing steps to perform (default 50)");
 
   opgroup->add_option("--su3-measurement-interval", measurement_interval,
@@ -251,6 +259,7 @@ int main(int argc, char **argv)
   smear_param.alpha = gauge_smear_alpha;
   smear_param.rho = gauge_smear_rho;
   smear_param.epsilon = gauge_smear_epsilon;
+  smear_param.adaptive_tol = gauge_flow_adaptive_tol;
 
   host_timer.start(); // start the timer
   switch (smear_param.smear_type) {
@@ -269,6 +278,9 @@ int main(int argc, char **argv)
       obs_param[i].compute_plaquette = QUDA_BOOLEAN_TRUE;
     }
     performWFlowQuda(&smear_param, obs_param);
+    if (smear_param.adaptive_tol > 0.0)
+      printfQuda("Adaptive flow took %d steps with %d rejected\n", smear_param.adaptive_steps,
+                 smear_param.adaptive_rejected);
     break;
   }
   default: errorQuda("Undefined gauge smear type %d given", smear_param.smear_type);
@@ -57,9 +57,11 @@ int gcrNkrylov = 8;
 QudaCABasis ca_basis = QUDA_CHEBYSHEV_BASIS;
 double ca_lambda_min = 0.0;
 double ca_lambda_max = -1.0;
+bool ca_adaptive = false;
 QudaCABasis ca_basis_precondition = QUDA_CHEBYSHEV_BASIS;
 double ca_lambda_min_precondition = 0.0;
 double ca_lambda_max_precondition = -1.0;
+bool ca_adaptive_precondition = false;
 int pipeline = 0;
 int solution_accumulator_pipeline = 0;
 int test_type = 0;
@@ -67,6 +69,7 @@ quda::mgarray<int> nvec = {};
 quda::mgarray<std::string> mg_vec_infile;
 quda::mgarray<std::string> mg_vec_outfile;
 quda::mgarray<bool> mg_vec_partfile = {};
+quda::mgarray<QudaPrecision> mg_vec_save_prec = {};
 QudaInverterType inv_type;
 bool inv_deflate = false;
 bool inv_multigrid = false;
@@ -86,6 +89,7 @@ std::string madwf_param_outfile;
 
 int precon_schwarz_cycle = 1;
 int multishift = 1;
+bool multishift_multi_src = false;
 std::vector<double> multishift_shifts = {};
 std::vector<double> multishift_masses = {};
 std::vector<double> multishift_tols = {};
@@ -235,6 +239,7 @@ std::string eig_vec_infile;
 std::string eig_vec_outfile;
 bool eig_io_parity_inflate = false;
 QudaPrecision eig_save_prec = QUDA_DOUBLE_PRECISION;
+QudaPrecision eig_deflation_prec = QUDA_DOUBLE_PRECISION;
 bool eig_partfile = false;
 
 // Parameters for the MG eigensolver.
@@ -274,6 +279,7 @@ int heatbath_num_steps = 10;
 int heatbath_num_heatbath_per_step = 5;
 int heatbath_num_overrelax_per_step = 5;
 bool heatbath_coldstart = false;
+bool heatbath_multi_hit = false;
 
 int gf_gauge_dir = 4;
 int gf_maxiter = 10000;
@@ -371,7 +377,8 @@ namespace
   CLI::TransformPairs<QudaEigType> eig_type_map {{"trlm", QUDA_EIG_TR_LANCZOS},
                                                  {"blktrlm", QUDA_EIG_BLK_TR_LANCZOS},
                                                  {"iram", QUDA_EIG_IR_ARNOLDI},
-                                                 {"blkiram", QUDA_EIG_BLK_IR_ARNOLDI}};
+                                                 {"blkiram", QUDA_EIG_BLK_IR_ARNOLDI},
+                                                 {"chfsi", QUDA_EIG_CHFSI}};
 
   CLI::TransformPairs<QudaTransferType> transfer_type_map {
     {"aggregate", QUDA_TRANSFER_AGGREGATE},
@@ -434,6 +441,9 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
     ca_lambda_max, "Conservative estimate of largest eigenvalue for Chebyshev basis CA solvers (default is to guess with power iterations)");
   quda_app->add_option("--cheby-basis-eig-min", ca_lambda_min,
                        "Conservative estimate of smallest eigenvalue for Chebyshev basis CA solvers (default 0)");
+  quda_app->add_option("--ca-adaptive", ca_adaptive,
+                       "Estimate the Chebyshev basis bounds with Arnoldi and select the largest stable CA basis size "
+                       "(default false)");
 
   quda_app
     ->add_option("--ca-basis-type-precondition", ca_basis_precondition,
@@ -445,6 +455,9 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
   quda_app->add_option("--cheby-basis-eig-min-precondition", ca_lambda_min_precondition,
                        "Conservative estimate of smallest eigenvalue for Chebyshev basis CA solvers when used as a "
                        "preconditioner (default 0)");
+  quda_app->add_option("--ca-adaptive-precondition", ca_adaptive_precondition,
+                       "Estimate the Chebyshev basis bounds with Arnoldi for CA solvers when used as a preconditioner "
+                       "(default false)");
 
   quda_app->add_option("--clover-csw", clover_csw, "Clover Csw coefficient 1.0")->capture_default_str();
   quda_app
@@ -524,6 +537,8 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
   quda_app->add_option(
     "--multishift-tols-hq", multishift_tols_hq,
     "List of hq tolerances to use in a multi-shift solve. Default is the input hq tolerance (default 0)");
+  quda_app->add_option("--multishift-multi-src", multishift_multi_src,
+                       "Solve all nsrc sources of a multi-shift solve together (default false)");
   quda_app->add_option("--ngcrkrylov", gcrNkrylov,
                        "The number of inner iterations to use for GCR, BiCGstab-l, CA-CG, CA-GCR (default 8)");
   quda_app->add_option("--niter", niter, "The number of iterations to perform (default 100)");
@@ -576,10 +591,11 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
   quda_app->add_option("--precon-schwarz-cycle", precon_schwarz_cycle,
                        "The number of Schwarz cycles to apply per smoother application (default=1)");
 
-  CLI::TransformPairs<int> rank_order_map {{"col", 0}, {"row", 1}};
+  CLI::TransformPairs<int> rank_order_map {{"col", 0}, {"row", 1}, {"topo", 2}};
   quda_app
     ->add_option("--rank-order", rank_order,
-                 "Set the [t][z][y][x] rank order as either column major (t fastest, default) or row major (x fastest)")
+                 "Set the [t][z][y][x] rank order as either column major (t fastest, default), row major (x fastest) "
+                 "or topology aware (blocks of the grid placed on nodes by adviseCommsLayoutQuda, MPI only)")
     ->transform(CLI::QUDACheckedTransformer(rank_order_map));
 
   quda_app->add_option("--recon", link_recon, "Link reconstruction type")
@@ -738,6 +754,11 @@ void add_eigen_option_group(std::shared_ptr<QUDAApp> quda_app)
                  "If saving eigenvectors, use this precision to save. No-op if eig-save-prec is greater than or equal "
                  "to precision of eigensolver (default = double)")
     ->transform(prec_transform);
+  opgroup
+    ->add_option("--eig-deflation-prec", eig_deflation_prec,
+                 "Store the deflation space of deflated solvers in this precision, deflating with the projected "
+                 "operator. No-op if greater than or equal to the precision of the eigensolver (default = double)")
+    ->transform(prec_transform);
   opgroup->add_option("--eig-save-partfile", eig_partfile,
                       "If saving eigenvectors, save in partfile format instead of singlefile (default false)");
 
@@ -912,6 +933,9 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
   quda_app->add_mgoption(
     opgroup, "--mg-save-partfile", mg_vec_partfile, CLI::Validator(),
     "Whether to save near-null vectors as partfile instead of singlefile (default false; singlefile)");
+  quda_app->add_mgoption(opgroup, "--mg-save-prec", mg_vec_save_prec, CLI::QUDACheckedTransformer(precision_map),
+                         "The precision with which to save the near-null vectors; half or quarter selects the "
+                         "compressed per-rank format, which does not require QIO (default field precision)");
 
   quda_app
     ->add_mgoption("--mg-eig-save-prec", mg_eig_save_prec, CLI::Validator(),
@@ -1064,6 +1088,9 @@ void add_heatbath_option_group(std::shared_ptr<QUDAApp> quda_app)
                       "Number of heatbath hits per heatbath step (default 5)");
   opgroup->add_option("--heatbath-num-or-per-step", heatbath_num_overrelax_per_step,
                       "Number of overrelaxation hits per heatbath step (default 5)");
+  opgroup->add_option("--heatbath-multi-hit", heatbath_multi_hit,
+                      "Whether to apply the heatbath hits, followed by a single overrelaxation hit if any are "
+                      "requested, to each link in a single fused sweep (default false)");
   opgroup->add_option("--heatbath-num-steps", heatbath_num_steps,
                       "Number of measurement steps in heatbath test (default 10)");
   opgroup->add_option("--heatbath-warmup-steps", heatbath_warmup_steps,
@@ -193,9 +193,11 @@ extern int gcrNkrylov;
 extern QudaCABasis ca_basis;
 extern double ca_lambda_min;
 extern double ca_lambda_max;
+extern bool ca_adaptive;
 extern QudaCABasis ca_basis_precondition;
 extern double ca_lambda_min_precondition;
 extern double ca_lambda_max_precondition;
+extern bool ca_adaptive_precondition;
 extern int pipeline;
 extern int solution_accumulator_pipeline;
 extern int test_type;
@@ -203,6 +205,7 @@ extern quda::mgarray<int> nvec;
 extern quda::mgarray<std::string> mg_vec_infile;
 extern quda::mgarray<std::string> mg_vec_outfile;
 extern quda::mgarray<bool> mg_vec_partfile;
+extern quda::mgarray<QudaPrecision> mg_vec_save_prec;
 extern QudaInverterType inv_type;
 extern bool inv_deflate;
 extern bool inv_multigrid;
@@ -222,6 +225,7 @@ extern std::string madwf_param_outfile;
 
 extern int precon_schwarz_cycle;
 extern int multishift;
+extern bool multishift_multi_src;
 extern std::vector<double> multishift_shifts;
 extern std::vector<double> multishift_masses;
 extern std::vector<double> multishift_tols;
@@ -361,6 +365,7 @@ extern std::string eig_vec_infile;
 extern std::string eig_vec_outfile;
 extern bool eig_io_parity_inflate;
 extern QudaPrecision eig_save_prec;
+extern QudaPrecision eig_deflation_prec;
 extern bool eig_partfile;
 
 // Parameters for the MG eigensolver.
@@ -400,6 +405,7 @@ extern int heatbath_num_steps;
 extern int heatbath_num_heatbath_per_step;
 extern int heatbath_num_overrelax_per_step;
 extern bool heatbath_coldstart;
+extern bool heatbath_multi_hit;
 
 extern int gf_gauge_dir;
 extern int gf_maxiter;
@@ -134,6 +134,7 @@ void setQudaDefaultMgTestParams()
     mg_eig_amin[i] = 1.0;
     mg_eig_amax[i] = -1.0; // use power iterations
     mg_eig_save_prec[i] = QUDA_DOUBLE_PRECISION;
+    mg_vec_save_prec[i] = QUDA_INVALID_PRECISION;
 
     setup_ca_basis[i] = QUDA_POWER_BASIS;
     setup_ca_basis_size[i] = 4;
@@ -277,9 +278,17 @@ void initComms(int, char **, int *const commDims)
   if (getenv("QUDA_TEST_GRID_SIZE")) { get_size_from_env(commDims, "QUDA_TEST_GRID_SIZE"); }
   if (getenv("QUDA_TEST_GRID_PARTITION")) { get_size_from_env(grid_partition.data(), "QUDA_TEST_GRID_PARTITION"); }
 
+#if defined(QMP_COMMS) || defined(MPI_COMMS)
+  // the communication progress thread requires full thread support
+  // (QUDA logging is not available until the comms grid is initialized)
+  char *enable_progress = getenv("QUDA_ENABLE_PROGRESS_THREAD");
+  bool progress_thread = enable_progress && strcmp(enable_progress, "1") == 0;
+#endif
+
 #if defined(QMP_COMMS)
   QMP_thread_level_t tl;
-  QMP_init_msg_passing(&argc, &argv, QMP_THREAD_SINGLE, &tl);
+  QMP_init_msg_passing(&argc, &argv, progress_thread ? QMP_THREAD_MULTIPLE : QMP_THREAD_SINGLE, &tl);
+  if (progress_thread && tl != QMP_THREAD_MULTIPLE) fprintf(stderr, "QMP_THREAD_MULTIPLE not provided\n");
 
   // make sure the QMP logical ordering matches QUDA's
   if (rank_order == 0) {
@@ -290,12 +299,41 @@ void initComms(int, char **, int *const commDims)
     QMP_declare_logical_topology_map(commDims, 4, map, 4);
   }
 #elif defined(MPI_COMMS)
-  MPI_Init(&argc, &argv);
+  if (progress_thread) {
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+    if (provided != MPI_THREAD_MULTIPLE) fprintf(stderr, "MPI_THREAD_MULTIPLE not provided\n");
+  } else {
+    MPI_Init(&argc, &argv);
+  }
 #endif
 
-  QudaCommsMap func = rank_order == 0 ? lex_rank_from_coords_t : lex_rank_from_coords_x;
+  QudaCommsMap func = rank_order == 1 ? lex_rank_from_coords_x : lex_rank_from_coords_t;
+  void *fdata = nullptr;
+
+  static QudaCommsLayout layout = {};
+  if (rank_order == 2) {
+#if defined(MPI_COMMS)
+    // keep the requested grid, but place blocks of it on nodes
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    int ranks_per_node, n_ranks;
+    MPI_Comm_size(node_comm, &ranks_per_node);
+    MPI_Comm_free(&node_comm);
+    MPI_Comm_size(MPI_COMM_WORLD, &n_ranks);
+
+    QudaCommsTopology topology = {ranks_per_node, ranks_per_node, 0.0, 0.0, 0.0};
+    int lattice[] = {xdim * commDims[0], ydim * commDims[1], zdim * commDims[2], tdim * commDims[3]};
+    for (int d = 0; d < 4; d++) layout.grid[d] = commDims[d];
+    // the outcome is reported once the comms grid is initialized
+    if (adviseCommsLayoutQuda(&layout, lattice, n_ranks, &topology) == 0) {
+      func = rankFromCoordsLayoutQuda;
+      fdata = &layout;
+    }
+#endif
+  }
 
-  initCommsGridQuda(4, commDims, func, NULL);
+  initCommsGridQuda(4, commDims, func, fdata);
 
   for (int d = 0; d < 4; d++) {
     if (dim_partitioned[d]) { commDimPartitionedSet(d); }
@@ -303,8 +341,22 @@ void initComms(int, char **, int *const commDims)
 
   initRand();
 
-  printfQuda("Rank order is %s major (%s running fastest)\n", rank_order == 0 ? "column" : "row",
-             rank_order == 0 ? "t" : "x");
+  if (rank_order == 2 && fdata) {
+    printfQuda("Rank order is topology aware: processor grid (%d,%d,%d,%d) with node block (%d,%d,%d,%d) and socket "
+               "block (%d,%d,%d,%d)\n",
+               layout.grid[0], layout.grid[1], layout.grid[2], layout.grid[3], layout.node_grid[0], layout.node_grid[1],
+               layout.node_grid[2], layout.node_grid[3], layout.socket_grid[0], layout.socket_grid[1],
+               layout.socket_grid[2], layout.socket_grid[3]);
+  } else if (rank_order == 2) {
+#if defined(MPI_COMMS)
+    warningQuda("No topology-aware layout found for this grid, falling back to column major rank order");
+#else
+    warningQuda("Topology-aware rank order requires MPI, falling back to column major rank order");
+#endif
+    printfQuda("Rank order is column major (t running fastest)\n");
+  } else
+    printfQuda("Rank order is %s major (%s running fastest)\n", rank_order == 0 ? "column" : "row",
+               rank_order == 0 ? "t" : "x");
 }
 
 void finalizeComms()
@@ -175,6 +175,7 @@ const char *get_eig_type_str(QudaEigType type)
   case QUDA_EIG_BLK_TR_LANCZOS: ret = "blktrlm"; break;
   case QUDA_EIG_IR_ARNOLDI: ret = "iram"; break;
   case QUDA_EIG_BLK_IR_ARNOLDI: ret = "blkiram"; break;
+  case QUDA_EIG_CHFSI: ret = "chfsi"; break;
   default: ret = "unknown eigensolver"; break;
   }
 
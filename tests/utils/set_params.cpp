@@ -191,6 +191,7 @@ void setInvertParam(QudaInvertParam &inv_param)
   inv_param.ca_basis = ca_basis;
   inv_param.ca_lambda_min = ca_lambda_min;
   inv_param.ca_lambda_max = ca_lambda_max;
+  inv_param.ca_adaptive = ca_adaptive ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   inv_param.tol = tol;
   inv_param.tol_restart = tol_restart;
   if (tol_hq == 0 && tol == 0) errorQuda("qudaInvert: requesting zero residual");
@@ -249,6 +250,7 @@ void setInvertParam(QudaInvertParam &inv_param)
   inv_param.ca_basis_precondition = ca_basis_precondition;
   inv_param.ca_lambda_min_precondition = ca_lambda_min_precondition;
   inv_param.ca_lambda_max_precondition = ca_lambda_max_precondition;
+  inv_param.ca_adaptive_precondition = ca_adaptive_precondition ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   inv_param.verbosity_precondition = verbosity_precondition;
   inv_param.cuda_prec_precondition = cuda_prec_precondition;
   inv_param.cuda_prec_eigensolver = cuda_prec_eigensolver;
@@ -339,6 +341,7 @@ void setEigParam(QudaEigParam &eig_param)
   safe_strcpy(eig_param.vec_infile, eig_vec_infile, 256, "eig_vec_infile");
   safe_strcpy(eig_param.vec_outfile, eig_vec_outfile, 256, "eig_vec_outfile");
   eig_param.save_prec = eig_save_prec;
+  eig_param.deflation_prec = eig_deflation_prec;
   eig_param.io_parity_inflate = eig_io_parity_inflate ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   eig_param.partfile = eig_partfile ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
@@ -608,6 +611,7 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     if (mg_vec_infile[i].size() > 0) mg_param.vec_load[i] = QUDA_BOOLEAN_TRUE;
     if (mg_vec_outfile[i].size() > 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
     mg_param.mg_vec_partfile[i] = mg_vec_partfile[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+    mg_param.vec_save_prec[i] = mg_vec_save_prec[i];
   }
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
@@ -736,6 +740,7 @@ void setMultigridInvertParam(QudaInvertParam &inv_param)
   inv_param.ca_basis_precondition = ca_basis_precondition;
   inv_param.ca_lambda_min_precondition = ca_lambda_min_precondition;
   inv_param.ca_lambda_max_precondition = ca_lambda_max_precondition;
+  inv_param.ca_adaptive_precondition = ca_adaptive_precondition ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   inv_param.omega = 1.0;
 
   // Whether or not to use native BLAS LAPACK
@@ -951,6 +956,7 @@ void setStaggeredInvertParam(QudaInvertParam &inv_param)
   inv_param.ca_basis = ca_basis;
   inv_param.ca_lambda_min = ca_lambda_min;
   inv_param.ca_lambda_max = ca_lambda_max;
+  inv_param.ca_adaptive = ca_adaptive ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
   inv_param.solution_type = solution_type;
   inv_param.solve_type = solve_type;
@@ -1203,6 +1209,7 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
     if (mg_vec_infile[i].size() > 0) mg_param.vec_load[i] = QUDA_BOOLEAN_TRUE;
     if (mg_vec_outfile[i].size() > 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
     mg_param.mg_vec_partfile[i] = mg_vec_partfile[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+    mg_param.vec_save_prec[i] = mg_vec_save_prec[i];
   }
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;